@@ -7,7 +7,36 @@
  * - Tabuleiro 10x10
  * - Posicionamento de 4 navios (horizontal, vertical e diagonal)
  * - Sistema de habilidades especiais (cone, cruz, octaedro)
+ * - Habilidades pré-compiladas em máscaras por centro (ataques de área em O(1))
+ * - Modo de simulação em lote sem saída no caminho crítico (--simulate N)
+ * - Motor Monte Carlo paralelo para avaliar habilidades e frotas (--montecarlo N)
+ * - Sorteio uniforme de frotas sem rejeição, com máscaras pré-calculadas
+ * - Tabuleiro e frota configuráveis em tempo de execução (2 bits por célula)
+ * - Kernels especializados em tempo de compilação para o 10x10 com habilidades 5x5
+ * - Suíte de micro-benchmarks com saída JSON (--benchmark [--json])
+ * - Renderização em buffer com um único write e modo diferencial ANSI (--assistir)
+ * - IA atacante por densidade de probabilidade com mapa incremental (--ia)
+ * - Convolução das habilidades sobre o mapa com kernels AVX2/NEON e fallback escalar
+ * - Registro binário compacto de partidas (varints, blocos com CRC-32, leitura por mmap)
+ * - Replay paralelo de registros com estatísticas por habilidade e histogramas (--replay)
+ * - Servidor multijogador com epoll e protocolo binário, mais gerador de carga (--servidor, --carga)
+ * - Métricas do servidor em contadores atômicos fragmentados, expostas em texto (--metricas)
+ * - Instantâneos das partidas em layout fixo, restaurados por mmap com CRC por partida (--instantaneo)
+ * - Pool de partidas de tamanho fixo com arena por partida e contadores de alocação
+ * - Escalonador de partidas em corrotinas sem pilha, milhares por thread (--corrotinas)
+ * - Torneio de estratégias distribuído em lotes entre nós por TCP (--torneio, --no-torneio)
+ * - Enumeração exata das frotas legais em threads, com backend OpenCL opcional (--enumerar)
+ * - Regressão semeada de todos os caminhos do motor contra a referência, com ganho por caminho (--regressao)
+ * - API de ataques em lote (vários ataques em um tabuleiro ou um ataque em vários)
+ * - Lotes de tabuleiros em estrutura de arrays com disparo em 8 partidas por instrução (AVX-512/AVX2)
+ * - Diário de jogadas com desfazer/refazer em O(células alteradas) para buscas
+ * - Planejador MCTS sobre frotas sorteadas em pool com roubo de tarefas (--planejador)
+ * - Hash Zobrist incremental dos estados e tabela de transposição sem travas
+ * - Habilidades definidas em arquivo de padrões KxK, compiladas em máscaras (--habilidades)
+ * - Leitor de comandos em lote sobre qualquer descritor, sem scanf, e roteiros de partida (--roteiro)
+ * - Instrumentação opcional por fase com TSC e histogramas HDR (-DBATALHA_INSTRUMENTACAO=1)
  * - Visualização completa do tabuleiro e áreas de impacto
+ * - Motor interno em bitboards (planos de 128 bits para navios, acertos e erros)
  * - Documentação completa e código manutenível
  *
  * Autor: Roger Ferreira
@@ -17,16 +46,61 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <signal.h>
+#include <poll.h>
+#if BATALHA_OPENCL
+#include <dlfcn.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CONTADOR_CICLOS_DISPONIVEL 1
+#else
+#define CONTADOR_CICLOS_DISPONIVEL 0
+#endif
+
+// Kernels vetoriais da convolução: AVX2 escolhido em tempo de execução, NEON em tempo de compilação
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CONVOLUCAO_AVX2 1
+#else
+#define CONVOLUCAO_AVX2 0
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CONVOLUCAO_NEON 1
+#else
+#define CONVOLUCAO_NEON 0
+#endif
 
 /*
  * ============================================
  * CONSTANTES E DEFINIÇÕES DO SISTEMA
  * ============================================
  */
+#define VERSAO_SISTEMA "2.0"
 #define TAMANHO_TABULEIRO 10
 #define TAMANHO_HABILIDADE 5
 #define MAX_NAVIOS 4
 #define MAX_NOME_HABILIDADE 20
+#define TOTAL_CELULAS (TAMANHO_TABULEIRO * TAMANHO_TABULEIRO)
 
 // Estados das posições do tabuleiro
 #define POSICAO_VAZIA 0
@@ -34,15 +108,193 @@
 #define POSICAO_ATINGIDA 2
 #define POSICAO_AGUA_ATINGIDA 1
 
+// Identificadores das habilidades padrão (usados pelos kernels especializados)
+#define HABILIDADE_CONE 0
+#define HABILIDADE_CRUZ 1
+#define HABILIDADE_OCTAEDRO 2
+
+// Padrões 5x5 das habilidades padrão como constantes de 25 bits (bit = linha * 5 + coluna)
+#define BIT_PADRAO(i, j) (1u << ((i) * TAMANHO_HABILIDADE + (j)))
+#define PADRAO_CONE (BIT_PADRAO(0, 2) |                                   \
+                     BIT_PADRAO(1, 1) | BIT_PADRAO(1, 2) | BIT_PADRAO(1, 3) | \
+                     BIT_PADRAO(2, 0) | BIT_PADRAO(2, 1) | BIT_PADRAO(2, 2) | \
+                     BIT_PADRAO(2, 3) | BIT_PADRAO(2, 4))
+#define PADRAO_CRUZ (BIT_PADRAO(0, 2) | BIT_PADRAO(1, 2) | BIT_PADRAO(3, 2) | \
+                     BIT_PADRAO(4, 2) | BIT_PADRAO(2, 0) | BIT_PADRAO(2, 1) | \
+                     BIT_PADRAO(2, 2) | BIT_PADRAO(2, 3) | BIT_PADRAO(2, 4))
+#define PADRAO_OCTAEDRO (BIT_PADRAO(0, 2) |                                   \
+                         BIT_PADRAO(1, 1) | BIT_PADRAO(1, 2) | BIT_PADRAO(1, 3) | \
+                         BIT_PADRAO(2, 2))
+
 // Estados das áreas de habilidades
 #define AREA_NAO_AFETADA 0
 #define AREA_AFETADA 1
 
+// Resultado do disparo em uma célula (relatado aos receptores de eventos)
+#define RESULTADO_ACERTO 1
+#define RESULTADO_AGUA 2
+#define RESULTADO_NAVIO_JA_ATINGIDO 3
+#define RESULTADO_AGUA_JA_ATINGIDA 4
+
+// Limite de turnos de uma partida simulada
+#define MAX_TURNOS 100
+
+// Parâmetros do motor Monte Carlo
+#define QUANTIDADE_HABILIDADES_PADRAO 3
+#define MAX_THREADS 256
+#define TAMANHO_LINHA_CACHE 64
+
+// Máximo de posicionamentos possíveis de um navio (H, V e D em cada célula)
+#define MAX_POSICIONAMENTOS (3 * TOTAL_CELULAS)
+
+// Sorteios diretos antes de enumerar as posições livres de um navio
+#define SORTEIOS_RAPIDOS 4
+
+// Posicionamentos que cobrem uma mesma célula: 3 orientações x deslocamento no navio
+#define MAX_POSICIONAMENTOS_POR_CELULA (3 * TAMANHO_TABULEIRO)
+
+// Peso extra de um posicionamento por acerto ainda não afundado que ele cobre (modo caça)
+#define PESO_ACERTO 8
+
+// Planejador MCTS: ações candidatas, profundidade da busca e tamanho das árvores
+#define CANDIDATOS_POR_HABILIDADE 6
+#define MAX_CANDIDATOS_PLANEJADOR 24
+#define HORIZONTE_PLANEJADOR 2          // Ataques planejados à frente em cada decisão
+#define MAX_NOS_ARVORE 16384            // Cabe em int16_t
+#define ARVORES_POR_THREAD 2            // Folga para o roubo de tarefas equilibrar a carga
+#define ITERACOES_POR_TAREFA 64
+#define TENTATIVAS_DETERMINIZACAO 32
+#define ORCAMENTO_PLANEJADOR_MS 10
+#define BONUS_AFUNDAMENTO 1             // Recompensa extra por navio afundado, em partes
+#define DESCONTO_PLANEJADOR 0.9f
+#define EXPLORACAO_PLANEJADOR 0.35f
+#define CAPACIDADE_FILA_TRABALHO 256
+
+// Hash Zobrist e tabelas de transposição
+#define SEMENTE_ZOBRIST 0x5A0B215742ULL    // Fixa: o mesmo estado tem o mesmo hash em qualquer execução
+#define BITS_TRANSPOSICAO_PLANEJADOR 16     // 2^16 entradas de 16 bytes (1 MiB)
+
+// Habilidades definidas em arquivo de padrões
+#define MAX_HABILIDADES_CATALOGO 256        // O índice da habilidade em AtaqueLote é um uint8_t
+#define MAX_LADO_PADRAO (2 * TAMANHO_TABULEIRO - 1)     // Maior carimbo que ainda alcança todo o tabuleiro
+#define MAX_LINHA_PADRAO 128
+#define MAX_SORTEIOS_FROTA_RESTRITA 4096    // Sorteios por frota nas estratégias de posicionamento por rejeição
+#define TAMANHO_BUFFER_COMANDOS 65536       // Bytes trazidos por read no leitor de comandos
+#define MAX_ERROS_ROTEIRO 5                 // Linhas inválidas relatadas individualmente por roteiro
+
+// Grade da convolução: o tabuleiro com borda de zeros de TAMANHO_HABILIDADE / 2 células;
+// a largura folgada permite leituras vetoriais de 16 colunas a partir de qualquer deslocamento
+#define MAX_HABILIDADES 8
+#define LINHAS_GRADE_CONVOLUCAO (TAMANHO_TABULEIRO + TAMANHO_HABILIDADE - 1)
+#define LARGURA_GRADE_CONVOLUCAO 24
+
+// Lotes de tabuleiros SoA: faixas de 64 bits por vetor de 512 bits (a capacidade é múltipla)
+#define FAIXAS_LOTE_SOA 8
+#define LOTE_SOA_VETORIAL CONVOLUCAO_AVX2
+
+// Compile com -DBATALHA_EVENTOS=0 para remover toda a emissão de eventos
+#ifndef BATALHA_EVENTOS
+#define BATALHA_EVENTOS 1
+#endif
+
+// Compile com -DBATALHA_OPENCL=1 para o backend OpenCL da enumeração exata (biblioteca carregada por dlopen)
+#ifndef BATALHA_OPENCL
+#define BATALHA_OPENCL 0
+#endif
+
+// Compile com -DBATALHA_INSTRUMENTACAO=1 para medir as fases do caminho crítico (histogramas no stderr)
+#ifndef BATALHA_INSTRUMENTACAO
+#define BATALHA_INSTRUMENTACAO 0
+#endif
+#define BITS_SUBBALDE_FASE 4            // 16 sub-baldes por potência de 2: erro relativo de até 6,25%
+#define MAX_EXPOENTE_FASE 40            // 2^40 ciclos (vários minutos); acima disso satura
+#define BALDES_HISTOGRAMA_FASE ((MAX_EXPOENTE_FASE - BITS_SUBBALDE_FASE + 2) << BITS_SUBBALDE_FASE)
+
 // Códigos de retorno para operações
 #define SUCESSO 1
 #define ERRO_POSICAO_INVALIDA 0
 #define ERRO_POSICAO_OCUPADA -1
 #define ERRO_FORA_LIMITES -2
+#define ERRO_COORDENADA_FORMATO -3
+#define ERRO_COORDENADA_COLUNA -4
+#define ERRO_COORDENADA_LINHA -5
+#define ERRO_REGISTRO_CORROMPIDO -6
+#define ERRO_FORA_DA_VEZ -7
+#define ERRO_SEM_PARTIDA -8
+#define ERRO_HABILIDADE_INVALIDA -9
+#define ERRO_JA_EM_PARTIDA -10
+#define ERRO_SERVIDOR_CHEIO -11
+#define ERRO_ARQUIVO_HABILIDADES -12
+#define ERRO_ENTRADA_PENDENTE -13           // Descritor não bloqueante ainda sem uma linha completa
+#define ERRO_FIM_ENTRADA -14
+#define ERRO_ADVERSARIO_AUSENTE -15         // Partida restaurada ainda sem o outro jogador
+#define ERRO_MEMORIA -16                    // Alocação falhou
+#define ERRO_ES -17                         // Leitura ou escrita em arquivo/socket falhou
+
+// Limites do tabuleiro dinâmico
+#define MAX_DIMENSAO_DINAMICA 10000
+#define MAX_NAVIOS_DINAMICOS 4096
+#define MAX_LETRAS_COLUNA 4     // "ZZZZ" = coluna 475253
+
+// Renderização em buffer: capacidade do quadro e posição das células na tela (1-based)
+#define CAPACIDADE_QUADRO 8192
+#define LINHA_PRIMEIRA_CELULA 7     // "\n", 3 linhas de título, cabeçalho e borda superior
+#define COLUNA_PRIMEIRA_CELULA 5    // " %d │" ocupa 4 colunas
+#define LINHA_APOS_QUADRO 23        // Primeira linha livre depois da legenda
+#define ATRASO_QUADRO_MS 150        // Pausa entre turnos no modo espectador (apenas em terminal)
+
+// Registro binário de partidas (formato descrito na seção REGISTRO BINÁRIO DE PARTIDAS)
+#define ASSINATURA_REGISTRO "BNREG"
+#define VERSAO_REGISTRO 1
+#define TAMANHO_CABECALHO_REGISTRO 8
+#define TAMANHO_CABECALHO_BLOCO 12
+#define TAMANHO_BLOCO_REGISTRO 65536    // Carga útil máxima de um bloco
+#define MAX_BYTES_EVENTO 16             // Maior evento codificado (navio ou ataque), com folga
+
+// Instantâneos de partidas em layout fixo
+#define ASSINATURA_INSTANTANEO "BNSNAP"
+#define VERSAO_INSTANTANEO 1
+#define MARCA_ORDEM_BYTES 0x01020304u
+#define MAX_VETORES_INSTANTANEO 1024    // Partidas por chamada de writev (IOV_MAX do Linux)
+#define INTERVALO_INSTANTANEO_MS 5000   // Gravação periódica do servidor quando houve mudanças
+
+// Servidor multijogador (protocolo descrito na seção SERVIDOR MULTIJOGADOR)
+#define MSG_ENTRAR 0x01
+#define MSG_ATAQUE 0x02
+#define MSG_RETOMAR 0x03
+#define MSG_INICIO 0x81
+#define MSG_RESULTADO 0x82
+#define MSG_FIM 0x83
+#define MSG_ERRO 0x8F
+#define MAX_TEXTO_COORDENADA 8          // Letras e dígitos de uma coordenada no protocolo
+#define TAMANHO_ENTRADA_CONEXAO 512
+#define TAMANHO_SAIDA_CONEXAO 512
+#define MAX_EVENTOS_EPOLL 256
+#define PARTIDAS_SERVIDOR_PADRAO 10000
+#define BALDES_LATENCIA 100000          // Histograma de latência do gerador de carga (até 1 s)
+#define MICROSSEGUNDOS_POR_BALDE 10
+#define FRAGMENTOS_METRICAS 16          // Fragmentos dos contadores do servidor (um por thread que grava)
+#define TAMANHO_RESPOSTA_METRICAS 8192  // Resposta HTTP do endpoint de métricas
+
+// Escalonador de partidas em corrotinas
+#define PARTIDAS_VIVAS_CORROTINAS 1024  // Partidas intercaladas por thread
+#define TAMANHO_ENTRADA_CORROTINA 256   // Buffer do leitor de comandos de cada cliente
+#define MAX_ERROS_CLIENTE_CORROTINA 16  // Comandos inválidos tolerados antes do abandono
+
+// Torneio distribuído: mensagens, lotes e pareamentos
+#define MSG_TORNEIO_PEDIR 0x11
+#define MSG_TORNEIO_RESULTADO 0x12
+#define MSG_TORNEIO_LOTE 0x91
+#define MSG_TORNEIO_FIM 0x92
+#define TAMANHO_LOTE_TORNEIO 19         // lote, posicionamento, ataque, partidas, semente, gravar
+#define TAMANHO_RESULTADO_TORNEIO 60    // lote e as 7 estatísticas; o registro vem em seguida
+#define TAMANHO_LEITURA_TORNEIO 4096
+#define MAX_MENSAGEM_TORNEIO (64u << 20)    // Resultado com registro de um lote grande
+#define MAX_NOS_TORNEIO 1024            // Conexões simultâneas de nós no coordenador
+#define PARTIDAS_LOTE_TORNEIO 20000
+#define POSICIONAMENTOS_TORNEIO 3
+#define ATAQUES_TORNEIO 2
+#define PAREAMENTOS_TORNEIO (POSICIONAMENTOS_TORNEIO * ATAQUES_TORNEIO)
 
 /*
  * ============================================
@@ -69,6 +321,7 @@ typedef struct {
     char orientacao;       // 'H' = horizontal, 'V' = vertical, 'D' = diagonal
     int id;               // Identificador único do navio
     int foiDestruido;     // Flag para saber se o navio já foi destruído (0 = não, 1 = sim)
+    int partesRestantes;  // Células ainda não atingidas (mantido pelo núcleo headless)
 } Navio;
 
 /**
@@ -82,696 +335,12210 @@ typedef struct {
     int erros;
 } EstatisticasJogo;
 
-/*
- * ============================================
- * DECLARAÇÃO DE FUNÇÕES (PROTÓTIPOS)
- * ============================================
+/**
+ * Plano de bits do tabuleiro (bitboard)
+ * Cada célula ocupa um bit no índice linha * TAMANHO_TABULEIRO + coluna;
+ * 128 bits comportam todo o tabuleiro 10x10 em duas palavras de 64 bits
  */
-static void proximaCoordenada(Coordenada* coord, char orientacao);
-static inline int coordenadaValida(int linha, int coluna);
-void verificarNaviosDestruidos(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navios[], int quantidadeNavios, EstatisticasJogo* stats);
+typedef struct {
+    uint64_t parte[2];      // parte[0] = células 0-63, parte[1] = células 64-127
+} Bitboard;
 
+/**
+ * Tabuleiro representado por planos de bits
+ * Substitui a matriz de inteiros nas operações internas: os quatro estados
+ * da matriz são derivados da combinação dos três planos
+ */
+typedef struct {
+    Bitboard navios;        // Células ocupadas por navios
+    Bitboard acertos;       // Células de navio já atingidas
+    Bitboard erros;         // Células de água já atingidas
+} TabuleiroBits;
 
-/*
- * ============================================
- * FUNÇÕES DE INICIALIZAÇÃO E CONFIGURAÇÃO
- * ============================================
+/**
+ * Habilidade compilada em máscaras alinhadas ao tabuleiro
+ * Guarda uma máscara por célula central, já recortada nas bordas, para que
+ * a aplicação da habilidade seja uma única interseção de bitboards
  */
+typedef struct {
+    char nome[MAX_NOME_HABILIDADE];
+    Bitboard mascaras[TOTAL_CELULAS];   // Área afetada indexada pelo centro do ataque
+} HabilidadeCompilada;
 
 /**
- * Inicializa o tabuleiro com todas as posições vazias
- * Otimizada para performance com loop único
- *
- * @param tabuleiro Matriz do tabuleiro a ser inicializada
- * @complexity O(n²) onde n = TAMANHO_TABULEIRO
+ * Habilidades carregadas de um arquivo de padrões, já compiladas
  */
-void inicializarTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
-    // Utiliza memset para inicialização mais eficiente
-    memset(tabuleiro, POSICAO_VAZIA, sizeof(int) * TAMANHO_TABULEIRO * TAMANHO_TABULEIRO);
-}
+typedef struct {
+    HabilidadeCompilada* habilidades;
+    int quantidade;
+    uint8_t lados[MAX_HABILIDADES_CATALOGO];    // Lado K do carimbo KxK
+    int custos[MAX_HABILIDADES_CATALOGO];       // Custo declarado no arquivo
+} CatalogoHabilidades;
 
 /**
- * Inicializa uma matriz de habilidade com zeros
- * Versão otimizada para melhor performance
- *
- * @param matriz Matriz de habilidade a ser inicializada
- * @complexity O(n²) onde n = TAMANHO_HABILIDADE
+ * Leitor de comandos sobre um descritor qualquer (terminal, arquivo, pipe ou socket)
+ * Cada read traz um lote de linhas; palavras e linhas são devolvidas como ponteiros
+ * para dentro do buffer, terminadas no lugar, válidos até a próxima leitura
  */
-void inicializarMatrizHabilidade(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
-    memset(matriz, AREA_NAO_AFETADA, sizeof(int) * TAMANHO_HABILIDADE * TAMANHO_HABILIDADE);
-}
+typedef struct {
+    int descritor;
+    char* buffer;
+    size_t capacidade;      // Um byte fica reservado para o terminador
+    size_t posicao;         // Primeiro byte ainda não consumido
+    size_t fim;             // Fim dos bytes lidos
+    int fimEntrada;         // 1 após fim de arquivo ou erro de leitura
+} LeitorComandos;
 
 /**
- * Inicializa as estatísticas do jogo
- *
- * @param stats Ponteiro para a estrutura de estatísticas
+ * Um ataque de um lote: habilidade e célula central (linha * TAMANHO_TABULEIRO + coluna)
  */
-void inicializarEstatisticas(EstatisticasJogo* stats) {
-    stats->naviosDestruidos = 0;
-    stats->totalTiros = 0;
-    stats->acertos = 0;
-    stats->erros = 0;
-}
+typedef struct {
+    uint8_t habilidade;
+    uint8_t centro;
+} AtaqueLote;
 
-/*
- * ============================================
- * FUNÇÕES DE VALIDAÇÃO E VERIFICAÇÃO
- * ============================================
+/**
+ * Resultado compactado de um ataque em lote: células que passaram a acerto ou a água
  */
+typedef struct {
+    Bitboard acertos;
+    Bitboard erros;
+} ResultadoAtaqueLote;
 
 /**
- * Verifica se uma coordenada está dentro dos limites do tabuleiro
- * Função auxiliar para evitar acessos inválidos à matriz
- *
- * @param linha Linha a ser verificada
- * @param coluna Coluna a ser verificada
- * @return 1 se válida, 0 caso contrário
+ * Lote de tabuleiros em estrutura de arrays (SoA) para resolver um disparo em muitos de uma vez
+ * Cada campo é um array contíguo com uma faixa por tabuleiro, alinhado para
+ * cargas vetoriais; a parte p do plano do tabuleiro b fica em plano[p][b]
  */
-static inline int coordenadaValida(int linha, int coluna) {
-    return (linha >= 0 && linha < TAMANHO_TABULEIRO &&
-            coluna >= 0 && coluna < TAMANHO_TABULEIRO);
-}
+typedef struct {
+    int capacidade;                     // Múltiplo de FAIXAS_LOTE_SOA
+    int quantidade;                     // Faixas carregadas
+    uint64_t* navios[2];
+    uint64_t* acertos[2];
+    uint64_t* erros[2];
+    uint64_t* mascaras[MAX_NAVIOS][2];  // Células de cada navio
+    uint64_t* afundados;                // Bit n = navio n afundado (ausentes entram afundados)
+    int32_t* tiros;                     // Tiros disparados desde o carregamento
+    int32_t* turnos;
+    void* bloco;                        // Alocação única de todos os arrays
+} LoteTabuleirosSoA;
 
 /**
- * Verifica se uma posição específica está disponível para posicionamento
- *
- * @param tabuleiro Matriz do tabuleiro
- * @param linha Linha a ser verificada
- * @param coluna Coluna a ser verificada
- * @return 1 se disponível, 0 caso contrário
+ * Jogada registrada no diário: só o que mudou no estado
  */
-static inline int posicaoDisponivel(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
-                                   int linha, int coluna) {
-    return coordenadaValida(linha, coluna) && tabuleiro[linha][coluna] == POSICAO_VAZIA;
-}
+typedef struct {
+    Bitboard acertos;           // Células que passaram a acerto
+    Bitboard erros;             // Células que passaram a água
+    uint8_t habilidade;
+    uint8_t centro;
+    uint8_t tiros;              // Células da área (contam nas estatísticas mesmo se repetidas)
+    uint8_t acertosNovos;
+    uint8_t afundados;          // Bit i = navio i afundado por esta jogada
+    uint8_t partesAtingidas[MAX_NAVIOS];    // Partes de cada navio atingidas por esta jogada
+    uint64_t hash;              // XOR aplicado ao hash Zobrist do estado
+} JogadaDiario;
 
-/*
- * ============================================
- * FUNÇÕES DE POSICIONAMENTO DE NAVIOS
- * ============================================
+/**
+ * Diário de jogadas com desfazer/refazer
+ * As jogadas [0, quantidade) estão aplicadas; [quantidade, topo) podem ser refeitas
  */
+typedef struct {
+    JogadaDiario jogadas[MAX_TURNOS];
+    int quantidade;
+    int topo;
+} DiarioJogadas;
 
 /**
- * Calcula a próxima coordenada baseada na orientação do navio
- * Função auxiliar para simplificar o posicionamento
- *
- * @param coord Coordenada atual (será modificada)
- * @param orientacao Orientação do navio
+ * Chaves Zobrist: uma por célula em cada estado visível e uma por navio afundado
+ * O hash de um estado é o XOR das chaves do que o atacante já observou
  */
-static void proximaCoordenada(Coordenada* coord, char orientacao) {
-    switch (orientacao) {
-        case 'H': // Horizontal - move para direita
-            coord->coluna++;
-            break;
-        case 'V': // Vertical - move para baixo
-            coord->linha++;
-            break;
-        case 'D': // Diagonal - move diagonal inferior direita
-            coord->linha++;
-            coord->coluna++;
-            break;
-        default:
-            // Orientação inválida - não move
-            break;
-    }
-}
+typedef struct {
+    uint64_t acerto[TOTAL_CELULAS];
+    uint64_t erro[TOTAL_CELULAS];
+    uint64_t afundado[MAX_NAVIOS];
+} ChavesZobrist;
 
 /**
- * Posiciona um navio no tabuleiro com validação completa
- * Versão otimizada com melhor tratamento de erros
- *
- * @param tabuleiro Matriz do tabuleiro
- * @param navio Estrutura contendo dados do navio
- * @return SUCESSO se bem-sucedido, código de erro caso contrário
+ * Entrada da tabela de transposição sem travas
+ * verificacao guarda chave ^ dados: uma leitura que mistura duas escritas
+ * concorrentes não confere e é tratada como ausência
  */
-int posicionarNavio(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navio) {
-    Coordenada coord = navio.inicio;
-    Coordenada coordenadas[navio.tamanho]; // Armazena coordenadas para rollback se necessário
+typedef struct {
+    _Atomic uint64_t verificacao;
+    _Atomic uint64_t dados;
+} EntradaTransposicao;
 
-    // Primeira passada: verifica se todas as posições estão disponíveis
-    for (int i = 0; i < navio.tamanho; i++) {
-        if (!posicaoDisponivel(tabuleiro, coord.linha, coord.coluna)) {
-            if (!coordenadaValida(coord.linha, coord.coluna)) {
-                return ERRO_FORA_LIMITES;
-            } else {
-                return ERRO_POSICAO_OCUPADA;
-            }
-        }
+/**
+ * Tabela de transposição de tamanho fixo (potência de 2), indexada pelos bits baixos do hash
+ * Cada entrada é substituída pela escrita mais recente
+ */
+typedef struct {
+    EntradaTransposicao* entradas;
+    uint64_t mascara;               // Quantidade de entradas - 1
+} TabelaTransposicao;
 
-        coordenadas[i] = coord;
-        proximaCoordenada(&coord, navio.orientacao);
-    }
+/**
+ * Contadores de uso da tabela, mantidos por quem consulta (sem disputa entre threads)
+ */
+typedef struct {
+    long long consultas;
+    long long acertos;
+    long long gravacoes;
+} EstatisticasTransposicao;
 
-    // Segunda passada: posiciona o navio (todas as posições já foram validadas)
-    for (int i = 0; i < navio.tamanho; i++) {
-        tabuleiro[coordenadas[i].linha][coordenadas[i].coluna] = POSICAO_NAVIO;
-    }
+/**
+ * Receptor de eventos do jogo
+ * Separa o relato (console, registro, espectadores) da lógica de combate;
+ * qualquer callback pode ser NULL e o receptor inteiro pode ser omitido
+ */
+typedef struct {
+    void (*inicioAtaque)(void* contexto, const char* nomeHabilidade, int centroLinha, int centroColuna);
+    void (*celulaAtingida)(void* contexto, int linha, int coluna, int resultado);
+    void (*navioDestruido)(void* contexto, const Navio* navio);
+    void (*fimAtaque)(void* contexto, int tiros, int acertos);
+    void* contexto;
+} ReceptorEventos;
 
-    return SUCESSO;
-}
+/**
+ * Estado completo de uma partida no núcleo headless
+ * Tudo fica em memória; nenhuma operação sobre o estado faz E/S
+ */
+typedef struct {
+    TabuleiroBits tabuleiro;
+    Navio navios[MAX_NAVIOS];
+    Bitboard mascarasNavios[MAX_NAVIOS];    // Células de cada navio, calculadas no posicionamento
+    uint8_t navioNaCelula[TOTAL_CELULAS];   // Índice do navio dono de cada célula (válido só nas células de navio)
+    int quantidadeNavios;
+    int naviosRestantes;
+    int turno;
+    EstatisticasJogo stats;
+    uint64_t hash;                          // Zobrist de acertos, erros e navios afundados
+} EstadoJogo;
 
-/*
- * ============================================
- * FUNÇÕES DE EXIBIÇÃO E INTERFACE
- * ============================================
+/**
+ * Gerador de números pseudoaleatórios (xoshiro256**)
+ * Cada simulação usa sua própria instância, sem estado global
  */
+typedef struct {
+    uint64_t s[4];
+} GeradorAleatorio;
 
 /**
- * Converte índice de coluna para letra (0->A, 1->B, ..., 9->J)
- *
- * @param coluna Índice da coluna (0-9)
- * @return Caractere correspondente (A-J)
+ * Estratégia plugável de posicionamento da frota
+ * Deve posicionar todos os navios da frota padrão no estado recebido
  */
-char colunaParaLetra(int coluna) {
-    return 'A' + coluna;
-}
+typedef struct {
+    const char* nome;
+    int (*posicionarFrota)(void* contexto, EstadoJogo* estado, GeradorAleatorio* gerador);
+    void* contexto;
+} EstrategiaPosicionamento;
 
 /**
- * Converte letra para índice de coluna (A->0, B->1, ..., J->9)
- *
- * @param letra Letra da coluna (A-J ou a-j)
- * @return Índice correspondente (0-9) ou -1 se inválida
+ * Estratégia plugável de ataque
+ * Escolhe a habilidade (índice no array de habilidades) e o centro do próximo ataque.
+ * Estratégias com estado entre turnos informam tamanhoContextoPrivado: o
+ * contexto é então copiado para cada thread que jogar partidas em paralelo
  */
-int letraParaColuna(char letra) {
-    if (letra >= 'A' && letra <= 'J') {
-        return letra - 'A';
-    }
-    if (letra >= 'a' && letra <= 'j') {
-        return letra - 'a';
-    }
-    return -1; // Letra inválida
-}
+typedef struct {
+    const char* nome;
+    void (*escolherAtaque)(void* contexto, const EstadoJogo* estado, GeradorAleatorio* gerador,
+                           int* habilidade, Coordenada* centro);
+    void* contexto;
+    size_t tamanhoContextoPrivado;  // 0 = contexto somente leitura, compartilhado entre threads
+} EstrategiaAtaque;
 
 /**
- * ---> FUNÇÃO MODIFICADA
- * Exibe o tabuleiro completo com formatação alinhada e legível.
- *
- * @param tabuleiro Matriz do tabuleiro a ser exibida
+ * Todos os posicionamentos válidos de um navio de determinado tamanho
+ * Pré-calculados uma vez com as mesmas regras de posicionarNavio
  */
-void exibirTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
-    printf("\n╔══════════════════════════════════════╗\n");
-    printf("║      TABULEIRO DE BATALHA NAVAL      ║\n");
-    printf("╚══════════════════════════════════════╝\n");
+typedef struct {
+    int quantidade;
+    Bitboard mascaras[MAX_POSICIONAMENTOS];
+    Coordenada inicios[MAX_POSICIONAMENTOS];
+    char orientacoes[MAX_POSICIONAMENTOS];
+    uint8_t quantidadePorCelula[TOTAL_CELULAS];     // Posicionamentos que cobrem cada célula
+    uint16_t porCelula[TOTAL_CELULAS][MAX_POSICIONAMENTOS_POR_CELULA];
+} PosicionamentosNavio;
 
-    // Cabeçalho das colunas (A-J), com 4 espaços de padding para alinhar com as linhas
-    printf("    ");
-    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
-        printf(" %c ", colunaParaLetra(j)); // Célula com 3 caracteres de largura
-    }
-    printf("\n");
+/**
+ * Mapa de densidade de probabilidade da frota adversária
+ * Para cada classe de navio (tamanho distinto), cada posicionamento ainda
+ * compatível com os disparos tem um peso; calor soma os pesos por célula e
+ * mapa combina as classes pela quantidade de navios vivos de cada uma.
+ * Todas as somas são mantidas incrementalmente a cada célula revelada
+ */
+typedef struct {
+    int quantidadeClasses;
+    int tamanhos[MAX_NAVIOS];                       // Tamanho de cada classe
+    int vivos[MAX_NAVIOS];                          // Navios ainda não afundados da classe
+    uint8_t peso[MAX_NAVIOS][MAX_POSICIONAMENTOS];  // 0 = descartado; 1 + PESO_ACERTO por acerto coberto
+    int32_t calor[MAX_NAVIOS][TOTAL_CELULAS];
+    int32_t mapa[TOTAL_CELULAS];
+    Bitboard acertosVistos;
+    Bitboard errosVistos;
+    int naviosAfundadosVistos;                      // Bit i = navio i já contabilizado como afundado
+} MapaProbabilidade;
 
-    // Borda superior, com 3 espaços de padding
-    printf("   ┌");
-    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
-        printf("───"); // 3 traços por célula
-    }
-    printf("┐\n");
+/**
+ * Contexto da estratégia de ataque por densidade de probabilidade
+ */
+typedef struct {
+    const HabilidadeCompilada* habilidades;
+    int quantidadeHabilidades;
+    uint32_t padroes[MAX_HABILIDADES];  // Padrão 5x5 de cada habilidade (bit = linha * 5 + coluna)
+    MapaProbabilidade mapa;
+} ContextoAtaqueDensidade;
 
-    // Linhas do tabuleiro (0-9)
-    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
-        printf(" %d │", i); // Cabeçalho da linha com 4 caracteres de largura
-        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
-            printf(" %d ", tabuleiro[i][j]); // Célula de dados com 3 caracteres
-        }
-        printf("│\n"); // Borda direita da linha
-    }
+typedef struct PoolTrabalho PoolTrabalho;
 
-    // Borda inferior
-    printf("   └");
-    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
-        printf("───"); // 3 traços por célula
-    }
-    printf("┘\n");
+/**
+ * Tarefa do pool de trabalho; pode submeter novas tarefas (inclusive a si mesma)
+ */
+typedef struct {
+    void (*executar)(void* argumento, PoolTrabalho* pool, int trabalhador);
+    void* argumento;
+} TarefaTrabalho;
 
-    printf("\n📋 Legenda:\n");
-    printf("   0 = Água (vazio)    3 = Navio\n");
-    printf("   1 = Água atingida   2 = Navio atingido\n");
-    printf("   Colunas: A-J  |  Linhas: 0-9\n");
-}
+/**
+ * Fila de tarefas de um trabalhador
+ * O dono retira do fim (LIFO, dados quentes no cache) e os ladrões retiram do início
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) pthread_mutex_t trava;
+    unsigned inicio;
+    unsigned fim;
+    TarefaTrabalho tarefas[CAPACIDADE_FILA_TRABALHO];
+} FilaTrabalho;
 
+/**
+ * Pool de threads persistente com roubo de tarefas
+ */
+struct PoolTrabalho {
+    FilaTrabalho* filas;            // Uma fila por trabalhador
+    pthread_t* threads;
+    int quantidadeThreads;
+    atomic_int naFila;              // Tarefas enfileiradas e ainda não retiradas
+    atomic_int pendentes;           // Tarefas enfileiradas ou em execução
+    atomic_uint proximaFila;        // Distribuição das submissões externas
+    atomic_llong executadas;
+    atomic_llong roubos;
+    int encerrar;
+    pthread_mutex_t trava;
+    pthread_cond_t haTrabalho;
+    pthread_cond_t concluido;
+};
 
 /**
- * Exibe as coordenadas dos navios posicionados de forma organizada
- * Com sistema de coordenadas A-J e 0-9
- *
- * @param tabuleiro Matriz do tabuleiro
+ * Nó da árvore de busca: estatísticas acumuladas e filhos por ação candidata
  */
-void exibirCoordenadosNavios(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
-    printf("\n╔══════════════════════════════════════╗\n");
-    printf("║       COORDENADAS DOS NAVIOS         ║\n");
-    printf("╚══════════════════════════════════════╝\n");
+typedef struct {
+    int16_t filhos[MAX_CANDIDATOS_PLANEJADOR];  // -1 = ação ainda não expandida
+    int32_t visitas;
+    float recompensa;                           // Soma das recompensas normalizadas
+} NoPlanejador;
 
-    int contador = 0;
-    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
-        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
-            if (tabuleiro[i][j] == POSICAO_NAVIO) {
-                printf("🚢 Posição do navio: %c%d\n", colunaParaLetra(j), i);
-                contador++;
-            }
-        }
-    }
-    printf("\n📊 Total de posições ocupadas por navios: %d\n", contador);
-}
+struct ContextoPlanejador;
 
-/*
- * ============================================
- * SISTEMA DE HABILIDADES ESPECIAIS
- * ============================================
+/**
+ * Árvore de busca de uma tarefa, com a determinização e o diário de trabalho
  */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) NoPlanejador nos[MAX_NOS_ARVORE];   // Uma árvore por thread: sem linhas compartilhadas
+    int quantidadeNos;
+    long long iteracoes;
+    long long falhas;               // Determinizações que não cobriram todos os acertos
+    EstadoJogo estado;              // Frota oculta sorteada a cada iteração
+    DiarioJogadas diario;
+    GeradorAleatorio gerador;
+    struct ContextoPlanejador* planejador;
+} ArvorePlanejador;
 
 /**
- * Cria o padrão de habilidade em cone (pirâmide invertida)
- * Otimizada para melhor performance e legibilidade
- *
- * @param matriz Matriz onde será criado o padrão
+ * Configuração do planejador escolhida na linha de comando
  */
-void criarHabilidadeCone(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
-    inicializarMatrizHabilidade(matriz);
+typedef struct {
+    int threads;                    // 0 = um por núcleo
+    int orcamentoMs;                // Tempo por decisão
+} ConfiguracaoPlanejador;
 
-    // Define o padrão cone usando coordenadas específicas
-    int padrao[][2] = {
-        {0, 2},           // Linha 0: centro
-        {1, 1}, {1, 2}, {1, 3},  // Linha 1: 3 posições
-        {2, 0}, {2, 1}, {2, 2}, {2, 3}, {2, 4}  // Linha 2: linha completa
-    };
+/**
+ * Contexto do planejador MCTS
+ * Os campos da decisão corrente são escritos antes de submeter as tarefas
+ * e somente lidos pelos trabalhadores
+ */
+typedef struct ContextoPlanejador {
+    ContextoAtaqueDensidade densidade;  // Mapa de probabilidade, que também guia os sorteios
+    PoolTrabalho* pool;
+    ArvorePlanejador* arvores;
+    int quantidadeArvores;
+    double orcamento;                   // Segundos por decisão
+    double prazo;                       // Fim da decisão corrente (tempoAtual)
 
-    int totalPosicoes = sizeof(padrao) / (sizeof(int) * 2);
+    AtaqueLote candidatos[MAX_CANDIDATOS_PLANEJADOR];
+    int quantidadeCandidatos;
+    EstadoJogo observado;               // Só o que o atacante vê: disparos e navios afundados
+    Bitboard acertosPendentes;          // Acertos que a frota sorteada precisa cobrir
+    int classeNavio[MAX_NAVIOS];        // Classe do mapa de cada navio ainda vivo, -1 se afundado
+    uint32_t acumulado[MAX_NAVIOS][MAX_POSICIONAMENTOS];    // Pesos acumulados por classe
+    float recompensaMaxima;
+    TabelaTransposicao transposicao;    // Hash do estado observado → ação já decidida
+    EstatisticasTransposicao statsTransposicao;
+
+    long long decisoes;
+    long long iteracoes;
+    long long falhasDeterminizacao;
+} ContextoPlanejador;
+
+/**
+ * Entrada do mapa esparso célula → navio do tabuleiro dinâmico
+ */
+typedef struct {
+    uint32_t celula;        // Índice da célula + 1 (0 = entrada livre)
+    uint32_t navio;         // Índice do navio em navios
+} EntradaMapaNavios;
+
+/**
+ * Tabuleiro com dimensões definidas em tempo de execução
+ * Cabeçalho, navios, mapa célula → navio e células ficam em uma única alocação contígua.
+ * Cada célula usa 2 bits com os mesmos valores da matriz (POSICAO_*); o mapa guarda
+ * só as células de navios, em endereçamento aberto com ocupação de no máximo 50%
+ */
+typedef struct {
+    int linhas;
+    int colunas;
+    int capacidadeNavios;
+    int quantidadeNavios;
+    int naviosRestantes;
+    int capacidadeCelulas;          // Máximo de células somadas de todos os navios
+    int celulasNavios;              // Células já ocupadas por navios
+    int bitsMapa;                   // O mapa tem 2^bitsMapa entradas
+    Navio* navios;                  // Aponta para dentro do próprio bloco
+    EntradaMapaNavios* mapaNavios;  // Também dentro do bloco
+    uint8_t* celulas;               // 4 células por byte, também dentro do bloco
+} TabuleiroDinamico;
+
+/**
+ * Arena de uma partida: alocações por avanço de ponteiro, liberadas todas de uma vez
+ */
+typedef struct {
+    uint8_t* base;
+    size_t capacidade;
+    size_t usado;
+} ArenaPartida;
+
+/**
+ * Contadores do pool de partidas
+ */
+typedef struct {
+    long long aquisicoes;
+    long long liberacoes;
+    long long esgotamentos;     // Aquisições recusadas por falta de objetos livres
+    long long falhasArena;      // Alocações recusadas por falta de espaço na arena
+    int emUso;
+    int picoEmUso;
+    size_t picoArena;           // Maior uso de arena observado em uma partida
+} EstatisticasPool;
+
+/**
+ * Pool de objetos de partida de tamanho fixo
+ * Todos os objetos ficam em um único bloco; cada um é uma arena alinhada à linha de cache
+ */
+typedef struct {
+    uint8_t* memoria;
+    ArenaPartida* arenas;
+    int* proximoLivre;
+    int capacidade;
+    int livre;                  // Primeiro objeto livre, -1 se esgotado
+    size_t bytesPorPartida;
+    EstatisticasPool stats;
+} PoolPartidas;
+
+/**
+ * Buffer de um quadro completo de saída
+ * Preenchido pelas funções renderizar* e emitido com uma única chamada write
+ */
+typedef struct {
+    size_t tamanho;
+    char dados[CAPACIDADE_QUADRO];
+} BufferQuadro;
+
+/**
+ * Renderizador diferencial do tabuleiro 10x10
+ * Guarda o último quadro desenhado para redesenhar apenas as células alteradas
+ */
+typedef struct {
+    int anterior[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    int valido;             // 0 = o próximo quadro precisa ser desenhado por inteiro
+} RenderizadorDiferencial;
+
+/**
+ * Gravador de registros de partidas
+ * Acumula as partidas em um bloco fixo e grava cada bloco completo com um
+ * único write; nenhuma alocação acontece depois de aberto
+ */
+typedef struct {
+    int descritor;
+    int erro;                       // 1 se alguma escrita falhou
+    size_t tamanho;                 // Bytes usados da carga útil do bloco
+    size_t inicioPartida;           // Início da partida em andamento dentro do bloco
+    uint32_t partidasNoBloco;       // Partidas completas no bloco
+    uint64_t partidasGravadas;      // Partidas em blocos já escritos com sucesso
+    uint64_t bytesGravados;         // Bytes efetivamente escritos (cabeçalho e blocos completos)
+    uint8_t bloco[TAMANHO_CABECALHO_BLOCO + TAMANHO_BLOCO_REGISTRO];
+} GravadorRegistro;
+
+/**
+ * Leitor de registros sobre um arquivo mapeado em memória
+ * Decodifica direto do mapeamento, sem copiar as partidas para o heap
+ */
+typedef struct {
+    const uint8_t* dados;
+    size_t tamanho;
+    size_t proximoBloco;            // Deslocamento do próximo cabeçalho de bloco
+    const uint8_t* cursor;          // Posição de leitura no bloco atual
+    const uint8_t* fimBloco;
+    uint32_t partidasRestantes;     // Partidas ainda não iniciadas no bloco atual
+    int partidaAberta;              // 1 enquanto houver ataques da partida atual a ler
+    int validarBlocos;              // 1 = confere o CRC de cada bloco ao entrar nele
+} LeitorRegistro;
+
+/**
+ * Frota de uma partida lida do registro
+ */
+typedef struct {
+    int quantidadeNavios;
+    Navio navios[MAX_NAVIOS];
+} PartidaRegistrada;
+
+/**
+ * Ataque de uma partida lida do registro e o resultado gravado
+ */
+typedef struct {
+    int habilidade;                 // Índice em criarHabilidadesPadrao
+    Coordenada centro;
+    int acertos;                    // Novos acertos do ataque
+    int afundados;                  // Bit i = navio i afundado por este ataque
+} AtaqueRegistrado;
+
+/**
+ * Composição de frota para o tabuleiro dinâmico
+ */
+typedef struct {
+    int quantidade;
+    int tamanhos[MAX_NAVIOS_DINAMICOS];
+} ConfiguracaoFrota;
+
+/**
+ * Totais acumulados de um lote de partidas simuladas
+ * Contadores de 64 bits para suportar milhões de partidas
+ */
+typedef struct {
+    long long partidas;
+    long long partidasVencidas;     // Frota inteira destruída antes de MAX_TURNOS
+    long long turnos;
+    long long totalTiros;
+    long long acertos;
+    long long erros;
+    long long naviosDestruidos;
+} EstatisticasSimulacao;
+
+_Static_assert(TOTAL_CELULAS <= 128, "O tabuleiro precisa caber em um Bitboard de 128 bits");
+_Static_assert(TAMANHO_HABILIDADE <= 10, "Os glifos pré-formatados cobrem índices de um dígito");
+_Static_assert(MAX_LADO_PADRAO <= 32, "Cada linha de um carimbo precisa caber em 32 bits");
+_Static_assert(TAMANHO_HABILIDADE - 1 + 16 <= LARGURA_GRADE_CONVOLUCAO && TAMANHO_TABULEIRO <= 16,
+               "A grade da convolução precisa comportar as leituras vetoriais de 16 colunas");
+
+/*
+ * ============================================
+ * DECLARAÇÃO DE FUNÇÕES (PROTÓTIPOS)
+ * ============================================
+ */
+static void proximaCoordenada(Coordenada* coord, char orientacao);
+static inline int coordenadaValida(int linha, int coluna);
+void limparLoteTabuleirosSoA(LoteTabuleirosSoA* lote);
+int lerProximoAtaque(LeitorRegistro* leitor, AtaqueRegistrado* ataque);
+EstrategiaAtaque criarAtaqueDensidade(ContextoAtaqueDensidade* contexto, const HabilidadeCompilada habilidades[],
+                                      int quantidadeHabilidades);
+int criarPlanejador(ContextoPlanejador* planejador, const HabilidadeCompilada habilidades[],
+                    int quantidadeHabilidades, const ConfiguracaoPlanejador* configuracao);
+void destruirPlanejador(ContextoPlanejador* planejador);
+EstrategiaAtaque criarAtaquePlanejador(ContextoPlanejador* planejador);
+void exibirEstatisticasPlanejador(const ContextoPlanejador* planejador);
+void verificarNaviosDestruidos(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navios[], int quantidadeNavios,
+                               EstatisticasJogo* stats, const ReceptorEventos* receptor);
+
+/*
+ * Emissão de eventos: desaparece por completo quando BATALHA_EVENTOS = 0
+ */
+#if BATALHA_EVENTOS
+#define EMITIR_EVENTO(receptor, evento, ...)                              \
+    do {                                                                  \
+        if ((receptor) != NULL && (receptor)->evento != NULL) {           \
+            (receptor)->evento((receptor)->contexto, __VA_ARGS__);        \
+        }                                                                 \
+    } while (0)
+#else
+// Mantém a checagem de tipos dos argumentos, mas nenhum código é gerado
+#define EMITIR_EVENTO(receptor, evento, ...)                              \
+    do {                                                                  \
+        if (0) {                                                          \
+            (receptor)->evento((receptor)->contexto, __VA_ARGS__);        \
+        }                                                                 \
+    } while (0)
+#endif
+
+// Frota padrão: Battleship, Cruiser, Cruiser, Destroyer
+static const int TAMANHOS_NAVIOS[MAX_NAVIOS] = {4, 3, 3, 2};
+static const char* const NOMES_NAVIOS[MAX_NAVIOS] = {"Battleship", "Cruiser 1", "Cruiser 2", "Destroyer"};
+
+/*
+ * ============================================
+ * INSTRUMENTAÇÃO DO CAMINHO CRÍTICO
+ * ============================================
+ */
+
+/**
+ * Lê o contador de ciclos do processador (TSC no x86)
+ *
+ * @return Ciclos de referência, ou 0 se não houver contador disponível
+ */
+static inline uint64_t lerCiclos(void) {
+#if CONTADOR_CICLOS_DISPONIVEL
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Fases medidas; cada medidor é inclusivo (uma fase pode conter outra)
+ */
+enum {
+    FASE_POSICIONAMENTO,
+    FASE_DISPARO,
+    FASE_AFUNDAMENTO,
+    FASE_DECISAO,
+    FASE_RENDERIZACAO,
+    FASE_ES,
+    QUANTIDADE_FASES
+};
+
+/*
+ * Baldes no estilo HDR, compartilhados pela instrumentação e pelas métricas do servidor:
+ * exatos até 2^(BITS_SUBBALDE_FASE+1) e, acima disso, 2^BITS_SUBBALDE_FASE sub-baldes
+ * lineares por potência de 2
+ */
+static inline int baldeHistogramaFase(uint64_t valor) {
+    if (valor < (2ULL << BITS_SUBBALDE_FASE)) {
+        return (int)valor;
+    }
+    int expoente = 63 - __builtin_clzll(valor);
+    if (expoente > MAX_EXPOENTE_FASE) {
+        return BALDES_HISTOGRAMA_FASE - 1;
+    }
+    int escala = expoente - BITS_SUBBALDE_FASE;
+    return (escala << BITS_SUBBALDE_FASE) + (int)(valor >> escala);
+}
+
+/**
+ * Menor valor que cai no balde (inverso de baldeHistogramaFase)
+ */
+static uint64_t limiteBaldeFase(int balde) {
+    if (balde < (2 << BITS_SUBBALDE_FASE)) {
+        return (uint64_t)balde;
+    }
+    int escala = (balde >> BITS_SUBBALDE_FASE) - 1;
+    uint64_t sub = (uint64_t)(balde & ((1 << BITS_SUBBALDE_FASE) - 1)) | (1ULL << BITS_SUBBALDE_FASE);
+    return sub << escala;
+}
+
+/**
+ * Percentil de um histograma de baldes (limite inferior do balde que o contém)
+ *
+ * @param baldes Contagens por balde (BALDES_HISTOGRAMA_FASE entradas)
+ * @param contagem Total de amostras
+ * @param percentil Percentil desejado, de 0 a 100
+ * @return Menor valor do balde do percentil
+ */
+static uint64_t percentilHistograma(const uint64_t* baldes, uint64_t contagem, double percentil) {
+    uint64_t alvo = (uint64_t)((double)contagem * percentil / 100.0);
+    uint64_t acumulado = 0;
+    int balde = 0;
+    while (balde < BALDES_HISTOGRAMA_FASE - 1 && acumulado + baldes[balde] <= alvo) {
+        acumulado += baldes[balde++];
+    }
+    return limiteBaldeFase(balde);
+}
+
+#if BATALHA_INSTRUMENTACAO
+static const char* const NOMES_FASES[QUANTIDADE_FASES] = {
+    "posicionamento", "disparo", "afundamento", "decisão da IA", "renderização", "E/S"
+};
+
+/**
+ * Histograma de uma fase, nos baldes de baldeHistogramaFase
+ */
+typedef struct {
+    uint64_t contagem;
+    uint64_t soma;
+    uint64_t maximo;
+    uint64_t baldes[BALDES_HISTOGRAMA_FASE];
+} HistogramaFase;
+
+/**
+ * Contadores de uma thread; cada thread escreve só nos seus, sem atômicos
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) HistogramaFase fases[QUANTIDADE_FASES];
+} ContadoresThread;
+
+/**
+ * Medidor de escopo: registra a fase quando a variável sai de escopo
+ */
+typedef struct {
+    int fase;
+    uint64_t inicio;
+} MedidorFase;
+
+// Os contadores sobrevivem ao fim das threads para serem somados no relatório
+static ContadoresThread contadoresInstrumentacao[MAX_THREADS];
+static atomic_int threadsInstrumentadas;
+static atomic_llong medicoesDescartadas;    // Threads além de MAX_THREADS
+static _Thread_local ContadoresThread* contadoresDaThread;
+static _Thread_local int threadSemContadores;
+
+/**
+ * Relógio das fases: TSC quando disponível, senão nanossegundos monotônicos
+ */
+static inline uint64_t lerRelogioFase(void) {
+#if CONTADOR_CICLOS_DISPONIVEL
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * Registra uma medição nos contadores da thread corrente
+ */
+static void registrarFase(int fase, uint64_t ciclos) {
+    if (contadoresDaThread == NULL) {
+        if (threadSemContadores) {
+            atomic_fetch_add_explicit(&medicoesDescartadas, 1, memory_order_relaxed);
+            return;
+        }
+        int indice = atomic_fetch_add(&threadsInstrumentadas, 1);
+        if (indice >= MAX_THREADS) {
+            threadSemContadores = 1;
+            atomic_fetch_add_explicit(&medicoesDescartadas, 1, memory_order_relaxed);
+            return;
+        }
+        contadoresDaThread = &contadoresInstrumentacao[indice];
+    }
+    HistogramaFase* histograma = &contadoresDaThread->fases[fase];
+    histograma->contagem++;
+    histograma->soma += ciclos;
+    histograma->maximo = ciclos > histograma->maximo ? ciclos : histograma->maximo;
+    histograma->baldes[baldeHistogramaFase(ciclos)]++;
+}
+
+static inline void encerrarMedidorFase(MedidorFase* medidor) {
+    registrarFase(medidor->fase, lerRelogioFase() - medidor->inicio);
+}
+
+#define CONCATENAR_NOME(a, b) a##b
+#define NOME_MEDIDOR(linha) CONCATENAR_NOME(medidorFase, linha)
+// Mede do ponto da declaração até o fim do bloco, inclusive em returns antecipados
+#define MEDIR_FASE(fase) \
+    MedidorFase NOME_MEDIDOR(__LINE__) __attribute__((cleanup(encerrarMedidorFase))) = {(fase), lerRelogioFase()}
+
+/**
+ * Estima o relógio das fases em ciclos por nanossegundo, com uma janela curta
+ */
+static double estimarCiclosPorNs(void) {
+#if CONTADOR_CICLOS_DISPONIVEL
+    struct timespec inicio, agora;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    uint64_t ciclosInicio = lerRelogioFase();
+    double decorrido;
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &agora);
+        decorrido = (double)(agora.tv_sec - inicio.tv_sec) * 1e9 + (double)(agora.tv_nsec - inicio.tv_nsec);
+    } while (decorrido < 2e6);
+    return (double)(lerRelogioFase() - ciclosInicio) / decorrido;
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * Exibe no stderr os histogramas somados de todas as threads (registrada com atexit)
+ * Chamada quando as threads de trabalho já terminaram
+ */
+static void exibirInstrumentacao(void) {
+    static HistogramaFase total[QUANTIDADE_FASES];
+    int threads = atomic_load(&threadsInstrumentadas);
+    threads = threads > MAX_THREADS ? MAX_THREADS : threads;
+    memset(total, 0, sizeof(total));
+    for (int t = 0; t < threads; t++) {
+        for (int f = 0; f < QUANTIDADE_FASES; f++) {
+            const HistogramaFase* origem = &contadoresInstrumentacao[t].fases[f];
+            total[f].contagem += origem->contagem;
+            total[f].soma += origem->soma;
+            total[f].maximo = origem->maximo > total[f].maximo ? origem->maximo : total[f].maximo;
+            for (int b = 0; b < BALDES_HISTOGRAMA_FASE; b++) {
+                total[f].baldes[b] += origem->baldes[b];
+            }
+        }
+    }
+
+    static const double percentis[] = {50.0, 90.0, 99.0, 99.9};
+    double ciclosPorNs = estimarCiclosPorNs();
+    fprintf(stderr, "\n⏱️  Instrumentação (%d threads, %.2f ciclos/ns, ns):\n", threads, ciclosPorNs);
+    fprintf(stderr, "%-16s %12s %10s %10s %10s %10s %10s %12s\n",
+            "Fase", "Medições", "Média", "p50", "p90", "p99", "p99.9", "Máximo");
+    for (int f = 0; f < QUANTIDADE_FASES; f++) {
+        const HistogramaFase* h = &total[f];
+        if (h->contagem == 0) {
+            continue;
+        }
+        fprintf(stderr, "%-16s %12llu %10.1f", NOMES_FASES[f], (unsigned long long)h->contagem,
+                (double)h->soma / (double)h->contagem / ciclosPorNs);
+        for (size_t p = 0; p < sizeof(percentis) / sizeof(percentis[0]); p++) {
+            fprintf(stderr, " %10.1f", (double)percentilHistograma(h->baldes, h->contagem, percentis[p]) / ciclosPorNs);
+        }
+        fprintf(stderr, " %12.1f\n", (double)h->maximo / ciclosPorNs);
+    }
+    long long descartadas = atomic_load(&medicoesDescartadas);
+    if (descartadas > 0) {
+        fprintf(stderr, "   Medições descartadas (threads além de %d): %lld\n", MAX_THREADS, descartadas);
+    }
+}
+#else
+// Sem instrumentação o medidor não gera código nem variável
+#define MEDIR_FASE(fase) ((void)0)
+#endif
+
+
+/*
+ * ============================================
+ * FUNÇÕES DE INICIALIZAÇÃO E CONFIGURAÇÃO
+ * ============================================
+ */
+
+/**
+ * Inicializa o tabuleiro com todas as posições vazias
+ * Otimizada para performance com loop único
+ *
+ * @param tabuleiro Matriz do tabuleiro a ser inicializada
+ * @complexity O(n²) onde n = TAMANHO_TABULEIRO
+ */
+void inicializarTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    // Utiliza memset para inicialização mais eficiente
+    memset(tabuleiro, POSICAO_VAZIA, sizeof(int) * TAMANHO_TABULEIRO * TAMANHO_TABULEIRO);
+}
+
+/**
+ * Inicializa uma matriz de habilidade com zeros
+ * Versão otimizada para melhor performance
+ *
+ * @param matriz Matriz de habilidade a ser inicializada
+ * @complexity O(n²) onde n = TAMANHO_HABILIDADE
+ */
+void inicializarMatrizHabilidade(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
+    memset(matriz, AREA_NAO_AFETADA, sizeof(int) * TAMANHO_HABILIDADE * TAMANHO_HABILIDADE);
+}
+
+/**
+ * Inicializa as estatísticas do jogo
+ *
+ * @param stats Ponteiro para a estrutura de estatísticas
+ */
+void inicializarEstatisticas(EstatisticasJogo* stats) {
+    stats->naviosDestruidos = 0;
+    stats->totalTiros = 0;
+    stats->acertos = 0;
+    stats->erros = 0;
+}
+
+/**
+ * Aloca um bloco alinhado à linha de cache
+ * aligned_alloc exige um tamanho múltiplo do alinhamento; o pedido é arredondado para cima
+ *
+ * @param bytes Tamanho mínimo do bloco
+ * @return Bloco alocado (liberado com free), ou NULL se faltar memória
+ */
+static void* alocarAlinhadoCache(size_t bytes) {
+    return aligned_alloc(TAMANHO_LINHA_CACHE, (bytes + TAMANHO_LINHA_CACHE - 1) / TAMANHO_LINHA_CACHE *
+                                              TAMANHO_LINHA_CACHE);
+}
+
+/*
+ * ============================================
+ * FUNÇÕES DE VALIDAÇÃO E VERIFICAÇÃO
+ * ============================================
+ */
+
+/**
+ * Verifica se uma coordenada está dentro dos limites do tabuleiro
+ * Função auxiliar para evitar acessos inválidos à matriz
+ *
+ * @param linha Linha a ser verificada
+ * @param coluna Coluna a ser verificada
+ * @return 1 se válida, 0 caso contrário
+ */
+static inline int coordenadaValida(int linha, int coluna) {
+    return (linha >= 0 && linha < TAMANHO_TABULEIRO &&
+            coluna >= 0 && coluna < TAMANHO_TABULEIRO);
+}
+
+/*
+ * ============================================
+ * MOTOR DE BITBOARDS
+ * ============================================
+ */
+
+/**
+ * Converte uma coordenada válida para o índice do bit correspondente
+ *
+ * @param linha Linha da célula
+ * @param coluna Coluna da célula
+ * @return Índice do bit (0 a TOTAL_CELULAS - 1)
+ */
+static inline int indiceCelula(int linha, int coluna) {
+    return linha * TAMANHO_TABULEIRO + coluna;
+}
+
+/**
+ * Retorna um bitboard sem nenhuma célula marcada
+ */
+static inline Bitboard bitboardVazio(void) {
+    Bitboard b = {{0, 0}};
+    return b;
+}
+
+/**
+ * Marca o bit de uma célula no bitboard
+ *
+ * @param b Bitboard a ser modificado
+ * @param indice Índice da célula
+ */
+static inline void bitboardDefinir(Bitboard* b, int indice) {
+    b->parte[indice >> 6] |= (uint64_t)1 << (indice & 63);
+}
+
+/**
+ * Verifica se o bit de uma célula está marcado
+ *
+ * @param b Bitboard consultado
+ * @param indice Índice da célula
+ * @return 1 se marcado, 0 caso contrário
+ */
+static inline int bitboardTestar(Bitboard b, int indice) {
+    return (int)((b.parte[indice >> 6] >> (indice & 63)) & 1);
+}
+
+static inline Bitboard bitboardUniao(Bitboard a, Bitboard b) {
+    Bitboard r = {{a.parte[0] | b.parte[0], a.parte[1] | b.parte[1]}};
+    return r;
+}
+
+static inline Bitboard bitboardIntersecao(Bitboard a, Bitboard b) {
+    Bitboard r = {{a.parte[0] & b.parte[0], a.parte[1] & b.parte[1]}};
+    return r;
+}
+
+/**
+ * Células marcadas em a e não marcadas em b (a AND NOT b)
+ */
+static inline Bitboard bitboardDiferenca(Bitboard a, Bitboard b) {
+    Bitboard r = {{a.parte[0] & ~b.parte[0], a.parte[1] & ~b.parte[1]}};
+    return r;
+}
+
+static inline int bitboardVazioTeste(Bitboard b) {
+    return (b.parte[0] | b.parte[1]) == 0;
+}
+
+/**
+ * Conta as células marcadas usando popcount de hardware quando disponível
+ */
+static inline int bitboardContar(Bitboard b) {
+    return __builtin_popcountll(b.parte[0]) + __builtin_popcountll(b.parte[1]);
+}
+
+/**
+ * Remove e retorna o índice da menor célula marcada
+ * Percorre as células em ordem linha a linha, como os loops da matriz
+ *
+ * @param b Bitboard não vazio (será modificado)
+ * @return Índice da célula removida
+ */
+static inline int bitboardExtrairPrimeiro(Bitboard* b) {
+    if (b->parte[0]) {
+        int indice = __builtin_ctzll(b->parte[0]);
+        b->parte[0] &= b->parte[0] - 1;
+        return indice;
+    }
+    int indice = 64 + __builtin_ctzll(b->parte[1]);
+    b->parte[1] &= b->parte[1] - 1;
+    return indice;
+}
+
+/**
+ * Inicializa um tabuleiro de bits com todas as posições vazias
+ *
+ * @param tab Tabuleiro a ser inicializado
+ */
+void inicializarTabuleiroBits(TabuleiroBits* tab) {
+    tab->navios = bitboardVazio();
+    tab->acertos = bitboardVazio();
+    tab->erros = bitboardVazio();
+}
+
+/**
+ * Calcula a máscara de células ocupadas por um navio
+ * Percorre o navio até a primeira célula fora dos limites; a máscara
+ * parcial é preenchida mesmo em caso de erro, preservando a mesma ordem
+ * de detecção de erros da validação célula a célula
+ *
+ * @param navio Navio a ser mapeado
+ * @param mascara Ponteiro para armazenar a máscara calculada
+ * @return SUCESSO se o navio cabe no tabuleiro, ERRO_FORA_LIMITES caso contrário
+ */
+int calcularMascaraNavio(Navio navio, Bitboard* mascara) {
+    Coordenada coord = navio.inicio;
+    *mascara = bitboardVazio();
+
+    for (int i = 0; i < navio.tamanho; i++) {
+        if (!coordenadaValida(coord.linha, coord.coluna)) {
+            return ERRO_FORA_LIMITES;
+        }
+        bitboardDefinir(mascara, indiceCelula(coord.linha, coord.coluna));
+        proximaCoordenada(&coord, navio.orientacao);
+    }
+
+    return SUCESSO;
+}
+
+/**
+ * Posiciona um navio no tabuleiro de bits
+ * A sobreposição é verificada com um único AND entre a máscara do navio
+ * e as células já ocupadas
+ *
+ * @param tab Tabuleiro de bits
+ * @param navio Estrutura contendo dados do navio
+ * @return SUCESSO se bem-sucedido, código de erro caso contrário
+ */
+int posicionarNavioBits(TabuleiroBits* tab, Navio navio) {
+    Bitboard mascara;
+    int resultado = calcularMascaraNavio(navio, &mascara);
+    Bitboard ocupadas = bitboardUniao(tab->navios, tab->erros);
+
+    // Uma célula ocupada antes do ponto de saída do tabuleiro tem prioridade
+    if (!bitboardVazioTeste(bitboardIntersecao(mascara, ocupadas))) {
+        return ERRO_POSICAO_OCUPADA;
+    }
+    if (resultado != SUCESSO) {
+        return resultado;
+    }
+
+    tab->navios = bitboardUniao(tab->navios, mascara);
+    return SUCESSO;
+}
+
+/**
+ * Resolve um disparo sobre as células de uma máscara de alvo
+ * Acertos e erros novos são calculados com operações de máscara;
+ * células já atingidas não mudam de estado
+ *
+ * @param tab Tabuleiro de bits
+ * @param alvo Máscara das células atingidas pelo disparo
+ * @param novosAcertos Saída: células de navio atingidas pela primeira vez
+ * @param novosErros Saída: células de água atingidas pela primeira vez
+ * @return Quantidade de novos acertos
+ */
+int resolverDisparoBits(TabuleiroBits* tab, Bitboard alvo,
+                        Bitboard* novosAcertos, Bitboard* novosErros) {
+    *novosAcertos = bitboardDiferenca(bitboardIntersecao(alvo, tab->navios), tab->acertos);
+    *novosErros = bitboardDiferenca(bitboardDiferenca(alvo, tab->navios), tab->erros);
+
+    tab->acertos = bitboardUniao(tab->acertos, *novosAcertos);
+    tab->erros = bitboardUniao(tab->erros, *novosErros);
+
+    return bitboardContar(*novosAcertos);
+}
+
+/**
+ * Verifica se um navio teve todas as suas células atingidas
+ *
+ * @param tab Tabuleiro de bits
+ * @param navio Navio a ser verificado
+ * @return 1 se destruído, 0 caso contrário
+ */
+int navioDestruidoBits(const TabuleiroBits* tab, Navio navio) {
+    Bitboard mascara;
+    calcularMascaraNavio(navio, &mascara);
+    return bitboardContar(bitboardIntersecao(mascara, tab->acertos)) == navio.tamanho;
+}
+
+/**
+ * Converte a matriz de inteiros para a representação em bitboards
+ * Adaptador usado pela API baseada em matriz
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param tab Tabuleiro de bits de destino
+ */
+void matrizParaTabuleiroBits(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], TabuleiroBits* tab) {
+    inicializarTabuleiroBits(tab);
+
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            int indice = indiceCelula(i, j);
+            switch (tabuleiro[i][j]) {
+                case POSICAO_NAVIO:
+                    bitboardDefinir(&tab->navios, indice);
+                    break;
+                case POSICAO_ATINGIDA:
+                    bitboardDefinir(&tab->navios, indice);
+                    bitboardDefinir(&tab->acertos, indice);
+                    break;
+                case POSICAO_AGUA_ATINGIDA:
+                    bitboardDefinir(&tab->erros, indice);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * Converte o tabuleiro de bits de volta para a matriz de inteiros
+ *
+ * @param tab Tabuleiro de bits
+ * @param tabuleiro Matriz de destino
+ */
+void tabuleiroBitsParaMatriz(const TabuleiroBits* tab, int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            int indice = indiceCelula(i, j);
+            if (bitboardTestar(tab->acertos, indice)) {
+                tabuleiro[i][j] = POSICAO_ATINGIDA;
+            } else if (bitboardTestar(tab->navios, indice)) {
+                tabuleiro[i][j] = POSICAO_NAVIO;
+            } else if (bitboardTestar(tab->erros, indice)) {
+                tabuleiro[i][j] = POSICAO_AGUA_ATINGIDA;
+            } else {
+                tabuleiro[i][j] = POSICAO_VAZIA;
+            }
+        }
+    }
+}
+
+/*
+ * ============================================
+ * FUNÇÕES DE POSICIONAMENTO DE NAVIOS
+ * ============================================
+ */
+
+/**
+ * Calcula a próxima coordenada baseada na orientação do navio
+ * Função auxiliar para simplificar o posicionamento
+ *
+ * @param coord Coordenada atual (será modificada)
+ * @param orientacao Orientação do navio
+ */
+static void proximaCoordenada(Coordenada* coord, char orientacao) {
+    switch (orientacao) {
+        case 'H': // Horizontal - move para direita
+            coord->coluna++;
+            break;
+        case 'V': // Vertical - move para baixo
+            coord->linha++;
+            break;
+        case 'D': // Diagonal - move diagonal inferior direita
+            coord->linha++;
+            coord->coluna++;
+            break;
+        default:
+            // Orientação inválida - não move
+            break;
+    }
+}
+
+/**
+ * Posiciona um navio no tabuleiro com validação completa
+ * Adaptador sobre posicionarNavioBits: a validação e a sobreposição são
+ * resolvidas com máscaras e apenas as células do navio são gravadas na matriz
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param navio Estrutura contendo dados do navio
+ * @return SUCESSO se bem-sucedido, código de erro caso contrário
+ */
+int posicionarNavio(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navio) {
+    MEDIR_FASE(FASE_POSICIONAMENTO);
+    TabuleiroBits tab;
+    matrizParaTabuleiroBits(tabuleiro, &tab);
+
+    int resultado = posicionarNavioBits(&tab, navio);
+    if (resultado != SUCESSO) {
+        return resultado;
+    }
+
+    Bitboard mascara;
+    calcularMascaraNavio(navio, &mascara);
+    while (!bitboardVazioTeste(mascara)) {
+        int indice = bitboardExtrairPrimeiro(&mascara);
+        tabuleiro[indice / TAMANHO_TABULEIRO][indice % TAMANHO_TABULEIRO] = POSICAO_NAVIO;
+    }
+
+    return SUCESSO;
+}
+
+/*
+ * ============================================
+ * RENDERIZAÇÃO EM BUFFER
+ * ============================================
+ */
+
+// Glifos pré-formatados: valores das células (" %d ") e rótulos de linha (" %d │")
+static const char GLIFOS_CELULA[10][4] = {" 0 ", " 1 ", " 2 ", " 3 ", " 4 ", " 5 ", " 6 ", " 7 ", " 8 ", " 9 "};
+static const char ROTULOS_LINHA[TAMANHO_TABULEIRO][8] = {
+    " 0 │", " 1 │", " 2 │", " 3 │", " 4 │", " 5 │", " 6 │", " 7 │", " 8 │", " 9 │"
+};
+
+/**
+ * Esvazia o buffer para um novo quadro
+ *
+ * @param quadro Buffer do quadro
+ */
+static inline void quadroLimpar(BufferQuadro* quadro) {
+    quadro->tamanho = 0;
+}
+
+/**
+ * Anexa bytes ao quadro; o excedente além de CAPACIDADE_QUADRO é descartado
+ *
+ * @param quadro Buffer do quadro
+ * @param texto Bytes a anexar
+ * @param tamanho Quantidade de bytes
+ */
+static inline void quadroAnexar(BufferQuadro* quadro, const char* texto, size_t tamanho) {
+    size_t livre = CAPACIDADE_QUADRO - quadro->tamanho;
+    if (tamanho > livre) {
+        tamanho = livre;
+    }
+    memcpy(&quadro->dados[quadro->tamanho], texto, tamanho);
+    quadro->tamanho += tamanho;
+}
+
+// Literais têm o tamanho conhecido em tempo de compilação: nenhum strlen no caminho crítico
+#define QUADRO_ANEXAR_LITERAL(quadro, literal) quadroAnexar((quadro), (literal), sizeof(literal) - 1)
+
+static inline void quadroAnexarCaractere(BufferQuadro* quadro, char caractere) {
+    if (quadro->tamanho < CAPACIDADE_QUADRO) {
+        quadro->dados[quadro->tamanho++] = caractere;
+    }
+}
+
+/**
+ * Anexa um inteiro em decimal sem passar pelo printf
+ *
+ * @param quadro Buffer do quadro
+ * @param valor Valor a ser escrito
+ */
+static void quadroAnexarInteiro(BufferQuadro* quadro, int valor) {
+    char digitos[12];
+    int posicao = sizeof(digitos);
+    unsigned int magnitude = valor < 0 ? 0u - (unsigned int)valor : (unsigned int)valor;
+    do {
+        digitos[--posicao] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (valor < 0) {
+        digitos[--posicao] = '-';
+    }
+    quadroAnexar(quadro, &digitos[posicao], sizeof(digitos) - (size_t)posicao);
+}
+
+/**
+ * Anexa o glifo de 3 colunas de uma célula do tabuleiro
+ */
+static inline void quadroAnexarCelula(BufferQuadro* quadro, int valor) {
+    if (valor >= 0 && valor <= 9) {
+        quadroAnexar(quadro, GLIFOS_CELULA[valor], 3);
+    } else {
+        quadroAnexarCaractere(quadro, ' ');
+        quadroAnexarInteiro(quadro, valor);
+        quadroAnexarCaractere(quadro, ' ');
+    }
+}
+
+/**
+ * Escreve todos os bytes no descritor, repetindo apenas em escrita parcial ou EINTR
+ *
+ * @param descritor Descritor de destino
+ * @param dados Bytes a escrever
+ * @param tamanho Quantidade de bytes
+ * @return SUCESSO ou ERRO_ES se a escrita falhar
+ */
+int escreverTudo(int descritor, const void* dados, size_t tamanho) {
+    MEDIR_FASE(FASE_ES);
+    const char* bytes = dados;
+    size_t enviados = 0;
+    while (enviados < tamanho) {
+        ssize_t escritos = write(descritor, bytes + enviados, tamanho - enviados);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return ERRO_ES;
+        }
+        enviados += (size_t)escritos;
+    }
+    return SUCESSO;
+}
+
+/**
+ * Emite o quadro com uma única chamada write (repetida apenas em escrita parcial)
+ * O stdout é esvaziado antes para manter a ordem com a saída do printf
+ *
+ * @param quadro Buffer do quadro
+ * @param descritor Descritor de destino (normalmente STDOUT_FILENO)
+ * @return SUCESSO ou ERRO_ES se a escrita falhar
+ */
+int emitirQuadro(const BufferQuadro* quadro, int descritor) {
+    fflush(stdout);
+    return escreverTudo(descritor, quadro->dados, quadro->tamanho);
+}
+
+/**
+ * Formata o tabuleiro completo no buffer, no mesmo layout de exibirTabuleiro
+ *
+ * @param quadro Buffer do quadro (o conteúdo é anexado)
+ * @param tabuleiro Matriz do tabuleiro
+ */
+void renderizarTabuleiro(BufferQuadro* quadro, int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    QUADRO_ANEXAR_LITERAL(quadro, "\n╔══════════════════════════════════════╗\n"
+                                  "║      TABULEIRO DE BATALHA NAVAL      ║\n"
+                                  "╚══════════════════════════════════════╝\n");
+
+    // Cabeçalho das colunas (A-J), com 4 espaços de padding para alinhar com as linhas
+    QUADRO_ANEXAR_LITERAL(quadro, "    ");
+    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+        char rotulo[3] = {' ', (char)('A' + j), ' '};
+        quadroAnexar(quadro, rotulo, sizeof(rotulo));
+    }
+    quadroAnexarCaractere(quadro, '\n');
+
+    QUADRO_ANEXAR_LITERAL(quadro, "   ┌");
+    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+        QUADRO_ANEXAR_LITERAL(quadro, "───");
+    }
+    QUADRO_ANEXAR_LITERAL(quadro, "┐\n");
+
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        quadroAnexar(quadro, ROTULOS_LINHA[i], strlen(ROTULOS_LINHA[i]));
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            quadroAnexarCelula(quadro, tabuleiro[i][j]);
+        }
+        QUADRO_ANEXAR_LITERAL(quadro, "│\n");
+    }
+
+    QUADRO_ANEXAR_LITERAL(quadro, "   └");
+    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+        QUADRO_ANEXAR_LITERAL(quadro, "───");
+    }
+    QUADRO_ANEXAR_LITERAL(quadro, "┘\n");
+
+    QUADRO_ANEXAR_LITERAL(quadro, "\n📋 Legenda:\n"
+                                  "   0 = Água (vazio)    3 = Navio\n"
+                                  "   1 = Água atingida   2 = Navio atingido\n"
+                                  "   Colunas: A-J  |  Linhas: 0-9\n");
+}
+
+/**
+ * Formata a lista de células de navio intactas no buffer
+ *
+ * @param quadro Buffer do quadro (o conteúdo é anexado)
+ * @param tabuleiro Matriz do tabuleiro
+ */
+void renderizarCoordenadasNavios(BufferQuadro* quadro, int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    QUADRO_ANEXAR_LITERAL(quadro, "\n╔══════════════════════════════════════╗\n"
+                                  "║       COORDENADAS DOS NAVIOS         ║\n"
+                                  "╚══════════════════════════════════════╝\n");
+
+    TabuleiroBits tab;
+    matrizParaTabuleiroBits(tabuleiro, &tab);
+
+    // Percorre apenas as células de navio ainda intactas, em ordem linha a linha
+    Bitboard intactas = bitboardDiferenca(tab.navios, tab.acertos);
+    int contador = bitboardContar(intactas);
+    while (!bitboardVazioTeste(intactas)) {
+        int indice = bitboardExtrairPrimeiro(&intactas);
+        QUADRO_ANEXAR_LITERAL(quadro, "🚢 Posição do navio: ");
+        quadroAnexarCaractere(quadro, (char)('A' + indice % TAMANHO_TABULEIRO));
+        quadroAnexarInteiro(quadro, indice / TAMANHO_TABULEIRO);
+        quadroAnexarCaractere(quadro, '\n');
+    }
+    QUADRO_ANEXAR_LITERAL(quadro, "\n📊 Total de posições ocupadas por navios: ");
+    quadroAnexarInteiro(quadro, contador);
+    quadroAnexarCaractere(quadro, '\n');
+}
+
+/**
+ * Formata uma matriz de habilidade no buffer
+ *
+ * @param quadro Buffer do quadro (o conteúdo é anexado)
+ * @param matriz Matriz de habilidade
+ * @param nomeHabilidade Nome exibido no título (alinhado em 15 colunas)
+ */
+void renderizarHabilidade(BufferQuadro* quadro, int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                          const char* nomeHabilidade) {
+    QUADRO_ANEXAR_LITERAL(quadro, "\n╔══════════════════════════════════════╗\n"
+                                  "║          HABILIDADE: ");
+    size_t tamanhoNome = strlen(nomeHabilidade);
+    quadroAnexar(quadro, nomeHabilidade, tamanhoNome);
+    for (size_t k = tamanhoNome; k < 15; k++) {
+        quadroAnexarCaractere(quadro, ' ');
+    }
+    QUADRO_ANEXAR_LITERAL(quadro, " ║\n"
+                                  "╚══════════════════════════════════════╝\n");
+
+    QUADRO_ANEXAR_LITERAL(quadro, "    ");
+    for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
+        quadroAnexar(quadro, GLIFOS_CELULA[j], 3);  // "%2d " para j < 10
+    }
+    quadroAnexarCaractere(quadro, '\n');
+
+    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
+        quadroAnexar(quadro, GLIFOS_CELULA[i], 2);
+        QUADRO_ANEXAR_LITERAL(quadro, ": ");
+        for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
+            if (matriz[i][j] == AREA_AFETADA) {
+                QUADRO_ANEXAR_LITERAL(quadro, " ● ");
+            } else {
+                QUADRO_ANEXAR_LITERAL(quadro, " · ");
+            }
+        }
+        quadroAnexarCaractere(quadro, '\n');
+    }
+    QUADRO_ANEXAR_LITERAL(quadro, "\n💡 Legenda: ● = Área atingida, · = Área não atingida\n");
+}
+
+/**
+ * Anexa a sequência ANSI que posiciona o cursor (linha e coluna 1-based)
+ */
+static inline void quadroAnexarCursor(BufferQuadro* quadro, int linha, int coluna) {
+    QUADRO_ANEXAR_LITERAL(quadro, "\033[");
+    quadroAnexarInteiro(quadro, linha);
+    quadroAnexarCaractere(quadro, ';');
+    quadroAnexarInteiro(quadro, coluna);
+    quadroAnexarCaractere(quadro, 'H');
+}
+
+/**
+ * Prepara o renderizador diferencial: o primeiro quadro será completo
+ *
+ * @param renderizador Renderizador a ser inicializado
+ */
+void inicializarRenderizadorDiferencial(RenderizadorDiferencial* renderizador) {
+    renderizador->valido = 0;
+}
+
+/**
+ * Formata apenas as mudanças do tabuleiro desde o último quadro
+ * O primeiro quadro limpa a tela e desenha tudo a partir do canto superior;
+ * os seguintes reposicionam o cursor com ANSI e reescrevem só as células
+ * alteradas. O cursor termina sempre em LINHA_APOS_QUADRO, coluna 1
+ *
+ * @param renderizador Estado do último quadro desenhado
+ * @param quadro Buffer do quadro (o conteúdo é anexado)
+ * @param tabuleiro Matriz do tabuleiro
+ * @return Quantidade de células redesenhadas
+ */
+int renderizarDiferenca(RenderizadorDiferencial* renderizador, BufferQuadro* quadro,
+                        int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    MEDIR_FASE(FASE_RENDERIZACAO);
+    if (!renderizador->valido) {
+        QUADRO_ANEXAR_LITERAL(quadro, "\033[H\033[2J");
+        renderizarTabuleiro(quadro, tabuleiro);
+        memcpy(renderizador->anterior, tabuleiro, sizeof(renderizador->anterior));
+        renderizador->valido = 1;
+        return TOTAL_CELULAS;
+    }
+
+    int alteradas = 0;
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        int colunaCursor = -1;  // Coluna onde o cursor já está após o último glifo desta linha
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            if (tabuleiro[i][j] == renderizador->anterior[i][j]) {
+                continue;
+            }
+            if (j != colunaCursor) {
+                quadroAnexarCursor(quadro, LINHA_PRIMEIRA_CELULA + i, COLUNA_PRIMEIRA_CELULA + 3 * j);
+            }
+            quadroAnexarCelula(quadro, tabuleiro[i][j]);
+            renderizador->anterior[i][j] = tabuleiro[i][j];
+            colunaCursor = j + 1;
+            alteradas++;
+        }
+    }
+
+    if (alteradas > 0) {
+        quadroAnexarCursor(quadro, LINHA_APOS_QUADRO, 1);
+    }
+    return alteradas;
+}
+
+/*
+ * ============================================
+ * FUNÇÕES DE EXIBIÇÃO E INTERFACE
+ * ============================================
+ */
+
+/**
+ * Converte índice de coluna para letra (0->A, 1->B, ..., 9->J)
+ *
+ * @param coluna Índice da coluna (0-9)
+ * @return Caractere correspondente (A-J)
+ */
+char colunaParaLetra(int coluna) {
+    return 'A' + coluna;
+}
+
+/**
+ * Converte letra para índice de coluna (A->0, B->1, ..., J->9)
+ *
+ * @param letra Letra da coluna (A-J ou a-j)
+ * @return Índice correspondente (0-9) ou -1 se inválida
+ */
+int letraParaColuna(char letra) {
+    if (letra >= 'A' && letra <= 'J') {
+        return letra - 'A';
+    }
+    if (letra >= 'a' && letra <= 'j') {
+        return letra - 'a';
+    }
+    return -1; // Letra inválida
+}
+
+/**
+ * Formata o rótulo de uma coluna com uma ou mais letras
+ * Numeração bijetiva em base 26: A-Z, AA-AZ, BA-BZ, ..., ZZ, AAA...
+ *
+ * @param coluna Índice da coluna (a partir de 0)
+ * @param destino Buffer de saída
+ * @param tamanho Tamanho do buffer (pelo menos MAX_LETRAS_COLUNA + 1)
+ * @return Quantidade de letras escritas
+ */
+int formatarColuna(int coluna, char* destino, size_t tamanho) {
+    char invertido[MAX_LETRAS_COLUNA + 1];
+    int letras = 0;
+
+    for (int n = coluna + 1; n > 0 && letras < MAX_LETRAS_COLUNA; n = (n - 1) / 26) {
+        invertido[letras++] = (char)('A' + (n - 1) % 26);
+    }
+
+    int escritas = 0;
+    while (letras > 0 && (size_t)escritas + 1 < tamanho) {
+        destino[escritas++] = invertido[--letras];
+    }
+    destino[escritas] = '\0';
+    return escritas;
+}
+
+/**
+ * Converte o prefixo de letras de um texto para índice de coluna
+ * Aceita letras maiúsculas ou minúsculas (A->0, Z->25, AA->26, ...)
+ *
+ * @param texto Texto começando pelas letras da coluna
+ * @param consumidos Saída: quantidade de letras lidas
+ * @return Índice da coluna, ou -1 se não houver letras ou forem letras demais
+ */
+int interpretarColuna(const char* texto, int* consumidos) {
+    int coluna = 0;
+    int letras = 0;
+
+    while ((texto[letras] >= 'A' && texto[letras] <= 'Z') || (texto[letras] >= 'a' && texto[letras] <= 'z')) {
+        if (letras == MAX_LETRAS_COLUNA) {
+            return -1;
+        }
+        char letra = texto[letras];
+        int valor = (letra >= 'a' ? letra - 'a' : letra - 'A') + 1;
+        coluna = coluna * 26 + valor;
+        letras++;
+    }
+
+    *consumidos = letras;
+    return letras > 0 ? coluna - 1 : -1;
+}
+
+/**
+ * Interpreta uma coordenada no formato LetrasLinha (ex: A5, AB12)
+ * Validação única compartilhada por todas as formas de entrada
+ *
+ * @param texto Texto da coordenada
+ * @param linhas Quantidade de linhas do tabuleiro
+ * @param colunas Quantidade de colunas do tabuleiro
+ * @param coord Saída: coordenada interpretada
+ * @return SUCESSO ou ERRO_COORDENADA_FORMATO/COLUNA/LINHA
+ */
+int interpretarCoordenada(const char* texto, int linhas, int colunas, Coordenada* coord) {
+    // Verifica se tem pelo menos 2 caracteres
+    if (strlen(texto) < 2) {
+        return ERRO_COORDENADA_FORMATO;
+    }
+
+    int letras;
+    int coluna = interpretarColuna(texto, &letras);
+    if (coluna < 0 || coluna >= colunas) {
+        return ERRO_COORDENADA_COLUNA;
+    }
+
+    char* endptr;
+    long linha = strtol(&texto[letras], &endptr, 10);
+    if (endptr == &texto[letras] || *endptr != '\0' || linha < 0 || linha >= linhas) {
+        return ERRO_COORDENADA_LINHA;
+    }
+
+    coord->linha = (int)linha;
+    coord->coluna = coluna;
+    return SUCESSO;
+}
+
+/**
+ * ---> FUNÇÃO MODIFICADA
+ * Exibe o tabuleiro completo com formatação alinhada e legível.
+ * O quadro é montado em buffer e enviado com um único write
+ *
+ * @param tabuleiro Matriz do tabuleiro a ser exibida
+ */
+void exibirTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    MEDIR_FASE(FASE_RENDERIZACAO);
+    BufferQuadro quadro;
+    quadroLimpar(&quadro);
+    renderizarTabuleiro(&quadro, tabuleiro);
+    emitirQuadro(&quadro, STDOUT_FILENO);
+}
+
+
+/**
+ * Exibe as coordenadas dos navios posicionados de forma organizada
+ * Com sistema de coordenadas A-J e 0-9
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ */
+void exibirCoordenadosNavios(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO]) {
+    BufferQuadro quadro;
+    quadroLimpar(&quadro);
+    renderizarCoordenadasNavios(&quadro, tabuleiro);
+    emitirQuadro(&quadro, STDOUT_FILENO);
+}
+
+/*
+ * ============================================
+ * SISTEMA DE HABILIDADES ESPECIAIS
+ * ============================================
+ */
+
+/**
+ * Cria o padrão de habilidade em cone (pirâmide invertida)
+ * Otimizada para melhor performance e legibilidade
+ *
+ * @param matriz Matriz onde será criado o padrão
+ */
+void criarHabilidadeCone(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
+    inicializarMatrizHabilidade(matriz);
+
+    // Define o padrão cone usando coordenadas específicas
+    int padrao[][2] = {
+        {0, 2},           // Linha 0: centro
+        {1, 1}, {1, 2}, {1, 3},  // Linha 1: 3 posições
+        {2, 0}, {2, 1}, {2, 2}, {2, 3}, {2, 4}  // Linha 2: linha completa
+    };
+
+    int totalPosicoes = sizeof(padrao) / (sizeof(int) * 2);
+    for (int i = 0; i < totalPosicoes; i++) {
+        matriz[padrao[i][0]][padrao[i][1]] = AREA_AFETADA;
+    }
+}
+
+/**
+ * Cria o padrão de habilidade em cruz
+ * Implementação otimizada usando loops direcionados
+ *
+ * @param matriz Matriz onde será criado o padrão
+ */
+void criarHabilidadeCruz(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
+    inicializarMatrizHabilidade(matriz);
+
+    const int centro = TAMANHO_HABILIDADE / 2;
+
+    // Linha vertical central
+    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
+        matriz[i][centro] = AREA_AFETADA;
+    }
+
+    // Linha horizontal central
+    for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
+        matriz[centro][j] = AREA_AFETADA;
+    }
+}
+
+/**
+ * Cria o padrão de habilidade em octaedro (diamante)
+ * Padrão otimizado para máximo impacto em área compacta
+ *
+ * @param matriz Matriz onde será criado o padrão
+ */
+void criarHabilidadeOctaedro(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
+    inicializarMatrizHabilidade(matriz);
+
+    // Padrão diamante centrado
+    int padrao[][2] = {
+        {0, 2},                    // Topo
+        {1, 1}, {1, 2}, {1, 3},   // Meio expandido
+        {2, 2}                     // Base
+    };
+
+    int totalPosicoes = sizeof(padrao) / (sizeof(int) * 2);
     for (int i = 0; i < totalPosicoes; i++) {
         matriz[padrao[i][0]][padrao[i][1]] = AREA_AFETADA;
     }
 }
 
 /**
- * Cria o padrão de habilidade em cruz
- * Implementação otimizada usando loops direcionados
+ * Exibe uma matriz de habilidade com formatação melhorada
+ *
+ * @param matriz Matriz de habilidade a ser exibida
+ * @param nomeHabilidade Nome da habilidade para exibição
+ */
+void exibirHabilidade(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE], const char* nomeHabilidade) {
+    BufferQuadro quadro;
+    quadroLimpar(&quadro);
+    renderizarHabilidade(&quadro, matriz, nomeHabilidade);
+    emitirQuadro(&quadro, STDOUT_FILENO);
+}
+
+/**
+ * Calcula a área afetada por uma habilidade em um centro específico
+ * Células que caem fora do tabuleiro são descartadas
+ *
+ * @param habilidade Matriz da habilidade
+ * @param centroLinha Linha central do ataque
+ * @param centroColuna Coluna central do ataque
+ * @return Máscara das células atingidas
+ */
+Bitboard calcularMascaraHabilidade(int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                                   int centroLinha, int centroColuna) {
+    const int deslocamento = TAMANHO_HABILIDADE / 2;
+    Bitboard alvo = bitboardVazio();
+
+    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
+        for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
+            int linhaTab = centroLinha - deslocamento + i;
+            int colunaTab = centroColuna - deslocamento + j;
+
+            if (habilidade[i][j] == AREA_AFETADA && coordenadaValida(linhaTab, colunaTab)) {
+                bitboardDefinir(&alvo, indiceCelula(linhaTab, colunaTab));
+            }
+        }
+    }
+
+    return alvo;
+}
+
+/**
+ * Compila uma habilidade em uma tabela de máscaras, uma por centro
+ * Executada uma única vez; cada ataque passa a custar uma consulta à tabela
+ *
+ * @param habilidade Matriz da habilidade (criada por criarHabilidade*)
+ * @param nomeHabilidade Nome da habilidade
+ * @param compilada Estrutura de destino
+ */
+void compilarHabilidade(int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                        const char* nomeHabilidade, HabilidadeCompilada* compilada) {
+    snprintf(compilada->nome, sizeof(compilada->nome), "%s", nomeHabilidade);
+
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            compilada->mascaras[indiceCelula(i, j)] = calcularMascaraHabilidade(habilidade, i, j);
+        }
+    }
+}
+
+/**
+ * Aplica uma habilidade compilada no tabuleiro de bits
+ * Acertos e erros são obtidos em um único passo de interseção de máscaras
+ *
+ * @param tab Tabuleiro de bits
+ * @param habilidade Habilidade compilada
+ * @param centroLinha Linha central (deve ser válida)
+ * @param centroColuna Coluna central (deve ser válida)
+ * @param novosAcertos Saída: células de navio atingidas pela primeira vez
+ * @param novosErros Saída: células de água atingidas pela primeira vez
+ * @return Quantidade de novos acertos
+ */
+static inline int resolverHabilidadeBits(TabuleiroBits* tab, const HabilidadeCompilada* habilidade,
+                                         int centroLinha, int centroColuna,
+                                         Bitboard* novosAcertos, Bitboard* novosErros) {
+    return resolverDisparoBits(tab, habilidade->mascaras[indiceCelula(centroLinha, centroColuna)],
+                               novosAcertos, novosErros);
+}
+
+/*
+ * ============================================
+ * HABILIDADES DEFINIDAS EM ARQUIVO
+ * ============================================
+ *
+ * Formato do arquivo de padrões (texto):
+ *
+ *     # comentário
+ *     NOME K CUSTO
+ *     K linhas de K caracteres: 'X' = célula afetada, '.' = não afetada
+ *
+ * O centro do carimbo é a célula (K / 2, K / 2). Cada habilidade é compilada
+ * direto nas máscaras por centro, como as habilidades padrão
+ */
+
+/*
+ * As três habilidades padrão no formato de arquivo; --benchmark-kernels
+ * confere que compilam nas mesmas máscaras de criarHabilidadesPadrao
+ */
+static const char PADROES_HABILIDADES_PADRAO[] =
+    "# Habilidades padrão\n"
+    "CONE 5 0\n"
+    "..X..\n"
+    ".XXX.\n"
+    "XXXXX\n"
+    ".....\n"
+    ".....\n"
+    "CRUZ 5 0\n"
+    "..X..\n"
+    "..X..\n"
+    "XXXXX\n"
+    "..X..\n"
+    "..X..\n"
+    "OCTAEDRO 5 0\n"
+    "..X..\n"
+    ".XXX.\n"
+    "..X..\n"
+    ".....\n"
+    ".....\n";
+
+/**
+ * Adiciona a uma máscara uma faixa de bits de uma linha do tabuleiro
+ */
+static inline void bitboardDefinirLinha(Bitboard* b, int linha, uint64_t bits) {
+    int inicio = linha * TAMANHO_TABULEIRO;
+    if (inicio >= 64) {
+        b->parte[1] |= bits << (inicio - 64);
+    } else {
+        b->parte[0] |= bits << inicio;
+        if (inicio + TAMANHO_TABULEIRO > 64) {
+            b->parte[1] |= bits >> (64 - inicio);
+        }
+    }
+}
+
+/**
+ * Compila um carimbo KxK nas máscaras por centro
+ * Descendo um centro na mesma coluna, a máscara anterior desce uma linha do
+ * tabuleiro (deslocamento de 10 bits) e ganha no máximo a linha do carimbo
+ * que entra pelo topo: duas operações por centro, qualquer que seja K
+ *
+ * @param linhas Linhas do carimbo (bit j = coluna j)
+ * @param lado Lado K do carimbo (até MAX_LADO_PADRAO)
+ * @param nome Nome da habilidade
+ * @param compilada Estrutura de destino
+ */
+void compilarCarimboHabilidade(const uint32_t linhas[], int lado, const char* nome, HabilidadeCompilada* compilada) {
+    const uint64_t larguraTabuleiro = (1ULL << TAMANHO_TABULEIRO) - 1;
+    const uint64_t fimTabuleiro = (1ULL << (TOTAL_CELULAS - 64)) - 1;     // Bits válidos de parte[1]
+    const int deslocamento = lado / 2;
+    uint64_t faixas[MAX_LADO_PADRAO];
+    snprintf(compilada->nome, sizeof(compilada->nome), "%s", nome);
+
+    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+        // Linhas do carimbo já deslocadas e recortadas para centros na coluna j
+        int avanco = j - deslocamento;
+        for (int r = 0; r < lado; r++) {
+            uint64_t bits = avanco >= 0 ? (uint64_t)linhas[r] << avanco : (uint64_t)linhas[r] >> -avanco;
+            faixas[r] = bits & larguraTabuleiro;
+        }
+
+        Bitboard mascara = bitboardVazio();
+        for (int r = deslocamento; r < lado && r - deslocamento < TAMANHO_TABULEIRO; r++) {
+            bitboardDefinirLinha(&mascara, r - deslocamento, faixas[r]);
+        }
+        compilada->mascaras[indiceCelula(0, j)] = mascara;
+
+        for (int i = 1; i < TAMANHO_TABULEIRO; i++) {
+            mascara.parte[1] = ((mascara.parte[1] << TAMANHO_TABULEIRO) |
+                                (mascara.parte[0] >> (64 - TAMANHO_TABULEIRO))) & fimTabuleiro;
+            mascara.parte[0] <<= TAMANHO_TABULEIRO;
+            int entrando = deslocamento - i;   // Linha do carimbo que chega à linha 0 do tabuleiro
+            if (entrando >= 0 && entrando < lado) {
+                mascara.parte[0] |= faixas[entrando];
+            }
+            compilada->mascaras[indiceCelula(i, j)] = mascara;
+        }
+    }
+}
+
+/**
+ * Lê a próxima linha do texto, sem o '\n' (e sem um '\r' final)
+ *
+ * @return 1 se havia uma linha
+ */
+static int proximaLinhaPadrao(const char** cursor, const char* fim, const char** linha, size_t* comprimento) {
+    if (*cursor >= fim) {
+        return 0;
+    }
+    const char* inicio = *cursor;
+    const char* quebra = memchr(inicio, '\n', (size_t)(fim - inicio));
+    const char* final = quebra != NULL ? quebra : fim;
+    *cursor = quebra != NULL ? quebra + 1 : fim;
+    if (final > inicio && final[-1] == '\r') {
+        final--;
+    }
+    *linha = inicio;
+    *comprimento = (size_t)(final - inicio);
+    return 1;
+}
+
+/**
+ * Interpreta e compila um texto no formato de padrões
+ *
+ * @param texto Conteúdo do arquivo (não precisa terminar em '\0')
+ * @param tamanho Tamanho do texto
+ * @param catalogo Catálogo de destino (liberar com destruirCatalogoHabilidades)
+ * @param linhaErro Saída: linha do primeiro erro (1-based)
+ * @return SUCESSO, ERRO_ARQUIVO_HABILIDADES se o texto for inválido ou ERRO_MEMORIA
+ */
+int interpretarPadroesHabilidades(const char* texto, size_t tamanho, CatalogoHabilidades* catalogo, int* linhaErro) {
+    const char* cursor = texto;
+    const char* fim = texto + tamanho;
+    const char* linha;
+    size_t comprimento;
+    int numeroLinha = 0;
+
+    memset(catalogo, 0, sizeof(*catalogo));
+    catalogo->habilidades = malloc(sizeof(HabilidadeCompilada) * MAX_HABILIDADES_CATALOGO);
+    if (catalogo->habilidades == NULL) {
+        return ERRO_MEMORIA;
+    }
+
+    while (proximaLinhaPadrao(&cursor, fim, &linha, &comprimento)) {
+        numeroLinha++;
+        if (comprimento == 0 || linha[0] == '#') {
+            continue;
+        }
+
+        // Cabeçalho: NOME K CUSTO
+        char cabecalho[MAX_LINHA_PADRAO];
+        char nome[MAX_NOME_HABILIDADE];
+        int lado, custo;
+        char sobra;
+        *linhaErro = numeroLinha;
+        if (comprimento >= sizeof(cabecalho) || catalogo->quantidade == MAX_HABILIDADES_CATALOGO) {
+            return ERRO_ARQUIVO_HABILIDADES;
+        }
+        memcpy(cabecalho, linha, comprimento);
+        cabecalho[comprimento] = '\0';
+        if (sscanf(cabecalho, "%19s %d %d %c", nome, &lado, &custo, &sobra) != 3 ||
+            lado < 1 || lado > MAX_LADO_PADRAO || custo < 0) {
+            return ERRO_ARQUIVO_HABILIDADES;
+        }
+
+        // Carimbo: K linhas de K caracteres
+        uint32_t linhas[MAX_LADO_PADRAO];
+        for (int r = 0; r < lado; r++) {
+            numeroLinha++;
+            *linhaErro = numeroLinha;
+            if (!proximaLinhaPadrao(&cursor, fim, &linha, &comprimento) || comprimento != (size_t)lado) {
+                return ERRO_ARQUIVO_HABILIDADES;
+            }
+            linhas[r] = 0;
+            for (int c = 0; c < lado; c++) {
+                if (linha[c] == 'X' || linha[c] == 'x') {
+                    linhas[r] |= 1u << c;
+                } else if (linha[c] != '.') {
+                    return ERRO_ARQUIVO_HABILIDADES;
+                }
+            }
+        }
+
+        int indice = catalogo->quantidade++;
+        compilarCarimboHabilidade(linhas, lado, nome, &catalogo->habilidades[indice]);
+        catalogo->lados[indice] = (uint8_t)lado;
+        catalogo->custos[indice] = custo;
+    }
+
+    *linhaErro = numeroLinha;
+    return catalogo->quantidade > 0 ? SUCESSO : ERRO_ARQUIVO_HABILIDADES;
+}
+
+/**
+ * Carrega e compila um arquivo de padrões
+ *
+ * @param caminho Caminho do arquivo
+ * @param catalogo Catálogo de destino (liberar com destruirCatalogoHabilidades)
+ * @param linhaErro Saída: linha do primeiro erro, 0 se o arquivo não pôde ser lido
+ * @return SUCESSO ou o código de erro de interpretarPadroesHabilidades
+ */
+int carregarArquivoHabilidades(const char* caminho, CatalogoHabilidades* catalogo, int* linhaErro) {
+    memset(catalogo, 0, sizeof(*catalogo));
+    *linhaErro = 0;
+    int descritor = open(caminho, O_RDONLY);
+    struct stat info;
+    if (descritor < 0 || fstat(descritor, &info) != 0) {
+        if (descritor >= 0) close(descritor);
+        return ERRO_ARQUIVO_HABILIDADES;
+    }
+
+    char* texto = malloc((size_t)info.st_size + 1);
+    size_t lidos = 0;
+    while (texto != NULL && lidos < (size_t)info.st_size) {
+        ssize_t n = read(descritor, texto + lidos, (size_t)info.st_size - lidos);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            break;
+        }
+        lidos += (size_t)n;
+    }
+    close(descritor);
+    if (texto == NULL) {
+        return ERRO_MEMORIA;
+    }
+    if (lidos != (size_t)info.st_size) {
+        free(texto);
+        return ERRO_ARQUIVO_HABILIDADES;
+    }
+
+    int resultado = interpretarPadroesHabilidades(texto, lidos, catalogo, linhaErro);
+    free(texto);
+    return resultado;
+}
+
+void destruirCatalogoHabilidades(CatalogoHabilidades* catalogo) {
+    free(catalogo->habilidades);
+    catalogo->habilidades = NULL;
+    catalogo->quantidade = 0;
+}
+
+/*
+ * ============================================
+ * FUNÇÕES DE ENTRADA DE DADOS DO USUÁRIO
+ * ============================================
+ */
+
+/**
+ * Prepara um leitor de comandos sobre um buffer fornecido pelo chamador
+ *
+ * @param leitor Leitor a preparar
+ * @param descritor Descritor de origem (bloqueante ou não)
+ * @param buffer Área de leitura
+ * @param capacidade Tamanho do buffer (a linha mais longa é capacidade - 1)
+ */
+void iniciarLeitorComandos(LeitorComandos* leitor, int descritor, char* buffer, size_t capacidade) {
+    leitor->descritor = descritor;
+    leitor->buffer = buffer;
+    leitor->capacidade = capacidade;
+    leitor->posicao = leitor->fim = 0;
+    leitor->fimEntrada = 0;
+}
+
+static inline int espacoComando(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Traz mais bytes com um único read, movendo antes o que falta consumir para o início
+ *
+ * @return SUCESSO, ERRO_ENTRADA_PENDENTE ou ERRO_FIM_ENTRADA
+ */
+static int preencherLeitorComandos(LeitorComandos* leitor) {
+    if (leitor->fimEntrada) {
+        return ERRO_FIM_ENTRADA;
+    }
+    if (leitor->posicao > 0) {
+        memmove(leitor->buffer, leitor->buffer + leitor->posicao, leitor->fim - leitor->posicao);
+        leitor->fim -= leitor->posicao;
+        leitor->posicao = 0;
+    }
+    for (;;) {
+        ssize_t lidos = read(leitor->descritor, leitor->buffer + leitor->fim, leitor->capacidade - 1 - leitor->fim);
+        if (lidos > 0) {
+            leitor->fim += (size_t)lidos;
+            return SUCESSO;
+        }
+        if (lidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (lidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return ERRO_ENTRADA_PENDENTE;
+        }
+        leitor->fimEntrada = 1;
+        return ERRO_FIM_ENTRADA;
+    }
+}
+
+/**
+ * Espera o descritor de um leitor não bloqueante ter dados
+ */
+void esperarLeitorComandos(const LeitorComandos* leitor) {
+    struct pollfd espera = {leitor->descritor, POLLIN, 0};
+    while (poll(&espera, 1, -1) < 0 && errno == EINTR) {
+    }
+}
+
+/**
+ * Lê a próxima linha, sem o '\n' (e sem um '\r' final)
+ * Uma linha maior que o buffer é entregue em pedaços de capacidade - 1 bytes
+ *
+ * @param leitor Leitor de comandos
+ * @param linha Saída: início da linha, terminada em '\0' dentro do buffer
+ * @param comprimento Saída: bytes da linha
+ * @return SUCESSO, ERRO_ENTRADA_PENDENTE ou ERRO_FIM_ENTRADA
+ */
+int lerLinhaComandos(LeitorComandos* leitor, char** linha, size_t* comprimento) {
+    size_t procurados = 0;      // Bytes já examinados sem encontrar '\n'
+    for (;;) {
+        char* inicio = leitor->buffer + leitor->posicao;
+        size_t disponiveis = leitor->fim - leitor->posicao;
+        char* quebra = memchr(inicio + procurados, '\n', disponiveis - procurados);
+        size_t tamanho = quebra != NULL ? (size_t)(quebra - inicio) : disponiveis;
+        int completa = quebra != NULL || disponiveis == leitor->capacidade - 1;
+
+        int resultado = SUCESSO;
+        if (!completa) {
+            procurados = disponiveis;
+            resultado = preencherLeitorComandos(leitor);
+            if (resultado == SUCESSO) {
+                continue;
+            }
+            if (resultado == ERRO_ENTRADA_PENDENTE || disponiveis == 0) {
+                return resultado;
+            }
+            inicio = leitor->buffer + leitor->posicao;  // Última linha, sem '\n' no fim do arquivo
+        }
+
+        leitor->posicao += tamanho + (quebra != NULL);
+        if (tamanho > 0 && inicio[tamanho - 1] == '\r') {
+            tamanho--;
+        }
+        inicio[tamanho] = '\0';
+        *linha = inicio;
+        *comprimento = tamanho;
+        return SUCESSO;
+    }
+}
+
+/**
+ * Lê a próxima palavra separada por espaços, atravessando quebras de linha (como scanf("%s"))
+ * O separador que encerra a palavra é consumido
+ *
+ * @return SUCESSO, ERRO_ENTRADA_PENDENTE ou ERRO_FIM_ENTRADA
+ */
+int lerPalavraComandos(LeitorComandos* leitor, char** palavra) {
+    size_t procurados = 0;
+    for (;;) {
+        while (leitor->posicao < leitor->fim && espacoComando(leitor->buffer[leitor->posicao])) {
+            leitor->posicao++;
+        }
+        char* inicio = leitor->buffer + leitor->posicao;
+        size_t disponiveis = leitor->fim - leitor->posicao;
+        while (procurados < disponiveis && !espacoComando(inicio[procurados])) {
+            procurados++;
+        }
+        if (procurados == disponiveis && disponiveis < leitor->capacidade - 1) {
+            int resultado = preencherLeitorComandos(leitor);
+            if (resultado == SUCESSO) {
+                continue;
+            }
+            if (resultado == ERRO_ENTRADA_PENDENTE || disponiveis == 0) {
+                return resultado;
+            }
+            inicio = leitor->buffer + leitor->posicao;
+        }
+
+        leitor->posicao += procurados + (procurados < disponiveis);
+        inicio[procurados] = '\0';
+        *palavra = inicio;
+        return SUCESSO;
+    }
+}
+
+/**
+ * Lê o próximo caractere que não seja espaço (como scanf(" %c"))
+ *
+ * @return SUCESSO, ERRO_ENTRADA_PENDENTE ou ERRO_FIM_ENTRADA
+ */
+int lerCaractereComandos(LeitorComandos* leitor, char* caractere) {
+    for (;;) {
+        while (leitor->posicao < leitor->fim && espacoComando(leitor->buffer[leitor->posicao])) {
+            leitor->posicao++;
+        }
+        if (leitor->posicao < leitor->fim) {
+            *caractere = leitor->buffer[leitor->posicao++];
+            return SUCESSO;
+        }
+        int resultado = preencherLeitorComandos(leitor);
+        if (resultado != SUCESSO) {
+            return resultado;
+        }
+    }
+}
+
+/**
+ * Quebra uma linha em palavras no próprio buffer
+ *
+ * @param cursor Posição corrente na linha; avança até depois da palavra
+ * @return Palavra terminada em '\0', ou NULL se a linha acabou
+ */
+char* proximaPalavraLinha(char** cursor) {
+    char* inicio = *cursor;
+    while (*inicio != '\0' && espacoComando(*inicio)) {
+        inicio++;
+    }
+    if (*inicio == '\0') {
+        *cursor = inicio;
+        return NULL;
+    }
+    char* final = inicio;
+    while (*final != '\0' && !espacoComando(*final)) {
+        final++;
+    }
+    *cursor = *final != '\0' ? final + 1 : final;
+    *final = '\0';
+    return inicio;
+}
+
+/**
+ * Leitor da entrada padrão usado pelo jogo interativo
+ * O prompt pendente no stdout é enviado antes de cada leitura que pode bloquear
+ */
+static LeitorComandos* leitorEntradaPadrao(void) {
+    static char buffer[TAMANHO_BUFFER_COMANDOS];
+    static LeitorComandos leitor;
+    static int iniciado = 0;
+    if (!iniciado) {
+        iniciarLeitorComandos(&leitor, STDIN_FILENO, buffer, sizeof(buffer));
+        iniciado = 1;
+    }
+    fflush(stdout);
+    return &leitor;
+}
+
+/**
+ * Solicita coordenadas do usuário no formato ColLetra (ex: A5, B3, J9)
+ *
+ * @param mensagem Mensagem a ser exibida para o usuário
+ * @param coord Ponteiro para armazenar a coordenada lida
+ * @return 1 se leitura bem-sucedida, 0 caso contrário
+ */
+int lerCoordenada(const char* mensagem, Coordenada* coord) {
+    printf("%s (formato: LetraLinha, ex: A5, B3, J9): ", mensagem);
+
+    LeitorComandos* leitor = leitorEntradaPadrao();
+    char* entrada;
+    int leitura;
+    while ((leitura = lerPalavraComandos(leitor, &entrada)) == ERRO_ENTRADA_PENDENTE) {
+        esperarLeitorComandos(leitor);
+    }
+    if (leitura != SUCESSO) {
+        printf("❌ Erro na leitura. Tente novamente.\n");
+        return 0;
+    }
+
+    switch (interpretarCoordenada(entrada, TAMANHO_TABULEIRO, TAMANHO_TABULEIRO, coord)) {
+        case SUCESSO:
+            break;
+        case ERRO_COORDENADA_FORMATO:
+            printf("❌ Formato inválido. Use formato LetraLinha (ex: A5).\n");
+            return 0;
+        case ERRO_COORDENADA_COLUNA:
+            printf("❌ Coluna inválida. Use letras de A a J.\n");
+            return 0;
+        default:
+            printf("❌ Linha inválida. Use números de 0 a %d.\n", TAMANHO_TABULEIRO - 1);
+            return 0;
+    }
+
+    int linha = coord->linha;
+    int coluna = coord->coluna;
+
+    printf("✅ Coordenada lida: %c%d (Linha %d, Coluna %d)\n",
+           colunaParaLetra(coluna), linha, linha, coluna);
+
+    return 1;
+}
+
+/**
+ * Solicita coordenadas de ataque ao usuário
+ *
+ * @param nomeHabilidade Nome da habilidade para exibição
+ * @param coord Ponteiro para armazenar a coordenada do ataque
+ * @return 1 se bem-sucedido, 0 caso contrário
+ */
+int lerCoordenadaAtaque(const char* nomeHabilidade, Coordenada* coord) {
+    printf("\n🎯 Escolha onde aplicar a habilidade %s:\n", nomeHabilidade);
+    return lerCoordenada("Coordenada do centro do ataque", coord);
+}
+
+/**
+ * Solicita orientação do navio ao usuário
+ *
+ * @return Caractere da orientação ('H', 'V' ou 'D') ou 0 se inválida
+ */
+char lerOrientacao() {
+    char orientacao = 0;
+    printf("Orientação do navio:\n");
+    printf("  H - Horizontal (→)\n");
+    printf("  V - Vertical (↓)\n");
+    printf("  D - Diagonal (↘)\n");
+    printf("Escolha (H/V/D): ");
+
+    LeitorComandos* leitor = leitorEntradaPadrao();
+    while (lerCaractereComandos(leitor, &orientacao) == ERRO_ENTRADA_PENDENTE) {
+        esperarLeitorComandos(leitor);
+    }
+
+    // Converte para maiúscula
+    if (orientacao >= 'a' && orientacao <= 'z') {
+        orientacao = orientacao - 'a' + 'A';
+    }
+
+    if (orientacao == 'H' || orientacao == 'V' || orientacao == 'D') {
+        printf("✅ Orientação selecionada: %c\n", orientacao);
+        return orientacao;
+    } else {
+        printf("❌ Orientação inválida. Use H, V ou D.\n");
+        return 0;
+    }
+}
+
+/**
+ * Solicita ao usuário o posicionamento manual de todos os navios
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param navios Array de navios a serem posicionados
+ * @param quantidadeNavios Quantidade de navios a posicionar
+ * @return 1 se todos os navios foram posicionados, 0 caso contrário
+ */
+int posicionarNaviosManualmente(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                               Navio navios[], int quantidadeNavios) {
+
+    // Definição dos tamanhos dos navios (frota padrão)
+    const int* tamanhosNavios = TAMANHOS_NAVIOS;
+    const char* const* nomesNavios = NOMES_NAVIOS;
+
+    printf("\n╔════════════════════════════════════════════════╗\n");
+    printf("║          POSICIONAMENTO MANUAL DOS NAVIOS      ║\n");
+    printf("╚════════════════════════════════════════════════╝\n");
+    printf("🎯 Você precisa posicionar %d navios no tabuleiro.\n\n", quantidadeNavios);
+
+    // Exibe tabuleiro inicial vazio
+    exibirTabuleiro(tabuleiro);
+
+    for (int i = 0; i < quantidadeNavios; i++) {
+        printf("\n" "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+        printf("🚢 POSICIONANDO NAVIO %d: %s (Tamanho: %d)\n", i + 1, nomesNavios[i], tamanhosNavios[i]);
+        printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+
+        int navioPositionado = 0;
+        int tentativas = 0;
+        const int maxTentativas = 5;
+
+        while (!navioPositionado && tentativas < maxTentativas) {
+            tentativas++;
+
+            Coordenada inicio;
+            char orientacao;
+
+            printf("\n🎯 Tentativa %d de %d:\n", tentativas, maxTentativas);
+
+            // Lê coordenada inicial
+            if (!lerCoordenada("Digite a posição inicial", &inicio)) {
+                printf("⚠️  Tente novamente.\n");
+                continue;
+            }
+
+            // Lê orientação
+            orientacao = lerOrientacao();
+            if (orientacao == 0) {
+                printf("⚠️  Tente novamente.\n");
+                continue;
+            }
+
+            // Configura o navio
+            navios[i].inicio = inicio;
+            navios[i].tamanho = tamanhosNavios[i];
+            navios[i].orientacao = orientacao;
+            navios[i].id = i + 1;
+            navios[i].foiDestruido = 0; // Inicializa o status do navio
+            navios[i].partesRestantes = tamanhosNavios[i];
+
+            // Tenta posicionar
+            int resultado = posicionarNavio(tabuleiro, navios[i]);
+
+            switch (resultado) {
+                case SUCESSO:
+                    printf("✅ %s posicionado com sucesso em %c%d!\n",
+                           nomesNavios[i], colunaParaLetra(inicio.coluna), inicio.linha);
+                    navioPositionado = 1;
+
+                    // Exibe tabuleiro atualizado
+                    exibirTabuleiro(tabuleiro);
+                    break;
+
+                case ERRO_FORA_LIMITES:
+                    printf("❌ Erro: O navio sai dos limites do tabuleiro nesta posição!\n");
+                    printf("💡 Dica: Considere a direção do navio e o tamanho (%d células).\n", tamanhosNavios[i]);
+                    break;
+
+                case ERRO_POSICAO_OCUPADA:
+                    printf("❌ Erro: Há outro navio bloqueando esta posição!\n");
+                    printf("💡 Dica: Escolha uma área livre no tabuleiro.\n");
+                    break;
+
+                default:
+                    printf("❌ Erro desconhecido ao posicionar o navio.\n");
+                    break;
+            }
+        }
+
+        if (!navioPositionado) {
+            printf("❌ Não foi possível posicionar o %s após %d tentativas.\n", nomesNavios[i], maxTentativas);
+            printf("🔄 Reinicie o jogo e tente novamente.\n");
+            return 0;
+        }
+    }
+
+    printf("\n🎉 Todos os navios foram posicionados com sucesso!\n");
+    return 1;
+}
+
+/*
+ * ============================================
+ * RELATO DE EVENTOS NO CONSOLE
+ * ============================================
+ */
+
+/**
+ * Retorna o nome de exibição de um navio a partir do seu identificador
+ *
+ * @param navio Navio consultado
+ * @return Nome da classe do navio
+ */
+static const char* nomeClasseNavio(const Navio* navio) {
+    return navio->id == 1 ? "Battleship" : (navio->id <= 3 ? "Cruiser" : "Destroyer");
+}
+
+static void consoleInicioAtaque(void* contexto, const char* nomeHabilidade, int centroLinha, int centroColuna) {
+    (void)contexto;
+    printf("\n╔══════════════════════════════════════╗\n");
+    printf("║    APLICANDO HABILIDADE: %-11s ║\n", nomeHabilidade);
+    printf("╚══════════════════════════════════════╝\n");
+    printf("🎯 Centro do ataque: %c%d\n", colunaParaLetra(centroColuna), centroLinha);
+    printf("📍 Posições atingidas:\n\n");
+}
+
+static void consoleCelulaAtingida(void* contexto, int linha, int coluna, int resultado) {
+    (void)contexto;
+    printf("   [%c%d] → ", colunaParaLetra(coluna), linha);
+
+    switch (resultado) {
+        case RESULTADO_ACERTO:
+            printf("💥 ACERTO! Navio atingido!\n");
+            break;
+        case RESULTADO_AGUA:
+            printf("🌊 Água - Tiro na água\n");
+            break;
+        case RESULTADO_NAVIO_JA_ATINGIDO:
+            printf("🔄 Já atingido anteriormente\n");
+            break;
+        default:
+            printf("🌊 Água já atingida\n");
+            break;
+    }
+}
+
+static void consoleNavioDestruido(void* contexto, const Navio* navio) {
+    (void)contexto;
+    printf("\n🎉 NAVIO DESTRUÍDO! O navio '%s' foi completamente afundado!\n", nomeClasseNavio(navio));
+}
+
+static void consoleFimAtaque(void* contexto, int tiros, int acertos) {
+    (void)contexto;
+    printf("\n📊 Resultado deste ataque:\n");
+    printf("   • Tiros disparados: %d\n", tiros);
+    printf("   • Acertos: %d\n", acertos);
+    printf("   • Erros: %d\n", tiros - acertos);
+    if (acertos > 0 && tiros > 0) {
+        printf("   🎉 Taxa de acerto: %.1f%%\n", (float)acertos / tiros * 100);
+    }
+}
+
+// Receptor usado pelo jogo interativo: reproduz o relato completo no console
+static const ReceptorEventos receptorConsole = {
+    consoleInicioAtaque,
+    consoleCelulaAtingida,
+    consoleNavioDestruido,
+    consoleFimAtaque,
+    NULL
+};
+
+/*
+ * ============================================
+ * SISTEMA DE COMBATE E APLICAÇÃO DE HABILIDADES
+ * ============================================
+ */
+
+
+/**
+ * Verifica todos os navios para ver se algum foi destruído após um ataque.
+ * Atualiza as estatísticas e o status do navio se for o caso.
+ *
+ * @param tabuleiro Matriz do tabuleiro do jogo.
+ * @param navios Array com os navios do jogo.
+ * @param quantidadeNavios Número total de navios.
+ * @param stats Ponteiro para as estatísticas do jogo.
+ * @param receptor Receptor dos eventos de navio destruído (pode ser NULL).
+ */
+void verificarNaviosDestruidos(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navios[], int quantidadeNavios,
+                               EstatisticasJogo* stats, const ReceptorEventos* receptor) {
+    MEDIR_FASE(FASE_AFUNDAMENTO);
+    TabuleiroBits tab;
+    matrizParaTabuleiroBits(tabuleiro, &tab);
+
+    for (int i = 0; i < quantidadeNavios; i++) {
+        // Pula a verificação se o navio já foi marcado como destruído
+        if (navios[i].foiDestruido) {
+            continue;
+        }
+
+        // O navio está destruído quando todas as células da sua máscara foram atingidas
+        if (navioDestruidoBits(&tab, navios[i])) {
+            navios[i].foiDestruido = 1; // Marca como destruído para não contar de novo
+            stats->naviosDestruidos++;  // Incrementa o contador de estatísticas
+            EMITIR_EVENTO(receptor, navioDestruido, &navios[i]);
+        }
+    }
+}
+
+
+/**
+ * Aplica uma máscara de alvo no tabuleiro, relatando cada célula atingida
+ * Núcleo comum às versões da habilidade por matriz e pré-compilada
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param alvo Máscara das células atingidas (já recortada nas bordas)
+ * @param centroLinha Linha central onde a habilidade foi aplicada
+ * @param centroColuna Coluna central onde a habilidade foi aplicada
+ * @param nomeHabilidade Nome da habilidade para exibição
+ * @param navios Array com todos os navios para verificação de destruição
+ * @param quantidadeNavios Número total de navios no array
+ * @param stats Ponteiro para estatísticas do jogo
+ * @param receptor Receptor dos eventos do ataque (pode ser NULL)
+ */
+static void aplicarMascaraNoTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                                      Bitboard alvo,
+                                      int centroLinha, int centroColuna,
+                                      const char* nomeHabilidade,
+                                      Navio navios[], int quantidadeNavios,
+                                      EstatisticasJogo* stats,
+                                      const ReceptorEventos* receptor) {
+    MEDIR_FASE(FASE_DISPARO);
+    int acertosNesteTiro = 0;
+    int tirosNesteTurno = 0;
+
+    EMITIR_EVENTO(receptor, inicioAtaque, nomeHabilidade, centroLinha, centroColuna);
+
+    TabuleiroBits tab;
+    Bitboard novosAcertos, novosErros;
+    matrizParaTabuleiroBits(tabuleiro, &tab);
+    Bitboard jaAtingidas = tab.acertos;
+    acertosNesteTiro = resolverDisparoBits(&tab, alvo, &novosAcertos, &novosErros);
+    tirosNesteTurno = bitboardContar(alvo);
+
+    // Atualiza a matriz e relata cada célula na mesma ordem do padrão (linha a linha)
+    Bitboard restantes = alvo;
+    while (!bitboardVazioTeste(restantes)) {
+        int indice = bitboardExtrairPrimeiro(&restantes);
+        int linhaTab = indice / TAMANHO_TABULEIRO;
+        int colunaTab = indice % TAMANHO_TABULEIRO;
+        int resultado;
+
+        if (bitboardTestar(novosAcertos, indice)) {
+            resultado = RESULTADO_ACERTO;
+            tabuleiro[linhaTab][colunaTab] = POSICAO_ATINGIDA;
+        } else if (bitboardTestar(novosErros, indice)) {
+            resultado = RESULTADO_AGUA;
+            tabuleiro[linhaTab][colunaTab] = POSICAO_AGUA_ATINGIDA;
+        } else if (bitboardTestar(jaAtingidas, indice)) {
+            resultado = RESULTADO_NAVIO_JA_ATINGIDO;
+        } else {
+            resultado = RESULTADO_AGUA_JA_ATINGIDA;
+        }
+        EMITIR_EVENTO(receptor, celulaAtingida, linhaTab, colunaTab, resultado);
+    }
+
+    // Verifica se algum navio foi destruído após a rodada de ataques
+    if (acertosNesteTiro > 0) {
+        verificarNaviosDestruidos(tabuleiro, navios, quantidadeNavios, stats, receptor);
+    }
+
+    // Atualiza estatísticas se fornecidas
+    if (stats != NULL) {
+        stats->totalTiros += tirosNesteTurno;
+        stats->acertos += acertosNesteTiro;
+        stats->erros += (tirosNesteTurno - acertosNesteTiro);
+    }
+
+    EMITIR_EVENTO(receptor, fimAtaque, tirosNesteTurno, acertosNesteTiro);
+}
+
+/**
+ * Aplica uma habilidade no tabuleiro em uma coordenada específica
+ * Versão otimizada com melhor feedback e controle de erros
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param habilidade Matriz da habilidade a ser aplicada
+ * @param centroLinha Linha central onde a habilidade será aplicada
+ * @param centroColuna Coluna central onde a habilidade será aplicada
+ * @param nomeHabilidade Nome da habilidade para exibição
+ * @param navios Array com todos os navios para verificação de destruição
+ * @param quantidadeNavios Número total de navios no array
+ * @param stats Ponteiro para estatísticas do jogo
+ * @param receptor Receptor dos eventos do ataque (NULL = sem saída)
+ */
+void aplicarHabilidadeNoTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                                  int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                                  int centroLinha, int centroColuna,
+                                  const char* nomeHabilidade,
+                                  Navio navios[], int quantidadeNavios,
+                                  EstatisticasJogo* stats,
+                                  const ReceptorEventos* receptor) {
+    Bitboard alvo = calcularMascaraHabilidade(habilidade, centroLinha, centroColuna);
+    aplicarMascaraNoTabuleiro(tabuleiro, alvo, centroLinha, centroColuna, nomeHabilidade,
+                              navios, quantidadeNavios, stats, receptor);
+}
+
+/**
+ * Aplica uma habilidade pré-compilada no tabuleiro
+ * A área afetada vem direto da tabela de máscaras, sem varrer a matriz 5x5
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param habilidade Habilidade compilada por compilarHabilidade
+ * @param centroLinha Linha central onde a habilidade será aplicada
+ * @param centroColuna Coluna central onde a habilidade será aplicada
+ * @param navios Array com todos os navios para verificação de destruição
+ * @param quantidadeNavios Número total de navios no array
+ * @param stats Ponteiro para estatísticas do jogo
+ * @param receptor Receptor dos eventos do ataque (NULL = sem saída)
+ */
+void aplicarHabilidadeCompiladaNoTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                                           const HabilidadeCompilada* habilidade,
+                                           int centroLinha, int centroColuna,
+                                           Navio navios[], int quantidadeNavios,
+                                           EstatisticasJogo* stats,
+                                           const ReceptorEventos* receptor) {
+    Bitboard alvo = habilidade->mascaras[indiceCelula(centroLinha, centroColuna)];
+    aplicarMascaraNoTabuleiro(tabuleiro, alvo, centroLinha, centroColuna, habilidade->nome,
+                              navios, quantidadeNavios, stats, receptor);
+}
+
+/**
+ * Exibe estatísticas finais do jogo
+ *
+ * @param stats Estrutura com as estatísticas
+ */
+void exibirEstatisticasFinais(EstatisticasJogo* stats) {
+    printf("\n╔══════════════════════════════════════╗\n");
+    printf("║        ESTATÍSTICAS FINAIS           ║\n");
+    printf("╚══════════════════════════════════════╝\n");
+    printf("📊 Total de tiros disparados: %d\n", stats->totalTiros);
+    printf("🎯 Total de acertos: %d\n", stats->acertos);
+    printf("❌ Total de erros: %d\n", stats->erros);
+    if (stats->totalTiros > 0) {
+        printf("📈 Taxa de acerto geral: %.1f%%\n", (float)stats->acertos / stats->totalTiros * 100);
+    }
+    printf("🚢 Navios destruídos: %d de %d\n", stats->naviosDestruidos, MAX_NAVIOS);
+}
+
+/*
+ * ============================================
+ * KERNELS ESPECIALIZADOS (TABULEIRO 10x10 E HABILIDADE 5x5)
+ * ============================================
+ */
+
+/*
+ * Os kernels abaixo são gerados por macros a partir de constantes de compilação:
+ * o padrão de cada habilidade é um literal de 25 bits, então cada teste
+ * "célula afetada?" é resolvido pelo compilador e o laço 5x5 some. Para
+ * centros no interior (2 a 7 em linha e coluna) a área cabe inteira no
+ * tabuleiro e nenhum limite é verificado; nas bordas a mesma expansão é
+ * gerada com verificação de limites.
+ */
+#define MARGEM_HABILIDADE (TAMANHO_HABILIDADE / 2)
+
+_Static_assert(TAMANHO_HABILIDADE == 5, "Os kernels especializados assumem habilidades 5x5");
+
+/**
+ * Processa uma célula atingida por um kernel especializado
+ * Mesma transição de estados de aplicarMascaraNoTabuleiro
+ */
+static inline void processarCelulaEspecializada(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                                                int linha, int coluna, int* tiros, int* acertos,
+                                                const ReceptorEventos* receptor) {
+    int* celula = &tabuleiro[linha][coluna];
+    int resultado;
+
+    (*tiros)++;
+    if (*celula == POSICAO_NAVIO) {
+        *celula = POSICAO_ATINGIDA;
+        (*acertos)++;
+        resultado = RESULTADO_ACERTO;
+    } else if (*celula == POSICAO_VAZIA) {
+        *celula = POSICAO_AGUA_ATINGIDA;
+        resultado = RESULTADO_AGUA;
+    } else if (*celula == POSICAO_ATINGIDA) {
+        resultado = RESULTADO_NAVIO_JA_ATINGIDO;
+    } else {
+        resultado = RESULTADO_AGUA_JA_ATINGIDA;
+    }
+    EMITIR_EVENTO(receptor, celulaAtingida, linha, coluna, resultado);
+}
+
+// Uma célula do padrão: o teste do bit é constante e o bloco some quando a célula não é afetada
+#define KERNEL_CELULA(padrao, i, j, verificarLimites)                                          \
+    if (((padrao) >> ((i) * TAMANHO_HABILIDADE + (j))) & 1u) {                                 \
+        const int linhaTab = centroLinha - MARGEM_HABILIDADE + (i);                            \
+        const int colunaTab = centroColuna - MARGEM_HABILIDADE + (j);                          \
+        if (!(verificarLimites) || coordenadaValida(linhaTab, colunaTab)) {                    \
+            processarCelulaEspecializada(tabuleiro, linhaTab, colunaTab, &tiros, &acertos,     \
+                                         receptor);                                            \
+        }                                                                                      \
+    }
+
+#define KERNEL_LINHA(padrao, i, verificarLimites)  \
+    KERNEL_CELULA(padrao, i, 0, verificarLimites)  \
+    KERNEL_CELULA(padrao, i, 1, verificarLimites)  \
+    KERNEL_CELULA(padrao, i, 2, verificarLimites)  \
+    KERNEL_CELULA(padrao, i, 3, verificarLimites)  \
+    KERNEL_CELULA(padrao, i, 4, verificarLimites)
+
+#define KERNEL_PADRAO(padrao, verificarLimites) \
+    KERNEL_LINHA(padrao, 0, verificarLimites)   \
+    KERNEL_LINHA(padrao, 1, verificarLimites)   \
+    KERNEL_LINHA(padrao, 2, verificarLimites)   \
+    KERNEL_LINHA(padrao, 3, verificarLimites)   \
+    KERNEL_LINHA(padrao, 4, verificarLimites)
+
+// Gera as versões interior e borda de uma habilidade; ambas retornam tiros e acertos
+#define DEFINIR_KERNEL_HABILIDADE(nome, padrao)                                                    \
+    static void nome##Interior(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],                \
+                               int centroLinha, int centroColuna, int* tirosSaida,                 \
+                               int* acertosSaida, const ReceptorEventos* receptor) {               \
+        int tiros = 0, acertos = 0;                                                                \
+        KERNEL_PADRAO(padrao, 0)                                                                   \
+        *tirosSaida = tiros;                                                                       \
+        *acertosSaida = acertos;                                                                   \
+    }                                                                                              \
+    static void nome##Borda(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],                   \
+                            int centroLinha, int centroColuna, int* tirosSaida,                    \
+                            int* acertosSaida, const ReceptorEventos* receptor) {                  \
+        int tiros = 0, acertos = 0;                                                                \
+        KERNEL_PADRAO(padrao, 1)                                                                   \
+        *tirosSaida = tiros;                                                                       \
+        *acertosSaida = acertos;                                                                   \
+    }
+
+DEFINIR_KERNEL_HABILIDADE(kernelCone, PADRAO_CONE)
+DEFINIR_KERNEL_HABILIDADE(kernelCruz, PADRAO_CRUZ)
+DEFINIR_KERNEL_HABILIDADE(kernelOctaedro, PADRAO_OCTAEDRO)
+
+typedef void (*KernelHabilidade)(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                                 int centroLinha, int centroColuna, int* tiros, int* acertos,
+                                 const ReceptorEventos* receptor);
+
+// Tabela constante de kernels: [habilidade][0 = interior, 1 = borda]
+static const KernelHabilidade KERNELS_HABILIDADE[QUANTIDADE_HABILIDADES_PADRAO][2] = {
+    {kernelConeInterior, kernelConeBorda},
+    {kernelCruzInterior, kernelCruzBorda},
+    {kernelOctaedroInterior, kernelOctaedroBorda}
+};
+
+static const char* const NOMES_HABILIDADES_PADRAO[QUANTIDADE_HABILIDADES_PADRAO] = {"CONE", "CRUZ", "OCTAEDRO"};
+
+/**
+ * Aplica uma habilidade padrão com o kernel especializado
+ * Produz o mesmo tabuleiro, estatísticas e eventos de aplicarHabilidadeNoTabuleiro
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param tipo HABILIDADE_CONE, HABILIDADE_CRUZ ou HABILIDADE_OCTAEDRO
+ * @param centroLinha Linha central onde a habilidade será aplicada
+ * @param centroColuna Coluna central onde a habilidade será aplicada
+ * @param navios Array com todos os navios para verificação de destruição
+ * @param quantidadeNavios Número total de navios no array
+ * @param stats Ponteiro para estatísticas do jogo
+ * @param receptor Receptor dos eventos do ataque (NULL = sem saída)
+ */
+void aplicarHabilidadeEspecializada(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                                    int tipo, int centroLinha, int centroColuna,
+                                    Navio navios[], int quantidadeNavios,
+                                    EstatisticasJogo* stats, const ReceptorEventos* receptor) {
+    const int interior = centroLinha >= MARGEM_HABILIDADE && centroLinha < TAMANHO_TABULEIRO - MARGEM_HABILIDADE &&
+                         centroColuna >= MARGEM_HABILIDADE && centroColuna < TAMANHO_TABULEIRO - MARGEM_HABILIDADE;
+    int tiros, acertos;
+
+    EMITIR_EVENTO(receptor, inicioAtaque, NOMES_HABILIDADES_PADRAO[tipo], centroLinha, centroColuna);
+    KERNELS_HABILIDADE[tipo][!interior](tabuleiro, centroLinha, centroColuna, &tiros, &acertos, receptor);
+
+    if (acertos > 0) {
+        verificarNaviosDestruidos(tabuleiro, navios, quantidadeNavios, stats, receptor);
+    }
+    if (stats != NULL) {
+        stats->totalTiros += tiros;
+        stats->acertos += acertos;
+        stats->erros += tiros - acertos;
+    }
+
+    EMITIR_EVENTO(receptor, fimAtaque, tiros, acertos);
+}
+
+/**
+ * Confere se as constantes PADRAO_* correspondem às matrizes de criarHabilidade*
+ *
+ * @return 1 se todas conferem, 0 caso contrário
+ */
+int conferirPadroesEspecializados(void) {
+    static const uint32_t padroes[QUANTIDADE_HABILIDADES_PADRAO] = {PADRAO_CONE, PADRAO_CRUZ, PADRAO_OCTAEDRO};
+    int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        if (h == HABILIDADE_CONE) criarHabilidadeCone(matriz);
+        if (h == HABILIDADE_CRUZ) criarHabilidadeCruz(matriz);
+        if (h == HABILIDADE_OCTAEDRO) criarHabilidadeOctaedro(matriz);
+
+        for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
+            for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
+                if ((matriz[i][j] == AREA_AFETADA) != (int)((padroes[h] >> (i * TAMANHO_HABILIDADE + j)) & 1u)) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/*
+ * Posicionamento especializado: para cada tamanho fixo da frota padrão o passo
+ * na matriz achatada é constante por orientação e o laço tem contagem constante.
+ * Primeiro calcula quantas células cabem no tabuleiro (uma conta, sem testar
+ * célula a célula) e depois verifica ocupação apenas nessas células, mantendo
+ * a ordem de erros de posicionarNavio.
+ */
+#define DEFINIR_KERNEL_POSICIONAMENTO(tamanhoNavio)                                               \
+    static int posicionarNavioTamanho##tamanhoNavio(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], \
+                                                    Navio navio) {                                \
+        const int linha = navio.inicio.linha, coluna = navio.inicio.coluna;                       \
+        int passo, cabem;                                                                         \
+        if (!coordenadaValida(linha, coluna)) {                                                   \
+            return ERRO_FORA_LIMITES;                                                             \
+        }                                                                                         \
+        switch (navio.orientacao) {                                                               \
+            case 'H': passo = 1; cabem = TAMANHO_TABULEIRO - coluna; break;                       \
+            case 'V': passo = TAMANHO_TABULEIRO; cabem = TAMANHO_TABULEIRO - linha; break;        \
+            case 'D': passo = TAMANHO_TABULEIRO + 1;                                              \
+                      cabem = TAMANHO_TABULEIRO - (linha > coluna ? linha : coluna); break;       \
+            default:  passo = 0; cabem = (tamanhoNavio); break; /* orientação inválida não se move */ \
+        }                                                                                         \
+        int* base = &tabuleiro[linha][coluna];                                                    \
+        const int verificar = cabem < (tamanhoNavio) ? cabem : (tamanhoNavio);                    \
+        int ocupadas = 0;                                                                         \
+        for (int k = 0; k < (tamanhoNavio); k++) {                                                \
+            ocupadas |= (k < verificar) & (base[k < verificar ? k * passo : 0] != POSICAO_VAZIA); \
+        }                                                                                         \
+        if (ocupadas) {                                                                           \
+            return ERRO_POSICAO_OCUPADA;                                                          \
+        }                                                                                         \
+        if (cabem < (tamanhoNavio)) {                                                             \
+            return ERRO_FORA_LIMITES;                                                             \
+        }                                                                                         \
+        for (int k = 0; k < (tamanhoNavio); k++) {                                                \
+            base[k * passo] = POSICAO_NAVIO;                                                      \
+        }                                                                                         \
+        return SUCESSO;                                                                           \
+    }
+
+DEFINIR_KERNEL_POSICIONAMENTO(2)
+DEFINIR_KERNEL_POSICIONAMENTO(3)
+DEFINIR_KERNEL_POSICIONAMENTO(4)
+
+/**
+ * Posiciona um navio usando o kernel do seu tamanho, quando existir
+ * Tamanhos fora da frota padrão usam posicionarNavio
+ *
+ * @param tabuleiro Matriz do tabuleiro
+ * @param navio Estrutura contendo dados do navio
+ * @return SUCESSO se bem-sucedido, código de erro caso contrário
+ */
+int posicionarNavioEspecializado(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navio) {
+    switch (navio.tamanho) {
+        case 2: return posicionarNavioTamanho2(tabuleiro, navio);
+        case 3: return posicionarNavioTamanho3(tabuleiro, navio);
+        case 4: return posicionarNavioTamanho4(tabuleiro, navio);
+        default: return posicionarNavio(tabuleiro, navio);
+    }
+}
+
+/*
+ * ============================================
+ * GERADOR DE NÚMEROS ALEATÓRIOS
+ * ============================================
+ */
+
+/**
+ * Avança um estado splitmix64 e retorna o próximo valor
+ * Usado apenas para expandir a semente do xoshiro256**
+ *
+ * @param estado Estado do splitmix64 (será modificado)
+ * @return Próximo valor de 64 bits
+ */
+static uint64_t splitmix64(uint64_t* estado) {
+    uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Inicializa o gerador a partir de uma semente e de um número de fluxo
+ * Fluxos diferentes com a mesma semente produzem sequências independentes
+ *
+ * @param gerador Gerador a ser inicializado
+ * @param semente Semente base
+ * @param fluxo Identificador do fluxo (ex: índice da thread)
+ */
+void inicializarGerador(GeradorAleatorio* gerador, uint64_t semente, uint64_t fluxo) {
+    uint64_t estado = semente ^ (fluxo * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        gerador->s[i] = splitmix64(&estado);
+    }
+}
+
+static inline uint64_t rotacionarEsquerda(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Gera o próximo número de 64 bits (xoshiro256**)
+ *
+ * @param gerador Gerador (será modificado)
+ * @return Valor pseudoaleatório de 64 bits
+ */
+static inline uint64_t proximoAleatorio(GeradorAleatorio* gerador) {
+    uint64_t* s = gerador->s;
+    const uint64_t resultado = rotacionarEsquerda(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotacionarEsquerda(s[3], 45);
+
+    return resultado;
+}
+
+/**
+ * Gera um inteiro em [0, limite) pelo método multiplicativo de Lemire
+ * Evita a divisão do operador % no caminho crítico
+ *
+ * @param gerador Gerador (será modificado)
+ * @param limite Limite superior exclusivo (maior que zero)
+ * @return Valor no intervalo [0, limite)
+ */
+static inline uint32_t aleatorioLimitado(GeradorAleatorio* gerador, uint32_t limite) {
+    return (uint32_t)(((proximoAleatorio(gerador) >> 32) * (uint64_t)limite) >> 32);
+}
+
+/*
+ * ============================================
+ * NÚCLEO HEADLESS DE SIMULAÇÃO
+ * ============================================
+ */
+
+/*
+ * Hash Zobrist do estado observado, criado uma única vez com semente fixa
+ */
+static ChavesZobrist chavesZobrist;
+static pthread_once_t chavesZobristCriadas = PTHREAD_ONCE_INIT;
+
+static void criarChavesZobrist(void) {
+    uint64_t estado = SEMENTE_ZOBRIST;
+    for (int i = 0; i < TOTAL_CELULAS; i++) {
+        chavesZobrist.acerto[i] = splitmix64(&estado);
+        chavesZobrist.erro[i] = splitmix64(&estado);
+    }
+    for (int n = 0; n < MAX_NAVIOS; n++) {
+        chavesZobrist.afundado[n] = splitmix64(&estado);
+    }
+}
+
+/**
+ * Retorna as chaves Zobrist, criando-as na primeira chamada
+ */
+const ChavesZobrist* obterChavesZobrist(void) {
+    pthread_once(&chavesZobristCriadas, criarChavesZobrist);
+    return &chavesZobrist;
+}
+
+/**
+ * XOR das chaves das células de um plano
+ */
+static inline uint64_t hashCelulasZobrist(const uint64_t chaves[TOTAL_CELULAS], Bitboard celulas) {
+    uint64_t hash = 0;
+    while (!bitboardVazioTeste(celulas)) {
+        hash ^= chaves[bitboardExtrairPrimeiro(&celulas)];
+    }
+    return hash;
+}
+
+/**
+ * Variação do hash causada por um disparo; aplicar duas vezes a desfaz
+ *
+ * @param novosAcertos Células que passaram a acerto
+ * @param novosErros Células que passaram a água
+ * @param afundados Bit i = navio i afundado pelo disparo
+ * @return Valor a combinar por XOR com o hash do estado
+ */
+static inline uint64_t variacaoHashZobrist(Bitboard novosAcertos, Bitboard novosErros, int afundados) {
+    uint64_t hash = hashCelulasZobrist(chavesZobrist.acerto, novosAcertos) ^
+                    hashCelulasZobrist(chavesZobrist.erro, novosErros);
+    while (afundados != 0) {
+        hash ^= chavesZobrist.afundado[__builtin_ctz((unsigned int)afundados)];
+        afundados &= afundados - 1;
+    }
+    return hash;
+}
+
+/**
+ * Recalcula do zero o hash que o estado mantém incrementalmente
+ *
+ * @param estado Estado da partida
+ * @return Hash Zobrist de acertos, erros e navios afundados
+ */
+uint64_t calcularHashZobrist(const EstadoJogo* estado) {
+    int afundados = 0;
+    obterChavesZobrist();
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        afundados |= estado->navios[n].foiDestruido << n;
+    }
+    return variacaoHashZobrist(estado->tabuleiro.acertos, estado->tabuleiro.erros, afundados);
+}
+
+/**
+ * Prepara um estado de partida vazio, sem navios
+ *
+ * @param estado Estado a ser inicializado
+ */
+void inicializarEstadoJogo(EstadoJogo* estado) {
+    obterChavesZobrist();
+    inicializarTabuleiroBits(&estado->tabuleiro);
+    inicializarEstatisticas(&estado->stats);
+    estado->quantidadeNavios = 0;
+    estado->naviosRestantes = 0;
+    estado->turno = 0;
+    estado->hash = 0;
+}
+
+/**
+ * Marca as células de um navio no mapa célula → navio
+ * Só as células de navios são escritas e lidas, por isso o mapa dispensa memset na inicialização;
+ * as células são percorridas com passo fixo a partir do início (a posição já foi validada)
+ *
+ * @param estado Estado da partida
+ * @param indice Índice do navio em estado->navios
+ */
+static inline void marcarCelulasNavio(EstadoJogo* estado, int indice) {
+    const Navio* navio = &estado->navios[indice];
+    int passo = navio->orientacao == 'H' ? 1 :
+                navio->orientacao == 'V' ? TAMANHO_TABULEIRO : TAMANHO_TABULEIRO + 1;
+    int celula = indiceCelula(navio->inicio.linha, navio->inicio.coluna);
+    for (int i = 0; i < navio->tamanho; i++, celula += passo) {
+        estado->navioNaCelula[celula] = (uint8_t)indice;
+    }
+}
+
+/**
+ * Registra no estado um navio cuja máscara já foi validada
+ * Preenche o mapa célula → navio usado na detecção incremental de afundamento
+ *
+ * @param estado Estado da partida
+ * @param inicio Coordenada inicial do navio
+ * @param tamanho Tamanho do navio
+ * @param orientacao Orientação ('H', 'V' ou 'D')
+ * @param mascara Células ocupadas pelo navio
+ */
+static inline void registrarNavioEstado(EstadoJogo* estado, Coordenada inicio, int tamanho,
+                                        char orientacao, Bitboard mascara) {
+    Navio* navio = &estado->navios[estado->quantidadeNavios];
+    navio->inicio = inicio;
+    navio->tamanho = tamanho;
+    navio->orientacao = orientacao;
+    navio->id = estado->quantidadeNavios + 1;
+    navio->foiDestruido = 0;
+    navio->partesRestantes = tamanho;
+
+    marcarCelulasNavio(estado, estado->quantidadeNavios);
+    estado->mascarasNavios[estado->quantidadeNavios] = mascara;
+    estado->tabuleiro.navios = bitboardUniao(estado->tabuleiro.navios, mascara);
+    estado->quantidadeNavios++;
+    estado->naviosRestantes++;
+}
+
+/**
+ * Adiciona um navio da frota ao estado, se a posição for válida
+ *
+ * @param estado Estado da partida
+ * @param inicio Coordenada inicial do navio
+ * @param tamanho Tamanho do navio
+ * @param orientacao Orientação ('H', 'V' ou 'D')
+ * @return SUCESSO ou o código de erro de posicionarNavioBits
+ */
+int adicionarNavioEstado(EstadoJogo* estado, Coordenada inicio, int tamanho, char orientacao) {
+    if (estado->quantidadeNavios >= MAX_NAVIOS) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+
+    Navio navio = {inicio, tamanho, orientacao, estado->quantidadeNavios + 1, 0, tamanho};
+    Bitboard mascara;
+    TabuleiroBits validacao = estado->tabuleiro;
+
+    int resultado = posicionarNavioBits(&validacao, navio);
+    if (resultado != SUCESSO) {
+        return resultado;
+    }
+
+    calcularMascaraNavio(navio, &mascara);
+    registrarNavioEstado(estado, inicio, tamanho, orientacao, mascara);
+    return SUCESSO;
+}
+
+/**
+ * Desconta novos acertos das partes dos navios, contabiliza os afundamentos e atualiza o hash
+ * Cada acerto desconta uma parte do navio dono da célula: O(acertos), sem revarrer a frota
+ *
+ * @param partes Saída opcional (pode ser NULL): partes atingidas de cada navio
+ * @return Máscara dos navios afundados por estes acertos (bit i = navio i)
+ */
+static int descontarAcertosNavios(EstadoJogo* estado, Bitboard novosAcertos, Bitboard novosErros, int tiros,
+                                  uint8_t partes[MAX_NAVIOS]) {
+    int acertos = bitboardContar(novosAcertos);
+    int afundados = 0;
+    if (partes != NULL) {
+        memset(partes, 0, MAX_NAVIOS);
+    }
+    Bitboard celulasAcertadas = novosAcertos;
+    while (!bitboardVazioTeste(celulasAcertadas)) {
+        int i = estado->navioNaCelula[bitboardExtrairPrimeiro(&celulasAcertadas)];
+        Navio* navio = &estado->navios[i];
+        if (partes != NULL) {
+            partes[i]++;
+        }
+        if (--navio->partesRestantes == 0) {
+            navio->foiDestruido = 1;
+            estado->naviosRestantes--;
+            estado->stats.naviosDestruidos++;
+            afundados |= 1 << i;
+        }
+    }
+
+    estado->hash ^= variacaoHashZobrist(novosAcertos, novosErros, afundados);
+    estado->stats.totalTiros += tiros;
+    estado->stats.acertos += acertos;
+    estado->stats.erros += tiros - acertos;
+    return afundados;
+}
+
+/**
+ * Resolve um ataque de habilidade no estado da partida
+ * Sem E/S: os relatos só acontecem se um receptor for informado
+ *
+ * @param estado Estado da partida
+ * @param habilidade Habilidade compilada
+ * @param centro Centro do ataque (deve ser válido)
+ * @param receptor Receptor de eventos (NULL no caminho crítico)
+ * @return Quantidade de novos acertos
+ */
+int resolverAtaque(EstadoJogo* estado, const HabilidadeCompilada* habilidade,
+                   Coordenada centro, const ReceptorEventos* receptor) {
+    MEDIR_FASE(FASE_DISPARO);
+    Bitboard novosAcertos, novosErros;
+    Bitboard alvo = habilidade->mascaras[indiceCelula(centro.linha, centro.coluna)];
+    int tiros = bitboardContar(alvo);
+
+#if BATALHA_EVENTOS
+    Bitboard jaAtingidas = estado->tabuleiro.acertos;
+#endif
+    int acertos = resolverHabilidadeBits(&estado->tabuleiro, habilidade, centro.linha, centro.coluna,
+                                         &novosAcertos, &novosErros);
+
+#if BATALHA_EVENTOS
+    if (receptor != NULL) {
+        EMITIR_EVENTO(receptor, inicioAtaque, habilidade->nome, centro.linha, centro.coluna);
+        if (receptor->celulaAtingida != NULL) {
+            Bitboard restantes = alvo;
+            while (!bitboardVazioTeste(restantes)) {
+                int indice = bitboardExtrairPrimeiro(&restantes);
+                int resultado = bitboardTestar(novosAcertos, indice) ? RESULTADO_ACERTO :
+                                bitboardTestar(novosErros, indice) ? RESULTADO_AGUA :
+                                bitboardTestar(jaAtingidas, indice) ? RESULTADO_NAVIO_JA_ATINGIDO :
+                                RESULTADO_AGUA_JA_ATINGIDA;
+                receptor->celulaAtingida(receptor->contexto, indice / TAMANHO_TABULEIRO,
+                                         indice % TAMANHO_TABULEIRO, resultado);
+            }
+        }
+    }
+#endif
+
+    int afundados = descontarAcertosNavios(estado, novosAcertos, novosErros, tiros, NULL);
+    for (int i = 0; afundados != 0 && i < estado->quantidadeNavios; i++) {
+        if (afundados & (1 << i)) {
+            EMITIR_EVENTO(receptor, navioDestruido, &estado->navios[i]);
+        }
+    }
+    estado->turno++;
+
+    EMITIR_EVENTO(receptor, fimAtaque, tiros, acertos);
+    return acertos;
+}
+
+/**
+ * Resolve vários ataques contra um mesmo tabuleiro em uma chamada
+ * O estado final é idêntico ao de chamar resolverAtaque em sequência (sem receptor);
+ * a contagem de partes por navio é feita uma única vez, ao fim do lote
+ *
+ * @param estado Estado da partida atacada
+ * @param habilidades Habilidades compiladas indexadas por AtaqueLote.habilidade
+ * @param ataques Ataques na ordem em que são disparados
+ * @param quantidade Quantidade de ataques
+ * @param resultados Saída opcional (pode ser NULL): novas células de cada ataque
+ * @param afundados Saída opcional (pode ser NULL): bit i = navio i afundado neste lote
+ * @return Total de novos acertos do lote
+ */
+int resolverAtaquesEmLote(EstadoJogo* estado, const HabilidadeCompilada* habilidades,
+                          const AtaqueLote* ataques, int quantidade,
+                          ResultadoAtaqueLote* resultados, int* afundados) {
+    TabuleiroBits* tab = &estado->tabuleiro;
+    Bitboard acertosAntes = tab->acertos, errosAntes = tab->erros;
+    int tiros = 0;
+
+    for (int a = 0; a < quantidade; a++) {
+        Bitboard novosAcertos, novosErros;
+        Bitboard alvo = habilidades[ataques[a].habilidade].mascaras[ataques[a].centro];
+        tiros += bitboardContar(alvo);
+        resolverDisparoBits(tab, alvo, &novosAcertos, &novosErros);
+        if (resultados != NULL) {
+            resultados[a].acertos = novosAcertos;
+            resultados[a].erros = novosErros;
+        }
+    }
+
+    // Os navios são conferidos uma vez para o lote inteiro
+    Bitboard novosAcertos = bitboardDiferenca(tab->acertos, acertosAntes);
+    int mascaraAfundados = descontarAcertosNavios(estado, novosAcertos, bitboardDiferenca(tab->erros, errosAntes),
+                                                  tiros, NULL);
+    estado->turno += quantidade;
+    if (afundados != NULL) {
+        *afundados = mascaraAfundados;
+    }
+    return bitboardContar(novosAcertos);
+}
+
+/**
+ * Resolve o mesmo ataque contra vários tabuleiros (ex.: frotas candidatas de uma busca)
+ * A máscara da habilidade é buscada uma única vez para todo o lote
+ *
+ * @param estados Estados das partidas atacadas
+ * @param quantidade Quantidade de estados
+ * @param habilidade Habilidade compilada
+ * @param centro Célula central (linha * TAMANHO_TABULEIRO + coluna)
+ * @param resultados Saída opcional (pode ser NULL): novas células em cada tabuleiro
+ * @param afundados Saída opcional (pode ser NULL): máscara de navios afundados em cada tabuleiro
+ * @return Total de novos acertos somado sobre os tabuleiros
+ */
+int resolverAtaqueEmTabuleiros(EstadoJogo* const estados[], int quantidade,
+                               const HabilidadeCompilada* habilidade, int centro,
+                               ResultadoAtaqueLote* resultados, int* afundados) {
+    const Bitboard alvo = habilidade->mascaras[centro];
+    const int tiros = bitboardContar(alvo);
+    int total = 0;
+    for (int e = 0; e < quantidade; e++) {
+        Bitboard novosAcertos, novosErros;
+        total += resolverDisparoBits(&estados[e]->tabuleiro, alvo, &novosAcertos, &novosErros);
+        int mascaraAfundados = descontarAcertosNavios(estados[e], novosAcertos, novosErros, tiros, NULL);
+        estados[e]->turno++;
+        if (resultados != NULL) {
+            resultados[e].acertos = novosAcertos;
+            resultados[e].erros = novosErros;
+        }
+        if (afundados != NULL) {
+            afundados[e] = mascaraAfundados;
+        }
+    }
+    return total;
+}
+
+/*
+ * Lotes de tabuleiros em estrutura de arrays: cada plano de cada tabuleiro é
+ * uma faixa de um array contíguo, e o mesmo disparo é resolvido em
+ * FAIXAS_LOTE_SOA tabuleiros por instrução vetorial (AVX-512), 4 em AVX2
+ */
+
+/**
+ * Cria um lote SoA vazio em um único bloco alinhado à linha de cache
+ *
+ * @param lote Lote a criar
+ * @param capacidade Tabuleiros desejados (arredondado para múltiplo de FAIXAS_LOTE_SOA)
+ * @return SUCESSO, ERRO_POSICAO_INVALIDA se a capacidade não for positiva ou ERRO_MEMORIA
+ */
+int criarLoteTabuleirosSoA(LoteTabuleirosSoA* lote, int capacidade) {
+    memset(lote, 0, sizeof(*lote));
+    if (capacidade <= 0) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    lote->capacidade = (capacidade + FAIXAS_LOTE_SOA - 1) / FAIXAS_LOTE_SOA * FAIXAS_LOTE_SOA;
+    const size_t faixa = sizeof(uint64_t) * (size_t)lote->capacidade;
+    const size_t planos = 2 * (3 + MAX_NAVIOS) + 1;
+    lote->bloco = alocarAlinhadoCache(faixa * planos + 2 * sizeof(int32_t) * (size_t)lote->capacidade);
+    if (lote->bloco == NULL) {
+        return ERRO_MEMORIA;
+    }
+
+    uint8_t* cursor = lote->bloco;
+    for (int p = 0; p < 2; p++) {
+        lote->navios[p] = (uint64_t*)cursor;
+        lote->acertos[p] = (uint64_t*)(cursor + faixa);
+        lote->erros[p] = (uint64_t*)(cursor + 2 * faixa);
+        cursor += 3 * faixa;
+        for (int n = 0; n < MAX_NAVIOS; n++) {
+            lote->mascaras[n][p] = (uint64_t*)cursor;
+            cursor += faixa;
+        }
+    }
+    lote->afundados = (uint64_t*)cursor;
+    lote->tiros = (int32_t*)(cursor + faixa);
+    lote->turnos = lote->tiros + lote->capacidade;
+    limparLoteTabuleirosSoA(lote);
+    return SUCESSO;
+}
+
+/**
+ * Esvazia o lote; faixas vazias não têm navios, e os disparos nelas não contam acertos
+ */
+void limparLoteTabuleirosSoA(LoteTabuleirosSoA* lote) {
+    memset(lote->bloco, 0, sizeof(uint64_t) * (size_t)lote->capacidade * (2 * (3 + MAX_NAVIOS) + 1) +
+                           2 * sizeof(int32_t) * (size_t)lote->capacidade);
+    for (int b = 0; b < lote->capacidade; b++) {
+        lote->afundados[b] = (1u << MAX_NAVIOS) - 1;
+    }
+    lote->quantidade = 0;
+}
+
+void destruirLoteTabuleirosSoA(LoteTabuleirosSoA* lote) {
+    free(lote->bloco);
+    memset(lote, 0, sizeof(*lote));
+}
+
+/**
+ * Copia um estado para a próxima faixa livre do lote
+ * Navios ausentes da frota entram como já afundados, com máscara vazia
+ *
+ * @return Índice da faixa, ou ERRO_FORA_LIMITES se o lote estiver cheio
+ */
+int carregarTabuleiroSoA(LoteTabuleirosSoA* lote, const EstadoJogo* estado) {
+    if (lote->quantidade == lote->capacidade) {
+        return ERRO_FORA_LIMITES;
+    }
+    const int b = lote->quantidade++;
+    uint64_t afundados = 0;
+    for (int p = 0; p < 2; p++) {
+        lote->navios[p][b] = estado->tabuleiro.navios.parte[p];
+        lote->acertos[p][b] = estado->tabuleiro.acertos.parte[p];
+        lote->erros[p][b] = estado->tabuleiro.erros.parte[p];
+    }
+    for (int n = 0; n < MAX_NAVIOS; n++) {
+        int presente = n < estado->quantidadeNavios;
+        lote->mascaras[n][0][b] = presente ? estado->mascarasNavios[n].parte[0] : 0;
+        lote->mascaras[n][1][b] = presente ? estado->mascarasNavios[n].parte[1] : 0;
+        afundados |= (uint64_t)(!presente || estado->navios[n].foiDestruido) << n;
+    }
+    lote->afundados[b] = afundados;
+    lote->tiros[b] = 0;
+    lote->turnos[b] = 0;
+    return b;
+}
+
+/**
+ * Leva ao estado tudo o que os disparos do lote mudaram na sua faixa
+ * O estado deve ser o mesmo que foi carregado nela: o resultado é idêntico,
+ * byte a byte, a ter resolvido os mesmos disparos com resolverAtaque
+ *
+ * @param indice Faixa devolvida por carregarTabuleiroSoA
+ */
+void descarregarTabuleiroSoA(const LoteTabuleirosSoA* lote, int indice, EstadoJogo* estado) {
+    Bitboard acertos = {{lote->acertos[0][indice], lote->acertos[1][indice]}};
+    Bitboard erros = {{lote->erros[0][indice], lote->erros[1][indice]}};
+    Bitboard novosAcertos = bitboardDiferenca(acertos, estado->tabuleiro.acertos);
+    Bitboard novosErros = bitboardDiferenca(erros, estado->tabuleiro.erros);
+    int quantidadeAcertos = bitboardContar(novosAcertos);
+
+    int afundados = 0;
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        Navio* navio = &estado->navios[n];
+        navio->partesRestantes -= bitboardContar(bitboardIntersecao(novosAcertos, estado->mascarasNavios[n]));
+        if (!navio->foiDestruido && ((lote->afundados[indice] >> n) & 1)) {
+            navio->foiDestruido = 1;
+            estado->naviosRestantes--;
+            estado->stats.naviosDestruidos++;
+            afundados |= 1 << n;
+        }
+    }
+
+    estado->tabuleiro.acertos = acertos;
+    estado->tabuleiro.erros = erros;
+    estado->hash ^= variacaoHashZobrist(novosAcertos, novosErros, afundados);
+    estado->stats.totalTiros += lote->tiros[indice];
+    estado->stats.acertos += quantidadeAcertos;
+    estado->stats.erros += lote->tiros[indice] - quantidadeAcertos;
+    estado->turno += lote->turnos[indice];
+}
+
+/**
+ * Partes ainda não atingidas de um navio de uma faixa (derivadas dos planos, sem contador próprio)
+ */
+int partesRestantesSoA(const LoteTabuleirosSoA* lote, int indice, int navio) {
+    return __builtin_popcountll(lote->mascaras[navio][0][indice] & ~lote->acertos[0][indice]) +
+           __builtin_popcountll(lote->mascaras[navio][1][indice] & ~lote->acertos[1][indice]);
+}
+
+/**
+ * Kernel escalar: uma faixa por iteração
+ * Um navio afunda quando a máscara não tem mais células fora dos acertos,
+ * o que dispensa contar as partes atingidas no caminho do disparo
+ */
+static long long resolverFaixasEscalar(LoteTabuleirosSoA* lote, Bitboard alvo) {
+    long long novos = 0;
+    for (int b = 0; b < lote->capacidade; b++) {
+        uint64_t antes0 = lote->acertos[0][b], antes1 = lote->acertos[1][b];
+        uint64_t acertos0 = antes0 | (alvo.parte[0] & lote->navios[0][b]);
+        uint64_t acertos1 = antes1 | (alvo.parte[1] & lote->navios[1][b]);
+        lote->acertos[0][b] = acertos0;
+        lote->acertos[1][b] = acertos1;
+        lote->erros[0][b] |= alvo.parte[0] & ~lote->navios[0][b];
+        lote->erros[1][b] |= alvo.parte[1] & ~lote->navios[1][b];
+        novos += __builtin_popcountll(acertos0 ^ antes0) + __builtin_popcountll(acertos1 ^ antes1);
+
+        uint64_t afundados = lote->afundados[b];
+        for (int n = 0; n < MAX_NAVIOS; n++) {
+            uint64_t intactas = (lote->mascaras[n][0][b] & ~acertos0) | (lote->mascaras[n][1][b] & ~acertos1);
+            afundados |= (uint64_t)(intactas == 0) << n;
+        }
+        lote->afundados[b] = afundados;
+    }
+    return novos;
+}
+
+#if LOTE_SOA_VETORIAL
+/**
+ * Popcount de cada palavra de 64 bits por tabela de nibbles (AVX2 não tem vpopcntq)
+ */
+__attribute__((target("avx2")))
+static inline __m256i contarBitsAvx2(__m256i v) {
+    const __m256i tabela = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i baixo = _mm256_shuffle_epi8(tabela, _mm256_and_si256(v, nibble));
+    __m256i alto = _mm256_shuffle_epi8(tabela, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    return _mm256_sad_epu8(_mm256_add_epi8(baixo, alto), _mm256_setzero_si256());
+}
+
+/**
+ * Kernel AVX2: 4 tabuleiros por vetor em cada plano
+ */
+__attribute__((target("avx2")))
+static long long resolverFaixasAvx2(LoteTabuleirosSoA* lote, Bitboard alvo) {
+    const __m256i alvo0 = _mm256_set1_epi64x((long long)alvo.parte[0]);
+    const __m256i alvo1 = _mm256_set1_epi64x((long long)alvo.parte[1]);
+    __m256i novos = _mm256_setzero_si256();
+    for (int b = 0; b < lote->capacidade; b += 4) {
+        __m256i navios0 = _mm256_load_si256((const __m256i*)&lote->navios[0][b]);
+        __m256i navios1 = _mm256_load_si256((const __m256i*)&lote->navios[1][b]);
+        __m256i antes0 = _mm256_load_si256((const __m256i*)&lote->acertos[0][b]);
+        __m256i antes1 = _mm256_load_si256((const __m256i*)&lote->acertos[1][b]);
+        __m256i acertos0 = _mm256_or_si256(antes0, _mm256_and_si256(alvo0, navios0));
+        __m256i acertos1 = _mm256_or_si256(antes1, _mm256_and_si256(alvo1, navios1));
+        _mm256_store_si256((__m256i*)&lote->acertos[0][b], acertos0);
+        _mm256_store_si256((__m256i*)&lote->acertos[1][b], acertos1);
+        __m256i* erros0 = (__m256i*)&lote->erros[0][b];
+        __m256i* erros1 = (__m256i*)&lote->erros[1][b];
+        _mm256_store_si256(erros0, _mm256_or_si256(_mm256_load_si256(erros0), _mm256_andnot_si256(navios0, alvo0)));
+        _mm256_store_si256(erros1, _mm256_or_si256(_mm256_load_si256(erros1), _mm256_andnot_si256(navios1, alvo1)));
+        novos = _mm256_add_epi64(novos, contarBitsAvx2(_mm256_xor_si256(acertos0, antes0)));
+        novos = _mm256_add_epi64(novos, contarBitsAvx2(_mm256_xor_si256(acertos1, antes1)));
+
+        __m256i afundados = _mm256_load_si256((const __m256i*)&lote->afundados[b]);
+        for (int n = 0; n < MAX_NAVIOS; n++) {
+            __m256i intactas = _mm256_or_si256(
+                _mm256_andnot_si256(acertos0, _mm256_load_si256((const __m256i*)&lote->mascaras[n][0][b])),
+                _mm256_andnot_si256(acertos1, _mm256_load_si256((const __m256i*)&lote->mascaras[n][1][b])));
+            __m256i vazia = _mm256_cmpeq_epi64(intactas, _mm256_setzero_si256());
+            afundados = _mm256_or_si256(afundados, _mm256_and_si256(vazia, _mm256_set1_epi64x(1LL << n)));
+        }
+        _mm256_store_si256((__m256i*)&lote->afundados[b], afundados);
+    }
+    long long parciais[4];
+    _mm256_storeu_si256((__m256i*)parciais, novos);
+    return parciais[0] + parciais[1] + parciais[2] + parciais[3];
+}
+
+/**
+ * Kernel AVX-512: 8 tabuleiros por vetor; o teste de máscara vazia vai direto para um registrador k
+ */
+__attribute__((target("avx512f,avx512bw")))
+static long long resolverFaixasAvx512(LoteTabuleirosSoA* lote, Bitboard alvo) {
+    const __m512i alvo0 = _mm512_set1_epi64((long long)alvo.parte[0]);
+    const __m512i alvo1 = _mm512_set1_epi64((long long)alvo.parte[1]);
+    const __m512i tabela = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i novos = _mm512_setzero_si512();
+    for (int b = 0; b < lote->capacidade; b += 8) {
+        __m512i navios0 = _mm512_load_si512(&lote->navios[0][b]);
+        __m512i navios1 = _mm512_load_si512(&lote->navios[1][b]);
+        __m512i antes0 = _mm512_load_si512(&lote->acertos[0][b]);
+        __m512i antes1 = _mm512_load_si512(&lote->acertos[1][b]);
+        __m512i acertos0 = _mm512_or_si512(antes0, _mm512_and_si512(alvo0, navios0));
+        __m512i acertos1 = _mm512_or_si512(antes1, _mm512_and_si512(alvo1, navios1));
+        _mm512_store_si512(&lote->acertos[0][b], acertos0);
+        _mm512_store_si512(&lote->acertos[1][b], acertos1);
+        _mm512_store_si512(&lote->erros[0][b], _mm512_or_si512(_mm512_load_si512(&lote->erros[0][b]),
+                                                               _mm512_andnot_si512(navios0, alvo0)));
+        _mm512_store_si512(&lote->erros[1][b], _mm512_or_si512(_mm512_load_si512(&lote->erros[1][b]),
+                                                               _mm512_andnot_si512(navios1, alvo1)));
+
+        // Popcount por nibbles somado nas duas metades antes do vpsadbw (no máximo 16 por byte)
+        __m512i diferenca0 = _mm512_xor_si512(acertos0, antes0);
+        __m512i diferenca1 = _mm512_xor_si512(acertos1, antes1);
+        __m512i bits = _mm512_add_epi8(
+            _mm512_add_epi8(_mm512_shuffle_epi8(tabela, _mm512_and_si512(diferenca0, nibble)),
+                            _mm512_shuffle_epi8(tabela, _mm512_and_si512(_mm512_srli_epi16(diferenca0, 4), nibble))),
+            _mm512_add_epi8(_mm512_shuffle_epi8(tabela, _mm512_and_si512(diferenca1, nibble)),
+                            _mm512_shuffle_epi8(tabela, _mm512_and_si512(_mm512_srli_epi16(diferenca1, 4), nibble))));
+        novos = _mm512_add_epi64(novos, _mm512_sad_epu8(bits, _mm512_setzero_si512()));
+
+        __m512i afundados = _mm512_load_si512(&lote->afundados[b]);
+        for (int n = 0; n < MAX_NAVIOS; n++) {
+            __m512i intactas = _mm512_or_si512(_mm512_andnot_si512(acertos0, _mm512_load_si512(&lote->mascaras[n][0][b])),
+                                               _mm512_andnot_si512(acertos1, _mm512_load_si512(&lote->mascaras[n][1][b])));
+            __mmask8 vazia = _mm512_testn_epi64_mask(intactas, intactas);
+            afundados = _mm512_mask_or_epi64(afundados, vazia, afundados, _mm512_set1_epi64(1LL << n));
+        }
+        _mm512_store_si512(&lote->afundados[b], afundados);
+    }
+    return _mm512_reduce_add_epi64(novos);
+}
+#endif
+
+typedef long long (*KernelLoteSoA)(LoteTabuleirosSoA* lote, Bitboard alvo);
+
+static KernelLoteSoA kernelLoteSoA = resolverFaixasEscalar;
+static const char* nomeKernelLoteSoA = "escalar";
+static pthread_once_t kernelLoteSoAEscolhido = PTHREAD_ONCE_INIT;
+
+static void escolherKernelLoteSoA(void) {
+#if LOTE_SOA_VETORIAL
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        kernelLoteSoA = resolverFaixasAvx512;
+        nomeKernelLoteSoA = "avx512";
+    } else if (__builtin_cpu_supports("avx2")) {
+        kernelLoteSoA = resolverFaixasAvx2;
+        nomeKernelLoteSoA = "avx2";
+    }
+#endif
+}
+
+/**
+ * Retorna o nome do kernel dos lotes SoA em uso ("avx512", "avx2" ou "escalar")
+ */
+const char* obterKernelLoteSoA(void) {
+    pthread_once(&kernelLoteSoAEscolhido, escolherKernelLoteSoA);
+    return nomeKernelLoteSoA;
+}
+
+/**
+ * Resolve o mesmo ataque em todos os tabuleiros do lote SoA
+ * Equivale a resolverAtaqueEmTabuleiros sobre os estados carregados, mas os
+ * planos de todos os tabuleiros são percorridos em passo único e vetorial
+ *
+ * @param lote Lote com os tabuleiros carregados
+ * @param habilidade Habilidade compilada
+ * @param centro Célula central (linha * TAMANHO_TABULEIRO + coluna)
+ * @return Total de novos acertos somado sobre os tabuleiros
+ */
+long long resolverAtaqueSoA(LoteTabuleirosSoA* lote, const HabilidadeCompilada* habilidade, int centro) {
+    pthread_once(&kernelLoteSoAEscolhido, escolherKernelLoteSoA);
+    const Bitboard alvo = habilidade->mascaras[centro];
+    const int32_t tiros = bitboardContar(alvo);
+    for (int b = 0; b < lote->quantidade; b++) {
+        lote->tiros[b] += tiros;
+        lote->turnos[b]++;
+    }
+    return kernelLoteSoA(lote, alvo);
+}
+
+/*
+ * Diário de jogadas: aplicar e desfazer custam O(células alteradas + navios),
+ * sem copiar o estado inteiro; usado por buscas que experimentam e voltam atrás
+ */
+
+void inicializarDiario(DiarioJogadas* diario) {
+    diario->quantidade = 0;
+    diario->topo = 0;
+}
+
+/**
+ * Aplica um ataque e o registra no diário, descartando as jogadas que podiam ser refeitas
+ *
+ * @param estado Estado da partida atacada
+ * @param diario Diário da partida
+ * @param habilidades Habilidades compiladas indexadas por ataque.habilidade
+ * @param ataque Habilidade e centro do ataque
+ * @return Novos acertos, ou ERRO_FORA_LIMITES se o diário estiver cheio
+ */
+int aplicarJogadaDiario(EstadoJogo* estado, DiarioJogadas* diario,
+                        const HabilidadeCompilada* habilidades, AtaqueLote ataque) {
+    if (diario->quantidade == MAX_TURNOS) {
+        return ERRO_FORA_LIMITES;
+    }
+    JogadaDiario* jogada = &diario->jogadas[diario->quantidade++];
+    diario->topo = diario->quantidade;
+
+    Bitboard alvo = habilidades[ataque.habilidade].mascaras[ataque.centro];
+    int tiros = bitboardContar(alvo);
+    int acertos = resolverDisparoBits(&estado->tabuleiro, alvo, &jogada->acertos, &jogada->erros);
+    uint64_t hashAntes = estado->hash;
+    jogada->afundados = (uint8_t)descontarAcertosNavios(estado, jogada->acertos, jogada->erros, tiros,
+                                                        jogada->partesAtingidas);
+    jogada->hash = estado->hash ^ hashAntes;
+    jogada->habilidade = ataque.habilidade;
+    jogada->centro = ataque.centro;
+    jogada->tiros = (uint8_t)tiros;
+    jogada->acertosNovos = (uint8_t)acertos;
+    estado->turno++;
+    return acertos;
+}
+
+/**
+ * Desfaz a última jogada aplicada
+ *
+ * @return SUCESSO, ou ERRO_POSICAO_INVALIDA se não houver jogada a desfazer
+ */
+int desfazerJogada(EstadoJogo* estado, DiarioJogadas* diario) {
+    if (diario->quantidade == 0) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    const JogadaDiario* jogada = &diario->jogadas[--diario->quantidade];
+    int acertos = jogada->acertosNovos;
+
+    estado->tabuleiro.acertos = bitboardDiferenca(estado->tabuleiro.acertos, jogada->acertos);
+    estado->tabuleiro.erros = bitboardDiferenca(estado->tabuleiro.erros, jogada->erros);
+    for (int i = 0; acertos > 0 && i < estado->quantidadeNavios; i++) {
+        estado->navios[i].partesRestantes += jogada->partesAtingidas[i];
+        if (jogada->afundados & (1 << i)) {
+            estado->navios[i].foiDestruido = 0;
+            estado->naviosRestantes++;
+            estado->stats.naviosDestruidos--;
+        }
+    }
+
+    estado->hash ^= jogada->hash;
+    estado->stats.totalTiros -= jogada->tiros;
+    estado->stats.acertos -= acertos;
+    estado->stats.erros -= jogada->tiros - acertos;
+    estado->turno--;
+    return SUCESSO;
+}
+
+/**
+ * Refaz a próxima jogada desfeita, reaplicando as células registradas
+ *
+ * @return SUCESSO, ou ERRO_POSICAO_INVALIDA se não houver jogada a refazer
+ */
+int refazerJogada(EstadoJogo* estado, DiarioJogadas* diario) {
+    if (diario->quantidade == diario->topo) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    const JogadaDiario* jogada = &diario->jogadas[diario->quantidade++];
+    int acertos = jogada->acertosNovos;
+
+    estado->tabuleiro.acertos = bitboardUniao(estado->tabuleiro.acertos, jogada->acertos);
+    estado->tabuleiro.erros = bitboardUniao(estado->tabuleiro.erros, jogada->erros);
+    for (int i = 0; acertos > 0 && i < estado->quantidadeNavios; i++) {
+        estado->navios[i].partesRestantes -= jogada->partesAtingidas[i];
+        if (jogada->afundados & (1 << i)) {
+            estado->navios[i].foiDestruido = 1;
+            estado->naviosRestantes--;
+            estado->stats.naviosDestruidos++;
+        }
+    }
+
+    estado->hash ^= jogada->hash;
+    estado->stats.totalTiros += jogada->tiros;
+    estado->stats.acertos += acertos;
+    estado->stats.erros += jogada->tiros - acertos;
+    estado->turno++;
+    return SUCESSO;
+}
+
+/*
+ * Tabela de posicionamentos por tamanho de navio, criada uma única vez
+ */
+static PosicionamentosNavio tabelaPosicionamentos[TAMANHO_TABULEIRO + 1];
+static pthread_once_t tabelaPosicionamentosCriada = PTHREAD_ONCE_INIT;
+
+/**
+ * Enumera todos os posicionamentos válidos de cada tamanho de navio
+ * Usa calcularMascaraNavio, portanto segue as mesmas regras de posicionarNavio
+ */
+static void criarTabelaPosicionamentos(void) {
+    static const char orientacoes[] = {'H', 'V', 'D'};
+
+    for (int tamanho = 1; tamanho <= TAMANHO_TABULEIRO; tamanho++) {
+        PosicionamentosNavio* tabela = &tabelaPosicionamentos[tamanho];
+        tabela->quantidade = 0;
+        memset(tabela->quantidadePorCelula, 0, sizeof(tabela->quantidadePorCelula));
+
+        for (int o = 0; o < 3; o++) {
+            for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+                for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+                    Navio navio = {{i, j}, tamanho, orientacoes[o], 0, 0, tamanho};
+                    Bitboard mascara;
+
+                    if (calcularMascaraNavio(navio, &mascara) == SUCESSO) {
+                        int k = tabela->quantidade++;
+                        tabela->mascaras[k] = mascara;
+                        tabela->inicios[k] = navio.inicio;
+                        tabela->orientacoes[k] = navio.orientacao;
+
+                        // Índice inverso: de cada célula para os posicionamentos que a cobrem
+                        while (!bitboardVazioTeste(mascara)) {
+                            int celula = bitboardExtrairPrimeiro(&mascara);
+                            tabela->porCelula[celula][tabela->quantidadePorCelula[celula]++] = (uint16_t)k;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Retorna os posicionamentos válidos de um navio de determinado tamanho
+ *
+ * @param tamanho Tamanho do navio (1 a TAMANHO_TABULEIRO)
+ * @return Tabela de posicionamentos (segura para uso entre threads)
+ */
+const PosicionamentosNavio* obterPosicionamentos(int tamanho) {
+    pthread_once(&tabelaPosicionamentosCriada, criarTabelaPosicionamentos);
+    return &tabelaPosicionamentos[tamanho];
+}
+
+/**
+ * Sorteia um posicionamento livre, uniforme entre todos os livres
+ * Primeiro faz alguns sorteios rápidos sobre a tabela inteira; se todos
+ * colidirem, enumera os livres e sorteia entre eles. Cada passo é uniforme
+ * sobre os livres, então a mistura também é, e o número de sorteios é limitado
+ *
+ * @param tabela Posicionamentos do tamanho desejado
+ * @param ocupadas Células já ocupadas
+ * @param gerador Gerador de números aleatórios
+ * @return Índice na tabela, ou -1 se não houver posição livre
+ */
+static inline int sortearPosicionamentoLivre(const PosicionamentosNavio* tabela, Bitboard ocupadas,
+                                             GeradorAleatorio* gerador) {
+    for (int tentativa = 0; tentativa < SORTEIOS_RAPIDOS; tentativa++) {
+        int k = (int)aleatorioLimitado(gerador, (uint32_t)tabela->quantidade);
+        if (bitboardVazioTeste(bitboardIntersecao(tabela->mascaras[k], ocupadas))) {
+            return k;
+        }
+    }
+
+    // Enumeração sem desvios: o índice é sempre gravado e o contador só avança se estiver livre
+    int livres[MAX_POSICIONAMENTOS];
+    int quantidadeLivres = 0;
+    for (int i = 0; i < tabela->quantidade; i++) {
+        livres[quantidadeLivres] = i;
+        quantidadeLivres += bitboardVazioTeste(bitboardIntersecao(tabela->mascaras[i], ocupadas));
+    }
+
+    if (quantidadeLivres == 0) {
+        return -1;
+    }
+    return livres[aleatorioLimitado(gerador, (uint32_t)quantidadeLivres)];
+}
+
+/**
+ * Sorteia uma frota completa com os tamanhos informados
+ * Cada navio é sorteado uniformemente entre as posições ainda livres,
+ * com ocupação incremental; nenhuma chamada a posicionarNavio é repetida
+ *
+ * @param estado Estado da partida (deve estar sem navios)
+ * @param tamanhos Tamanhos dos navios
+ * @param quantidade Número de navios (até MAX_NAVIOS)
+ * @param gerador Gerador de números aleatórios
+ * @return 1 se a frota foi posicionada, 0 caso contrário
+ */
+int sortearFrota(EstadoJogo* estado, const int tamanhos[], int quantidade, GeradorAleatorio* gerador) {
+    for (int i = 0; i < quantidade; i++) {
+        const PosicionamentosNavio* tabela = obterPosicionamentos(tamanhos[i]);
+        int k = sortearPosicionamentoLivre(tabela, estado->tabuleiro.navios, gerador);
+
+        if (k < 0) {
+            return 0;
+        }
+        registrarNavioEstado(estado, tabela->inicios[k], tamanhos[i], tabela->orientacoes[k],
+                             tabela->mascaras[k]);
+    }
+    return 1;
+}
+
+/**
+ * Estratégia de posicionamento uniforme da frota padrão
+ * Se um sorteio ficar sem espaço (impossível no 10x10 padrão), recomeça a frota
+ */
+static int posicionarFrotaUniforme(void* contexto, EstadoJogo* estado, GeradorAleatorio* gerador) {
+    MEDIR_FASE(FASE_POSICIONAMENTO);
+    (void)contexto;
+
+    for (int tentativa = 0; tentativa < 100; tentativa++) {
+        if (sortearFrota(estado, TAMANHOS_NAVIOS, MAX_NAVIOS, gerador)) {
+            return 1;
+        }
+        inicializarEstadoJogo(estado);
+    }
+    return 0;
+}
+
+/**
+ * Verifica se algum navio encosta em outro, inclusive na diagonal
+ */
+static int naviosSeTocam(const EstadoJogo* estado) {
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        Bitboard outros = bitboardDiferenca(estado->tabuleiro.navios, estado->mascarasNavios[n]);
+        Bitboard celulas = estado->mascarasNavios[n];
+        while (!bitboardVazioTeste(celulas)) {
+            int indice = bitboardExtrairPrimeiro(&celulas);
+            int linha = indice / TAMANHO_TABULEIRO, coluna = indice % TAMANHO_TABULEIRO;
+            for (int i = linha - 1; i <= linha + 1; i++) {
+                for (int j = coluna - 1; j <= coluna + 1; j++) {
+                    if (i >= 0 && i < TAMANHO_TABULEIRO && j >= 0 && j < TAMANHO_TABULEIRO &&
+                        bitboardTestar(outros, indiceCelula(i, j))) {
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Verifica se todos os navios têm pelo menos uma célula na borda do tabuleiro
+ */
+static int naviosNaBorda(const EstadoJogo* estado) {
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        const Navio* navio = &estado->navios[n];
+        int fimLinha = navio->inicio.linha + (navio->orientacao == 'H' ? 0 : navio->tamanho - 1);
+        int fimColuna = navio->inicio.coluna + (navio->orientacao == 'V' ? 0 : navio->tamanho - 1);
+        if (navio->inicio.linha > 0 && navio->inicio.coluna > 0 &&
+            fimLinha < TAMANHO_TABULEIRO - 1 && fimColuna < TAMANHO_TABULEIRO - 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Estratégia "espalhada": frota uniforme entre as que não têm navios encostados
+ * (rejeição sobre sortearFrota)
+ */
+static int posicionarFrotaEspalhada(void* contexto, EstadoJogo* estado, GeradorAleatorio* gerador) {
+    MEDIR_FASE(FASE_POSICIONAMENTO);
+    (void)contexto;
+
+    for (int tentativa = 0; tentativa < MAX_SORTEIOS_FROTA_RESTRITA; tentativa++) {
+        inicializarEstadoJogo(estado);
+        if (sortearFrota(estado, TAMANHOS_NAVIOS, MAX_NAVIOS, gerador) && !naviosSeTocam(estado)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Estratégia "bordas": frota uniforme entre as que têm todos os navios na borda
+ * (rejeição sobre sortearFrota)
+ */
+static int posicionarFrotaBordas(void* contexto, EstadoJogo* estado, GeradorAleatorio* gerador) {
+    MEDIR_FASE(FASE_POSICIONAMENTO);
+    (void)contexto;
+
+    for (int tentativa = 0; tentativa < MAX_SORTEIOS_FROTA_RESTRITA; tentativa++) {
+        inicializarEstadoJogo(estado);
+        if (sortearFrota(estado, TAMANHOS_NAVIOS, MAX_NAVIOS, gerador) && naviosNaBorda(estado)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Estratégia de ataque aleatório
+ * Alterna as habilidades em ordem e sorteia o centro de cada ataque
+ */
+static void escolherAtaqueAleatorio(void* contexto, const EstadoJogo* estado, GeradorAleatorio* gerador,
+                                    int* habilidade, Coordenada* centro) {
+    int quantidadeHabilidades = *(const int*)contexto;
+    *habilidade = estado->turno % quantidadeHabilidades;
+    centro->linha = (int)aleatorioLimitado(gerador, TAMANHO_TABULEIRO);
+    centro->coluna = (int)aleatorioLimitado(gerador, TAMANHO_TABULEIRO);
+}
+
+/*
+ * ============================================
+ * IA DE ATAQUE POR DENSIDADE DE PROBABILIDADE
+ * ============================================
+ */
+
+/**
+ * Soma (ou subtrai) a contribuição de um posicionamento no calor da classe e no mapa
+ *
+ * @param mapa Mapa de probabilidade
+ * @param classe Classe do posicionamento
+ * @param celulas Máscara do posicionamento
+ * @param delta Variação do peso do posicionamento
+ */
+static inline void ajustarPosicionamento(MapaProbabilidade* mapa, int classe, Bitboard celulas, int delta) {
+    const int deltaMapa = delta * mapa->vivos[classe];
+    while (!bitboardVazioTeste(celulas)) {
+        int celula = bitboardExtrairPrimeiro(&celulas);
+        mapa->calor[classe][celula] += delta;
+        mapa->mapa[celula] += deltaMapa;
+    }
+}
+
+/**
+ * Reinicia o mapa para uma frota nova, ainda sem nenhum disparo
+ * O calor inicial de cada classe é a contagem de posicionamentos por célula,
+ * já pré-calculada na tabela de posicionamentos
+ *
+ * @param mapa Mapa de probabilidade
+ * @param tamanhos Tamanhos dos navios da frota adversária
+ * @param quantidadeNavios Número de navios (até MAX_NAVIOS)
+ */
+void inicializarMapaProbabilidade(MapaProbabilidade* mapa, const int tamanhos[], int quantidadeNavios) {
+    // Navios de mesmo tamanho formam uma classe com multiplicidade
+    mapa->quantidadeClasses = 0;
+    for (int n = 0; n < quantidadeNavios; n++) {
+        int k = 0;
+        while (k < mapa->quantidadeClasses && mapa->tamanhos[k] != tamanhos[n]) {
+            k++;
+        }
+        if (k == mapa->quantidadeClasses) {
+            mapa->tamanhos[k] = tamanhos[n];
+            mapa->vivos[k] = 0;
+            mapa->quantidadeClasses++;
+        }
+        mapa->vivos[k]++;
+    }
+
+    memset(mapa->mapa, 0, sizeof(mapa->mapa));
+    for (int k = 0; k < mapa->quantidadeClasses; k++) {
+        const PosicionamentosNavio* tabela = obterPosicionamentos(mapa->tamanhos[k]);
+        memset(mapa->peso[k], 1, (size_t)tabela->quantidade);
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            mapa->calor[k][c] = tabela->quantidadePorCelula[c];
+            mapa->mapa[c] += mapa->vivos[k] * tabela->quantidadePorCelula[c];
+        }
+    }
+
+    mapa->acertosVistos = bitboardVazio();
+    mapa->errosVistos = bitboardVazio();
+    mapa->naviosAfundadosVistos = 0;
+}
+
+/**
+ * Descarta todos os posicionamentos que cobrem uma célula sabidamente livre
+ * (água atingida ou parte de um navio já afundado)
+ *
+ * @param mapa Mapa de probabilidade
+ * @param celula Índice da célula
+ */
+static void descartarPosicionamentosNaCelula(MapaProbabilidade* mapa, int celula) {
+    for (int k = 0; k < mapa->quantidadeClasses; k++) {
+        const PosicionamentosNavio* tabela = obterPosicionamentos(mapa->tamanhos[k]);
+        for (int i = 0; i < tabela->quantidadePorCelula[celula]; i++) {
+            int p = tabela->porCelula[celula][i];
+            if (mapa->peso[k][p] != 0) {
+                ajustarPosicionamento(mapa, k, tabela->mascaras[p], -mapa->peso[k][p]);
+                mapa->peso[k][p] = 0;
+            }
+        }
+    }
+}
+
+/**
+ * Reforça os posicionamentos compatíveis que passam por um novo acerto
+ *
+ * @param mapa Mapa de probabilidade
+ * @param celula Índice da célula acertada
+ */
+static void reforcarPosicionamentosNaCelula(MapaProbabilidade* mapa, int celula) {
+    for (int k = 0; k < mapa->quantidadeClasses; k++) {
+        const PosicionamentosNavio* tabela = obterPosicionamentos(mapa->tamanhos[k]);
+        for (int i = 0; i < tabela->quantidadePorCelula[celula]; i++) {
+            int p = tabela->porCelula[celula][i];
+            if (mapa->peso[k][p] != 0) {
+                ajustarPosicionamento(mapa, k, tabela->mascaras[p], PESO_ACERTO);
+                mapa->peso[k][p] += PESO_ACERTO;
+            }
+        }
+    }
+}
+
+/**
+ * Incorpora ao mapa apenas o que mudou no tabuleiro desde a última observação
+ * Custa O(células reveladas x posicionamentos por célula), nunca um recálculo completo
+ *
+ * @param mapa Mapa de probabilidade
+ * @param estado Estado da partida (somente o que o atacante pode observar)
+ */
+void atualizarMapaProbabilidade(MapaProbabilidade* mapa, const EstadoJogo* estado) {
+    Bitboard novosErros = bitboardDiferenca(estado->tabuleiro.erros, mapa->errosVistos);
+    Bitboard novosAcertos = bitboardDiferenca(estado->tabuleiro.acertos, mapa->acertosVistos);
+    mapa->errosVistos = estado->tabuleiro.erros;
+    mapa->acertosVistos = estado->tabuleiro.acertos;
+
+    while (!bitboardVazioTeste(novosErros)) {
+        descartarPosicionamentosNaCelula(mapa, bitboardExtrairPrimeiro(&novosErros));
+    }
+    while (!bitboardVazioTeste(novosAcertos)) {
+        reforcarPosicionamentosNaCelula(mapa, bitboardExtrairPrimeiro(&novosAcertos));
+    }
+
+    // Navio afundado: suas células deixam de servir a outros navios e a classe perde um membro
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        const Navio* navio = &estado->navios[n];
+        if (!navio->foiDestruido || (mapa->naviosAfundadosVistos & (1 << n))) {
+            continue;
+        }
+        mapa->naviosAfundadosVistos |= 1 << n;
+
+        Bitboard celulas = estado->mascarasNavios[n];
+        while (!bitboardVazioTeste(celulas)) {
+            descartarPosicionamentosNaCelula(mapa, bitboardExtrairPrimeiro(&celulas));
+        }
+
+        for (int k = 0; k < mapa->quantidadeClasses; k++) {
+            if (mapa->tamanhos[k] == navio->tamanho && mapa->vivos[k] > 0) {
+                mapa->vivos[k]--;
+                for (int c = 0; c < TOTAL_CELULAS; c++) {
+                    mapa->mapa[c] -= mapa->calor[k][c];
+                }
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Escolhe a habilidade e o centro com maior densidade somada nas células ainda não disparadas
+ * A soma é proporcional ao número esperado de acertos do ataque
+ *
+ * @param mapa Mapa de probabilidade atualizado
+ * @param habilidades Habilidades compiladas
+ * @param quantidadeHabilidades Número de habilidades
+ * @param disparadas Células já atingidas (acertos e erros)
+ * @param habilidade Saída: índice da habilidade
+ * @param centro Saída: centro do ataque
+ * @return Densidade somada do melhor ataque
+ */
+int64_t escolherMelhorAtaque(const MapaProbabilidade* mapa, const HabilidadeCompilada habilidades[],
+                             int quantidadeHabilidades, Bitboard disparadas,
+                             int* habilidade, Coordenada* centro) {
+    int64_t melhor = -1;
+    int melhorHabilidade = 0, melhorCentro = 0;
+
+    for (int h = 0; h < quantidadeHabilidades; h++) {
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            Bitboard alvo = bitboardDiferenca(habilidades[h].mascaras[c], disparadas);
+            int64_t soma = 0;
+            while (!bitboardVazioTeste(alvo)) {
+                soma += mapa->mapa[bitboardExtrairPrimeiro(&alvo)];
+            }
+            if (soma > melhor) {
+                melhor = soma;
+                melhorHabilidade = h;
+                melhorCentro = c;
+            }
+        }
+    }
+
+    *habilidade = melhorHabilidade;
+    centro->linha = melhorCentro / TAMANHO_TABULEIRO;
+    centro->coluna = melhorCentro % TAMANHO_TABULEIRO;
+    return melhor;
+}
+
+/**
+ * Recupera o padrão 5x5 de uma habilidade compilada
+ * A máscara do centro (2, 2) não sofre recorte nas bordas, então contém o
+ * padrão inteiro gerado por criarHabilidadeCone/Cruz/Octaedro
+ *
+ * @param habilidade Habilidade compilada
+ * @return Padrão com bit linha * TAMANHO_HABILIDADE + coluna
+ */
+uint32_t extrairPadraoHabilidade(const HabilidadeCompilada* habilidade) {
+    const int deslocamento = TAMANHO_HABILIDADE / 2;
+    Bitboard mascara = habilidade->mascaras[indiceCelula(deslocamento, deslocamento)];
+    uint32_t padrao = 0;
+    while (!bitboardVazioTeste(mascara)) {
+        int indice = bitboardExtrairPrimeiro(&mascara);
+        padrao |= BIT_PADRAO(indice / TAMANHO_TABULEIRO, indice % TAMANHO_TABULEIRO);
+    }
+    return padrao;
+}
+
+/**
+ * Monta a grade da convolução: densidade das células ainda não disparadas,
+ * cercada por zeros que fazem o papel do recorte das máscaras nas bordas
+ *
+ * @param mapa Densidade por célula
+ * @param disparadas Células já atingidas (contribuem com zero)
+ * @param grade Grade de saída
+ */
+static void prepararGradeConvolucao(const int32_t mapa[TOTAL_CELULAS], Bitboard disparadas,
+                                    int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO]) {
+    const int deslocamento = TAMANHO_HABILIDADE / 2;
+    memset(grade, 0, sizeof(int32_t) * LINHAS_GRADE_CONVOLUCAO * LARGURA_GRADE_CONVOLUCAO);
+    for (int c = 0; c < TOTAL_CELULAS; c++) {
+        if (!bitboardTestar(disparadas, c)) {
+            grade[c / TAMANHO_TABULEIRO + deslocamento][c % TAMANHO_TABULEIRO + deslocamento] = mapa[c];
+        }
+    }
+}
+
+/**
+ * Kernel escalar: pontuação de todos os centros para um padrão
+ * Cada célula do padrão soma uma linha deslocada da grade em todos os centros da linha
+ *
+ * @param grade Grade preparada por prepararGradeConvolucao
+ * @param padrao Padrão 5x5 da habilidade
+ * @param pontuacao Saída: soma por centro (índice de célula)
+ */
+static void convoluirEscalar(const int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO],
+                             uint32_t padrao, int32_t pontuacao[TOTAL_CELULAS]) {
+    for (int r = 0; r < TAMANHO_TABULEIRO; r++) {
+        int32_t linha[TAMANHO_TABULEIRO] = {0};
+        for (uint32_t restantes = padrao; restantes != 0; restantes &= restantes - 1) {
+            int bit = __builtin_ctz(restantes);
+            const int32_t* origem = &grade[r + bit / TAMANHO_HABILIDADE][bit % TAMANHO_HABILIDADE];
+            for (int c = 0; c < TAMANHO_TABULEIRO; c++) {
+                linha[c] += origem[c];
+            }
+        }
+        memcpy(&pontuacao[r * TAMANHO_TABULEIRO], linha, sizeof(linha));
+    }
+}
+
+#if CONVOLUCAO_AVX2
+/**
+ * Kernel AVX2: uma linha de centros em dois vetores de 8 colunas
+ */
+__attribute__((target("avx2")))
+static void convoluirAvx2(const int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO],
+                          uint32_t padrao, int32_t pontuacao[TOTAL_CELULAS]) {
+    for (int r = 0; r < TAMANHO_TABULEIRO; r++) {
+        __m256i baixo = _mm256_setzero_si256();
+        __m256i alto = _mm256_setzero_si256();
+        for (uint32_t restantes = padrao; restantes != 0; restantes &= restantes - 1) {
+            int bit = __builtin_ctz(restantes);
+            const int32_t* origem = &grade[r + bit / TAMANHO_HABILIDADE][bit % TAMANHO_HABILIDADE];
+            baixo = _mm256_add_epi32(baixo, _mm256_loadu_si256((const __m256i*)origem));
+            alto = _mm256_add_epi32(alto, _mm256_loadu_si256((const __m256i*)(origem + 8)));
+        }
+        int32_t linha[16];
+        _mm256_storeu_si256((__m256i*)linha, baixo);
+        _mm256_storeu_si256((__m256i*)(linha + 8), alto);
+        memcpy(&pontuacao[r * TAMANHO_TABULEIRO], linha, sizeof(int32_t) * TAMANHO_TABULEIRO);
+    }
+}
+#endif
+
+#if CONVOLUCAO_NEON
+/**
+ * Kernel NEON: uma linha de centros em três vetores de 4 colunas
+ */
+static void convoluirNeon(const int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO],
+                          uint32_t padrao, int32_t pontuacao[TOTAL_CELULAS]) {
+    for (int r = 0; r < TAMANHO_TABULEIRO; r++) {
+        int32x4_t a = vdupq_n_s32(0), b = vdupq_n_s32(0), c = vdupq_n_s32(0);
+        for (uint32_t restantes = padrao; restantes != 0; restantes &= restantes - 1) {
+            int bit = __builtin_ctz(restantes);
+            const int32_t* origem = &grade[r + bit / TAMANHO_HABILIDADE][bit % TAMANHO_HABILIDADE];
+            a = vaddq_s32(a, vld1q_s32(origem));
+            b = vaddq_s32(b, vld1q_s32(origem + 4));
+            c = vaddq_s32(c, vld1q_s32(origem + 8));
+        }
+        int32_t linha[12];
+        vst1q_s32(linha, a);
+        vst1q_s32(linha + 4, b);
+        vst1q_s32(linha + 8, c);
+        memcpy(&pontuacao[r * TAMANHO_TABULEIRO], linha, sizeof(int32_t) * TAMANHO_TABULEIRO);
+    }
+}
+#endif
+
+typedef void (*KernelConvolucao)(const int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO],
+                                 uint32_t padrao, int32_t pontuacao[TOTAL_CELULAS]);
+
+static KernelConvolucao kernelConvolucao = convoluirEscalar;
+static const char* nomeKernelConvolucao = "escalar";
+static pthread_once_t kernelConvolucaoEscolhido = PTHREAD_ONCE_INIT;
+
+/**
+ * Escolhe o melhor kernel suportado pelo processador (uma única vez)
+ */
+static void escolherKernelConvolucao(void) {
+#if CONVOLUCAO_NEON
+    kernelConvolucao = convoluirNeon;
+    nomeKernelConvolucao = "neon";
+#elif CONVOLUCAO_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        kernelConvolucao = convoluirAvx2;
+        nomeKernelConvolucao = "avx2";
+    }
+#endif
+}
+
+/**
+ * Retorna o nome do kernel de convolução em uso ("avx2", "neon" ou "escalar")
+ */
+const char* obterKernelConvolucao(void) {
+    pthread_once(&kernelConvolucaoEscolhido, escolherKernelConvolucao);
+    return nomeKernelConvolucao;
+}
+
+/**
+ * Pontua todos os centros de todas as habilidades por convolução e retorna o melhor
+ * Mesmo resultado de escolherMelhorAtaque (inclusive no desempate: primeira
+ * habilidade, depois primeiro centro em ordem de linha), em uma passada vetorial
+ *
+ * @param mapa Densidade por célula
+ * @param disparadas Células já atingidas
+ * @param padroes Padrão 5x5 de cada habilidade
+ * @param quantidadeHabilidades Número de habilidades
+ * @param vetorial 1 para o kernel vetorial disponível, 0 para o escalar
+ * @param habilidade Saída: índice da habilidade
+ * @param centro Saída: centro do ataque
+ * @return Densidade somada do melhor ataque
+ */
+int64_t escolherMelhorAtaqueConvolucao(const int32_t mapa[TOTAL_CELULAS], Bitboard disparadas,
+                                       const uint32_t padroes[], int quantidadeHabilidades, int vetorial,
+                                       int* habilidade, Coordenada* centro) {
+    pthread_once(&kernelConvolucaoEscolhido, escolherKernelConvolucao);
+    KernelConvolucao kernel = vetorial ? kernelConvolucao : convoluirEscalar;
+
+    int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO];
+    int32_t pontuacao[TOTAL_CELULAS];
+    prepararGradeConvolucao(mapa, disparadas, grade);
+
+    int32_t melhor = -1;
+    int melhorHabilidade = 0, melhorCentro = 0;
+    for (int h = 0; h < quantidadeHabilidades; h++) {
+        kernel(grade, padroes[h], pontuacao);
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            if (pontuacao[c] > melhor) {
+                melhor = pontuacao[c];
+                melhorHabilidade = h;
+                melhorCentro = c;
+            }
+        }
+    }
+
+    *habilidade = melhorHabilidade;
+    centro->linha = melhorCentro / TAMANHO_TABULEIRO;
+    centro->coluna = melhorCentro % TAMANHO_TABULEIRO;
+    return melhor;
+}
+
+/**
+ * Estratégia de ataque por densidade de probabilidade
+ * O mapa é reiniciado no turno 0 de cada partida e atualizado com as
+ * células reveladas pelo ataque anterior; os centros são pontuados por convolução
+ */
+static void escolherAtaqueDensidade(void* contexto, const EstadoJogo* estado, GeradorAleatorio* gerador,
+                                    int* habilidade, Coordenada* centro) {
+    ContextoAtaqueDensidade* ctx = contexto;
+    (void)gerador;
+
+    if (estado->turno == 0) {
+        inicializarMapaProbabilidade(&ctx->mapa, TAMANHOS_NAVIOS, MAX_NAVIOS);
+    }
+    atualizarMapaProbabilidade(&ctx->mapa, estado);
+
+    Bitboard disparadas = bitboardUniao(estado->tabuleiro.acertos, estado->tabuleiro.erros);
+    escolherMelhorAtaqueConvolucao(ctx->mapa.mapa, disparadas, ctx->padroes, ctx->quantidadeHabilidades, 1,
+                                   habilidade, centro);
+}
+
+/**
+ * Cria a estratégia de ataque por densidade de probabilidade
+ *
+ * @param contexto Contexto a ser usado pela estratégia (mantido pelo chamador)
+ * @param habilidades Habilidades compiladas disponíveis
+ * @param quantidadeHabilidades Número de habilidades (até MAX_HABILIDADES)
+ * @return Estratégia pronta para simularPartida ou para o Monte Carlo
+ */
+EstrategiaAtaque criarAtaqueDensidade(ContextoAtaqueDensidade* contexto, const HabilidadeCompilada habilidades[],
+                                      int quantidadeHabilidades) {
+    contexto->habilidades = habilidades;
+    contexto->quantidadeHabilidades = quantidadeHabilidades < MAX_HABILIDADES ? quantidadeHabilidades : MAX_HABILIDADES;
+    for (int h = 0; h < contexto->quantidadeHabilidades; h++) {
+        contexto->padroes[h] = extrairPadraoHabilidade(&habilidades[h]);
+    }
+    inicializarMapaProbabilidade(&contexto->mapa, TAMANHOS_NAVIOS, MAX_NAVIOS);
+
+    EstrategiaAtaque ataque = {"densidade", escolherAtaqueDensidade, contexto, sizeof(ContextoAtaqueDensidade)};
+    return ataque;
+}
+
+/**
+ * Executa uma partida completa em memória
+ * A partida termina quando a frota é destruída ou ao atingir MAX_TURNOS
+ *
+ * @param estado Estado de trabalho (reinicializado pela função)
+ * @param posicionamento Estratégia que posiciona a frota
+ * @param ataque Estratégia que escolhe os ataques
+ * @param habilidades Habilidades compiladas disponíveis
+ * @param gerador Gerador de números aleatórios da partida
+ * @param receptor Receptor de eventos (NULL no modo de simulação)
+ * @return Número de turnos jogados, ou -1 se o posicionamento falhar
+ */
+int simularPartida(EstadoJogo* estado,
+                   const EstrategiaPosicionamento* posicionamento,
+                   const EstrategiaAtaque* ataque,
+                   const HabilidadeCompilada habilidades[],
+                   GeradorAleatorio* gerador,
+                   const ReceptorEventos* receptor) {
+    inicializarEstadoJogo(estado);
+    if (!posicionamento->posicionarFrota(posicionamento->contexto, estado, gerador)) {
+        return -1;
+    }
+
+    while (estado->naviosRestantes > 0 && estado->turno < MAX_TURNOS) {
+        int indiceHabilidade;
+        Coordenada centro;
+        {
+            MEDIR_FASE(FASE_DECISAO);
+            ataque->escolherAtaque(ataque->contexto, estado, gerador, &indiceHabilidade, &centro);
+        }
+        resolverAtaque(estado, &habilidades[indiceHabilidade], centro, receptor);
+    }
+
+    return estado->turno;
+}
+
+/**
+ * Acumula o resultado de uma partida nos totais da simulação
+ *
+ * @param totais Totais do lote
+ * @param estado Estado final da partida
+ */
+void acumularPartida(EstatisticasSimulacao* totais, const EstadoJogo* estado) {
+    totais->partidas++;
+    totais->partidasVencidas += (estado->naviosRestantes == 0);
+    totais->turnos += estado->turno;
+    totais->totalTiros += estado->stats.totalTiros;
+    totais->acertos += estado->stats.acertos;
+    totais->erros += estado->stats.erros;
+    totais->naviosDestruidos += estado->stats.naviosDestruidos;
+}
+
+/**
+ * Cria as três habilidades padrão já compiladas
+ *
+ * @param habilidades Array com espaço para 3 habilidades (CONE, CRUZ, OCTAEDRO)
+ */
+void criarHabilidadesPadrao(HabilidadeCompilada habilidades[3]) {
+    int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+
+    criarHabilidadeCone(matriz);
+    compilarHabilidade(matriz, "CONE", &habilidades[0]);
+    criarHabilidadeCruz(matriz);
+    compilarHabilidade(matriz, "CRUZ", &habilidades[1]);
+    criarHabilidadeOctaedro(matriz);
+    compilarHabilidade(matriz, "OCTAEDRO", &habilidades[2]);
+}
+
+/**
+ * Retorna o tempo monotônico atual em segundos
+ */
+static double tempoAtual(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * Exibe o resumo de um lote de partidas simuladas
+ *
+ * @param totais Totais acumulados
+ * @param segundos Tempo total da simulação
+ */
+void exibirResumoSimulacao(const EstatisticasSimulacao* totais, double segundos) {
+    printf("\n╔══════════════════════════════════════╗\n");
+    printf("║        RESUMO DA SIMULAÇÃO           ║\n");
+    printf("╚══════════════════════════════════════╝\n");
+    printf("🎮 Partidas simuladas: %lld\n", totais->partidas);
+    if (totais->partidas > 0) {
+        printf("🏆 Frotas destruídas: %lld (%.1f%%)\n", totais->partidasVencidas,
+               (double)totais->partidasVencidas / totais->partidas * 100);
+        printf("🔁 Turnos por partida: %.2f\n", (double)totais->turnos / totais->partidas);
+        printf("🚢 Navios destruídos por partida: %.2f\n", (double)totais->naviosDestruidos / totais->partidas);
+    }
+    printf("📊 Total de tiros disparados: %lld\n", totais->totalTiros);
+    printf("🎯 Total de acertos: %lld\n", totais->acertos);
+    printf("❌ Total de erros: %lld\n", totais->erros);
+    if (totais->totalTiros > 0) {
+        printf("📈 Taxa de acerto geral: %.1f%%\n", (double)totais->acertos / totais->totalTiros * 100);
+    }
+    printf("⏱️  Tempo: %.3f s (%.0f partidas/s)\n", segundos,
+           segundos > 0 ? (double)totais->partidas / segundos : 0.0);
+}
+
+/**
+ * Indica se as habilidades do catálogo cabem na convolução da IA de densidade
+ */
+static int catalogoCompativelDensidade(const CatalogoHabilidades* catalogo) {
+    if (catalogo->quantidade > MAX_HABILIDADES) {
+        return 0;
+    }
+    for (int h = 0; h < catalogo->quantidade; h++) {
+        if (catalogo->lados[h] > TAMANHO_HABILIDADE) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Carrega um arquivo de padrões e lista as habilidades compiladas (--habilidades ARQUIVO)
+ *
+ * @param caminho Caminho do arquivo de padrões
+ * @return 0 se o arquivo é válido
+ */
+int executarCatalogoHabilidades(const char* caminho) {
+    CatalogoHabilidades catalogo;
+    int linhaErro;
+    double inicio = tempoAtual();
+    int resultado = carregarArquivoHabilidades(caminho, &catalogo, &linhaErro);
+    double segundos = tempoAtual() - inicio;
+    if (resultado == ERRO_MEMORIA) {
+        fprintf(stderr, "❌ Memória insuficiente para carregar %s\n", caminho);
+        destruirCatalogoHabilidades(&catalogo);
+        return 1;
+    }
+    if (resultado != SUCESSO) {
+        fprintf(stderr, "❌ Arquivo de habilidades inválido: %s (linha %d)\n", caminho, linhaErro);
+        destruirCatalogoHabilidades(&catalogo);
+        return 1;
+    }
+
+    printf("🧩 %s: %d habilidades compiladas em %.1f µs\n", caminho, catalogo.quantidade, segundos * 1e6);
+    printf("\n%-20s %5s %7s %16s\n", "Habilidade", "Lado", "Custo", "Células/ataque");
+    for (int h = 0; h < catalogo.quantidade; h++) {
+        long long celulas = 0;
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            celulas += bitboardContar(catalogo.habilidades[h].mascaras[c]);
+        }
+        printf("%-20s %5d %7d %16.1f\n", catalogo.habilidades[h].nome, catalogo.lados[h], catalogo.custos[h],
+               (double)celulas / TOTAL_CELULAS);
+    }
+    printf("\n🤖 IA de densidade e planejador: %s\n",
+           catalogoCompativelDensidade(&catalogo) ? "compatíveis" : "incompatíveis (carimbo maior que 5x5 ou mais de 8 habilidades)");
+    destruirCatalogoHabilidades(&catalogo);
+    return 0;
+}
+
+/*
+ * Roteiros de partida (--roteiro ARQUIVO): uma linha por comando, '#' inicia comentário
+ *   A5 H          posiciona o próximo navio da frota padrão (orientação H, V ou D)
+ *   CONE A5       ataca com uma habilidade padrão (CONE, CRUZ ou OCTAEDRO)
+ *   FIM           encerra a partida; a próxima começa com uma frota vazia
+ * As coordenadas passam pela mesma validação de lerCoordenada (interpretarCoordenada)
+ */
+enum {
+    COMANDO_VAZIO,
+    COMANDO_NAVIO,
+    COMANDO_ATAQUE,
+    COMANDO_FIM
+};
+
+typedef struct {
+    int tipo;
+    Coordenada coord;
+    char orientacao;
+    int habilidade;
+} ComandoRoteiro;
+
+/**
+ * Decodifica uma linha de roteiro no próprio buffer
+ *
+ * @param linha Linha terminada em '\0' (é modificada)
+ * @param comando Saída: comando decodificado
+ * @return SUCESSO, ERRO_COORDENADA_*, ERRO_HABILIDADE_INVALIDA ou ERRO_POSICAO_INVALIDA
+ */
+int interpretarComandoRoteiro(char* linha, ComandoRoteiro* comando) {
+    char* comentario = strchr(linha, '#');
+    if (comentario != NULL) {
+        *comentario = '\0';
+    }
+    char* cursor = linha;
+    char* primeira = proximaPalavraLinha(&cursor);
+    char* segunda = proximaPalavraLinha(&cursor);
+    comando->tipo = COMANDO_VAZIO;
+    if (primeira == NULL) {
+        return SUCESSO;
+    }
+    if (proximaPalavraLinha(&cursor) != NULL) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    if (strcmp(primeira, "FIM") == 0) {
+        comando->tipo = COMANDO_FIM;
+        return segunda == NULL ? SUCESSO : ERRO_POSICAO_INVALIDA;
+    }
+    if (segunda == NULL) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        if (strcmp(primeira, NOMES_HABILIDADES_PADRAO[h]) == 0) {
+            comando->tipo = COMANDO_ATAQUE;
+            comando->habilidade = h;
+            return interpretarCoordenada(segunda, TAMANHO_TABULEIRO, TAMANHO_TABULEIRO, &comando->coord);
+        }
+    }
+    int resultado = interpretarCoordenada(primeira, TAMANHO_TABULEIRO, TAMANHO_TABULEIRO, &comando->coord);
+    if (resultado != SUCESSO) {
+        // Uma palavra sem dígitos não é coordenada: era o nome de uma habilidade
+        return strpbrk(primeira, "0123456789") == NULL ? ERRO_HABILIDADE_INVALIDA : resultado;
+    }
+    char orientacao = segunda[0] >= 'a' && segunda[0] <= 'z' ? (char)(segunda[0] - 'a' + 'A') : segunda[0];
+    if (segunda[1] != '\0' || (orientacao != 'H' && orientacao != 'V' && orientacao != 'D')) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    comando->tipo = COMANDO_NAVIO;
+    comando->orientacao = orientacao;
+    return SUCESSO;
+}
+
+static const char* descreverErroRoteiro(int codigo) {
+    switch (codigo) {
+        case ERRO_COORDENADA_FORMATO: return "coordenada em formato inválido";
+        case ERRO_COORDENADA_COLUNA: return "coluna inválida";
+        case ERRO_COORDENADA_LINHA: return "linha inválida";
+        case ERRO_HABILIDADE_INVALIDA: return "habilidade desconhecida";
+        case ERRO_FORA_LIMITES: return "navio fora dos limites";
+        case ERRO_POSICAO_OCUPADA: return "navio sobre outro navio";
+        default: return "comando inválido";
+    }
+}
+
+/**
+ * Executa um roteiro de partidas lido de um arquivo ou da entrada padrão ("-")
+ * As linhas chegam em lotes de TAMANHO_BUFFER_COMANDOS e são decodificadas sem cópia
+ *
+ * @param caminho Arquivo do roteiro, ou "-" para a entrada padrão (pipe ou socket de um bot)
+ * @return 0 se todas as linhas eram válidas
+ */
+int executarRoteiro(const char* caminho) {
+    char* buffer = malloc(TAMANHO_BUFFER_COMANDOS);
+    EstadoJogo* estado = malloc(sizeof(EstadoJogo));
+    if (buffer == NULL || estado == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para o roteiro %s\n", caminho);
+        free(buffer);
+        free(estado);
+        return 1;
+    }
+    // Aberto depois das alocações: nenhuma saída de erro deixa o descritor aberto
+    int descritor = strcmp(caminho, "-") == 0 ? STDIN_FILENO : open(caminho, O_RDONLY | O_CLOEXEC);
+    if (descritor < 0) {
+        fprintf(stderr, "❌ Não foi possível ler o roteiro %s: %s\n", caminho, strerror(errno));
+        free(buffer);
+        free(estado);
+        return 1;
+    }
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    criarHabilidadesPadrao(habilidades);
+    LeitorComandos leitor;
+    iniciarLeitorComandos(&leitor, descritor, buffer, TAMANHO_BUFFER_COMANDOS);
+
+    long long linhas = 0, invalidas = 0, partidas = 0, navios = 0, ataques = 0, acertos = 0, frotasDestruidas = 0;
+    int partidaAberta = 0;
+    double inicio = tempoAtual();
+    for (;;) {
+        char* linha;
+        size_t comprimento;
+        int leitura = lerLinhaComandos(&leitor, &linha, &comprimento);
+        if (leitura == ERRO_ENTRADA_PENDENTE) {
+            esperarLeitorComandos(&leitor);
+            continue;
+        }
+        if (leitura != SUCESSO) {
+            break;
+        }
+        linhas++;
+
+        ComandoRoteiro comando;
+        int resultado = interpretarComandoRoteiro(linha, &comando);
+        if (resultado == SUCESSO && comando.tipo != COMANDO_VAZIO && comando.tipo != COMANDO_FIM && !partidaAberta) {
+            inicializarEstadoJogo(estado);
+            partidaAberta = 1;
+        }
+        if (resultado == SUCESSO && comando.tipo == COMANDO_NAVIO) {
+            // Navios só antes do primeiro ataque, na ordem da frota padrão
+            resultado = estado->stats.totalTiros > 0 || estado->quantidadeNavios == MAX_NAVIOS ? ERRO_POSICAO_INVALIDA :
+                        adicionarNavioEstado(estado, comando.coord, TAMANHOS_NAVIOS[estado->quantidadeNavios],
+                                             comando.orientacao);
+            navios += resultado == SUCESSO;
+        } else if (resultado == SUCESSO && comando.tipo == COMANDO_ATAQUE) {
+            acertos += resolverAtaque(estado, &habilidades[comando.habilidade], comando.coord, NULL);
+            ataques++;
+        }
+        if (resultado == SUCESSO && comando.tipo == COMANDO_FIM && partidaAberta) {
+            partidas++;
+            frotasDestruidas += estado->quantidadeNavios > 0 && estado->naviosRestantes == 0;
+            partidaAberta = 0;
+        }
+
+        if (resultado != SUCESSO) {
+            if (invalidas < MAX_ERROS_ROTEIRO) {
+                fprintf(stderr, "⚠️  %s:%lld: %s\n", caminho, linhas, descreverErroRoteiro(resultado));
+            }
+            invalidas++;
+        }
+    }
+    if (partidaAberta) {
+        partidas++;
+        frotasDestruidas += estado->quantidadeNavios > 0 && estado->naviosRestantes == 0;
+    }
+    double segundos = tempoAtual() - inicio;
+
+    printf("📜 Roteiro %s: %lld linhas em %.3f s (%.0f linhas/s)\n", caminho, linhas, segundos,
+           segundos > 0 ? (double)linhas / segundos : 0.0);
+    printf("🎮 Partidas: %lld | Navios: %lld | Ataques: %lld | Acertos: %lld | Frotas destruídas: %lld\n",
+           partidas, navios, ataques, acertos, frotasDestruidas);
+    if (invalidas > 0) {
+        printf("⚠️  Linhas inválidas: %lld\n", invalidas);
+    }
+    if (descritor != STDIN_FILENO) {
+        close(descritor);
+    }
+    free(buffer);
+    free(estado);
+    return invalidas > 0;
+}
+
+/**
+ * Executa o modo de simulação em lote (--simulate N)
+ * Nenhuma saída é produzida até o resumo final
+ *
+ * @param quantidadePartidas Número de partidas a simular
+ * @param semente Semente do gerador
+ * @param ataqueDensidade 1 para a IA de densidade, 0 para ataques aleatórios
+ * @param configuracaoPlanejador Configuração do planejador MCTS, ou NULL para não usá-lo
+ * @param catalogo Habilidades carregadas de arquivo, ou NULL para as padrão
+ * @return 0 se a simulação foi concluída
+ */
+int executarSimulacao(long long quantidadePartidas, uint64_t semente, int ataqueDensidade,
+                      const ConfiguracaoPlanejador* configuracaoPlanejador, const CatalogoHabilidades* catalogo) {
+    HabilidadeCompilada padrao[QUANTIDADE_HABILIDADES_PADRAO];
+    const HabilidadeCompilada* habilidades = padrao;
+    int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    if (catalogo != NULL) {
+        if ((ataqueDensidade || configuracaoPlanejador != NULL) && !catalogoCompativelDensidade(catalogo)) {
+            fprintf(stderr, "❌ A IA aceita até %d habilidades com carimbos de até %dx%d.\n",
+                    MAX_HABILIDADES, TAMANHO_HABILIDADE, TAMANHO_HABILIDADE);
+            return 1;
+        }
+        habilidades = catalogo->habilidades;
+        quantidadeHabilidades = catalogo->quantidade;
+    } else {
+        criarHabilidadesPadrao(padrao);
+    }
+
+    EstrategiaPosicionamento posicionamento = {"uniforme", posicionarFrotaUniforme, NULL};
+    EstrategiaAtaque ataque = {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0};
+    ContextoAtaqueDensidade contextoDensidade;
+    ContextoPlanejador* planejador = NULL;
+    if (configuracaoPlanejador != NULL) {
+        planejador = malloc(sizeof(ContextoPlanejador));
+        if (planejador == NULL || criarPlanejador(planejador, habilidades, quantidadeHabilidades,
+                                                  configuracaoPlanejador) != SUCESSO) {
+            fprintf(stderr, "❌ Não foi possível criar o planejador.\n");
+            free(planejador);
+            return 1;
+        }
+        ataque = criarAtaquePlanejador(planejador);
+    } else if (ataqueDensidade) {
+        ataque = criarAtaqueDensidade(&contextoDensidade, habilidades, quantidadeHabilidades);
+    }
+
+    GeradorAleatorio gerador;
+    inicializarGerador(&gerador, semente, 0);
+
+    EstatisticasSimulacao totais;
+    memset(&totais, 0, sizeof(totais));
+
+    EstadoJogo estado;
+    double inicio = tempoAtual();
+    for (long long i = 0; i < quantidadePartidas; i++) {
+        if (simularPartida(&estado, &posicionamento, &ataque, habilidades, &gerador, NULL) >= 0) {
+            acumularPartida(&totais, &estado);
+        }
+    }
+    double segundos = tempoAtual() - inicio;
+
+    printf("🎲 Simulação: posicionamento '%s', ataque '%s', semente %llu\n",
+           posicionamento.nome, ataque.nome, (unsigned long long)semente);
+    if (catalogo != NULL) {
+        printf("🧩 Habilidades do arquivo de padrões: %d\n", catalogo->quantidade);
+    }
+    exibirResumoSimulacao(&totais, segundos);
+    if (planejador != NULL) {
+        exibirEstatisticasPlanejador(planejador);
+        destruirPlanejador(planejador);
+        free(planejador);
+    }
+    return 0;
+}
+
+/**
+ * Assiste a uma partida simulada turno a turno (--assistir)
+ * Cada turno vira um quadro diferencial: só as células atingidas são
+ * redesenhadas e o quadro sai em um único write, próprio para espectadores
+ * e para repetir partidas em terminais remotos
+ *
+ * @param semente Semente da partida
+ * @param ataqueDensidade 1 para a IA de densidade, 0 para ataques aleatórios
+ * @param configuracaoPlanejador Configuração do planejador MCTS, ou NULL para não usá-lo
+ * @return 0 se a partida foi exibida
+ */
+int executarModoEspectador(uint64_t semente, int ataqueDensidade, const ConfiguracaoPlanejador* configuracaoPlanejador) {
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    const int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    criarHabilidadesPadrao(habilidades);
+    EstrategiaAtaque ataque = {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0};
+    ContextoAtaqueDensidade contextoDensidade;
+    ContextoPlanejador* planejador = NULL;
+    if (configuracaoPlanejador != NULL) {
+        planejador = malloc(sizeof(ContextoPlanejador));
+        if (planejador == NULL || criarPlanejador(planejador, habilidades, quantidadeHabilidades,
+                                                  configuracaoPlanejador) != SUCESSO) {
+            fprintf(stderr, "❌ Não foi possível criar o planejador.\n");
+            free(planejador);
+            return 1;
+        }
+        ataque = criarAtaquePlanejador(planejador);
+    } else if (ataqueDensidade) {
+        ataque = criarAtaqueDensidade(&contextoDensidade, habilidades, quantidadeHabilidades);
+    }
+
+    GeradorAleatorio gerador;
+    inicializarGerador(&gerador, semente, 0);
+
+    EstadoJogo estado;
+    inicializarEstadoJogo(&estado);
+    if (!posicionarFrotaUniforme(NULL, &estado, &gerador)) {
+        fprintf(stderr, "❌ Não foi possível posicionar a frota.\n");
+        if (planejador != NULL) {
+            destruirPlanejador(planejador);
+            free(planejador);
+        }
+        return 1;
+    }
+
+    const int terminal = isatty(STDOUT_FILENO);
+    const struct timespec atraso = {0, ATRASO_QUADRO_MS * 1000000L};
+    int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    RenderizadorDiferencial renderizador;
+    BufferQuadro quadro;
+    inicializarRenderizadorDiferencial(&renderizador);
+
+    for (;;) {
+        tabuleiroBitsParaMatriz(&estado.tabuleiro, tabuleiro);
+        quadroLimpar(&quadro);
+        renderizarDiferenca(&renderizador, &quadro, tabuleiro);
+
+        // Linha de status logo abaixo da legenda, apagada antes de reescrever
+        quadroAnexarCursor(&quadro, LINHA_APOS_QUADRO, 1);
+        QUADRO_ANEXAR_LITERAL(&quadro, "\033[K🎯 Turno ");
+        quadroAnexarInteiro(&quadro, estado.turno);
+        QUADRO_ANEXAR_LITERAL(&quadro, " | Tiros ");
+        quadroAnexarInteiro(&quadro, estado.stats.totalTiros);
+        QUADRO_ANEXAR_LITERAL(&quadro, " | Navios restantes ");
+        quadroAnexarInteiro(&quadro, estado.naviosRestantes);
+        quadroAnexarCaractere(&quadro, '\n');
+        emitirQuadro(&quadro, STDOUT_FILENO);
+
+        if (estado.naviosRestantes == 0 || estado.turno >= MAX_TURNOS) {
+            break;
+        }
+        if (terminal) {
+            nanosleep(&atraso, NULL);
+        }
+
+        int indiceHabilidade;
+        Coordenada centro;
+        {
+            MEDIR_FASE(FASE_DECISAO);
+            ataque.escolherAtaque(ataque.contexto, &estado, &gerador, &indiceHabilidade, &centro);
+        }
+        resolverAtaque(&estado, &habilidades[indiceHabilidade], centro, NULL);
+    }
+
+    printf("%s\n", estado.naviosRestantes == 0 ? "🏆 Frota destruída!" : "⏱️  Limite de turnos atingido.");
+    if (planejador != NULL) {
+        destruirPlanejador(planejador);
+        free(planejador);
+    }
+    return 0;
+}
+
+/*
+ * ============================================
+ * TABELA DE TRANSPOSIÇÃO
+ * ============================================
+ */
+
+/**
+ * Cria uma tabela de transposição vazia
+ *
+ * @param tabela Tabela a ser criada
+ * @param bitsEntradas log2 da quantidade de entradas
+ * @return SUCESSO ou ERRO_MEMORIA
+ */
+int criarTabelaTransposicao(TabelaTransposicao* tabela, int bitsEntradas) {
+    size_t quantidade = (size_t)1 << bitsEntradas;
+    tabela->mascara = quantidade - 1;
+    tabela->entradas = alocarAlinhadoCache(sizeof(EntradaTransposicao) * quantidade);
+    if (tabela->entradas == NULL) {
+        return ERRO_MEMORIA;
+    }
+    for (size_t i = 0; i < quantidade; i++) {
+        atomic_init(&tabela->entradas[i].verificacao, 0);
+        atomic_init(&tabela->entradas[i].dados, 0);
+    }
+    return SUCESSO;
+}
+
+void destruirTabelaTransposicao(TabelaTransposicao* tabela) {
+    free(tabela->entradas);
+    tabela->entradas = NULL;
+}
+
+/**
+ * Procura um estado na tabela; pode ser chamada por várias threads ao mesmo tempo
+ *
+ * @param tabela Tabela de transposição
+ * @param hash Hash Zobrist do estado
+ * @param dados Saída: valor gravado para o estado
+ * @param stats Contadores de quem consulta
+ * @return 1 se o estado estava na tabela
+ */
+static inline int consultarTransposicao(const TabelaTransposicao* tabela, uint64_t hash, uint64_t* dados,
+                                        EstatisticasTransposicao* stats) {
+    const EntradaTransposicao* entrada = &tabela->entradas[hash & tabela->mascara];
+    uint64_t valor = atomic_load_explicit(&entrada->dados, memory_order_relaxed);
+    uint64_t verificacao = atomic_load_explicit(&entrada->verificacao, memory_order_relaxed);
+    stats->consultas++;
+    // Entradas vazias têm dados zero, que nenhuma gravação usa
+    if (valor == 0 || (verificacao ^ valor) != hash) {
+        return 0;
+    }
+    stats->acertos++;
+    *dados = valor;
+    return 1;
+}
+
+/**
+ * Grava (ou substitui) o valor de um estado, sem travas
+ *
+ * @param dados Valor diferente de zero
+ */
+static inline void gravarTransposicao(TabelaTransposicao* tabela, uint64_t hash, uint64_t dados,
+                                      EstatisticasTransposicao* stats) {
+    EntradaTransposicao* entrada = &tabela->entradas[hash & tabela->mascara];
+    atomic_store_explicit(&entrada->dados, dados, memory_order_relaxed);
+    atomic_store_explicit(&entrada->verificacao, hash ^ dados, memory_order_relaxed);
+    stats->gravacoes++;
+}
+
+/**
+ * Exibe a taxa de acerto da tabela
+ */
+static void exibirEstatisticasTransposicao(const char* rotulo, const TabelaTransposicao* tabela,
+                                           const EstatisticasTransposicao* stats) {
+    printf("   %s: %lld consultas, %lld acertos (%.1f%%), %lld falhas, %lld gravações, %llu entradas\n",
+           rotulo, stats->consultas, stats->acertos,
+           stats->consultas > 0 ? 100.0 * (double)stats->acertos / (double)stats->consultas : 0.0,
+           stats->consultas - stats->acertos, stats->gravacoes, (unsigned long long)(tabela->mascara + 1));
+}
+
+/*
+ * ============================================
+ * POOL DE TRABALHO COM ROUBO DE TAREFAS
+ * ============================================
+ */
+
+/**
+ * Retira uma tarefa: primeiro do fim da própria fila, depois do início das filas vizinhas
+ *
+ * @return 1 se obteve uma tarefa
+ */
+static int retirarTarefa(PoolTrabalho* pool, int trabalhador, TarefaTrabalho* tarefa) {
+    FilaTrabalho* propria = &pool->filas[trabalhador];
+    pthread_mutex_lock(&propria->trava);
+    if (propria->fim != propria->inicio) {
+        *tarefa = propria->tarefas[--propria->fim % CAPACIDADE_FILA_TRABALHO];
+        pthread_mutex_unlock(&propria->trava);
+        atomic_fetch_sub(&pool->naFila, 1);
+        return 1;
+    }
+    pthread_mutex_unlock(&propria->trava);
+
+    for (int k = 1; k < pool->quantidadeThreads; k++) {
+        FilaTrabalho* vitima = &pool->filas[(trabalhador + k) % pool->quantidadeThreads];
+        pthread_mutex_lock(&vitima->trava);
+        if (vitima->fim != vitima->inicio) {
+            *tarefa = vitima->tarefas[vitima->inicio++ % CAPACIDADE_FILA_TRABALHO];
+            pthread_mutex_unlock(&vitima->trava);
+            atomic_fetch_sub(&pool->naFila, 1);
+            atomic_fetch_add(&pool->roubos, 1);
+            return 1;
+        }
+        pthread_mutex_unlock(&vitima->trava);
+    }
+    return 0;
+}
+
+/**
+ * Executa uma tarefa e sinaliza quem aguarda o pool quando não restar nenhuma
+ */
+static void concluirTarefa(PoolTrabalho* pool, TarefaTrabalho tarefa, int trabalhador) {
+    tarefa.executar(tarefa.argumento, pool, trabalhador);
+    atomic_fetch_add(&pool->executadas, 1);
+    if (atomic_fetch_sub(&pool->pendentes, 1) == 1) {
+        pthread_mutex_lock(&pool->trava);
+        pthread_cond_broadcast(&pool->concluido);
+        pthread_mutex_unlock(&pool->trava);
+    }
+}
+
+/**
+ * Submete uma tarefa à fila de um trabalhador
+ * Trabalhadores submetem à própria fila; de fora do pool (trabalhador = -1)
+ * as filas são usadas em rodízio. Com a fila cheia a tarefa roda na hora
+ *
+ * @param pool Pool de trabalho
+ * @param trabalhador Índice do trabalhador que submete, ou -1
+ * @param tarefa Tarefa a executar
+ */
+void submeterTarefa(PoolTrabalho* pool, int trabalhador, TarefaTrabalho tarefa) {
+    int indice = trabalhador >= 0 ? trabalhador
+                                  : (int)(atomic_fetch_add(&pool->proximaFila, 1) % (unsigned)pool->quantidadeThreads);
+    FilaTrabalho* fila = &pool->filas[indice];
+    atomic_fetch_add(&pool->pendentes, 1);
+
+    pthread_mutex_lock(&fila->trava);
+    int cheia = fila->fim - fila->inicio == CAPACIDADE_FILA_TRABALHO;
+    if (!cheia) {
+        fila->tarefas[fila->fim++ % CAPACIDADE_FILA_TRABALHO] = tarefa;
+    }
+    pthread_mutex_unlock(&fila->trava);
+
+    if (cheia) {
+        concluirTarefa(pool, tarefa, trabalhador);
+        return;
+    }
+    atomic_fetch_add(&pool->naFila, 1);
+    pthread_mutex_lock(&pool->trava);
+    pthread_cond_signal(&pool->haTrabalho);
+    pthread_mutex_unlock(&pool->trava);
+}
+
+typedef struct {
+    PoolTrabalho* pool;
+    int indice;
+} ParametrosTrabalhador;
+
+static void* executarTrabalhador(void* argumento) {
+    ParametrosTrabalhador* parametros = argumento;
+    PoolTrabalho* pool = parametros->pool;
+    const int indice = parametros->indice;
+    free(parametros);
+
+    for (;;) {
+        TarefaTrabalho tarefa;
+        if (retirarTarefa(pool, indice, &tarefa)) {
+            concluirTarefa(pool, tarefa, indice);
+            continue;
+        }
+        pthread_mutex_lock(&pool->trava);
+        while (atomic_load(&pool->naFila) == 0 && !pool->encerrar) {
+            pthread_cond_wait(&pool->haTrabalho, &pool->trava);
+        }
+        int encerrar = pool->encerrar && atomic_load(&pool->naFila) == 0;
+        pthread_mutex_unlock(&pool->trava);
+        if (encerrar) {
+            return NULL;
+        }
+    }
+}
+
+/**
+ * Cria o pool e inicia suas threads
+ *
+ * @param quantidadeThreads Número de trabalhadores (1 a MAX_THREADS)
+ * @return Pool criado, ou NULL se faltar memória ou não for possível criar as threads
+ */
+PoolTrabalho* criarPoolTrabalho(int quantidadeThreads) {
+    PoolTrabalho* pool = calloc(1, sizeof(PoolTrabalho));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->filas = alocarAlinhadoCache(sizeof(FilaTrabalho) * (size_t)quantidadeThreads);
+    pool->threads = malloc(sizeof(pthread_t) * (size_t)quantidadeThreads);
+    if (pool->filas == NULL || pool->threads == NULL) {
+        free(pool->filas);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    for (int t = 0; t < quantidadeThreads; t++) {
+        pthread_mutex_init(&pool->filas[t].trava, NULL);
+        pool->filas[t].inicio = pool->filas[t].fim = 0;
+    }
+    pthread_mutex_init(&pool->trava, NULL);
+    pthread_cond_init(&pool->haTrabalho, NULL);
+    pthread_cond_init(&pool->concluido, NULL);
+
+    for (int t = 0; t < quantidadeThreads; t++) {
+        ParametrosTrabalhador* parametros = malloc(sizeof(ParametrosTrabalhador));
+        if (parametros != NULL) {
+            parametros->pool = pool;
+            parametros->indice = t;
+        }
+        if (parametros == NULL || pthread_create(&pool->threads[t], NULL, executarTrabalhador, parametros) != 0) {
+            free(parametros);
+            break;
+        }
+        pool->quantidadeThreads++;
+    }
+    if (pool->quantidadeThreads == 0) {
+        free(pool->filas);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * Aguarda até que nenhuma tarefa esteja enfileirada ou em execução
+ */
+void aguardarPoolTrabalho(PoolTrabalho* pool) {
+    pthread_mutex_lock(&pool->trava);
+    while (atomic_load(&pool->pendentes) > 0) {
+        pthread_cond_wait(&pool->concluido, &pool->trava);
+    }
+    pthread_mutex_unlock(&pool->trava);
+}
+
+/**
+ * Conclui as tarefas pendentes, encerra as threads e libera o pool
+ *
+ * @param pool Pool a destruir (pode ser NULL)
+ */
+void destruirPoolTrabalho(PoolTrabalho* pool) {
+    if (pool == NULL) {
+        return;
+    }
+    aguardarPoolTrabalho(pool);
+    pthread_mutex_lock(&pool->trava);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->haTrabalho);
+    pthread_mutex_unlock(&pool->trava);
+    for (int t = 0; t < pool->quantidadeThreads; t++) {
+        pthread_join(pool->threads[t], NULL);
+        pthread_mutex_destroy(&pool->filas[t].trava);
+    }
+    pthread_mutex_destroy(&pool->trava);
+    pthread_cond_destroy(&pool->haTrabalho);
+    pthread_cond_destroy(&pool->concluido);
+    free(pool->filas);
+    free(pool->threads);
+    free(pool);
+}
+
+/*
+ * ============================================
+ * PLANEJADOR MCTS PARALELO
+ * ============================================
+ *
+ * A cada decisão, várias árvores de busca (ARVORES_POR_THREAD por trabalhador)
+ * crescem em paralelo até o fim do orçamento de tempo. Cada iteração sorteia
+ * uma frota oculta compatível com o que já foi observado, desce a árvore por
+ * UCT aplicando os ataques com o diário de jogadas e, depois de desfazê-los,
+ * propaga a recompensa: partes acertadas e navios afundados, com desconto por
+ * turno. As ações de cada nó são as melhores (habilidade, centro) da
+ * convolução na raiz, então a árvore decide qual habilidade disparar, onde e
+ * em que ordem nos próximos HORIZONTE_PLANEJADOR turnos
+ */
+
+/*
+ * Aproximações para o UCT sem depender da libm (a tarefa de build não liga -lm):
+ * log2 pela representação do float (aproximação de Mitchell) e raiz por Newton
+ */
+static inline float log2Aproximado(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (float)bits * (1.0f / (1 << 23)) - 127.0f;
+}
+
+static inline float raizAproximada(float x) {
+    if (x <= 0.0f) {
+        return 0.0f;
+    }
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = (bits >> 1) + (127u << 22);
+    float r;
+    memcpy(&r, &bits, sizeof(r));
+    r = 0.5f * (r + x / r);
+    return 0.5f * (r + x / r);
+}
+
+/**
+ * Sorteia um posicionamento da classe com probabilidade proporcional ao peso do mapa
+ */
+static inline int sortearPosicionamento(const ContextoPlanejador* planejador, int classe, GeradorAleatorio* gerador) {
+    const PosicionamentosNavio* tabela = obterPosicionamentos(planejador->densidade.mapa.tamanhos[classe]);
+    const uint32_t* acumulado = planejador->acumulado[classe];
+    if (acumulado[tabela->quantidade - 1] == 0) {
+        return 0;   // Classe sem posicionamento compatível: a determinização será rejeitada
+    }
+    uint32_t alvo = aleatorioLimitado(gerador, acumulado[tabela->quantidade - 1]);
+    int inicio = 0, fim = tabela->quantidade - 1;
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (acumulado[meio] > alvo) {
+            fim = meio;
+        } else {
+            inicio = meio + 1;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * Sorteia de novo a frota oculta da determinização (disparos e afundados vêm do estado observado)
+ * Os navios vivos não se sobrepõem, não cobrem água nem navios afundados (peso zero)
+ * e, juntos, cobrem todos os acertos ainda não explicados por um afundamento
+ *
+ * @return 1 se a frota sorteada é compatível com tudo o que foi observado
+ */
+static int sortearDeterminizacao(ArvorePlanejador* arvore) {
+    const ContextoPlanejador* planejador = arvore->planejador;
+    EstadoJogo* estado = &arvore->estado;
+
+    for (int tentativa = 0; tentativa < TENTATIVAS_DETERMINIZACAO; tentativa++) {
+        Bitboard ocupadas = planejador->observado.tabuleiro.navios;   // Navios afundados
+        int valida = 1;
+        for (int n = 0; valida && n < estado->quantidadeNavios; n++) {
+            int classe = planejador->classeNavio[n];
+            if (classe < 0) {
+                continue;
+            }
+            const PosicionamentosNavio* tabela = obterPosicionamentos(estado->navios[n].tamanho);
+            Bitboard mascara = bitboardVazio();
+            int partes = 0;
+            valida = 0;
+            int k = 0;
+            for (int sorteio = 0; sorteio < TENTATIVAS_DETERMINIZACAO && !valida; sorteio++) {
+                k = sortearPosicionamento(planejador, classe, &arvore->gerador);
+                mascara = tabela->mascaras[k];
+                partes = estado->navios[n].tamanho -
+                         bitboardContar(bitboardIntersecao(mascara, estado->tabuleiro.acertos));
+                // Um navio vivo nunca está com todas as partes atingidas
+                valida = partes > 0 && bitboardVazioTeste(bitboardIntersecao(mascara, ocupadas));
+            }
+            estado->mascarasNavios[n] = mascara;
+            estado->navios[n].partesRestantes = partes;
+            estado->navios[n].inicio = tabela->inicios[k];
+            estado->navios[n].orientacao = tabela->orientacoes[k];
+            marcarCelulasNavio(estado, n);
+            ocupadas = bitboardUniao(ocupadas, mascara);
+        }
+        if (valida && bitboardVazioTeste(bitboardDiferenca(planejador->acertosPendentes, ocupadas))) {
+            estado->tabuleiro.navios = ocupadas;
+            return 1;
+        }
+    }
+
+    // Sem frota compatível: a última tentativa serve como aproximação
+    Bitboard ocupadas = planejador->observado.tabuleiro.navios;
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        // Um navio que nunca chegou a ser sorteado fica com a máscara vazia e fora do mapa
+        if (planejador->classeNavio[n] >= 0 && !bitboardVazioTeste(estado->mascarasNavios[n])) {
+            ocupadas = bitboardUniao(ocupadas, estado->mascarasNavios[n]);
+            marcarCelulasNavio(estado, n);
+        }
+    }
+    estado->tabuleiro.navios = ocupadas;
+    return 0;
+}
+
+/**
+ * Cria um nó sem filhos expandidos
+ *
+ * @return Índice do nó, ou -1 se a árvore estiver cheia
+ */
+static inline int criarNoPlanejador(ArvorePlanejador* arvore) {
+    if (arvore->quantidadeNos == MAX_NOS_ARVORE) {
+        return -1;
+    }
+    NoPlanejador* no = &arvore->nos[arvore->quantidadeNos];
+    memset(no->filhos, 0xff, sizeof(no->filhos));
+    no->visitas = 0;
+    no->recompensa = 0;
+    return arvore->quantidadeNos++;
+}
+
+/**
+ * Escolhe o filho de maior UCT; ações não expandidas têm prioridade, na ordem dos candidatos
+ *
+ * @return Índice da ação candidata
+ */
+static int selecionarAcaoPlanejador(const ArvorePlanejador* arvore, const NoPlanejador* no, int quantidadeAcoes) {
+    int melhor = 0;
+    float melhorValor = -1.0f;
+    const float logVisitas = log2Aproximado((float)no->visitas + 1.0f);
+    for (int a = 0; a < quantidadeAcoes; a++) {
+        if (no->filhos[a] < 0) {
+            return a;
+        }
+        const NoPlanejador* filho = &arvore->nos[no->filhos[a]];
+        float valor = filho->recompensa / (float)filho->visitas +
+                      EXPLORACAO_PLANEJADOR * raizAproximada(logVisitas / (float)filho->visitas);
+        if (valor > melhorValor) {
+            melhorValor = valor;
+            melhor = a;
+        }
+    }
+    return melhor;
+}
+
+/**
+ * Uma iteração: determinização, descida por UCT, expansão, simulação até o horizonte e propagação
+ */
+static void iterarPlanejador(ArvorePlanejador* arvore) {
+    const ContextoPlanejador* planejador = arvore->planejador;
+    const int quantidadeAcoes = planejador->quantidadeCandidatos;
+    EstadoJogo* estado = &arvore->estado;
+    int caminho[HORIZONTE_PLANEJADOR + 1];
+    int profundidadeArvore = 0;
+
+    arvore->falhas += !sortearDeterminizacao(arvore);
+    inicializarDiario(&arvore->diario);
+    caminho[0] = 0;
+
+    float retorno = 0.0f, fator = 1.0f;
+    int naArvore = 1;
+    for (int d = 0; d < HORIZONTE_PLANEJADOR && estado->naviosRestantes > 0; d++) {
+        int acao;
+        if (naArvore) {
+            NoPlanejador* no = &arvore->nos[caminho[profundidadeArvore]];
+            acao = selecionarAcaoPlanejador(arvore, no, quantidadeAcoes);
+            if (no->filhos[acao] < 0) {
+                no->filhos[acao] = (int16_t)criarNoPlanejador(arvore);
+                naArvore = 0;   // Nó recém-expandido: o restante é simulação
+            }
+            if (no->filhos[acao] >= 0) {
+                caminho[++profundidadeArvore] = no->filhos[acao];
+            }
+        } else {
+            acao = (int)aleatorioLimitado(&arvore->gerador, (uint32_t)quantidadeAcoes);
+        }
+
+        int acertos = aplicarJogadaDiario(estado, &arvore->diario, planejador->densidade.habilidades,
+                                          planejador->candidatos[acao]);
+        int afundados = __builtin_popcount(arvore->diario.jogadas[arvore->diario.quantidade - 1].afundados);
+        retorno += fator * (float)(acertos + BONUS_AFUNDAMENTO * afundados);
+        fator *= DESCONTO_PLANEJADOR;
+    }
+
+    retorno /= planejador->recompensaMaxima;
+    for (int d = 0; d <= profundidadeArvore; d++) {
+        arvore->nos[caminho[d]].visitas++;
+        arvore->nos[caminho[d]].recompensa += retorno;
+    }
+    arvore->iteracoes++;
+
+    // O diário devolve o estado ao observado em O(células alteradas)
+    while (desfazerJogada(estado, &arvore->diario) == SUCESSO) {}
+}
+
+/**
+ * Tarefa do pool: um bloco de iterações em uma árvore; reenfileira-se até o prazo
+ */
+static void executarTarefaPlanejador(void* argumento, PoolTrabalho* pool, int trabalhador) {
+    ArvorePlanejador* arvore = argumento;
+    for (int i = 0; i < ITERACOES_POR_TAREFA; i++) {
+        iterarPlanejador(arvore);
+    }
+    if (tempoAtual() < arvore->planejador->prazo) {
+        TarefaTrabalho continuacao = {executarTarefaPlanejador, arvore};
+        submeterTarefa(pool, trabalhador, continuacao);
+    }
+}
+
+/**
+ * Seleciona as ações candidatas: os melhores centros de cada habilidade segundo a convolução,
+ * em ordem decrescente de densidade (a ordem em que a árvore as expande)
+ *
+ * @return Quantidade de candidatos com densidade positiva
+ */
+static int selecionarCandidatosPlanejador(ContextoPlanejador* planejador, Bitboard disparadas) {
+    const ContextoAtaqueDensidade* densidade = &planejador->densidade;
+    const int porHabilidade = MAX_CANDIDATOS_PLANEJADOR / densidade->quantidadeHabilidades < CANDIDATOS_POR_HABILIDADE ?
+                              MAX_CANDIDATOS_PLANEJADOR / densidade->quantidadeHabilidades : CANDIDATOS_POR_HABILIDADE;
+    int32_t grade[LINHAS_GRADE_CONVOLUCAO][LARGURA_GRADE_CONVOLUCAO];
+    int32_t pontuacao[TOTAL_CELULAS];
+    int32_t pontos[MAX_CANDIDATOS_PLANEJADOR];
+    int quantidade = 0;
+
+    pthread_once(&kernelConvolucaoEscolhido, escolherKernelConvolucao);
+    prepararGradeConvolucao(densidade->mapa.mapa, disparadas, grade);
+
+    for (int h = 0; h < densidade->quantidadeHabilidades; h++) {
+        kernelConvolucao(grade, densidade->padroes[h], pontuacao);
+        for (int k = 0; k < porHabilidade; k++) {
+            int melhor = -1;
+            for (int c = 0; c < TOTAL_CELULAS; c++) {
+                if (pontuacao[c] > 0 && (melhor < 0 || pontuacao[c] > pontuacao[melhor])) {
+                    melhor = c;
+                }
+            }
+            if (melhor < 0) {
+                break;
+            }
+
+            // Inserção ordenada entre os candidatos já escolhidos
+            int posicao = quantidade++;
+            while (posicao > 0 && pontos[posicao - 1] < pontuacao[melhor]) {
+                pontos[posicao] = pontos[posicao - 1];
+                planejador->candidatos[posicao] = planejador->candidatos[posicao - 1];
+                posicao--;
+            }
+            pontos[posicao] = pontuacao[melhor];
+            planejador->candidatos[posicao].habilidade = (uint8_t)h;
+            planejador->candidatos[posicao].centro = (uint8_t)melhor;
+            pontuacao[melhor] = 0;
+        }
+    }
+    planejador->quantidadeCandidatos = quantidade;
+    return quantidade;
+}
+
+/**
+ * Prepara o estado observado e as tabelas de sorteio da decisão corrente
+ */
+static void prepararDecisaoPlanejador(ContextoPlanejador* planejador, const EstadoJogo* estado) {
+    const MapaProbabilidade* mapa = &planejador->densidade.mapa;
+    EstadoJogo* observado = &planejador->observado;
+
+    // Pesos acumulados: posicionamentos descartados pelo mapa têm peso zero
+    for (int k = 0; k < mapa->quantidadeClasses; k++) {
+        const PosicionamentosNavio* tabela = obterPosicionamentos(mapa->tamanhos[k]);
+        uint32_t soma = 0;
+        for (int p = 0; p < tabela->quantidade; p++) {
+            soma += mapa->peso[k][p];
+            planejador->acumulado[k][p] = soma;
+        }
+    }
+
+    // Navios afundados são públicos; os vivos serão sorteados em cada iteração
+    memset(observado, 0, sizeof(EstadoJogo));
+    observado->hash = estado->hash;
+    observado->tabuleiro.acertos = estado->tabuleiro.acertos;
+    observado->tabuleiro.erros = estado->tabuleiro.erros;
+    observado->quantidadeNavios = estado->quantidadeNavios;
+    observado->naviosRestantes = estado->naviosRestantes;
+    observado->turno = estado->turno;
+    Bitboard afundadas = bitboardVazio();
+    int partesVivas = 0;
+    for (int n = 0; n < estado->quantidadeNavios; n++) {
+        observado->navios[n].tamanho = estado->navios[n].tamanho;
+        observado->navios[n].foiDestruido = estado->navios[n].foiDestruido;
+        planejador->classeNavio[n] = -1;
+        if (estado->navios[n].foiDestruido) {
+            observado->mascarasNavios[n] = estado->mascarasNavios[n];
+            afundadas = bitboardUniao(afundadas, estado->mascarasNavios[n]);
+            continue;
+        }
+        for (int k = 0; k < mapa->quantidadeClasses; k++) {
+            if (mapa->tamanhos[k] == estado->navios[n].tamanho) {
+                planejador->classeNavio[n] = k;
+            }
+        }
+        partesVivas += estado->navios[n].tamanho;
+    }
+    observado->tabuleiro.navios = afundadas;
+    planejador->acertosPendentes = bitboardDiferenca(estado->tabuleiro.acertos, afundadas);
+
+    partesVivas -= bitboardContar(planejador->acertosPendentes);
+    planejador->recompensaMaxima = (float)(partesVivas + BONUS_AFUNDAMENTO * estado->naviosRestantes);
+}
+
+/**
+ * Estratégia de ataque do planejador
+ * Mantém o mapa de densidade como a estratégia "densidade" e usa o tempo da
+ * decisão para comparar as melhores ações por busca sobre frotas sorteadas
+ */
+static void escolherAtaquePlanejador(void* contexto, const EstadoJogo* estado, GeradorAleatorio* gerador,
+                                     int* habilidade, Coordenada* centro) {
+    ContextoPlanejador* planejador = contexto;
+    ContextoAtaqueDensidade* densidade = &planejador->densidade;
+
+    if (estado->turno == 0) {
+        inicializarMapaProbabilidade(&densidade->mapa, TAMANHOS_NAVIOS, MAX_NAVIOS);
+    }
+    atualizarMapaProbabilidade(&densidade->mapa, estado);
+    planejador->decisoes++;
+
+    // Estado já decidido (a abertura de toda partida, por exemplo): reaproveita a ação sem nova busca
+    uint64_t decidido;
+    if (consultarTransposicao(&planejador->transposicao, estado->hash, &decidido, &planejador->statsTransposicao)) {
+        *habilidade = (int)(decidido >> 8 & 0xFF);
+        centro->linha = (int)(decidido & 0xFF) / TAMANHO_TABULEIRO;
+        centro->coluna = (int)(decidido & 0xFF) % TAMANHO_TABULEIRO;
+        return;
+    }
+
+    Bitboard disparadas = bitboardUniao(estado->tabuleiro.acertos, estado->tabuleiro.erros);
+    if (selecionarCandidatosPlanejador(planejador, disparadas) < 2) {
+        escolherMelhorAtaqueConvolucao(densidade->mapa.mapa, disparadas, densidade->padroes,
+                                       densidade->quantidadeHabilidades, 1, habilidade, centro);
+        return;
+    }
+
+    prepararDecisaoPlanejador(planejador, estado);
+    planejador->prazo = tempoAtual() + planejador->orcamento;
+    for (int a = 0; a < planejador->quantidadeArvores; a++) {
+        ArvorePlanejador* arvore = &planejador->arvores[a];
+        arvore->quantidadeNos = 0;
+        arvore->iteracoes = 0;
+        arvore->falhas = 0;
+        memcpy(&arvore->estado, &planejador->observado, sizeof(EstadoJogo));
+        criarNoPlanejador(arvore);
+        inicializarGerador(&arvore->gerador, proximoAleatorio(gerador), (uint64_t)a + 1);
+        TarefaTrabalho tarefa = {executarTarefaPlanejador, arvore};
+        submeterTarefa(planejador->pool, -1, tarefa);
+    }
+    aguardarPoolTrabalho(planejador->pool);
+
+    // Decisão: ação mais visitada somando todas as árvores
+    long long visitas[MAX_CANDIDATOS_PLANEJADOR] = {0};
+    for (int a = 0; a < planejador->quantidadeArvores; a++) {
+        const ArvorePlanejador* arvore = &planejador->arvores[a];
+        for (int c = 0; c < planejador->quantidadeCandidatos; c++) {
+            if (arvore->nos[0].filhos[c] >= 0) {
+                visitas[c] += arvore->nos[arvore->nos[0].filhos[c]].visitas;
+            }
+        }
+        planejador->iteracoes += arvore->iteracoes;
+        planejador->falhasDeterminizacao += arvore->falhas;
+    }
+    int melhor = 0;
+    for (int c = 1; c < planejador->quantidadeCandidatos; c++) {
+        if (visitas[c] > visitas[melhor]) {
+            melhor = c;
+        }
+    }
+
+    *habilidade = planejador->candidatos[melhor].habilidade;
+    centro->linha = planejador->candidatos[melhor].centro / TAMANHO_TABULEIRO;
+    centro->coluna = planejador->candidatos[melhor].centro % TAMANHO_TABULEIRO;
+    // O bit 16 mantém os dados diferentes de zero mesmo para a habilidade 0 no centro 0
+    gravarTransposicao(&planejador->transposicao, estado->hash,
+                       1ULL << 16 | (uint64_t)*habilidade << 8 | planejador->candidatos[melhor].centro,
+                       &planejador->statsTransposicao);
+}
+
+/**
+ * Cria o planejador: mapa de densidade, árvores e o pool de trabalho persistente
+ *
+ * @param planejador Contexto a inicializar
+ * @param habilidades Habilidades compiladas disponíveis
+ * @param quantidadeHabilidades Número de habilidades
+ * @param configuracao Threads e orçamento de tempo por decisão
+ * @return SUCESSO ou ERRO_MEMORIA
+ */
+int criarPlanejador(ContextoPlanejador* planejador, const HabilidadeCompilada habilidades[],
+                    int quantidadeHabilidades, const ConfiguracaoPlanejador* configuracao) {
+    memset(planejador, 0, sizeof(*planejador));
+    criarAtaqueDensidade(&planejador->densidade, habilidades, quantidadeHabilidades);
+
+    int threads = configuracao->threads;
+    if (threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    threads = threads > MAX_THREADS ? MAX_THREADS : threads;
+    planejador->orcamento = (configuracao->orcamentoMs > 0 ? configuracao->orcamentoMs : ORCAMENTO_PLANEJADOR_MS) / 1000.0;
+
+    planejador->quantidadeArvores = threads * ARVORES_POR_THREAD;
+    planejador->arvores = alocarAlinhadoCache(sizeof(ArvorePlanejador) * (size_t)planejador->quantidadeArvores);
+    planejador->pool = criarPoolTrabalho(threads);
+    int tabelaCriada = criarTabelaTransposicao(&planejador->transposicao, BITS_TRANSPOSICAO_PLANEJADOR);
+    if (planejador->arvores == NULL || planejador->pool == NULL || tabelaCriada != SUCESSO) {
+        destruirPlanejador(planejador);
+        return ERRO_MEMORIA;
+    }
+    for (int a = 0; a < planejador->quantidadeArvores; a++) {
+        planejador->arvores[a].planejador = planejador;
+    }
+    return SUCESSO;
+}
+
+void destruirPlanejador(ContextoPlanejador* planejador) {
+    destruirPoolTrabalho(planejador->pool);
+    destruirTabelaTransposicao(&planejador->transposicao);
+    free(planejador->arvores);
+    planejador->pool = NULL;
+    planejador->arvores = NULL;
+}
+
+/**
+ * Cria a estratégia de ataque do planejador
+ * O contexto tem threads e árvores próprias, portanto não é copiado por thread
+ * do Monte Carlo: use-o em partidas sequenciais (--simulate, --assistir)
+ *
+ * @param planejador Planejador criado por criarPlanejador
+ * @return Estratégia pronta para simularPartida
+ */
+EstrategiaAtaque criarAtaquePlanejador(ContextoPlanejador* planejador) {
+    EstrategiaAtaque ataque = {"planejador", escolherAtaquePlanejador, planejador, 0};
+    return ataque;
+}
+
+/**
+ * Exibe os contadores do planejador e do seu pool de trabalho
+ */
+void exibirEstatisticasPlanejador(const ContextoPlanejador* planejador) {
+    printf("🌲 Planejador: %d threads, %d árvores, %.0f ms por decisão\n",
+           planejador->pool->quantidadeThreads, planejador->quantidadeArvores, planejador->orcamento * 1000.0);
+    printf("   Decisões: %lld | Iterações por decisão: %.0f | Tarefas: %lld | Roubos: %lld\n",
+           planejador->decisoes,
+           planejador->decisoes > 0 ? (double)planejador->iteracoes / (double)planejador->decisoes : 0.0,
+           (long long)atomic_load(&planejador->pool->executadas), (long long)atomic_load(&planejador->pool->roubos));
+    printf("   Frotas sorteadas sem cobrir todos os acertos: %.2f%%\n",
+           planejador->iteracoes > 0 ? 100.0 * (double)planejador->falhasDeterminizacao / (double)planejador->iteracoes : 0.0);
+    exibirEstatisticasTransposicao("Transposição", &planejador->transposicao, &planejador->statsTransposicao);
+}
+
+/*
+ * ============================================
+ * MOTOR MONTE CARLO PARALELO
+ * ============================================
+ */
+
+/**
+ * Resultado parcial de uma thread do Monte Carlo
+ * Alinhado à linha de cache para que threads vizinhas não disputem a mesma
+ * linha enquanto acumulam; cada thread escreve apenas no próprio resultado
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) EstatisticasSimulacao totais;
+    uint64_t frotasAvaliadas;
+    // Soma, para cada habilidade e centro, dos acertos e navios afundados por um ataque isolado
+    uint64_t acertosPorCentro[QUANTIDADE_HABILIDADES_PADRAO][TOTAL_CELULAS];
+    uint64_t afundadosPorCentro[QUANTIDADE_HABILIDADES_PADRAO][TOTAL_CELULAS];
+} ResultadoMonteCarlo;
+
+/**
+ * Tarefa de uma thread do Monte Carlo
+ * Cada thread tem seu próprio fluxo aleatório, estado de jogo e estatísticas
+ */
+typedef struct {
+    const HabilidadeCompilada* habilidades;
+    const EstrategiaPosicionamento* posicionamento;
+    const EstrategiaAtaque* ataque;
+    long long partidas;
+    uint64_t semente;
+    int indice;
+    int avaliarIsolados;            // 0 = apenas as partidas completas (sem a avaliação por centro)
+    ResultadoMonteCarlo* resultado;
+} TarefaMonteCarlo;
+
+/**
+ * Avalia um único ataque de cada habilidade em cada centro contra uma frota nova
+ * O tabuleiro não é modificado: acertos e navios afundados vêm das máscaras
+ *
+ * @param estado Estado com a frota recém-posicionada
+ * @param habilidades Habilidades compiladas
+ * @param resultado Resultado parcial da thread
+ */
+static void avaliarAtaquesIsolados(const EstadoJogo* estado, const HabilidadeCompilada habilidades[],
+                                   ResultadoMonteCarlo* resultado) {
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            Bitboard alvo = habilidades[h].mascaras[c];
+            int afundados = 0;
+
+            for (int n = 0; n < estado->quantidadeNavios; n++) {
+                afundados += bitboardVazioTeste(bitboardDiferenca(estado->mascarasNavios[n], alvo));
+            }
+
+            resultado->acertosPorCentro[h][c] += (uint64_t)bitboardContar(bitboardIntersecao(alvo, estado->tabuleiro.navios));
+            resultado->afundadosPorCentro[h][c] += (uint64_t)afundados;
+        }
+    }
+}
+
+/**
+ * Corpo de uma thread do Monte Carlo
+ * Joga as partidas do seu fragmento sem nenhuma sincronização
+ *
+ * @param argumento Ponteiro para TarefaMonteCarlo
+ * @return NULL
+ */
+static void* executarTarefaMonteCarlo(void* argumento) {
+    TarefaMonteCarlo* tarefa = (TarefaMonteCarlo*)argumento;
+    ResultadoMonteCarlo* resultado = tarefa->resultado;
+    GeradorAleatorio gerador;
+    EstadoJogo estado;
+
+    // Estratégias com estado recebem uma cópia própria do contexto nesta thread
+    EstrategiaAtaque ataque = *tarefa->ataque;
+    void* contextoPrivado = NULL;
+    if (ataque.tamanhoContextoPrivado > 0) {
+        contextoPrivado = malloc(ataque.tamanhoContextoPrivado);
+        if (contextoPrivado == NULL) {
+            return NULL;
+        }
+        memcpy(contextoPrivado, ataque.contexto, ataque.tamanhoContextoPrivado);
+        ataque.contexto = contextoPrivado;
+    }
+
+    inicializarGerador(&gerador, tarefa->semente, (uint64_t)tarefa->indice + 1);
+
+    for (long long i = 0; i < tarefa->partidas; i++) {
+        // Avaliação isolada: uma frota nova, todas as habilidades em todos os centros
+        inicializarEstadoJogo(&estado);
+        if (tarefa->avaliarIsolados &&
+            tarefa->posicionamento->posicionarFrota(tarefa->posicionamento->contexto, &estado, &gerador)) {
+            avaliarAtaquesIsolados(&estado, tarefa->habilidades, resultado);
+            resultado->frotasAvaliadas++;
+        }
+
+        // Partida completa com as estratégias configuradas
+        if (simularPartida(&estado, tarefa->posicionamento, &ataque,
+                           tarefa->habilidades, &gerador, NULL) >= 0) {
+            acumularPartida(&resultado->totais, &estado);
+        }
+    }
+
+    free(contextoPrivado);
+    return NULL;
+}
+
+/**
+ * Soma um resultado parcial no resultado final
+ * Chamada somente após o join de todas as threads
+ *
+ * @param destino Resultado final
+ * @param origem Resultado parcial de uma thread
+ */
+static void mesclarResultadoMonteCarlo(ResultadoMonteCarlo* destino, const ResultadoMonteCarlo* origem) {
+    destino->totais.partidas += origem->totais.partidas;
+    destino->totais.partidasVencidas += origem->totais.partidasVencidas;
+    destino->totais.turnos += origem->totais.turnos;
+    destino->totais.totalTiros += origem->totais.totalTiros;
+    destino->totais.acertos += origem->totais.acertos;
+    destino->totais.erros += origem->totais.erros;
+    destino->totais.naviosDestruidos += origem->totais.naviosDestruidos;
+    destino->frotasAvaliadas += origem->frotasAvaliadas;
+
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            destino->acertosPorCentro[h][c] += origem->acertosPorCentro[h][c];
+            destino->afundadosPorCentro[h][c] += origem->afundadosPorCentro[h][c];
+        }
+    }
+}
+
+/**
+ * Executa o Monte Carlo distribuindo as partidas em várias threads
+ * Cada thread recebe um fragmento contíguo das partidas e um fluxo aleatório
+ * próprio; os resultados são mesclados sem locks depois do join
+ *
+ * @param habilidades Habilidades compiladas (QUANTIDADE_HABILIDADES_PADRAO)
+ * @param posicionamento Estratégia de posicionamento
+ * @param ataque Estratégia de ataque
+ * @param partidas Total de partidas
+ * @param quantidadeThreads Número de threads de trabalho
+ * @param semente Semente base
+ * @param final Resultado mesclado (zerado pela função)
+ * @return 1 se bem-sucedido, 0 em caso de falha ao criar threads
+ */
+int executarMonteCarloParalelo(const HabilidadeCompilada habilidades[],
+                               const EstrategiaPosicionamento* posicionamento,
+                               const EstrategiaAtaque* ataque,
+                               long long partidas, int quantidadeThreads, uint64_t semente,
+                               ResultadoMonteCarlo* final) {
+    pthread_t threads[MAX_THREADS];
+    TarefaMonteCarlo tarefas[MAX_THREADS];
+    ResultadoMonteCarlo* parciais = alocarAlinhadoCache(sizeof(ResultadoMonteCarlo) * (size_t)quantidadeThreads);
+    if (parciais == NULL) {
+        return 0;
+    }
+    memset(parciais, 0, sizeof(ResultadoMonteCarlo) * (size_t)quantidadeThreads);
+    memset(final, 0, sizeof(*final));
+
+    int iniciadas = 0;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        tarefas[t].habilidades = habilidades;
+        tarefas[t].posicionamento = posicionamento;
+        tarefas[t].ataque = ataque;
+        tarefas[t].partidas = partidas / quantidadeThreads + (t < partidas % quantidadeThreads);
+        tarefas[t].semente = semente;
+        tarefas[t].indice = t;
+        tarefas[t].avaliarIsolados = 1;
+        tarefas[t].resultado = &parciais[t];
+
+        if (pthread_create(&threads[t], NULL, executarTarefaMonteCarlo, &tarefas[t]) != 0) {
+            break;
+        }
+        iniciadas++;
+    }
+
+    for (int t = 0; t < iniciadas; t++) {
+        pthread_join(threads[t], NULL);
+        mesclarResultadoMonteCarlo(final, &parciais[t]);
+    }
+
+    free(parciais);
+    return iniciadas == quantidadeThreads;
+}
+
+/**
+ * Exibe uma tabela 10x10 com o valor esperado por centro de ataque
+ *
+ * @param titulo Título da tabela
+ * @param somas Soma dos valores por centro
+ * @param amostras Número de amostras
+ */
+static void exibirTabelaPorCentro(const char* titulo, const uint64_t somas[TOTAL_CELULAS], uint64_t amostras) {
+    printf("\n%s\n", titulo);
+    printf("    ");
+    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+        printf("   %c  ", colunaParaLetra(j));
+    }
+    printf("\n");
+
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        printf(" %d: ", i);
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            printf(" %.3f", amostras > 0 ? (double)somas[indiceCelula(i, j)] / (double)amostras : 0.0);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * Executa o modo Monte Carlo (--montecarlo N)
+ * Relata, para cada habilidade, os acertos e navios afundados esperados por
+ * centro contra uma frota aleatória, além do resumo das partidas completas
+ *
+ * @param partidas Número de partidas (e frotas avaliadas)
+ * @param quantidadeThreads Número de threads (0 = todos os núcleos)
+ * @param semente Semente base
+ * @param ataqueDensidade 1 para a IA de densidade, 0 para ataques aleatórios
+ * @return 0 se bem-sucedido
+ */
+int executarModoMonteCarlo(long long partidas, int quantidadeThreads, uint64_t semente, int ataqueDensidade) {
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    const int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    criarHabilidadesPadrao(habilidades);
+
+    if (quantidadeThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        quantidadeThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (quantidadeThreads > MAX_THREADS) {
+        quantidadeThreads = MAX_THREADS;
+    }
+
+    EstrategiaPosicionamento posicionamento = {"uniforme", posicionarFrotaUniforme, NULL};
+    EstrategiaAtaque ataque = {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0};
+    ContextoAtaqueDensidade contextoDensidade;
+    if (ataqueDensidade) {
+        ataque = criarAtaqueDensidade(&contextoDensidade, habilidades, quantidadeHabilidades);
+    }
+
+    ResultadoMonteCarlo* resultado = alocarAlinhadoCache(sizeof(ResultadoMonteCarlo));
+    if (resultado == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para o Monte Carlo.\n");
+        return 1;
+    }
+
+    double inicio = tempoAtual();
+    int ok = executarMonteCarloParalelo(habilidades, &posicionamento, &ataque,
+                                        partidas, quantidadeThreads, semente, resultado);
+    double segundos = tempoAtual() - inicio;
+
+    if (!ok) {
+        fprintf(stderr, "❌ Falha ao criar as threads do Monte Carlo.\n");
+        free(resultado);
+        return 1;
+    }
+
+    printf("🎲 Monte Carlo: %lld partidas em %d threads, ataque '%s', semente %llu\n",
+           partidas, quantidadeThreads, ataque.nome, (unsigned long long)semente);
+
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        char titulo[MAX_NOME_HABILIDADE + 64];
+        snprintf(titulo, sizeof(titulo), "🎯 %.*s - acertos esperados por centro:",
+                 MAX_NOME_HABILIDADE, habilidades[h].nome);
+        exibirTabelaPorCentro(titulo, resultado->acertosPorCentro[h], resultado->frotasAvaliadas);
+        snprintf(titulo, sizeof(titulo), "🚢 %.*s - navios afundados esperados por centro:",
+                 MAX_NOME_HABILIDADE, habilidades[h].nome);
+        exibirTabelaPorCentro(titulo, resultado->afundadosPorCentro[h], resultado->frotasAvaliadas);
+    }
+
+    exibirResumoSimulacao(&resultado->totais, segundos);
+    free(resultado);
+    return 0;
+}
+
+/*
+ * ============================================
+ * REGISTRO BINÁRIO DE PARTIDAS
+ * ============================================
+ *
+ * Arquivo:  cabeçalho de 8 bytes ("BNREG", versão, 2 bytes reservados) seguido de blocos
+ * Bloco:    tamanho da carga (u32), partidas no bloco (u32), CRC-32 da carga (u32), carga;
+ *           inteiros do cabeçalho em little-endian, uma partida nunca atravessa blocos
+ * Partida:  varint quantidadeNavios
+ *           por navio:  varint célula inicial, varint (tamanho << 2 | orientação 0=H 1=V 2=D)
+ *           por ataque: varint (habilidade * TOTAL_CELULAS + centro + 1),
+ *                       varint (acertos << MAX_NAVIOS | navios afundados pelo ataque)
+ *           varint 0 encerra a partida
+ * Os varints são LEB128 sem sinal: um ataque típico ocupa 3 bytes
+ */
+
+// Tabelas do CRC-32 fatiado em 8: oito bytes por iteração em vez de um
+static uint32_t tabelaCrc32[8][256];
+static pthread_once_t tabelaCrc32Criada = PTHREAD_ONCE_INIT;
+
+static void criarTabelaCrc32(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        tabelaCrc32[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int t = 1; t < 8; t++) {
+            uint32_t anterior = tabelaCrc32[t - 1][i];
+            tabelaCrc32[t][i] = (anterior >> 8) ^ tabelaCrc32[0][anterior & 0xFFu];
+        }
+    }
+}
+
+/**
+ * Calcula o CRC-32 (IEEE 802.3) de um trecho
+ *
+ * @param dados Bytes do trecho
+ * @param tamanho Quantidade de bytes
+ * @return CRC-32 dos bytes
+ */
+uint32_t calcularCrc32(const uint8_t* dados, size_t tamanho) {
+    pthread_once(&tabelaCrc32Criada, criarTabelaCrc32);
+    uint32_t crc = 0xFFFFFFFFu;
+    size_t i = 0;
+    for (; i + 8 <= tamanho; i += 8) {
+        uint32_t baixo = crc ^ ((uint32_t)dados[i] | (uint32_t)dados[i + 1] << 8 |
+                                (uint32_t)dados[i + 2] << 16 | (uint32_t)dados[i + 3] << 24);
+        crc = tabelaCrc32[7][baixo & 0xFFu] ^ tabelaCrc32[6][(baixo >> 8) & 0xFFu] ^
+              tabelaCrc32[5][(baixo >> 16) & 0xFFu] ^ tabelaCrc32[4][baixo >> 24] ^
+              tabelaCrc32[3][dados[i + 4]] ^ tabelaCrc32[2][dados[i + 5]] ^
+              tabelaCrc32[1][dados[i + 6]] ^ tabelaCrc32[0][dados[i + 7]];
+    }
+    for (; i < tamanho; i++) {
+        crc = (crc >> 8) ^ tabelaCrc32[0][(crc ^ dados[i]) & 0xFFu];
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static inline void escreverU32(uint8_t* destino, uint32_t valor) {
+    destino[0] = (uint8_t)valor;
+    destino[1] = (uint8_t)(valor >> 8);
+    destino[2] = (uint8_t)(valor >> 16);
+    destino[3] = (uint8_t)(valor >> 24);
+}
+
+static inline uint32_t lerU32(const uint8_t* origem) {
+    return (uint32_t)origem[0] | (uint32_t)origem[1] << 8 | (uint32_t)origem[2] << 16 | (uint32_t)origem[3] << 24;
+}
+
+static inline void escreverU64(uint8_t* destino, uint64_t valor) {
+    escreverU32(destino, (uint32_t)valor);
+    escreverU32(destino + 4, (uint32_t)(valor >> 32));
+}
+
+static inline uint64_t lerU64(const uint8_t* origem) {
+    return (uint64_t)lerU32(origem) | (uint64_t)lerU32(origem + 4) << 32;
+}
+
+/**
+ * Codifica um varint LEB128
+ *
+ * @param destino Posição de escrita (precisa de até 10 bytes)
+ * @param valor Valor a codificar
+ * @return Posição logo após o varint
+ */
+static inline uint8_t* codificarVarint(uint8_t* destino, uint64_t valor) {
+    while (valor >= 0x80) {
+        *destino++ = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    *destino++ = (uint8_t)valor;
+    return destino;
+}
+
+/**
+ * Decodifica um varint LEB128, sem ler além do fim do bloco
+ *
+ * @param cursor Posição de leitura (avança)
+ * @param fim Fim do bloco
+ * @param valor Saída: valor decodificado
+ * @return 1 se válido, 0 se truncado ou longo demais
+ */
+static inline int decodificarVarint(const uint8_t** cursor, const uint8_t* fim, uint64_t* valor) {
+    const uint8_t* p = *cursor;
+    uint64_t resultado = 0;
+    for (int deslocamento = 0; deslocamento < 64 && p < fim; deslocamento += 7) {
+        uint8_t byte = *p++;
+        resultado |= (uint64_t)(byte & 0x7F) << deslocamento;
+        if ((byte & 0x80) == 0) {
+            *cursor = p;
+            *valor = resultado;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Abre (e trunca) um arquivo de registro e grava o cabeçalho
+ *
+ * @param gravador Gravador a ser inicializado
+ * @param caminho Caminho do arquivo
+ * @return SUCESSO ou ERRO_ES se o arquivo não puder ser criado
+ */
+int abrirGravadorRegistro(GravadorRegistro* gravador, const char* caminho) {
+    uint8_t cabecalho[TAMANHO_CABECALHO_REGISTRO] = {0};
+    memcpy(cabecalho, ASSINATURA_REGISTRO, sizeof(ASSINATURA_REGISTRO) - 1);
+    cabecalho[sizeof(ASSINATURA_REGISTRO) - 1] = VERSAO_REGISTRO;
+
+    gravador->descritor = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (gravador->descritor < 0) {
+        return ERRO_ES;
+    }
+    gravador->erro = escreverTudo(gravador->descritor, cabecalho, sizeof(cabecalho)) != SUCESSO;
+    gravador->tamanho = 0;
+    gravador->inicioPartida = 0;
+    gravador->partidasNoBloco = 0;
+    gravador->partidasGravadas = 0;
+    gravador->bytesGravados = gravador->erro ? 0 : sizeof(cabecalho);
+    return gravador->erro ? ERRO_ES : SUCESSO;
+}
+
+/**
+ * Grava as partidas completas do bloco e move a partida em andamento para o início
+ */
+static void gravarBlocoRegistro(GravadorRegistro* gravador) {
+    uint8_t* carga = &gravador->bloco[TAMANHO_CABECALHO_BLOCO];
+    size_t completos = gravador->inicioPartida;
+
+    escreverU32(&gravador->bloco[0], (uint32_t)completos);
+    escreverU32(&gravador->bloco[4], gravador->partidasNoBloco);
+    escreverU32(&gravador->bloco[8], calcularCrc32(carga, completos));
+    // Depois de um erro nada mais é gravado, para o arquivo não ficar com um buraco no meio
+    if (!gravador->erro) {
+        if (escreverTudo(gravador->descritor, gravador->bloco, TAMANHO_CABECALHO_BLOCO + completos) == SUCESSO) {
+            gravador->bytesGravados += TAMANHO_CABECALHO_BLOCO + completos;
+            gravador->partidasGravadas += gravador->partidasNoBloco;
+        } else {
+            gravador->erro = 1;
+        }
+    }
+
+    memmove(carga, carga + completos, gravador->tamanho - completos);
+    gravador->tamanho -= completos;
+    gravador->inicioPartida = 0;
+    gravador->partidasNoBloco = 0;
+}
+
+/**
+ * Garante espaço para um evento no bloco, gravando o bloco se necessário
+ *
+ * @return Posição de escrita, ou NULL se a partida sozinha exceder o bloco
+ */
+static inline uint8_t* reservarEventoRegistro(GravadorRegistro* gravador) {
+    if (gravador->tamanho + MAX_BYTES_EVENTO > TAMANHO_BLOCO_REGISTRO) {
+        if (gravador->inicioPartida == 0) {
+            gravador->erro = 1;
+            return NULL;
+        }
+        gravarBlocoRegistro(gravador);
+    }
+    return &gravador->bloco[TAMANHO_CABECALHO_BLOCO + gravador->tamanho];
+}
+
+static inline void confirmarEventoRegistro(GravadorRegistro* gravador, const uint8_t* fim) {
+    gravador->tamanho = (size_t)(fim - &gravador->bloco[TAMANHO_CABECALHO_BLOCO]);
+}
+
+/**
+ * Inicia uma partida no registro com a frota posicionada
+ *
+ * @param gravador Gravador aberto
+ * @param navios Navios da frota
+ * @param quantidadeNavios Número de navios (até MAX_NAVIOS)
+ */
+void gravarInicioPartida(GravadorRegistro* gravador, const Navio navios[], int quantidadeNavios) {
+    uint8_t* p = reservarEventoRegistro(gravador);
+    if (p == NULL) {
+        return;
+    }
+    confirmarEventoRegistro(gravador, codificarVarint(p, (uint64_t)quantidadeNavios));
+
+    for (int n = 0; n < quantidadeNavios; n++) {
+        const Navio* navio = &navios[n];
+        int orientacao = navio->orientacao == 'H' ? 0 : navio->orientacao == 'V' ? 1 : 2;
+        if ((p = reservarEventoRegistro(gravador)) == NULL) {
+            return;
+        }
+        p = codificarVarint(p, (uint64_t)indiceCelula(navio->inicio.linha, navio->inicio.coluna));
+        p = codificarVarint(p, (uint64_t)navio->tamanho << 2 | (uint64_t)orientacao);
+        confirmarEventoRegistro(gravador, p);
+    }
+}
+
+/**
+ * Acrescenta um ataque e seu resultado à partida em andamento
+ *
+ * @param gravador Gravador aberto
+ * @param habilidade Índice da habilidade
+ * @param centro Centro do ataque
+ * @param acertos Novos acertos
+ * @param afundados Máscara dos navios afundados pelo ataque
+ */
+void gravarAtaqueRegistro(GravadorRegistro* gravador, int habilidade, Coordenada centro,
+                          int acertos, int afundados) {
+    uint8_t* p = reservarEventoRegistro(gravador);
+    if (p == NULL) {
+        return;
+    }
+    p = codificarVarint(p, (uint64_t)habilidade * TOTAL_CELULAS + (uint64_t)indiceCelula(centro.linha, centro.coluna) + 1);
+    p = codificarVarint(p, (uint64_t)acertos << MAX_NAVIOS | (uint64_t)afundados);
+    confirmarEventoRegistro(gravador, p);
+}
+
+/**
+ * Encerra a partida em andamento
+ *
+ * @param gravador Gravador aberto
+ */
+void gravarFimPartida(GravadorRegistro* gravador) {
+    uint8_t* p = reservarEventoRegistro(gravador);
+    if (p == NULL) {
+        return;
+    }
+    confirmarEventoRegistro(gravador, codificarVarint(p, 0));
+    gravador->inicioPartida = gravador->tamanho;
+    gravador->partidasNoBloco++;
+}
+
+/**
+ * Grava o último bloco e fecha o arquivo (uma partida incompleta é descartada)
+ *
+ * @param gravador Gravador aberto
+ * @return SUCESSO ou ERRO_ES se alguma escrita falhou
+ */
+int fecharGravadorRegistro(GravadorRegistro* gravador) {
+    if (gravador->partidasNoBloco > 0) {
+        gravarBlocoRegistro(gravador);
+    }
+    if (close(gravador->descritor) != 0) {
+        gravador->erro = 1;
+    }
+    return gravador->erro ? ERRO_ES : SUCESSO;
+}
+
+/**
+ * Mapeia um arquivo de registro para leitura
+ *
+ * @param leitor Leitor a ser inicializado
+ * @param caminho Caminho do arquivo
+ * @param validarBlocos 1 para conferir o CRC de cada bloco
+ * @return SUCESSO, ERRO_ES se não abrir ou ERRO_REGISTRO_CORROMPIDO
+ */
+int abrirLeitorRegistro(LeitorRegistro* leitor, const char* caminho, int validarBlocos) {
+    int descritor = open(caminho, O_RDONLY);
+    if (descritor < 0) {
+        return ERRO_ES;
+    }
+
+    struct stat info;
+    if (fstat(descritor, &info) != 0 || info.st_size < TAMANHO_CABECALHO_REGISTRO) {
+        close(descritor);
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+
+    void* mapeamento = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descritor, 0);
+    close(descritor);   // O mapeamento continua válido sem o descritor
+    if (mapeamento == MAP_FAILED) {
+        return ERRO_ES;
+    }
+    madvise(mapeamento, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    leitor->dados = mapeamento;
+    leitor->tamanho = (size_t)info.st_size;
+    leitor->proximoBloco = TAMANHO_CABECALHO_REGISTRO;
+    leitor->cursor = leitor->fimBloco = NULL;
+    leitor->partidasRestantes = 0;
+    leitor->partidaAberta = 0;
+    leitor->validarBlocos = validarBlocos;
+
+    if (memcmp(leitor->dados, ASSINATURA_REGISTRO, sizeof(ASSINATURA_REGISTRO) - 1) != 0 ||
+        leitor->dados[sizeof(ASSINATURA_REGISTRO) - 1] != VERSAO_REGISTRO) {
+        munmap(mapeamento, leitor->tamanho);
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+    return SUCESSO;
+}
+
+/**
+ * Desfaz o mapeamento do arquivo
+ *
+ * @param leitor Leitor aberto
+ */
+void fecharLeitorRegistro(LeitorRegistro* leitor) {
+    munmap((void*)leitor->dados, leitor->tamanho);
+}
+
+/**
+ * Avança para o próximo bloco, conferindo limites e (opcionalmente) o CRC
+ *
+ * @return 1 se entrou em um bloco, 0 no fim do arquivo, ERRO_REGISTRO_CORROMPIDO
+ */
+static int entrarProximoBlocoRegistro(LeitorRegistro* leitor) {
+    if (leitor->proximoBloco == leitor->tamanho) {
+        return 0;
+    }
+    if (leitor->tamanho - leitor->proximoBloco < TAMANHO_CABECALHO_BLOCO) {
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+
+    const uint8_t* cabecalho = leitor->dados + leitor->proximoBloco;
+    uint32_t tamanhoCarga = lerU32(cabecalho);
+    uint32_t partidas = lerU32(cabecalho + 4);
+    const uint8_t* carga = cabecalho + TAMANHO_CABECALHO_BLOCO;
+
+    if (tamanhoCarga > TAMANHO_BLOCO_REGISTRO ||
+        tamanhoCarga > leitor->tamanho - leitor->proximoBloco - TAMANHO_CABECALHO_BLOCO ||
+        (leitor->validarBlocos && calcularCrc32(carga, tamanhoCarga) != lerU32(cabecalho + 8))) {
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+
+    leitor->cursor = carga;
+    leitor->fimBloco = carga + tamanhoCarga;
+    leitor->partidasRestantes = partidas;
+    leitor->proximoBloco += TAMANHO_CABECALHO_BLOCO + tamanhoCarga;
+    return 1;
+}
+
+/**
+ * Lê a frota da próxima partida; ataques não lidos da partida anterior são pulados
+ *
+ * @param leitor Leitor aberto
+ * @param partida Saída: frota da partida
+ * @return 1 se leu uma partida, 0 no fim do arquivo, ERRO_REGISTRO_CORROMPIDO
+ */
+int lerProximaPartida(LeitorRegistro* leitor, PartidaRegistrada* partida) {
+    AtaqueRegistrado descartado;
+    int resultado;
+    while ((resultado = lerProximoAtaque(leitor, &descartado)) == 1) {
+        continue;
+    }
+    if (resultado < 0) {
+        return resultado;
+    }
+
+    while (leitor->partidasRestantes == 0) {
+        if ((resultado = entrarProximoBlocoRegistro(leitor)) <= 0) {
+            return resultado;
+        }
+    }
+
+    uint64_t quantidade;
+    if (!decodificarVarint(&leitor->cursor, leitor->fimBloco, &quantidade) || quantidade > MAX_NAVIOS) {
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+
+    static const char orientacoes[] = {'H', 'V', 'D'};
+    partida->quantidadeNavios = (int)quantidade;
+    for (int n = 0; n < partida->quantidadeNavios; n++) {
+        uint64_t celula, tamanhoOrientacao;
+        if (!decodificarVarint(&leitor->cursor, leitor->fimBloco, &celula) ||
+            !decodificarVarint(&leitor->cursor, leitor->fimBloco, &tamanhoOrientacao) ||
+            celula >= TOTAL_CELULAS || (tamanhoOrientacao & 3) > 2 ||
+            (tamanhoOrientacao >> 2) < 1 || (tamanhoOrientacao >> 2) > TAMANHO_TABULEIRO) {
+            return ERRO_REGISTRO_CORROMPIDO;
+        }
+        Navio* navio = &partida->navios[n];
+        navio->inicio.linha = (int)celula / TAMANHO_TABULEIRO;
+        navio->inicio.coluna = (int)celula % TAMANHO_TABULEIRO;
+        navio->tamanho = (int)(tamanhoOrientacao >> 2);
+        navio->orientacao = orientacoes[tamanhoOrientacao & 3];
+        navio->id = n + 1;
+        navio->foiDestruido = 0;
+        navio->partesRestantes = navio->tamanho;
+    }
+
+    leitor->partidasRestantes--;
+    leitor->partidaAberta = 1;
+    return 1;
+}
+
+/**
+ * Lê o próximo ataque da partida atual
+ *
+ * @param leitor Leitor aberto
+ * @param ataque Saída: ataque e resultado gravado
+ * @return 1 se leu um ataque, 0 no fim da partida, ERRO_REGISTRO_CORROMPIDO
+ */
+int lerProximoAtaque(LeitorRegistro* leitor, AtaqueRegistrado* ataque) {
+    if (!leitor->partidaAberta) {
+        return 0;
+    }
+
+    uint64_t alvo, resultado;
+    if (!decodificarVarint(&leitor->cursor, leitor->fimBloco, &alvo)) {
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+    if (alvo == 0) {
+        leitor->partidaAberta = 0;
+        return 0;
+    }
+    if (!decodificarVarint(&leitor->cursor, leitor->fimBloco, &resultado) ||
+        alvo > (uint64_t)MAX_HABILIDADES * TOTAL_CELULAS) {
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+
+    int celula = (int)((alvo - 1) % TOTAL_CELULAS);
+    ataque->habilidade = (int)((alvo - 1) / TOTAL_CELULAS);
+    ataque->centro.linha = celula / TAMANHO_TABULEIRO;
+    ataque->centro.coluna = celula % TAMANHO_TABULEIRO;
+    ataque->acertos = (int)(resultado >> MAX_NAVIOS);
+    ataque->afundados = (int)(resultado & ((1u << MAX_NAVIOS) - 1));
+    return 1;
+}
+
+#if BATALHA_EVENTOS
+/*
+ * Gravação a partir da simulação: um receptor de eventos traduz cada
+ * ataque resolvido em um evento do registro
+ */
+typedef struct {
+    GravadorRegistro* gravador;
+    const EstadoJogo* estado;
+    const HabilidadeCompilada* habilidades;
+    int quantidadeHabilidades;
+    int habilidade;
+    Coordenada centro;
+    int afundados;
+} ContextoGravacao;
+
+static void gravacaoInicioAtaque(void* contexto, const char* nomeHabilidade, int centroLinha, int centroColuna) {
+    ContextoGravacao* ctx = contexto;
+    if (ctx->estado->turno == 0) {
+        gravarInicioPartida(ctx->gravador, ctx->estado->navios, ctx->estado->quantidadeNavios);
+    }
+    ctx->habilidade = 0;
+    for (int h = 0; h < ctx->quantidadeHabilidades; h++) {
+        if (ctx->habilidades[h].nome == nomeHabilidade) {
+            ctx->habilidade = h;
+            break;
+        }
+    }
+    ctx->centro.linha = centroLinha;
+    ctx->centro.coluna = centroColuna;
+    ctx->afundados = 0;
+}
+
+static void gravacaoNavioDestruido(void* contexto, const Navio* navio) {
+    ContextoGravacao* ctx = contexto;
+    ctx->afundados |= 1 << (navio->id - 1);
+}
+
+static void gravacaoFimAtaque(void* contexto, int tiros, int acertos) {
+    ContextoGravacao* ctx = contexto;
+    (void)tiros;
+    gravarAtaqueRegistro(ctx->gravador, ctx->habilidade, ctx->centro, acertos, ctx->afundados);
+}
+#endif
+
+/**
+ * Simula partidas gravando cada uma no registro (--simulate N --gravar ARQUIVO)
+ *
+ * @param quantidadePartidas Número de partidas
+ * @param semente Semente do gerador
+ * @param ataqueDensidade 1 para a IA de densidade, 0 para ataques aleatórios
+ * @param caminho Arquivo de registro a ser criado
+ * @return 0 se bem-sucedido
+ */
+int executarSimulacaoGravada(long long quantidadePartidas, uint64_t semente, int ataqueDensidade,
+                             const char* caminho) {
+#if BATALHA_EVENTOS
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    const int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    criarHabilidadesPadrao(habilidades);
+
+    EstrategiaPosicionamento posicionamento = {"uniforme", posicionarFrotaUniforme, NULL};
+    EstrategiaAtaque ataque = {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0};
+    ContextoAtaqueDensidade contextoDensidade;
+    if (ataqueDensidade) {
+        ataque = criarAtaqueDensidade(&contextoDensidade, habilidades, quantidadeHabilidades);
+    }
+
+    GravadorRegistro* gravador = malloc(sizeof(GravadorRegistro));
+    if (gravador == NULL || abrirGravadorRegistro(gravador, caminho) != SUCESSO) {
+        fprintf(stderr, "❌ Não foi possível criar o registro: %s\n", caminho);
+        free(gravador);
+        return 1;
+    }
+
+    EstadoJogo estado;
+    ContextoGravacao contexto = {gravador, &estado, habilidades, quantidadeHabilidades, 0, {0, 0}, 0};
+    ReceptorEventos receptor = {gravacaoInicioAtaque, NULL, gravacaoNavioDestruido, gravacaoFimAtaque, &contexto};
+
+    GeradorAleatorio gerador;
+    inicializarGerador(&gerador, semente, 0);
+
+    EstatisticasSimulacao totais;
+    memset(&totais, 0, sizeof(totais));
+
+    double inicio = tempoAtual();
+    for (long long i = 0; i < quantidadePartidas; i++) {
+        if (simularPartida(&estado, &posicionamento, &ataque, habilidades, &gerador, &receptor) >= 0) {
+            gravarFimPartida(gravador);
+            acumularPartida(&totais, &estado);
+        }
+    }
+    int ok = fecharGravadorRegistro(gravador) == SUCESSO;
+    double segundos = tempoAtual() - inicio;
+
+    printf("💾 Registro: %llu partidas, %llu bytes (%.1f bytes/partida) em %s\n",
+           (unsigned long long)gravador->partidasGravadas, (unsigned long long)gravador->bytesGravados,
+           gravador->partidasGravadas > 0 ? (double)gravador->bytesGravados / (double)gravador->partidasGravadas : 0.0,
+           caminho);
+    exibirResumoSimulacao(&totais, segundos);
+    free(gravador);
+    if (!ok) {
+        fprintf(stderr, "❌ Falha ao gravar o registro: %s\n", caminho);
+        return 1;
+    }
+    return 0;
+#else
+    (void)quantidadePartidas;
+    (void)semente;
+    (void)ataqueDensidade;
+    fprintf(stderr, "❌ A gravação depende dos eventos; recompile sem -DBATALHA_EVENTOS=0 (%s).\n", caminho);
+    return 1;
+#endif
+}
+
+/**
+ * Percorre um registro inteiro conferindo os blocos (--inspecionar ARQUIVO)
+ *
+ * @param caminho Arquivo de registro
+ * @return 0 se o registro está íntegro
+ */
+int executarInspecaoRegistro(const char* caminho) {
+    LeitorRegistro leitor;
+    int resultado = abrirLeitorRegistro(&leitor, caminho, 1);
+    if (resultado != SUCESSO) {
+        fprintf(stderr, resultado == ERRO_ES ? "❌ Registro inacessível: %s\n" : "❌ Registro inválido: %s\n", caminho);
+        return 1;
+    }
+
+    PartidaRegistrada partida;
+    AtaqueRegistrado ataque;
+    unsigned long long partidas = 0, ataques = 0, acertos = 0;
+    double inicio = tempoAtual();
+    while ((resultado = lerProximaPartida(&leitor, &partida)) == 1) {
+        partidas++;
+        while ((resultado = lerProximoAtaque(&leitor, &ataque)) == 1) {
+            ataques++;
+            acertos += (unsigned long long)ataque.acertos;
+        }
+        if (resultado < 0) {
+            break;
+        }
+    }
+    double segundos = tempoAtual() - inicio;
+    size_t bytes = leitor.tamanho;
+    fecharLeitorRegistro(&leitor);
+
+    printf("📂 %s: %llu partidas, %llu ataques, %llu acertos, %zu bytes\n",
+           caminho, partidas, ataques, acertos, bytes);
+    printf("⏱️  Leitura: %.3f s (%.0f MB/s)\n", segundos, segundos > 0 ? (double)bytes / segundos / 1e6 : 0.0);
+    if (resultado < 0) {
+        fprintf(stderr, "❌ Registro corrompido após %llu partidas.\n", partidas);
+        return 1;
+    }
+    printf("✅ Todos os blocos conferem (CRC-32).\n");
+    return 0;
+}
+
+/*
+ * ============================================
+ * REPLAY E ANÁLISE DE REGISTROS
+ * ============================================
+ */
+
+/**
+ * Resultado parcial do replay de uma thread
+ * Alinhado à linha de cache como o ResultadoMonteCarlo: cada thread só escreve no seu
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) EstatisticasSimulacao totais;
+    long long ataques;
+    long long divergencias;         // Ataques cujo resultado refeito difere do gravado
+    long long arquivosInvalidos;
+    long long tirosPorHabilidade[QUANTIDADE_HABILIDADES_PADRAO];
+    long long acertosPorHabilidade[QUANTIDADE_HABILIDADES_PADRAO];
+    long long usosPorHabilidade[QUANTIDADE_HABILIDADES_PADRAO];
+    long long afundamentosPorTurno[MAX_TURNOS + 1];     // Turno (1-based) em que cada navio afundou
+    long long frotasPorTurno[MAX_TURNOS + 1];           // Turno em que a frota inteira afundou
+} ResultadoReplay;
+
+/**
+ * Trabalho compartilhado do replay: as threads disputam os arquivos por um contador atômico
+ */
+typedef struct {
+    const char* const* arquivos;
+    int quantidadeArquivos;
+    atomic_int proximoArquivo;
+    int habilidades[QUANTIDADE_HABILIDADES_PADRAO][TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+} TrabalhoReplay;
+
+typedef struct {
+    TrabalhoReplay* trabalho;
+    ResultadoReplay* resultado;
+} TarefaReplay;
+
+/**
+ * Refaz uma partida do registro pelo caminho de matriz do jogo interativo
+ *
+ * @param leitor Leitor posicionado nos ataques da partida
+ * @param partida Frota da partida
+ * @param trabalho Habilidades padrão
+ * @param resultado Resultado parcial da thread
+ * @return 1 se a partida foi refeita, ERRO_REGISTRO_CORROMPIDO se o registro terminou no meio
+ */
+static int refazerPartida(LeitorRegistro* leitor, const PartidaRegistrada* partida,
+                          TrabalhoReplay* trabalho, ResultadoReplay* resultado) {
+    int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    Navio navios[MAX_NAVIOS];
+    EstatisticasJogo stats;
+    AtaqueRegistrado ataque;
+    int turno = 0, status;
+
+    inicializarTabuleiro(tabuleiro);
+    inicializarEstatisticas(&stats);
+    memcpy(navios, partida->navios, sizeof(Navio) * (size_t)partida->quantidadeNavios);
+    for (int n = 0; n < partida->quantidadeNavios; n++) {
+        if (posicionarNavio(tabuleiro, navios[n]) != SUCESSO) {
+            resultado->divergencias++;
+        }
+    }
+
+    while ((status = lerProximoAtaque(leitor, &ataque)) == 1) {
+        turno++;
+        resultado->ataques++;
+        if (ataque.habilidade >= QUANTIDADE_HABILIDADES_PADRAO) {
+            resultado->divergencias++;
+            continue;
+        }
+
+        EstatisticasJogo antes = stats;
+        int afundadosAntes = 0, afundadosDepois = 0;
+        for (int n = 0; n < partida->quantidadeNavios; n++) {
+            afundadosAntes |= navios[n].foiDestruido << n;
+        }
+
+        aplicarHabilidadeNoTabuleiro(tabuleiro, trabalho->habilidades[ataque.habilidade], ataque.centro.linha,
+                                     ataque.centro.coluna, NOMES_HABILIDADES_PADRAO[ataque.habilidade],
+                                     navios, partida->quantidadeNavios, &stats, NULL);
+
+        for (int n = 0; n < partida->quantidadeNavios; n++) {
+            afundadosDepois |= navios[n].foiDestruido << n;
+        }
+        int afundados = afundadosDepois & ~afundadosAntes;
+        int acertos = stats.acertos - antes.acertos;
+        resultado->divergencias += acertos != ataque.acertos || afundados != ataque.afundados;
+
+        int h = ataque.habilidade;
+        resultado->usosPorHabilidade[h]++;
+        resultado->tirosPorHabilidade[h] += stats.totalTiros - antes.totalTiros;
+        resultado->acertosPorHabilidade[h] += acertos;
+        int turnoHistograma = turno <= MAX_TURNOS ? turno : MAX_TURNOS;
+        resultado->afundamentosPorTurno[turnoHistograma] += __builtin_popcount((unsigned int)afundados);
+        if (afundados != 0 && stats.naviosDestruidos == partida->quantidadeNavios) {
+            resultado->frotasPorTurno[turnoHistograma]++;
+        }
+    }
+    if (status < 0) {
+        return status;
+    }
+
+    EstatisticasSimulacao* totais = &resultado->totais;
+    totais->partidas++;
+    totais->partidasVencidas += stats.naviosDestruidos == partida->quantidadeNavios;
+    totais->turnos += turno;
+    totais->totalTiros += stats.totalTiros;
+    totais->acertos += stats.acertos;
+    totais->erros += stats.erros;
+    totais->naviosDestruidos += stats.naviosDestruidos;
+    return 1;
+}
+
+/**
+ * Corpo de uma thread do replay: pega o próximo arquivo livre até acabarem
+ *
+ * @param argumento Ponteiro para TarefaReplay
+ * @return NULL
+ */
+static void* executarTarefaReplay(void* argumento) {
+    TarefaReplay* tarefa = argumento;
+    TrabalhoReplay* trabalho = tarefa->trabalho;
+
+    for (;;) {
+        int indice = atomic_fetch_add_explicit(&trabalho->proximoArquivo, 1, memory_order_relaxed);
+        if (indice >= trabalho->quantidadeArquivos) {
+            break;
+        }
+
+        LeitorRegistro leitor;
+        if (abrirLeitorRegistro(&leitor, trabalho->arquivos[indice], 1) != SUCESSO) {
+            tarefa->resultado->arquivosInvalidos++;
+            continue;
+        }
+
+        PartidaRegistrada partida;
+        int status;
+        while ((status = lerProximaPartida(&leitor, &partida)) == 1) {
+            if ((status = refazerPartida(&leitor, &partida, trabalho, tarefa->resultado)) < 0) {
+                break;
+            }
+        }
+        if (status < 0) {
+            tarefa->resultado->arquivosInvalidos++;
+        }
+        fecharLeitorRegistro(&leitor);
+    }
+    return NULL;
+}
+
+/**
+ * Soma um resultado parcial do replay no resultado final (após o join)
+ */
+static void mesclarResultadoReplay(ResultadoReplay* destino, const ResultadoReplay* origem) {
+    destino->totais.partidas += origem->totais.partidas;
+    destino->totais.partidasVencidas += origem->totais.partidasVencidas;
+    destino->totais.turnos += origem->totais.turnos;
+    destino->totais.totalTiros += origem->totais.totalTiros;
+    destino->totais.acertos += origem->totais.acertos;
+    destino->totais.erros += origem->totais.erros;
+    destino->totais.naviosDestruidos += origem->totais.naviosDestruidos;
+    destino->ataques += origem->ataques;
+    destino->divergencias += origem->divergencias;
+    destino->arquivosInvalidos += origem->arquivosInvalidos;
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        destino->tirosPorHabilidade[h] += origem->tirosPorHabilidade[h];
+        destino->acertosPorHabilidade[h] += origem->acertosPorHabilidade[h];
+        destino->usosPorHabilidade[h] += origem->usosPorHabilidade[h];
+    }
+    for (int t = 0; t <= MAX_TURNOS; t++) {
+        destino->afundamentosPorTurno[t] += origem->afundamentosPorTurno[t];
+        destino->frotasPorTurno[t] += origem->frotasPorTurno[t];
+    }
+}
+
+/**
+ * Exibe o histograma de turnos de afundamento (apenas turnos com ocorrências)
+ */
+static void exibirHistogramaAfundamentos(const ResultadoReplay* resultado) {
+    long long maior = 1;
+    for (int t = 1; t <= MAX_TURNOS; t++) {
+        if (resultado->afundamentosPorTurno[t] > maior) {
+            maior = resultado->afundamentosPorTurno[t];
+        }
+    }
+
+    printf("\n📊 Turno de afundamento (navios | frotas completas):\n");
+    for (int t = 1; t <= MAX_TURNOS; t++) {
+        if (resultado->afundamentosPorTurno[t] == 0) {
+            continue;
+        }
+        char barra[41];
+        int largura = (int)(resultado->afundamentosPorTurno[t] * 40 / maior);
+        memset(barra, '#', (size_t)largura);
+        barra[largura] = '\0';
+        printf("%4d %10lld %10lld %s\n", t, resultado->afundamentosPorTurno[t], resultado->frotasPorTurno[t], barra);
+    }
+}
+
+/**
+ * Refaz e analisa registros de partidas em paralelo (--replay ARQUIVO...)
+ * Cada arquivo é mapeado e refeito por aplicarHabilidadeNoTabuleiro, sem
+ * saída até o relatório final; resultados divergentes do gravado são contados
+ *
+ * @param arquivos Caminhos dos registros
+ * @param quantidadeArquivos Número de registros
+ * @param quantidadeThreads Número de threads (0 = todos os núcleos)
+ * @return 0 se todos os registros foram refeitos sem divergência
+ */
+int executarReplay(const char* const arquivos[], int quantidadeArquivos, int quantidadeThreads) {
+    if (quantidadeThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        quantidadeThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (quantidadeThreads > quantidadeArquivos) {
+        quantidadeThreads = quantidadeArquivos;
+    }
+    if (quantidadeThreads > MAX_THREADS) {
+        quantidadeThreads = MAX_THREADS;
+    }
+
+    TrabalhoReplay trabalho;
+    trabalho.arquivos = arquivos;
+    trabalho.quantidadeArquivos = quantidadeArquivos;
+    atomic_init(&trabalho.proximoArquivo, 0);
+    criarHabilidadeCone(trabalho.habilidades[HABILIDADE_CONE]);
+    criarHabilidadeCruz(trabalho.habilidades[HABILIDADE_CRUZ]);
+    criarHabilidadeOctaedro(trabalho.habilidades[HABILIDADE_OCTAEDRO]);
+
+    ResultadoReplay* parciais = alocarAlinhadoCache(sizeof(ResultadoReplay) * (size_t)(quantidadeThreads + 1));
+    if (parciais == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para o replay.\n");
+        return 1;
+    }
+    memset(parciais, 0, sizeof(ResultadoReplay) * (size_t)(quantidadeThreads + 1));
+    ResultadoReplay* final = &parciais[quantidadeThreads];
+
+    pthread_t threads[MAX_THREADS];
+    TarefaReplay tarefas[MAX_THREADS];
+    double inicio = tempoAtual();
+    int iniciadas = 0;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        tarefas[t].trabalho = &trabalho;
+        tarefas[t].resultado = &parciais[t];
+        if (pthread_create(&threads[t], NULL, executarTarefaReplay, &tarefas[t]) != 0) {
+            break;
+        }
+        iniciadas++;
+    }
+    if (iniciadas == 0) {
+        // Sem threads disponíveis a thread principal faz todo o trabalho
+        tarefas[0].trabalho = &trabalho;
+        tarefas[0].resultado = &parciais[0];
+        executarTarefaReplay(&tarefas[0]);
+        iniciadas = 1;
+    } else {
+        for (int t = 0; t < iniciadas; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    for (int t = 0; t < iniciadas; t++) {
+        mesclarResultadoReplay(final, &parciais[t]);
+    }
+    double segundos = tempoAtual() - inicio;
+
+    printf("🎞️  Replay: %d arquivos em %d threads, %lld ataques, %lld divergências, %lld arquivos inválidos\n",
+           quantidadeArquivos, iniciadas, final->ataques, final->divergencias, final->arquivosInvalidos);
+    printf("\n%-10s %12s %12s %14s %9s\n", "Habilidade", "Usos", "Tiros", "Acertos", "Taxa");
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        long long tiros = final->tirosPorHabilidade[h];
+        printf("%-10s %12lld %12lld %14lld %8.1f%%\n", NOMES_HABILIDADES_PADRAO[h], final->usosPorHabilidade[h],
+               tiros, final->acertosPorHabilidade[h],
+               tiros > 0 ? (double)final->acertosPorHabilidade[h] / (double)tiros * 100 : 0.0);
+    }
+    exibirHistogramaAfundamentos(final);
+    exibirResumoSimulacao(&final->totais, segundos);
+
+    int ok = final->divergencias == 0 && final->arquivosInvalidos == 0;
+    free(parciais);
+    return ok ? 0 : 1;
+}
+
+/*
+ * ============================================
+ * POOL E ARENA DE PARTIDAS
+ * ============================================
+ */
+
+/**
+ * Reserva memória na arena da partida
+ *
+ * @param arena Arena da partida
+ * @param bytes Quantidade de bytes
+ * @param alinhamento Alinhamento exigido (potência de 2)
+ * @return Ponteiro para a região, ou NULL se a arena estiver cheia
+ */
+static inline void* alocarArena(ArenaPartida* arena, size_t bytes, size_t alinhamento) {
+    size_t inicio = (arena->usado + alinhamento - 1) & ~(alinhamento - 1);
+    if (inicio > arena->capacidade || bytes > arena->capacidade - inicio) {
+        return NULL;
+    }
+    arena->usado = inicio + bytes;
+    return arena->base + inicio;
+}
+
+/**
+ * Cria um pool com todos os objetos de partida em uma única alocação
+ *
+ * @param pool Pool a ser criado
+ * @param capacidade Quantidade de objetos
+ * @param bytesPorPartida Tamanho da arena de cada objeto
+ * @return SUCESSO ou ERRO_MEMORIA
+ */
+int criarPoolPartidas(PoolPartidas* pool, int capacidade, size_t bytesPorPartida) {
+    memset(pool, 0, sizeof(*pool));
+    pool->capacidade = capacidade;
+    pool->bytesPorPartida = (bytesPorPartida + TAMANHO_LINHA_CACHE - 1) / TAMANHO_LINHA_CACHE * TAMANHO_LINHA_CACHE;
+    pool->memoria = alocarAlinhadoCache(pool->bytesPorPartida * (size_t)capacidade);
+    pool->arenas = malloc(sizeof(ArenaPartida) * (size_t)capacidade);
+    pool->proximoLivre = malloc(sizeof(int) * (size_t)capacidade);
+    if (pool->memoria == NULL || pool->arenas == NULL || pool->proximoLivre == NULL) {
+        free(pool->memoria);
+        free(pool->arenas);
+        free(pool->proximoLivre);
+        memset(pool, 0, sizeof(*pool));
+        return ERRO_MEMORIA;
+    }
+
+    for (int i = 0; i < capacidade; i++) {
+        pool->arenas[i].base = pool->memoria + pool->bytesPorPartida * (size_t)i;
+        pool->arenas[i].capacidade = pool->bytesPorPartida;
+        pool->arenas[i].usado = 0;
+        pool->proximoLivre[i] = i + 1 < capacidade ? i + 1 : -1;
+    }
+    pool->livre = capacidade > 0 ? 0 : -1;
+    return SUCESSO;
+}
+
+void destruirPoolPartidas(PoolPartidas* pool) {
+    free(pool->memoria);
+    free(pool->arenas);
+    free(pool->proximoLivre);
+    memset(pool, 0, sizeof(*pool));
+}
+
+/**
+ * Retira um objeto de partida do pool, com a arena vazia
+ *
+ * @param pool Pool de partidas
+ * @return Índice do objeto, ou -1 se o pool estiver esgotado
+ */
+int adquirirPartidaPool(PoolPartidas* pool) {
+    int indice = pool->livre;
+    if (indice < 0) {
+        pool->stats.esgotamentos++;
+        return -1;
+    }
+    pool->livre = pool->proximoLivre[indice];
+    pool->arenas[indice].usado = 0;
+    pool->stats.aquisicoes++;
+    if (++pool->stats.emUso > pool->stats.picoEmUso) {
+        pool->stats.picoEmUso = pool->stats.emUso;
+    }
+    return indice;
+}
+
+/**
+ * Devolve um objeto ao pool; tudo o que foi alocado na sua arena é descartado junto
+ *
+ * @param pool Pool de partidas
+ * @param indice Índice devolvido por adquirirPartidaPool
+ */
+void liberarPartidaPool(PoolPartidas* pool, int indice) {
+    if (pool->arenas[indice].usado > pool->stats.picoArena) {
+        pool->stats.picoArena = pool->arenas[indice].usado;
+    }
+    pool->proximoLivre[indice] = pool->livre;
+    pool->livre = indice;
+    pool->stats.liberacoes++;
+    pool->stats.emUso--;
+}
+
+static inline ArenaPartida* arenaPartidaPool(PoolPartidas* pool, int indice) {
+    return &pool->arenas[indice];
+}
+
+/**
+ * Reserva memória na arena de um objeto do pool, contabilizando falhas
+ *
+ * @return Ponteiro para a região, ou NULL se a arena estiver cheia
+ */
+static inline void* alocarNaPartidaPool(PoolPartidas* pool, int indice, size_t bytes, size_t alinhamento) {
+    void* regiao = alocarArena(&pool->arenas[indice], bytes, alinhamento);
+    pool->stats.falhasArena += (regiao == NULL);
+    return regiao;
+}
+
+/**
+ * Exibe os contadores do pool de partidas
+ *
+ * @param pool Pool de partidas
+ */
+void exibirEstatisticasPool(const PoolPartidas* pool) {
+    const EstatisticasPool* s = &pool->stats;
+    printf("🧱 Pool de partidas: %d objetos de %zu bytes (%.1f MiB em uma alocação)\n",
+           pool->capacidade, pool->bytesPorPartida,
+           (double)pool->bytesPorPartida * (double)pool->capacidade / (1024.0 * 1024.0));
+    printf("   Aquisições: %lld | Liberações: %lld | Em uso: %d | Pico: %d\n",
+           s->aquisicoes, s->liberacoes, s->emUso, s->picoEmUso);
+    printf("   Esgotamentos: %lld | Falhas de arena: %lld | Maior arena usada: %zu bytes\n",
+           s->esgotamentos, s->falhasArena, s->picoArena);
+}
+
+/*
+ * ============================================
+ * INSTANTÂNEOS DE PARTIDAS (LAYOUT FIXO)
+ * ============================================
+ *
+ * Um instantâneo é um cabeçalho seguido de PartidaInstantanea em sequência,
+ * exatamente como estão na memória: gravar é um writev das próprias partidas
+ * e restaurar é um mmap, sem codificação campo a campo. O cabeçalho guarda a
+ * ordem dos bytes e o tamanho do registro de quem gravou; um binário com
+ * outro layout recusa o arquivo em vez de interpretá-lo errado
+ */
+
+/**
+ * Estado persistente de uma partida de dois jogadores, sem ponteiros
+ */
+typedef struct {
+    EstadoJogo estados[2];          // estados[j] = frota do jogador j (atacada pelo outro)
+    uint64_t chave;                 // Chave de retomada, conhecida só pelos dois jogadores
+    int32_t vez;                    // Jogador que ataca agora
+    uint32_t crc;                   // CRC-32 dos bytes anteriores, calculado ao gravar
+} PartidaInstantanea;
+
+_Static_assert(offsetof(PartidaInstantanea, crc) + sizeof(uint32_t) == sizeof(PartidaInstantanea),
+               "O CRC precisa cobrir todo o registro antes dele");
+
+typedef struct {
+    char assinatura[8];             // ASSINATURA_INSTANTANEO, completada com zeros
+    uint32_t versao;
+    uint32_t ordemBytes;            // MARCA_ORDEM_BYTES como quem gravou a vê
+    uint32_t tamanhoPartida;        // sizeof(PartidaInstantanea) de quem gravou
+    uint32_t quantidade;
+    int64_t gravadoEm;              // Segundos desde a época
+} CabecalhoInstantaneo;
+
+/**
+ * Instantâneo aberto por mmap; as partidas são lidas direto do mapeamento
+ */
+typedef struct {
+    const CabecalhoInstantaneo* cabecalho;
+    const PartidaInstantanea* partidas;
+    int quantidade;
+    void* mapeamento;
+    size_t tamanho;
+} InstantaneoMapeado;
+
+static inline uint32_t crcPartidaInstantanea(const PartidaInstantanea* partida) {
+    return calcularCrc32((const uint8_t*)partida, offsetof(PartidaInstantanea, crc));
+}
+
+/**
+ * Grava as partidas em um instantâneo, substituindo o arquivo de forma atômica
+ * O CRC de cada partida é escrito no próprio registro; o resto segue como está
+ * na memória, reunido por writev (arquivo temporário, fsync e rename)
+ *
+ * @param caminho Arquivo de destino
+ * @param partidas Partidas a gravar (o campo crc de cada uma é atualizado)
+ * @param quantidade Quantidade de partidas
+ * @return SUCESSO, ERRO_POSICAO_INVALIDA se o caminho for longo demais ou ERRO_ES em falha de E/S
+ */
+int gravarInstantaneo(const char* caminho, PartidaInstantanea* const partidas[], int quantidade) {
+    char temporario[1024];
+    if (snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario)) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    int descritor = open(temporario, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (descritor < 0) {
+        return ERRO_ES;
+    }
+
+    CabecalhoInstantaneo cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.assinatura, ASSINATURA_INSTANTANEO, sizeof(ASSINATURA_INSTANTANEO) - 1);
+    cabecalho.versao = VERSAO_INSTANTANEO;
+    cabecalho.ordemBytes = MARCA_ORDEM_BYTES;
+    cabecalho.tamanhoPartida = sizeof(PartidaInstantanea);
+    cabecalho.quantidade = (uint32_t)quantidade;
+    cabecalho.gravadoEm = (int64_t)time(NULL);
+
+    struct iovec vetores[MAX_VETORES_INSTANTANEO];
+    int ok = escreverTudo(descritor, &cabecalho, sizeof(cabecalho)) == SUCESSO;
+    for (int inicio = 0; ok && inicio < quantidade; inicio += MAX_VETORES_INSTANTANEO) {
+        int lote = quantidade - inicio < MAX_VETORES_INSTANTANEO ? quantidade - inicio : MAX_VETORES_INSTANTANEO;
+        size_t restante = 0;
+        for (int i = 0; i < lote; i++) {
+            partidas[inicio + i]->crc = crcPartidaInstantanea(partidas[inicio + i]);
+            vetores[i].iov_base = partidas[inicio + i];
+            vetores[i].iov_len = sizeof(PartidaInstantanea);
+            restante += sizeof(PartidaInstantanea);
+        }
+
+        // Escrita parcial: avança pelos vetores já escritos e repete
+        struct iovec* atual = vetores;
+        int vetoresRestantes = lote;
+        while (ok && restante > 0) {
+            ssize_t escritos = writev(descritor, atual, vetoresRestantes);
+            if (escritos < 0) {
+                ok = errno == EINTR;
+                continue;
+            }
+            restante -= (size_t)escritos;
+            while (vetoresRestantes > 0 && (size_t)escritos >= atual->iov_len) {
+                escritos -= (ssize_t)atual->iov_len;
+                atual++;
+                vetoresRestantes--;
+            }
+            if (vetoresRestantes > 0) {
+                atual->iov_base = (uint8_t*)atual->iov_base + escritos;
+                atual->iov_len -= (size_t)escritos;
+            }
+        }
+    }
+    ok = ok && fsync(descritor) == 0;
+    ok = close(descritor) == 0 && ok;
+    if (!ok || rename(temporario, caminho) != 0) {
+        unlink(temporario);
+        return ERRO_ES;
+    }
+    return SUCESSO;
+}
+
+/**
+ * Mapeia um instantâneo e confere o cabeçalho
+ * As partidas ficam acessíveis no mapeamento; cada uma deve passar por
+ * partidaInstantaneaIntegra antes do uso
+ *
+ * @return SUCESSO, ERRO_ES se o arquivo não abrir,
+ *         ou ERRO_REGISTRO_CORROMPIDO se o cabeçalho não servir para este binário
+ */
+int abrirInstantaneo(const char* caminho, InstantaneoMapeado* instantaneo) {
+    memset(instantaneo, 0, sizeof(*instantaneo));
+    int descritor = open(caminho, O_RDONLY | O_CLOEXEC);
+    if (descritor < 0) {
+        return ERRO_ES;
+    }
+    struct stat info;
+    if (fstat(descritor, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoInstantaneo)) {
+        close(descritor);
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+    void* mapeamento = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descritor, 0);
+    close(descritor);
+    if (mapeamento == MAP_FAILED) {
+        return ERRO_ES;
+    }
+
+    const CabecalhoInstantaneo* cabecalho = mapeamento;
+    if (memcmp(cabecalho->assinatura, ASSINATURA_INSTANTANEO, sizeof(ASSINATURA_INSTANTANEO) - 1) != 0 ||
+        cabecalho->versao != VERSAO_INSTANTANEO || cabecalho->ordemBytes != MARCA_ORDEM_BYTES ||
+        cabecalho->tamanhoPartida != sizeof(PartidaInstantanea) || cabecalho->quantidade > INT32_MAX ||
+        (size_t)info.st_size != sizeof(CabecalhoInstantaneo) + (size_t)cabecalho->quantidade * sizeof(PartidaInstantanea)) {
+        munmap(mapeamento, (size_t)info.st_size);
+        return ERRO_REGISTRO_CORROMPIDO;
+    }
+    madvise(mapeamento, (size_t)info.st_size, MADV_SEQUENTIAL);
+    instantaneo->cabecalho = cabecalho;
+    instantaneo->partidas = (const PartidaInstantanea*)(cabecalho + 1);
+    instantaneo->quantidade = (int)cabecalho->quantidade;
+    instantaneo->mapeamento = mapeamento;
+    instantaneo->tamanho = (size_t)info.st_size;
+    return SUCESSO;
+}
+
+void fecharInstantaneo(InstantaneoMapeado* instantaneo) {
+    if (instantaneo->mapeamento != NULL) {
+        munmap(instantaneo->mapeamento, instantaneo->tamanho);
+    }
+    memset(instantaneo, 0, sizeof(*instantaneo));
+}
+
+/**
+ * Confere um estado restaurado: cada navio precisa caber no tabuleiro, bater com a
+ * própria máscara sem sobrepor os outros e ter partesRestantes igual às suas células
+ * ainda não atingidas; navios e acertos do tabuleiro precisam vir exatamente das máscaras
+ * O CRC não tem chave, então nada do arquivo que vira índice pode ser aceito sem isso
+ *
+ * @return 1 se o estado é consistente
+ */
+static int estadoInstantaneoIntegro(const EstadoJogo* estado) {
+    if (estado->quantidadeNavios < 0 || estado->quantidadeNavios > MAX_NAVIOS ||
+        estado->naviosRestantes < 1 || estado->naviosRestantes > estado->quantidadeNavios) {
+        return 0;
+    }
+    Bitboard ocupadas = bitboardVazio();
+    int restantes = 0;
+    for (int i = 0; i < estado->quantidadeNavios; i++) {
+        const Navio* navio = &estado->navios[i];
+        Bitboard mascara;
+        if ((navio->orientacao != 'H' && navio->orientacao != 'V' && navio->orientacao != 'D') ||
+            navio->tamanho < 1 || navio->tamanho > TAMANHO_TABULEIRO ||
+            calcularMascaraNavio(*navio, &mascara) != SUCESSO ||
+            memcmp(&mascara, &estado->mascarasNavios[i], sizeof(mascara)) != 0 ||
+            !bitboardVazioTeste(bitboardIntersecao(mascara, ocupadas))) {
+            return 0;
+        }
+        int atingidas = bitboardContar(bitboardIntersecao(mascara, estado->tabuleiro.acertos));
+        if (navio->partesRestantes != navio->tamanho - atingidas) {
+            return 0;
+        }
+        restantes += navio->partesRestantes > 0;
+        ocupadas = bitboardUniao(ocupadas, mascara);
+    }
+    Bitboard acertosForaDeNavios = bitboardDiferenca(estado->tabuleiro.acertos, ocupadas);
+    return restantes == estado->naviosRestantes &&
+           memcmp(&ocupadas, &estado->tabuleiro.navios, sizeof(ocupadas)) == 0 &&
+           bitboardVazioTeste(acertosForaDeNavios);
+}
+
+/**
+ * Confere o CRC de uma partida e os campos usados como índices
+ * (o mapa célula → navio não é conferido: restaurarPartidaInstantanea o reconstrói)
+ *
+ * @return 1 se a partida pode ser retomada
+ */
+int partidaInstantaneaIntegra(const PartidaInstantanea* partida) {
+    if (partida->crc != crcPartidaInstantanea(partida) || (partida->vez != 0 && partida->vez != 1)) {
+        return 0;
+    }
+    for (int j = 0; j < 2; j++) {
+        if (!estadoInstantaneoIntegro(&partida->estados[j])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Copia uma partida íntegra do instantâneo e reconstrói o mapa célula → navio
+ * a partir dos navios, em vez de confiar no mapa gravado
+ *
+ * @param destino Partida de destino
+ * @param salva Partida aprovada por partidaInstantaneaIntegra
+ */
+void restaurarPartidaInstantanea(PartidaInstantanea* destino, const PartidaInstantanea* salva) {
+    memcpy(destino, salva, sizeof(PartidaInstantanea));
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < destino->estados[j].quantidadeNavios; i++) {
+            marcarCelulasNavio(&destino->estados[j], i);
+        }
+    }
+}
+
+/*
+ * ============================================
+ * SERVIDOR MULTIJOGADOR (EPOLL)
+ * ============================================
+ *
+ * Protocolo binário: cada mensagem é [tipo u8][tamanho u8][carga]
+ * Coordenadas viajam como texto curto no formato de lerCoordenada ("A5"),
+ * precedido do comprimento, e são validadas por interpretarCoordenada
+ *
+ * Cliente -> servidor
+ *   ENTRAR    (vazio)                           entra na fila; pares formam partidas
+ *   ATAQUE    habilidade u8, coordenada         0=CONE 1=CRUZ 2=OCTAEDRO
+ *   RETOMAR   chave u64, jogador u8             volta a uma partida restaurada de instantâneo
+ * Servidor -> cliente
+ *   INICIO    jogador u8, suaVez u8, chave u64  frotas sorteadas pelo servidor (chave de retomada)
+ *   RESULTADO atacante u8 (0=você), habilidade u8, coordenada, acertos u8,
+ *             afundados u8 (máscara), naviosRestantes u8 (do defensor)
+ *   FIM       venceu u8
+ *   ERRO      código i8                         ERRO_COORDENADA_*, ERRO_FORA_DA_VEZ, ...
+ *
+ * Com --metricas PORTA, um segundo socket responde a qualquer requisição HTTP
+ * com as métricas agregadas em texto (formato de exposição do Prometheus)
+ *
+ * Com --instantaneo ARQUIVO, as partidas em andamento são gravadas a cada
+ * INTERVALO_INSTANTANEO_MS (se mudaram), em SIGUSR1 e ao encerrar; um servidor
+ * iniciado com o mesmo arquivo as restaura e espera os jogadores voltarem com
+ * RETOMAR. Até os dois voltarem, os ataques recebem ERRO_ADVERSARIO_AUSENTE
+ */
+
+/**
+ * Conexão de um jogador, guardada na tabela de conexões do servidor
+ */
+typedef struct {
+    int descritor;                  // -1 = entrada livre
+    int partida;                    // Índice da partida, -1 fora de partida
+    int jogador;                    // 0 ou 1 dentro da partida
+    int proximaLivre;               // Lista de entradas livres
+    int pendente;                   // 1 se está na lista de saídas a enviar
+    int transbordou;                // 1 = uma mensagem não coube na saída: fecha ao fim do lote
+    int metricas;                   // 1 = cliente do endpoint de métricas
+    uint16_t tamanhoEntrada;
+    uint16_t tamanhoSaida;
+    uint16_t enviadoSaida;
+    uint8_t entrada[TAMANHO_ENTRADA_CONEXAO];
+    uint8_t saida[TAMANHO_SAIDA_CONEXAO];
+} ConexaoServidor;
+
+/**
+ * Partida hospedada: única alocação da arena do seu objeto no pool
+ * Os tabuleiros e navios ficam na parte salva, gravada como está nos instantâneos
+ */
+typedef struct {
+    PartidaInstantanea salva;
+    int conexoes[2];                // -1 = jogador ausente
+    int ativa;                      // 0 depois de devolvida ao pool
+} PartidaServidor;
+
+/**
+ * Fragmento dos contadores do servidor, em linhas de cache próprias: cada thread
+ * grava só no seu com somas atômicas relaxadas, sem travas nem disputa de linha
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) atomic_llong partidasIniciadas;
+    atomic_llong partidasConcluidas;
+    atomic_llong ataques;
+    atomic_llong tiros[QUANTIDADE_HABILIDADES_PADRAO];
+    atomic_llong acertos[QUANTIDADE_HABILIDADES_PADRAO];
+    atomic_llong latencia[BALDES_HISTOGRAMA_FASE];     // Latência do disparo (ns), baldes HDR
+} FragmentoMetricas;
+
+/**
+ * Métricas agregadas do servidor; a leitura soma os fragmentos sem parar quem grava
+ */
+typedef struct {
+    FragmentoMetricas fragmentos[FRAGMENTOS_METRICAS];
+    atomic_int proximoFragmento;
+    // Usados só por quem responde às raspagens (taxas desde a raspagem anterior)
+    uint64_t inicioNs;
+    uint64_t raspagemAnteriorNs;
+    long long partidasAnteriores;
+    long long ataquesAnteriores;
+} MetricasServidor;
+
+/**
+ * Soma dos fragmentos em um instante
+ */
+typedef struct {
+    long long partidasIniciadas;
+    long long partidasConcluidas;
+    long long ataques;
+    long long tiros[QUANTIDADE_HABILIDADES_PADRAO];
+    long long acertos[QUANTIDADE_HABILIDADES_PADRAO];
+    uint64_t amostrasLatencia;
+    uint64_t latencia[BALDES_HISTOGRAMA_FASE];
+} LeituraMetricas;
+
+/**
+ * Estado do servidor: slabs de conexões e partidas alocados uma vez na partida do processo
+ */
+typedef struct {
+    int epoll;
+    int escuta;
+    int escutaMetricas;             // -1 sem endpoint de métricas
+    ConexaoServidor* conexoes;
+    int capacidadeConexoes;
+    int conexaoLivre;
+    PoolPartidas partidas;
+    int esperando;                  // Conexão aguardando adversário, -1 se nenhuma
+    int* pendentes;                 // Conexões com saída a enviar ao fim do lote de eventos
+    int quantidadePendentes;
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    GeradorAleatorio gerador;
+    MetricasServidor* metricas;
+    uint64_t inicioLote;            // Retorno do epoll_wait do lote atual (ns)
+    int ataquesLote;                // Ataques resolvidos no lote atual
+    int conexoesAtivas;
+    GeradorAleatorio geradorChaves; // Chaves de retomada, independentes da semente das frotas
+    const char* caminhoInstantaneo; // NULL sem instantâneos
+    long long alteracoes;           // Mudanças desde o último instantâneo
+    int* retomaveis;                // Tabela chave -> partida das restauradas (endereçamento aberto)
+    uint32_t mascaraRetomaveis;
+} Servidor;
+
+static volatile sig_atomic_t servidorEncerrando = 0;
+static volatile sig_atomic_t servidorInstantaneoPedido = 0;
+
+// Fragmento de métricas da thread (o processo hospeda um único servidor)
+static _Thread_local int fragmentoMetricasDaThread = -1;
+
+static inline PartidaServidor* partidaServidor(Servidor* servidor, int indice) {
+    return (PartidaServidor*)arenaPartidaPool(&servidor->partidas, indice)->base;
+}
+
+static void sinalEncerrarServidor(int sinal) {
+    (void)sinal;
+    servidorEncerrando = 1;
+}
+
+static void sinalInstantaneoServidor(int sinal) {
+    (void)sinal;
+    servidorInstantaneoPedido = 1;
+}
+
+static inline uint64_t nanossegundosMonotonicos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Fragmento de métricas da thread corrente, distribuído em rodízio no primeiro uso
+ */
+static inline FragmentoMetricas* fragmentoMetricas(MetricasServidor* metricas) {
+    if (fragmentoMetricasDaThread < 0) {
+        fragmentoMetricasDaThread = atomic_fetch_add_explicit(&metricas->proximoFragmento, 1, memory_order_relaxed) %
+                                    FRAGMENTOS_METRICAS;
+    }
+    return &metricas->fragmentos[fragmentoMetricasDaThread];
+}
+
+static inline void somarMetrica(atomic_llong* contador, long long valor) {
+    atomic_fetch_add_explicit(contador, valor, memory_order_relaxed);
+}
+
+/**
+ * Soma os fragmentos; cada contador é lido atomicamente, o conjunto não é um
+ * instantâneo exato (os totais podem estar alguns ataques defasados entre si)
+ */
+static void lerMetricasServidor(MetricasServidor* metricas, LeituraMetricas* leitura) {
+    memset(leitura, 0, sizeof(*leitura));
+    for (int f = 0; f < FRAGMENTOS_METRICAS; f++) {
+        FragmentoMetricas* fragmento = &metricas->fragmentos[f];
+        leitura->partidasIniciadas += atomic_load_explicit(&fragmento->partidasIniciadas, memory_order_relaxed);
+        leitura->partidasConcluidas += atomic_load_explicit(&fragmento->partidasConcluidas, memory_order_relaxed);
+        leitura->ataques += atomic_load_explicit(&fragmento->ataques, memory_order_relaxed);
+        for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+            leitura->tiros[h] += atomic_load_explicit(&fragmento->tiros[h], memory_order_relaxed);
+            leitura->acertos[h] += atomic_load_explicit(&fragmento->acertos[h], memory_order_relaxed);
+        }
+        for (int b = 0; b < BALDES_HISTOGRAMA_FASE; b++) {
+            uint64_t contagem = (uint64_t)atomic_load_explicit(&fragmento->latencia[b], memory_order_relaxed);
+            leitura->latencia[b] += contagem;
+            leitura->amostrasLatencia += contagem;
+        }
+    }
+}
+
+/**
+ * Formata as métricas no formato de exposição em texto do Prometheus
+ * As taxas por segundo cobrem o intervalo desde a raspagem anterior
+ *
+ * @return Bytes escritos (truncado em tamanho - 1)
+ */
+static int formatarMetricasServidor(Servidor* servidor, char* destino, size_t tamanho) {
+    static LeituraMetricas leitura;     // Só a thread do laço de eventos responde às raspagens
+    MetricasServidor* metricas = servidor->metricas;
+    lerMetricasServidor(metricas, &leitura);
+    uint64_t agora = nanossegundosMonotonicos();
+    double intervalo = (double)(agora - metricas->raspagemAnteriorNs) / 1e9;
+    intervalo = intervalo > 0.0 ? intervalo : 1e-9;
+
+    size_t usado = 0;
+#define ESCREVER_METRICA(...) \
+    (usado += (size_t)snprintf(destino + (usado < tamanho ? usado : tamanho - 1), \
+                               usado < tamanho ? tamanho - usado : 1, __VA_ARGS__))
+    ESCREVER_METRICA("# TYPE batalha_tempo_ativo_segundos gauge\nbatalha_tempo_ativo_segundos %.3f\n",
+                     (double)(agora - metricas->inicioNs) / 1e9);
+    ESCREVER_METRICA("# TYPE batalha_conexoes_ativas gauge\nbatalha_conexoes_ativas %d\n", servidor->conexoesAtivas);
+    ESCREVER_METRICA("# TYPE batalha_partidas_em_andamento gauge\nbatalha_partidas_em_andamento %d\n",
+                     servidor->partidas.stats.emUso);
+    ESCREVER_METRICA("# TYPE batalha_partidas_iniciadas_total counter\nbatalha_partidas_iniciadas_total %lld\n",
+                     leitura.partidasIniciadas);
+    ESCREVER_METRICA("# TYPE batalha_partidas_concluidas_total counter\nbatalha_partidas_concluidas_total %lld\n",
+                     leitura.partidasConcluidas);
+    ESCREVER_METRICA("# TYPE batalha_ataques_total counter\nbatalha_ataques_total %lld\n", leitura.ataques);
+    ESCREVER_METRICA("# TYPE batalha_partidas_por_segundo gauge\nbatalha_partidas_por_segundo %.1f\n",
+                     (double)(leitura.partidasConcluidas - metricas->partidasAnteriores) / intervalo);
+    ESCREVER_METRICA("# TYPE batalha_ataques_por_segundo gauge\nbatalha_ataques_por_segundo %.1f\n",
+                     (double)(leitura.ataques - metricas->ataquesAnteriores) / intervalo);
+
+    ESCREVER_METRICA("# TYPE batalha_tiros_total counter\n");
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        ESCREVER_METRICA("batalha_tiros_total{habilidade=\"%s\"} %lld\n", NOMES_HABILIDADES_PADRAO[h], leitura.tiros[h]);
+    }
+    ESCREVER_METRICA("# TYPE batalha_acertos_total counter\n");
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        ESCREVER_METRICA("batalha_acertos_total{habilidade=\"%s\"} %lld\n", NOMES_HABILIDADES_PADRAO[h],
+                         leitura.acertos[h]);
+    }
+    ESCREVER_METRICA("# TYPE batalha_taxa_acerto gauge\n");
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        ESCREVER_METRICA("batalha_taxa_acerto{habilidade=\"%s\"} %.4f\n", NOMES_HABILIDADES_PADRAO[h],
+                         leitura.tiros[h] > 0 ? (double)leitura.acertos[h] / (double)leitura.tiros[h] : 0.0);
+    }
+
+    static const double quantis[] = {0.5, 0.9, 0.99, 0.999};
+    ESCREVER_METRICA("# TYPE batalha_latencia_disparo_segundos summary\n");
+    for (size_t q = 0; q < sizeof(quantis) / sizeof(quantis[0]); q++) {
+        uint64_t ns = percentilHistograma(leitura.latencia, leitura.amostrasLatencia, quantis[q] * 100.0);
+        ESCREVER_METRICA("batalha_latencia_disparo_segundos{quantile=\"%g\"} %.9f\n", quantis[q], (double)ns / 1e9);
+    }
+    ESCREVER_METRICA("batalha_latencia_disparo_segundos_count %llu\n", (unsigned long long)leitura.amostrasLatencia);
+#undef ESCREVER_METRICA
+
+    metricas->raspagemAnteriorNs = agora;
+    metricas->partidasAnteriores = leitura.partidasConcluidas;
+    metricas->ataquesAnteriores = leitura.ataques;
+    return (int)(usado < tamanho ? usado : tamanho - 1);
+}
+
+/**
+ * Eleva o limite de descritores abertos ao máximo permitido
+ */
+static void elevarLimiteDescritores(void) {
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+}
+
+/**
+ * Formata uma coordenada no formato de lerCoordenada ("A5", "AB12")
+ *
+ * @return Quantidade de caracteres escritos (sem o terminador)
+ */
+static int formatarCoordenada(Coordenada coord, char* destino, size_t tamanho) {
+    int letras = formatarColuna(coord.coluna, destino, tamanho);
+    return letras + snprintf(destino + letras, tamanho - (size_t)letras, "%d", coord.linha);
+}
+
+static int enviarSaidaServidor(Servidor* servidor, int indice);
+
+/**
+ * Enfileira uma mensagem na saída da conexão; o envio acontece ao fim do lote de eventos
+ * Com a saída cheia, o que já está enfileirado é enviado na hora; se ainda assim a mensagem
+ * não couber, a conexão é marcada para fechar ao fim do lote em vez de perder a mensagem
+ *
+ * @return SUCESSO, ou ERRO_ES se a conexão está fechada ou a mensagem não pôde ser enfileirada
+ */
+static int enviarMensagemServidor(Servidor* servidor, int indice, uint8_t tipo,
+                                  const uint8_t* carga, uint8_t tamanho) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    if (conexao->descritor < 0 || conexao->transbordou) {
+        return ERRO_ES;
+    }
+    if (conexao->tamanhoSaida + 2u + tamanho > TAMANHO_SAIDA_CONEXAO) {
+        int aberta = enviarSaidaServidor(servidor, indice);
+        // Um envio parcial deixa o restante no início do buffer
+        memmove(conexao->saida, &conexao->saida[conexao->enviadoSaida],
+                (size_t)(conexao->tamanhoSaida - conexao->enviadoSaida));
+        conexao->tamanhoSaida = (uint16_t)(conexao->tamanhoSaida - conexao->enviadoSaida);
+        conexao->enviadoSaida = 0;
+        if (!aberta || conexao->tamanhoSaida + 2u + tamanho > TAMANHO_SAIDA_CONEXAO) {
+            // Fechar agora liberaria partidas que quem chamou ainda usa
+            conexao->transbordou = 1;
+            if (!conexao->pendente) {
+                conexao->pendente = 1;
+                servidor->pendentes[servidor->quantidadePendentes++] = indice;
+            }
+            return ERRO_ES;
+        }
+    }
+    conexao->saida[conexao->tamanhoSaida++] = tipo;
+    conexao->saida[conexao->tamanhoSaida++] = tamanho;
+    memcpy(&conexao->saida[conexao->tamanhoSaida], carga, tamanho);
+    conexao->tamanhoSaida += tamanho;
+
+    if (!conexao->pendente) {
+        conexao->pendente = 1;
+        servidor->pendentes[servidor->quantidadePendentes++] = indice;
+    }
+    return SUCESSO;
+}
+
+static void enviarErroServidor(Servidor* servidor, int indice, int codigo) {
+    uint8_t carga = (uint8_t)(int8_t)codigo;
+    enviarMensagemServidor(servidor, indice, MSG_ERRO, &carga, 1);
+}
+
+/**
+ * Devolve a partida ao pool (a arena inteira é descartada de uma vez)
+ */
+static void liberarPartidaServidor(Servidor* servidor, int indice) {
+    PartidaServidor* partida = partidaServidor(servidor, indice);
+    for (int j = 0; j < 2; j++) {
+        if (partida->conexoes[j] >= 0) {
+            servidor->conexoes[partida->conexoes[j]].partida = -1;
+        }
+    }
+    partida->ativa = 0;
+    servidor->alteracoes++;
+    liberarPartidaPool(&servidor->partidas, indice);
+}
+
+/**
+ * Encerra uma partida avisando cada jogador se venceu
+ */
+static void encerrarPartidaServidor(Servidor* servidor, int indice, int vencedor) {
+    PartidaServidor* partida = partidaServidor(servidor, indice);
+    for (int j = 0; j < 2; j++) {
+        if (partida->conexoes[j] >= 0) {
+            uint8_t venceu = (uint8_t)(j == vencedor);
+            enviarMensagemServidor(servidor, partida->conexoes[j], MSG_FIM, &venceu, 1);
+        }
+    }
+    somarMetrica(&fragmentoMetricas(servidor->metricas)->partidasConcluidas, 1);
+    liberarPartidaServidor(servidor, indice);
+}
+
+/**
+ * Fecha a conexão; o adversário de uma partida em andamento vence por abandono
+ */
+static void fecharConexaoServidor(Servidor* servidor, int indice) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    if (conexao->descritor < 0) {
+        return;
+    }
+    if (servidor->esperando == indice) {
+        servidor->esperando = -1;
+    }
+    if (conexao->partida >= 0) {
+        PartidaServidor* partida = partidaServidor(servidor, conexao->partida);
+        partida->conexoes[conexao->jogador] = -1;
+        encerrarPartidaServidor(servidor, conexao->partida, 1 - conexao->jogador);
+    }
+
+    close(conexao->descritor);  // Também remove o descritor do epoll
+    conexao->descritor = -1;
+    conexao->proximaLivre = servidor->conexaoLivre;
+    servidor->conexaoLivre = indice;
+    servidor->conexoesAtivas -= !conexao->metricas;
+}
+
+/**
+ * Envia o INICIO a um jogador: seu número, se é a sua vez e a chave de retomada
+ */
+static void enviarInicioServidor(Servidor* servidor, int indicePartida, int jogador) {
+    PartidaServidor* partida = partidaServidor(servidor, indicePartida);
+    uint8_t carga[10] = {(uint8_t)jogador, (uint8_t)(jogador == partida->salva.vez)};
+    escreverU64(&carga[2], partida->salva.chave);
+    enviarMensagemServidor(servidor, partida->conexoes[jogador], MSG_INICIO, carga, sizeof(carga));
+}
+
+/**
+ * Forma uma partida com o jogador em espera, ou coloca a conexão em espera
+ */
+static void entrarNaFilaServidor(Servidor* servidor, int indice) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    if (conexao->partida >= 0 || servidor->esperando == indice) {
+        enviarErroServidor(servidor, indice, ERRO_JA_EM_PARTIDA);
+        return;
+    }
+    if (servidor->esperando < 0) {
+        servidor->esperando = indice;
+        return;
+    }
+    int p = adquirirPartidaPool(&servidor->partidas);
+    if (p < 0) {
+        enviarErroServidor(servidor, indice, ERRO_SERVIDOR_CHEIO);
+        return;
+    }
+
+    // O objeto do pool comporta a partida com os dois estados (ver criarServidor)
+    PartidaServidor* partida = alocarNaPartidaPool(&servidor->partidas, p, sizeof(PartidaServidor),
+                                                   _Alignof(PartidaServidor));
+    partida->conexoes[0] = servidor->esperando;
+    partida->conexoes[1] = indice;
+    partida->salva.vez = 0;
+    partida->salva.chave = proximoAleatorio(&servidor->geradorChaves);
+    partida->ativa = 1;
+    servidor->esperando = -1;
+    servidor->alteracoes++;
+    somarMetrica(&fragmentoMetricas(servidor->metricas)->partidasIniciadas, 1);
+
+    for (int j = 0; j < 2; j++) {
+        inicializarEstadoJogo(&partida->salva.estados[j]);
+        posicionarFrotaUniforme(NULL, &partida->salva.estados[j], &servidor->gerador);
+        ConexaoServidor* jogador = &servidor->conexoes[partida->conexoes[j]];
+        jogador->partida = p;
+        jogador->jogador = j;
+        enviarInicioServidor(servidor, p, j);
+    }
+}
+
+/**
+ * Volta a uma partida restaurada de instantâneo (RETOMAR chave, jogador)
+ */
+static void retomarPartidaServidor(Servidor* servidor, int indice, const uint8_t* carga, int tamanho) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    if (conexao->partida >= 0 || servidor->esperando == indice) {
+        enviarErroServidor(servidor, indice, ERRO_JA_EM_PARTIDA);
+        return;
+    }
+    if (tamanho != 9 || carga[8] > 1 || servidor->retomaveis == NULL) {
+        enviarErroServidor(servidor, indice, ERRO_SEM_PARTIDA);
+        return;
+    }
+    uint64_t chave = lerU64(carga);
+    int jogador = carga[8];
+
+    // Entradas de partidas já encerradas continuam na tabela: a chave da partida confirma
+    for (uint32_t i = (uint32_t)chave & servidor->mascaraRetomaveis; servidor->retomaveis[i] >= 0;
+         i = (i + 1) & servidor->mascaraRetomaveis) {
+        PartidaServidor* partida = partidaServidor(servidor, servidor->retomaveis[i]);
+        if (partida->ativa && partida->salva.chave == chave) {
+            if (partida->conexoes[jogador] >= 0) {
+                break;
+            }
+            partida->conexoes[jogador] = indice;
+            conexao->partida = servidor->retomaveis[i];
+            conexao->jogador = jogador;
+            enviarInicioServidor(servidor, servidor->retomaveis[i], jogador);
+            return;
+        }
+    }
+    enviarErroServidor(servidor, indice, ERRO_SEM_PARTIDA);
+}
+
+/**
+ * Resolve um ATAQUE recebido e relata o resultado aos dois jogadores
+ */
+static void processarAtaqueServidor(Servidor* servidor, int indice, const uint8_t* carga, int tamanho) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    if (conexao->partida < 0) {
+        enviarErroServidor(servidor, indice, ERRO_SEM_PARTIDA);
+        return;
+    }
+    PartidaServidor* partida = partidaServidor(servidor, conexao->partida);
+    if (partida->salva.vez != conexao->jogador) {
+        enviarErroServidor(servidor, indice, ERRO_FORA_DA_VEZ);
+        return;
+    }
+    if (partida->conexoes[1 - conexao->jogador] < 0) {
+        enviarErroServidor(servidor, indice, ERRO_ADVERSARIO_AUSENTE);
+        return;
+    }
+    if (tamanho < 2 || carga[1] > MAX_TEXTO_COORDENADA || tamanho != 2 + carga[1]) {
+        enviarErroServidor(servidor, indice, ERRO_COORDENADA_FORMATO);
+        return;
+    }
+    int habilidade = carga[0];
+    if (habilidade >= QUANTIDADE_HABILIDADES_PADRAO) {
+        enviarErroServidor(servidor, indice, ERRO_HABILIDADE_INVALIDA);
+        return;
+    }
+
+    char texto[MAX_TEXTO_COORDENADA + 1];
+    memcpy(texto, &carga[2], carga[1]);
+    texto[carga[1]] = '\0';
+    Coordenada centro;
+    int validacao = interpretarCoordenada(texto, TAMANHO_TABULEIRO, TAMANHO_TABULEIRO, &centro);
+    if (validacao != SUCESSO) {
+        enviarErroServidor(servidor, indice, validacao);
+        return;
+    }
+
+    int defensor = 1 - conexao->jogador;
+    EstadoJogo* alvo = &partida->salva.estados[defensor];
+    int afundadosAntes = 0, afundados = 0;
+    for (int n = 0; n < alvo->quantidadeNavios; n++) {
+        afundadosAntes |= alvo->navios[n].foiDestruido << n;
+    }
+    int acertos = resolverAtaque(alvo, &servidor->habilidades[habilidade], centro, NULL);
+    for (int n = 0; n < alvo->quantidadeNavios; n++) {
+        afundados |= alvo->navios[n].foiDestruido << n;
+    }
+    afundados &= ~afundadosAntes;
+
+    FragmentoMetricas* metricas = fragmentoMetricas(servidor->metricas);
+    somarMetrica(&metricas->ataques, 1);
+    somarMetrica(&metricas->tiros[habilidade],
+                 bitboardContar(servidor->habilidades[habilidade].mascaras[indiceCelula(centro.linha, centro.coluna)]));
+    somarMetrica(&metricas->acertos[habilidade], acertos);
+    servidor->ataquesLote++;
+    servidor->alteracoes++;
+
+    // RESULTADO: a coordenada volta normalizada (maiúsculas)
+    uint8_t resposta[6 + MAX_TEXTO_COORDENADA];
+    int comprimento = formatarCoordenada(centro, (char*)&resposta[3], MAX_TEXTO_COORDENADA + 1);
+    resposta[1] = (uint8_t)habilidade;
+    resposta[2] = (uint8_t)comprimento;
+    resposta[3 + comprimento] = (uint8_t)acertos;
+    resposta[4 + comprimento] = (uint8_t)afundados;
+    resposta[5 + comprimento] = (uint8_t)alvo->naviosRestantes;
+    for (int j = 0; j < 2; j++) {
+        resposta[0] = (uint8_t)(j != conexao->jogador);
+        enviarMensagemServidor(servidor, partida->conexoes[j], MSG_RESULTADO, resposta, (uint8_t)(6 + comprimento));
+    }
+
+    if (alvo->naviosRestantes == 0) {
+        encerrarPartidaServidor(servidor, conexao->partida, conexao->jogador);
+    } else {
+        partida->salva.vez = defensor;
+    }
+}
+
+/**
+ * Lê tudo o que estiver disponível e processa as mensagens completas
+ *
+ * @return 1 se a conexão continua aberta, 0 se deve ser fechada
+ */
+static int lerConexaoServidor(Servidor* servidor, int indice) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    for (;;) {
+        ssize_t lidos = read(conexao->descritor, &conexao->entrada[conexao->tamanhoEntrada],
+                             TAMANHO_ENTRADA_CONEXAO - conexao->tamanhoEntrada);
+        if (lidos == 0) {
+            return 0;
+        }
+        if (lidos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conexao->tamanhoEntrada += (uint16_t)lidos;
+
+        size_t posicao = 0;
+        while (conexao->tamanhoEntrada - posicao >= 2 &&
+               conexao->tamanhoEntrada - posicao >= 2u + conexao->entrada[posicao + 1]) {
+            uint8_t tipo = conexao->entrada[posicao];
+            uint8_t tamanho = conexao->entrada[posicao + 1];
+            const uint8_t* carga = &conexao->entrada[posicao + 2];
+            posicao += 2u + tamanho;
+
+            if (tipo == MSG_ENTRAR) {
+                entrarNaFilaServidor(servidor, indice);
+            } else if (tipo == MSG_ATAQUE) {
+                processarAtaqueServidor(servidor, indice, carga, tamanho);
+            } else if (tipo == MSG_RETOMAR) {
+                retomarPartidaServidor(servidor, indice, carga, tamanho);
+            } else {
+                return 0;   // Tipo desconhecido: protocolo violado
+            }
+        }
+        memmove(conexao->entrada, &conexao->entrada[posicao], conexao->tamanhoEntrada - posicao);
+        conexao->tamanhoEntrada -= (uint16_t)posicao;
+    }
+}
+
+/**
+ * Atende um cliente do endpoint de métricas: lê a requisição até a linha em branco
+ * e responde de uma vez; a conexão é fechada em seguida (HTTP/1.0)
+ *
+ * @return 1 se ainda aguarda o restante da requisição, 0 se deve ser fechada
+ */
+static int responderMetricasServidor(Servidor* servidor, int indice) {
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    for (;;) {
+        ssize_t lidos = read(conexao->descritor, &conexao->entrada[conexao->tamanhoEntrada],
+                             TAMANHO_ENTRADA_CONEXAO - 1 - conexao->tamanhoEntrada);
+        if (lidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (lidos < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return 0;
+            }
+            break;
+        }
+        conexao->tamanhoEntrada += (uint16_t)lidos;
+        if (lidos == 0 || conexao->tamanhoEntrada == TAMANHO_ENTRADA_CONEXAO - 1) {
+            break;      // Fim do envio ou cabeçalho longo: responde com o que chegou
+        }
+    }
+    conexao->entrada[conexao->tamanhoEntrada] = '\0';
+    const char* texto = (const char*)conexao->entrada;
+    if (conexao->tamanhoEntrada < TAMANHO_ENTRADA_CONEXAO - 1 &&
+        strstr(texto, "\r\n\r\n") == NULL && strstr(texto, "\n\n") == NULL) {
+        return 1;
+    }
+
+    static char resposta[TAMANHO_RESPOSTA_METRICAS];
+    static char corpo[TAMANHO_RESPOSTA_METRICAS - 128];
+    int tamanhoCorpo = formatarMetricasServidor(servidor, corpo, sizeof(corpo));
+    int tamanhoResposta = snprintf(resposta, sizeof(resposta),
+                                   "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                   "Content-Length: %d\r\nConnection: close\r\n\r\n%s", tamanhoCorpo, corpo);
+    // Um socket recém-aceito aceita a resposta inteira no buffer do núcleo
+    for (int enviado = 0; enviado < tamanhoResposta;) {
+        ssize_t escritos = write(conexao->descritor, resposta + enviado, (size_t)(tamanhoResposta - enviado));
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos <= 0) {
+            break;
+        }
+        enviado += (int)escritos;
+    }
+    return 0;
+}
+
+/**
+ * Envia a saída acumulada de uma conexão; o restante espera por EPOLLOUT
+ *
+ * @return 1 se a conexão continua aberta, 0 se deve ser fechada
+ */
+static int enviarSaidaServidor(Servidor* servidor, int indice) {
+    MEDIR_FASE(FASE_ES);
+    ConexaoServidor* conexao = &servidor->conexoes[indice];
+    while (conexao->enviadoSaida < conexao->tamanhoSaida) {
+        ssize_t escritos = write(conexao->descritor, &conexao->saida[conexao->enviadoSaida],
+                                 conexao->tamanhoSaida - conexao->enviadoSaida);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                struct epoll_event evento = {EPOLLIN | EPOLLOUT, {.u32 = (uint32_t)indice}};
+                epoll_ctl(servidor->epoll, EPOLL_CTL_MOD, conexao->descritor, &evento);
+                return 1;
+            }
+            return 0;
+        }
+        conexao->enviadoSaida += (uint16_t)escritos;
+    }
+    conexao->tamanhoSaida = conexao->enviadoSaida = 0;
+    return 1;
+}
+
+/**
+ * Aceita todas as conexões pendentes em um socket de escuta
+ *
+ * @param escuta Socket de jogo ou de métricas
+ * @param metricas 1 se as conexões são do endpoint de métricas
+ */
+static void aceitarConexoesServidor(Servidor* servidor, int escuta, int metricas) {
+    for (;;) {
+        int descritor = accept(escuta, NULL, NULL);
+        if (descritor < 0) {
+            return;     // EAGAIN: nada mais a aceitar (ou erro transitório)
+        }
+        fcntl(descritor, F_SETFL, fcntl(descritor, F_GETFL) | O_NONBLOCK);
+        fcntl(descritor, F_SETFD, FD_CLOEXEC);
+        if (servidor->conexaoLivre < 0) {
+            close(descritor);
+            continue;
+        }
+
+        int indice = servidor->conexaoLivre;
+        ConexaoServidor* conexao = &servidor->conexoes[indice];
+        servidor->conexaoLivre = conexao->proximaLivre;
+
+        int ligado = 1;
+        setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &ligado, sizeof(ligado));
+        conexao->descritor = descritor;
+        conexao->partida = -1;
+        conexao->pendente = 0;
+        conexao->transbordou = 0;
+        conexao->metricas = metricas;
+        conexao->tamanhoEntrada = conexao->tamanhoSaida = conexao->enviadoSaida = 0;
+        servidor->conexoesAtivas += !metricas;
+
+        struct epoll_event evento = {EPOLLIN, {.u32 = (uint32_t)indice}};
+        if (epoll_ctl(servidor->epoll, EPOLL_CTL_ADD, descritor, &evento) != 0) {
+            fecharConexaoServidor(servidor, indice);
+        }
+    }
+}
+
+/**
+ * Abre um socket TCP de escuta não bloqueante em todas as interfaces
+ *
+ * @return Descritor, ou -1 em caso de erro
+ */
+static int abrirEscutaServidor(int porta) {
+    int escuta = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (escuta < 0) {
+        return -1;
+    }
+    int ligado = 1;
+    setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, &ligado, sizeof(ligado));
+    struct sockaddr_in endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sin_family = AF_INET;
+    endereco.sin_addr.s_addr = htonl(INADDR_ANY);
+    endereco.sin_port = htons((uint16_t)porta);
+    if (bind(escuta, (struct sockaddr*)&endereco, sizeof(endereco)) != 0 || listen(escuta, SOMAXCONN) != 0) {
+        close(escuta);
+        return -1;
+    }
+    return escuta;
+}
+
+/**
+ * Cria o servidor: sockets de escuta, epoll, a tabela de conexões, o pool de partidas e as métricas
+ *
+ * @param portaMetricas Porta do endpoint de métricas, -1 para não abri-lo
+ * @return SUCESSO, ERRO_MEMORIA ou ERRO_ES se um socket não abrir (causa em errno)
+ */
+static int criarServidor(Servidor* servidor, int porta, int portaMetricas, int maxPartidas, uint64_t semente) {
+    memset(servidor, 0, sizeof(*servidor));
+    servidor->escuta = servidor->escutaMetricas = -1;
+    servidor->capacidadeConexoes = 2 * maxPartidas + 1;
+    servidor->conexoes = malloc(sizeof(ConexaoServidor) * (size_t)servidor->capacidadeConexoes);
+    servidor->pendentes = malloc(sizeof(int) * (size_t)servidor->capacidadeConexoes);
+    servidor->metricas = alocarAlinhadoCache(sizeof(MetricasServidor));
+    if (servidor->conexoes == NULL || servidor->pendentes == NULL || servidor->metricas == NULL ||
+        criarPoolPartidas(&servidor->partidas, maxPartidas, sizeof(PartidaServidor)) != SUCESSO) {
+        return ERRO_MEMORIA;
+    }
+    // Objetos zerados: nenhuma partida começa ativa para a varredura dos instantâneos
+    memset(servidor->partidas.memoria, 0, servidor->partidas.bytesPorPartida * (size_t)maxPartidas);
+    memset(servidor->metricas, 0, sizeof(MetricasServidor));
+    servidor->metricas->inicioNs = servidor->metricas->raspagemAnteriorNs = nanossegundosMonotonicos();
+
+    // Lista livre em ordem crescente de índice
+    for (int i = 0; i < servidor->capacidadeConexoes; i++) {
+        servidor->conexoes[i].descritor = -1;
+        servidor->conexoes[i].proximaLivre = i + 1 < servidor->capacidadeConexoes ? i + 1 : -1;
+    }
+    servidor->conexaoLivre = 0;
+    servidor->esperando = -1;
+    criarHabilidadesPadrao(servidor->habilidades);
+    inicializarGerador(&servidor->gerador, semente, 0);
+    inicializarGerador(&servidor->geradorChaves, nanossegundosMonotonicos() ^ (uint64_t)time(NULL), (uint64_t)getpid());
+
+    servidor->escuta = abrirEscutaServidor(porta);
+    if (servidor->escuta < 0) {
+        return ERRO_ES;
+    }
+    servidor->epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event evento = {EPOLLIN, {.u32 = UINT32_MAX}};  // UINT32_MAX identifica o socket de escuta
+    if (servidor->epoll < 0 || epoll_ctl(servidor->epoll, EPOLL_CTL_ADD, servidor->escuta, &evento) != 0) {
+        return ERRO_ES;
+    }
+    if (portaMetricas >= 0) {
+        servidor->escutaMetricas = abrirEscutaServidor(portaMetricas);
+        struct epoll_event eventoMetricas = {EPOLLIN, {.u32 = UINT32_MAX - 1}};  // Socket de métricas
+        if (servidor->escutaMetricas < 0 ||
+            epoll_ctl(servidor->epoll, EPOLL_CTL_ADD, servidor->escutaMetricas, &eventoMetricas) != 0) {
+            return ERRO_ES;
+        }
+    }
+    return SUCESSO;
+}
+
+static void destruirServidor(Servidor* servidor) {
+    for (int i = 0; i < servidor->capacidadeConexoes && servidor->conexoes != NULL; i++) {
+        if (servidor->conexoes[i].descritor >= 0) {
+            close(servidor->conexoes[i].descritor);
+        }
+    }
+    if (servidor->epoll > 0) {
+        close(servidor->epoll);
+    }
+    if (servidor->escuta >= 0) {
+        close(servidor->escuta);
+    }
+    if (servidor->escutaMetricas >= 0) {
+        close(servidor->escutaMetricas);
+    }
+    destruirPoolPartidas(&servidor->partidas);
+    free(servidor->conexoes);
+    free(servidor->pendentes);
+    free(servidor->metricas);
+    free(servidor->retomaveis);
+}
+
+/**
+ * Grava as partidas ativas no instantâneo do servidor
+ *
+ * @return Partidas gravadas, ou -1 em falha de E/S
+ */
+static int salvarInstantaneoServidor(Servidor* servidor) {
+    PartidaInstantanea** partidas = malloc(sizeof(PartidaInstantanea*) * (size_t)(servidor->partidas.stats.emUso + 1));
+    if (partidas == NULL) {
+        return -1;
+    }
+    int quantidade = 0;
+    for (int p = 0; p < servidor->partidas.capacidade && quantidade < servidor->partidas.stats.emUso; p++) {
+        PartidaServidor* partida = partidaServidor(servidor, p);
+        if (partida->ativa) {
+            partidas[quantidade++] = &partida->salva;
+        }
+    }
+    int resultado = gravarInstantaneo(servidor->caminhoInstantaneo, partidas, quantidade);
+    free(partidas);
+    if (resultado != SUCESSO) {
+        fprintf(stderr, "⚠️  Falha ao gravar o instantâneo %s: %s\n", servidor->caminhoInstantaneo, strerror(errno));
+        return -1;
+    }
+    servidor->alteracoes = 0;
+    return quantidade;
+}
+
+/**
+ * Restaura as partidas de um instantâneo; cada uma espera os dois jogadores com RETOMAR
+ * Partidas com CRC inválido são descartadas individualmente
+ *
+ * @return SUCESSO (também sem arquivo), ERRO_ES ou ERRO_REGISTRO_CORROMPIDO se o arquivo
+ *         existe mas não pôde ser usado, ou ERRO_MEMORIA
+ */
+static int restaurarInstantaneoServidor(Servidor* servidor) {
+    InstantaneoMapeado instantaneo;
+    double inicio = tempoAtual();
+    int resultado = abrirInstantaneo(servidor->caminhoInstantaneo, &instantaneo);
+    if (resultado != SUCESSO) {
+        return resultado == ERRO_ES && errno == ENOENT ? SUCESSO : resultado;
+    }
+
+    uint32_t capacidade = 1;
+    while (capacidade < 2u * (uint32_t)instantaneo.quantidade) {
+        capacidade <<= 1;
+    }
+    servidor->retomaveis = malloc(sizeof(int) * capacidade);
+    if (servidor->retomaveis == NULL) {
+        fecharInstantaneo(&instantaneo);
+        return ERRO_MEMORIA;
+    }
+    memset(servidor->retomaveis, 0xFF, sizeof(int) * capacidade);
+    servidor->mascaraRetomaveis = capacidade - 1;
+
+    int restauradas = 0, descartadas = 0;
+    for (int i = 0; i < instantaneo.quantidade; i++) {
+        const PartidaInstantanea* salva = &instantaneo.partidas[i];
+        int p = partidaInstantaneaIntegra(salva) ? adquirirPartidaPool(&servidor->partidas) : -1;
+        if (p < 0) {
+            descartadas++;
+            continue;
+        }
+        PartidaServidor* partida = alocarNaPartidaPool(&servidor->partidas, p, sizeof(PartidaServidor),
+                                                       _Alignof(PartidaServidor));
+        restaurarPartidaInstantanea(&partida->salva, salva);
+        partida->conexoes[0] = partida->conexoes[1] = -1;
+        partida->ativa = 1;
+        uint32_t posicao = (uint32_t)salva->chave & servidor->mascaraRetomaveis;
+        while (servidor->retomaveis[posicao] >= 0) {
+            posicao = (posicao + 1) & servidor->mascaraRetomaveis;
+        }
+        servidor->retomaveis[posicao] = p;
+        restauradas++;
+    }
+    printf("♻️  Instantâneo %s: %d partidas restauradas, %d descartadas (%.1f ms)\n", servidor->caminhoInstantaneo,
+           restauradas, descartadas, (tempoAtual() - inicio) * 1e3);
+    fecharInstantaneo(&instantaneo);
+    return SUCESSO;
+}
+
+/**
+ * Executa o servidor multijogador (--servidor PORTA [--max-partidas N] [--metricas PORTA] [--instantaneo ARQUIVO])
+ * Uma única thread atende todas as partidas com epoll; as respostas geradas
+ * em um lote de eventos saem juntas, uma escrita por conexão
+ * A latência do disparo vai do retorno do epoll_wait à escrita do RESULTADO
+ *
+ * @param porta Porta TCP
+ * @param portaMetricas Porta do endpoint de métricas em texto, -1 para desativá-lo
+ * @param maxPartidas Partidas simultâneas (tamanho do slab)
+ * @param semente Semente das frotas
+ * @param caminhoInstantaneo Arquivo de instantâneos das partidas, NULL para desativá-los
+ * @return 0 ao encerrar por SIGINT/SIGTERM
+ */
+int executarServidor(int porta, int portaMetricas, int maxPartidas, uint64_t semente, const char* caminhoInstantaneo) {
+    elevarLimiteDescritores();
+    signal(SIGPIPE, SIG_IGN);
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = sinalEncerrarServidor;   // Sem SA_RESTART: epoll_wait retorna com EINTR
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+    acao.sa_handler = sinalInstantaneoServidor;
+    sigaction(SIGUSR1, &acao, NULL);
+
+    Servidor* servidor = malloc(sizeof(Servidor));
+    int criado = servidor != NULL ? criarServidor(servidor, porta, portaMetricas, maxPartidas, semente) : ERRO_MEMORIA;
+    if (criado != SUCESSO) {
+        fprintf(stderr, "❌ Não foi possível iniciar o servidor na porta %d: %s\n", porta,
+                criado == ERRO_MEMORIA ? "memória insuficiente" : strerror(errno));
+        if (servidor != NULL) {
+            destruirServidor(servidor);
+        }
+        free(servidor);
+        return 1;
+    }
+    servidor->caminhoInstantaneo = caminhoInstantaneo;
+    int restaurado = caminhoInstantaneo != NULL ? restaurarInstantaneoServidor(servidor) : SUCESSO;
+    if (restaurado != SUCESSO) {
+        if (restaurado == ERRO_REGISTRO_CORROMPIDO) {
+            fprintf(stderr, "❌ Instantâneo inválido: %s\n", caminhoInstantaneo);
+        } else {
+            fprintf(stderr, "❌ Não foi possível restaurar o instantâneo %s: %s\n", caminhoInstantaneo,
+                    restaurado == ERRO_MEMORIA ? "memória insuficiente" : strerror(errno));
+        }
+        destruirServidor(servidor);
+        free(servidor);
+        return 1;
+    }
+
+    printf("🌐 Servidor na porta %d: até %d partidas simultâneas\n", porta, maxPartidas);
+    if (portaMetricas >= 0) {
+        printf("📈 Métricas em http://localhost:%d/metrics\n", portaMetricas);
+    }
+    fflush(stdout);
+
+    struct epoll_event eventos[MAX_EVENTOS_EPOLL];
+    uint64_t proximoInstantaneo = nanossegundosMonotonicos() + INTERVALO_INSTANTANEO_MS * 1000000ull;
+    while (!servidorEncerrando) {
+        // Com instantâneos, o epoll_wait acorda no máximo a cada intervalo para a gravação periódica
+        int quantidade = epoll_wait(servidor->epoll, eventos, MAX_EVENTOS_EPOLL,
+                                    caminhoInstantaneo != NULL ? INTERVALO_INSTANTANEO_MS : -1);
+        if (caminhoInstantaneo != NULL &&
+            (servidorInstantaneoPedido ||
+             (servidor->alteracoes > 0 && nanossegundosMonotonicos() >= proximoInstantaneo))) {
+            int gravadas = salvarInstantaneoServidor(servidor);
+            if (servidorInstantaneoPedido && gravadas >= 0) {
+                printf("📸 Instantâneo %s: %d partidas\n", caminhoInstantaneo, gravadas);
+                fflush(stdout);
+            }
+            servidorInstantaneoPedido = 0;
+            proximoInstantaneo = nanossegundosMonotonicos() + INTERVALO_INSTANTANEO_MS * 1000000ull;
+        }
+        if (quantidade < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        servidor->inicioLote = nanossegundosMonotonicos();
+
+        for (int e = 0; e < quantidade; e++) {
+            uint32_t indice = eventos[e].data.u32;
+            if (indice == UINT32_MAX) {
+                aceitarConexoesServidor(servidor, servidor->escuta, 0);
+                continue;
+            }
+            if (indice == UINT32_MAX - 1) {
+                aceitarConexoesServidor(servidor, servidor->escutaMetricas, 1);
+                continue;
+            }
+            if (servidor->conexoes[indice].descritor < 0) {
+                continue;   // Fechada por outro evento do mesmo lote
+            }
+            int aberta = 1;
+            if (servidor->conexoes[indice].metricas) {
+                aberta = responderMetricasServidor(servidor, (int)indice);
+            } else if (eventos[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                aberta = lerConexaoServidor(servidor, (int)indice);
+            }
+            if (aberta && (eventos[e].events & EPOLLOUT)) {
+                struct epoll_event evento = {EPOLLIN, {.u32 = indice}};
+                epoll_ctl(servidor->epoll, EPOLL_CTL_MOD, servidor->conexoes[indice].descritor, &evento);
+                aberta = enviarSaidaServidor(servidor, (int)indice);
+            }
+            if (!aberta) {
+                fecharConexaoServidor(servidor, (int)indice);
+            }
+        }
+
+        // Uma escrita por conexão com tudo o que o lote produziu para ela
+        for (int p = 0; p < servidor->quantidadePendentes; p++) {
+            int indice = servidor->pendentes[p];
+            servidor->conexoes[indice].pendente = 0;
+            if (servidor->conexoes[indice].descritor >= 0 &&
+                (servidor->conexoes[indice].transbordou || !enviarSaidaServidor(servidor, indice))) {
+                fecharConexaoServidor(servidor, indice);
+            }
+        }
+        servidor->quantidadePendentes = 0;
+
+        // Cada ataque do lote esperou até a escrita conjunta das respostas
+        if (servidor->ataquesLote > 0) {
+            uint64_t latencia = nanossegundosMonotonicos() - servidor->inicioLote;
+            somarMetrica(&fragmentoMetricas(servidor->metricas)->latencia[baldeHistogramaFase(latencia)],
+                         servidor->ataquesLote);
+            servidor->ataquesLote = 0;
+        }
+    }
+
+    static LeituraMetricas leitura;
+    lerMetricasServidor(servidor->metricas, &leitura);
+    printf("\n🌐 Servidor encerrado: %lld partidas, %lld ataques\n",
+           servidor->partidas.stats.aquisicoes, leitura.ataques);
+    if (caminhoInstantaneo != NULL) {
+        int gravadas = salvarInstantaneoServidor(servidor);
+        if (gravadas >= 0) {
+            printf("📸 Instantâneo %s: %d partidas em andamento\n", caminhoInstantaneo, gravadas);
+        }
+    }
+    if (leitura.amostrasLatencia > 0) {
+        printf("⏱️  Latência do disparo: p50 %.1f µs, p99 %.1f µs\n",
+               (double)percentilHistograma(leitura.latencia, leitura.amostrasLatencia, 50.0) / 1e3,
+               (double)percentilHistograma(leitura.latencia, leitura.amostrasLatencia, 99.0) / 1e3);
+    }
+    exibirEstatisticasPool(&servidor->partidas);
+    destruirServidor(servidor);
+    free(servidor);
+    return 0;
+}
+
+/*
+ * Gerador de carga: muitos pares de jogadores em um único processo,
+ * medindo a latência de cada ataque até o RESULTADO correspondente
+ */
+typedef struct {
+    int descritor;
+    int suaVez;
+    int emPartida;
+    int disparos;                   // Próximo centro da permutação
+    double enviadoEm;               // Instante do último ATAQUE, 0 se nenhum em voo
+    uint16_t tamanhoEntrada;
+    uint8_t entrada[TAMANHO_ENTRADA_CONEXAO];
+    uint8_t centros[TOTAL_CELULAS]; // Permutação dos centros: nenhum centro se repete
+} ClienteCarga;
+
+static int enviarAtaqueCarga(ClienteCarga* cliente, GeradorAleatorio* gerador) {
+    int celula = cliente->centros[cliente->disparos++ % TOTAL_CELULAS];
+    Coordenada centro = {celula / TAMANHO_TABULEIRO, celula % TAMANHO_TABULEIRO};
+    uint8_t mensagem[4 + MAX_TEXTO_COORDENADA];
+    int comprimento = formatarCoordenada(centro, (char*)&mensagem[4], MAX_TEXTO_COORDENADA + 1);
+    mensagem[0] = MSG_ATAQUE;
+    mensagem[1] = (uint8_t)(2 + comprimento);
+    mensagem[2] = (uint8_t)aleatorioLimitado(gerador, QUANTIDADE_HABILIDADES_PADRAO);
+    mensagem[3] = (uint8_t)comprimento;
+    cliente->enviadoEm = tempoAtual();
+    cliente->suaVez = 0;
+    return escreverTudo(cliente->descritor, mensagem, (size_t)(4 + comprimento));
+}
+
+/**
+ * Executa o gerador de carga contra um servidor local (--carga PORTA N)
+ *
+ * @param porta Porta do servidor em 127.0.0.1
+ * @param partidas Partidas simultâneas (2 conexões cada)
+ * @param semente Semente das jogadas
+ * @return 0 se todas as partidas terminaram
+ */
+int executarGeradorCarga(int porta, int partidas, uint64_t semente) {
+    elevarLimiteDescritores();
+    signal(SIGPIPE, SIG_IGN);
+    const int quantidade = 2 * partidas;
+    ClienteCarga* clientes = calloc((size_t)quantidade, sizeof(ClienteCarga));
+    long long* histograma = calloc(BALDES_LATENCIA + 1, sizeof(long long));
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (clientes == NULL || histograma == NULL || epoll < 0) {
+        fprintf(stderr, "❌ Memória insuficiente para o gerador de carga.\n");
+        free(clientes);
+        free(histograma);
+        return 1;
+    }
+
+    GeradorAleatorio gerador;
+    inicializarGerador(&gerador, semente, 7);
+    struct sockaddr_in endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sin_family = AF_INET;
+    endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    endereco.sin_port = htons((uint16_t)porta);
+
+    // Conexões bloqueantes durante o estabelecimento; depois tudo é não bloqueante
+    int conectados = 0;
+    for (int i = 0; i < quantidade; i++) {
+        ClienteCarga* cliente = &clientes[i];
+        cliente->descritor = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (cliente->descritor < 0 ||
+            connect(cliente->descritor, (struct sockaddr*)&endereco, sizeof(endereco)) != 0) {
+            fprintf(stderr, "❌ Falha ao conectar o cliente %d: %s\n", i, strerror(errno));
+            if (cliente->descritor >= 0) {
+                close(cliente->descritor);
+            }
+            break;
+        }
+        int ligado = 1;
+        setsockopt(cliente->descritor, IPPROTO_TCP, TCP_NODELAY, &ligado, sizeof(ligado));
+        fcntl(cliente->descritor, F_SETFL, fcntl(cliente->descritor, F_GETFL) | O_NONBLOCK);
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            int k = (int)aleatorioLimitado(&gerador, (uint32_t)(c + 1));
+            cliente->centros[c] = cliente->centros[k];
+            cliente->centros[k] = (uint8_t)c;
+        }
+        struct epoll_event evento = {EPOLLIN, {.u32 = (uint32_t)i}};
+        epoll_ctl(epoll, EPOLL_CTL_ADD, cliente->descritor, &evento);
+        uint8_t entrar[2] = {MSG_ENTRAR, 0};
+        escreverTudo(cliente->descritor, entrar, sizeof(entrar));
+        conectados++;
+    }
+    conectados -= conectados % 2;
+
+    struct epoll_event eventos[MAX_EVENTOS_EPOLL];
+    long long ataques = 0, erros = 0, terminadas = 0, amostras = 0;
+    double somaLatencia = 0, maiorLatencia = 0;
+    double inicio = tempoAtual();
+
+    while (terminadas * 2 < conectados) {
+        int prontos = epoll_wait(epoll, eventos, MAX_EVENTOS_EPOLL, 5000);
+        if (prontos <= 0) {
+            if (prontos < 0 && errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "❌ Servidor sem resposta.\n");
+            break;
+        }
+
+        for (int e = 0; e < prontos; e++) {
+            ClienteCarga* cliente = &clientes[eventos[e].data.u32];
+            ssize_t lidos = read(cliente->descritor, &cliente->entrada[cliente->tamanhoEntrada],
+                                 TAMANHO_ENTRADA_CONEXAO - cliente->tamanhoEntrada);
+            if (lidos <= 0) {
+                continue;
+            }
+            double agora = tempoAtual();
+            cliente->tamanhoEntrada += (uint16_t)lidos;
+
+            size_t posicao = 0;
+            while (cliente->tamanhoEntrada - posicao >= 2 &&
+                   cliente->tamanhoEntrada - posicao >= 2u + cliente->entrada[posicao + 1]) {
+                uint8_t tipo = cliente->entrada[posicao];
+                const uint8_t* carga = &cliente->entrada[posicao + 2];
+                posicao += 2u + cliente->entrada[posicao + 1];
+
+                if (tipo == MSG_INICIO) {
+                    cliente->emPartida = 1;
+                    cliente->suaVez = carga[1];
+                } else if (tipo == MSG_RESULTADO) {
+                    if (carga[0] == 0) {
+                        double latencia = agora - cliente->enviadoEm;
+                        int balde = (int)(latencia * 1e6 / MICROSSEGUNDOS_POR_BALDE);
+                        histograma[balde < BALDES_LATENCIA ? balde : BALDES_LATENCIA]++;
+                        somaLatencia += latencia;
+                        maiorLatencia = latencia > maiorLatencia ? latencia : maiorLatencia;
+                        amostras++;
+                        ataques++;
+                    } else {
+                        cliente->suaVez = 1;
+                    }
+                } else if (tipo == MSG_FIM) {
+                    cliente->emPartida = 0;
+                    cliente->suaVez = 0;
+                    terminadas += carga[0];     // Conta a partida uma vez, pelo vencedor
+                } else if (tipo == MSG_ERRO) {
+                    erros++;
+                }
+            }
+            memmove(cliente->entrada, &cliente->entrada[posicao], cliente->tamanhoEntrada - posicao);
+            cliente->tamanhoEntrada -= (uint16_t)posicao;
+
+            if (cliente->emPartida && cliente->suaVez) {
+                enviarAtaqueCarga(cliente, &gerador);
+            }
+        }
+    }
+    double segundos = tempoAtual() - inicio;
+
+    // Percentis a partir do histograma de baldes
+    double percentis[2] = {0.50, 0.99};
+    double valores[2] = {0, 0};
+    for (int q = 0; q < 2; q++) {
+        long long acumulado = 0, alvo = (long long)(percentis[q] * (double)amostras);
+        for (int b = 0; b <= BALDES_LATENCIA; b++) {
+            acumulado += histograma[b];
+            if (acumulado > alvo) {
+                valores[q] = (b + 1) * MICROSSEGUNDOS_POR_BALDE;
+                break;
+            }
+        }
+    }
+
+    printf("🌐 Carga: %d conexões, %lld partidas concluídas, %lld ataques, %lld erros em %.2f s (%.0f ataques/s)\n",
+           conectados, terminadas, ataques, erros, segundos, segundos > 0 ? (double)ataques / segundos : 0.0);
+    printf("⏱️  Latência por ataque: média %.1f µs, p50 <= %.0f µs, p99 <= %.0f µs, máx %.1f µs\n",
+           amostras > 0 ? somaLatencia / (double)amostras * 1e6 : 0.0, valores[0], valores[1], maiorLatencia * 1e6);
+
+    for (int i = 0; i < quantidade; i++) {
+        if (clientes[i].descritor > 0) {
+            close(clientes[i].descritor);
+        }
+    }
+    close(epoll);
+    free(clientes);
+    free(histograma);
+    return terminadas * 2 == conectados && conectados == quantidade ? 0 : 1;
+}
+
+/*
+ * ============================================
+ * ESCALONADOR DE PARTIDAS EM CORROTINAS
+ * ============================================
+ *
+ * Cada partida é uma corrotina sem pilha: uma função de passo que guarda o ponto de
+ * retomada e o estado vivo na própria partida, e cede quando espera a decisão da IA
+ * ou uma linha do cliente. Cada thread intercala milhares de partidas vivas; as que
+ * esperam o cliente ficam no epoll da thread, fora da fila de prontas
+ *
+ * Protocolo de texto com o cliente (jogador 0), uma mensagem por linha
+ *   escalonador -> cliente   FROTA | VEZ | ERRO | FIM venceu
+ *   cliente -> escalonador   "A5 H" por navio após FROTA, "CONE A5" após VEZ (comandos de --roteiro)
+ */
+
+typedef struct {
+    int ponto;                      // Ponto de retomada (0 = início, -1 = concluída)
+} Corrotina;
+
+enum {
+    CORROTINA_PRONTA,               // Cedeu a vez; volta ao fim da fila de prontas
+    CORROTINA_ESPERA_ENTRADA,       // Aguarda o descritor do cliente ficar legível
+    CORROTINA_CONCLUIDA
+};
+
+// Retomada por switch: o que precisa sobreviver a um CORROTINA_CEDER mora na partida
+#define CORROTINA_INICIO(c) switch ((c)->ponto) { case 0:
+#define CORROTINA_CEDER(c, motivo) do { (c)->ponto = __LINE__; return (motivo); case __LINE__:; } while (0)
+#define CORROTINA_FIM(c) } (c)->ponto = -1; return CORROTINA_CONCLUIDA
+
+/**
+ * Partida escalonada: primeira alocação da arena do seu objeto no pool do escalonador
+ */
+typedef struct {
+    Corrotina corrotina;
+    EstadoJogo* estados[2];         // estados[j] = frota do jogador j (atacada pelo outro)
+    void* contextos[2];             // Contexto da IA que joga como j
+    GeradorAleatorio gerador;
+    LeitorComandos leitor;          // Entrada do cliente, se houver
+    int cliente;                    // Descritor do cliente (jogador 0), -1 = IA contra IA
+    int vez;
+    int vencedor;                   // -1 em andamento, 2 = empate por MAX_TURNOS
+    int aguardandoAtaque;
+    int habilidade;
+    Coordenada centro;
+    int erros;                      // Comandos inválidos recebidos do cliente
+    int estacionada;                // 1 enquanto espera entrada no epoll
+} PartidaCorrotina;
+
+/**
+ * Parâmetros compartilhados pelas threads do escalonador
+ */
+typedef struct {
+    const EstrategiaAtaque* ataque;
+    const HabilidadeCompilada* habilidades;
+    uint64_t semente;
+    long long totalPartidas;
+    atomic_llong proximaPartida;    // Próximo número de partida a iniciar
+    int comClientes;
+    int epollClientes;              // epoll da thread dos clientes automáticos
+    atomic_int escalonadoresAtivos;
+    atomic_int clientesAbertos;
+} ConfiguracaoCorrotinas;
+
+/**
+ * Escalonador de uma thread: pool de partidas vivas, fila circular de prontas e epoll
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) ConfiguracaoCorrotinas* configuracao;
+    PoolPartidas partidas;
+    int* prontas;
+    int cabeca;
+    int quantidadeProntas;
+    int estacionadas;
+    int epoll;
+    int semNovasPartidas;
+    long long concluidas;
+    long long vitoriasJogador0;
+    long long empates;
+    long long abandonos;
+    long long turnos;
+    long long retomadas;
+    long long esperas;
+    long long semCliente;           // Partidas sem socketpair disponível, jogadas IA contra IA
+} EscalonadorCorrotinas;
+
+/**
+ * Cliente automático do jogador 0, atendido pela thread dos clientes
+ */
+typedef struct {
+    int descritor;
+    LeitorComandos leitor;
+    GeradorAleatorio gerador;
+    char buffer[TAMANHO_ENTRADA_CORROTINA];
+} ClienteAutomatico;
+
+static inline PartidaCorrotina* partidaCorrotina(EscalonadorCorrotinas* escalonador, int indice) {
+    return (PartidaCorrotina*)arenaPartidaPool(&escalonador->partidas, indice)->base;
+}
+
+static inline void enfileirarCorrotina(EscalonadorCorrotinas* escalonador, int indice) {
+    int capacidade = escalonador->partidas.capacidade;
+    escalonador->prontas[(escalonador->cabeca + escalonador->quantidadeProntas) % capacidade] = indice;
+    escalonador->quantidadeProntas++;
+}
+
+static void enviarLinhaCorrotina(const PartidaCorrotina* partida, const char* texto) {
+    // Mensagens curtas: cabem no buffer do socket, uma escrita por linha
+    if (write(partida->cliente, texto, strlen(texto)) < 0) {
+        return;     // A partida termina quando a leitura vir o fim da conexão
+    }
+}
+
+/**
+ * Conta um comando inválido do cliente; acima do limite o cliente perde por abandono
+ */
+static void recusarComandoCorrotina(PartidaCorrotina* partida) {
+    enviarLinhaCorrotina(partida, "ERRO\n");
+    if (++partida->erros > MAX_ERROS_CLIENTE_CORROTINA) {
+        partida->vencedor = 1;
+    }
+}
+
+/**
+ * Avança a partida até o próximo ponto de espera
+ *
+ * @return CORROTINA_PRONTA, CORROTINA_ESPERA_ENTRADA ou CORROTINA_CONCLUIDA
+ */
+static int passoPartidaCorrotina(const ConfiguracaoCorrotinas* configuracao, PartidaCorrotina* partida) {
+    char* linha;
+    size_t comprimento;
+    int leitura;
+    ComandoRoteiro comando;
+    EstadoJogo* alvo;
+
+    CORROTINA_INICIO(&partida->corrotina);
+    posicionarFrotaUniforme(NULL, partida->estados[1], &partida->gerador);
+    if (partida->cliente < 0) {
+        posicionarFrotaUniforme(NULL, partida->estados[0], &partida->gerador);
+    } else {
+        enviarLinhaCorrotina(partida, "FROTA\n");
+        while (partida->vencedor < 0 && partida->estados[0]->quantidadeNavios < MAX_NAVIOS) {
+            while ((leitura = lerLinhaComandos(&partida->leitor, &linha, &comprimento)) == ERRO_ENTRADA_PENDENTE) {
+                CORROTINA_CEDER(&partida->corrotina, CORROTINA_ESPERA_ENTRADA);
+            }
+            if (leitura != SUCESSO) {
+                partida->vencedor = 1;      // Cliente foi embora
+            } else if (interpretarComandoRoteiro(linha, &comando) != SUCESSO ||
+                       (comando.tipo != COMANDO_VAZIO &&
+                        (comando.tipo != COMANDO_NAVIO ||
+                         adicionarNavioEstado(partida->estados[0], comando.coord,
+                                              TAMANHOS_NAVIOS[partida->estados[0]->quantidadeNavios],
+                                              comando.orientacao) != SUCESSO))) {
+                recusarComandoCorrotina(partida);
+            }
+        }
+    }
+
+    while (partida->vencedor < 0) {
+        if (partida->vez == 0 && partida->cliente >= 0) {
+            enviarLinhaCorrotina(partida, "VEZ\n");
+            partida->aguardandoAtaque = 1;
+            while (partida->vencedor < 0 && partida->aguardandoAtaque) {
+                while ((leitura = lerLinhaComandos(&partida->leitor, &linha, &comprimento)) == ERRO_ENTRADA_PENDENTE) {
+                    CORROTINA_CEDER(&partida->corrotina, CORROTINA_ESPERA_ENTRADA);
+                }
+                if (leitura != SUCESSO) {
+                    partida->vencedor = 1;
+                } else if (interpretarComandoRoteiro(linha, &comando) != SUCESSO ||
+                           (comando.tipo != COMANDO_VAZIO && comando.tipo != COMANDO_ATAQUE)) {
+                    recusarComandoCorrotina(partida);
+                } else if (comando.tipo == COMANDO_ATAQUE) {
+                    partida->habilidade = comando.habilidade;
+                    partida->centro = comando.coord;
+                    partida->aguardandoAtaque = 0;
+                }
+            }
+            if (partida->vencedor >= 0) {
+                break;
+            }
+        } else {
+            // A decisão da IA espera a sua vez na fila, como uma resposta de cliente
+            CORROTINA_CEDER(&partida->corrotina, CORROTINA_PRONTA);
+            MEDIR_FASE(FASE_DECISAO);
+            configuracao->ataque->escolherAtaque(partida->contextos[partida->vez], partida->estados[1 - partida->vez],
+                                                 &partida->gerador, &partida->habilidade, &partida->centro);
+        }
+
+        alvo = partida->estados[1 - partida->vez];
+        resolverAtaque(alvo, &configuracao->habilidades[partida->habilidade], partida->centro, NULL);
+        if (alvo->naviosRestantes == 0) {
+            partida->vencedor = partida->vez;
+        } else if (partida->estados[0]->turno >= MAX_TURNOS && partida->estados[1]->turno >= MAX_TURNOS) {
+            partida->vencedor = 2;
+        }
+        partida->vez = 1 - partida->vez;
+    }
+
+    if (partida->cliente >= 0) {
+        enviarLinhaCorrotina(partida, partida->vencedor == 0 ? "FIM 1\n" : "FIM 0\n");
+    }
+    CORROTINA_FIM(&partida->corrotina);
+}
+
+/**
+ * Entrega a outra ponta do socketpair à thread dos clientes automáticos
+ *
+ * @return SUCESSO, ERRO_MEMORIA ou ERRO_ES se o epoll recusar o descritor
+ */
+static int entregarClienteAutomatico(ConfiguracaoCorrotinas* configuracao, int descritor, long long numero) {
+    ClienteAutomatico* cliente = malloc(sizeof(ClienteAutomatico));
+    if (cliente == NULL) {
+        return ERRO_MEMORIA;
+    }
+    cliente->descritor = descritor;
+    iniciarLeitorComandos(&cliente->leitor, descritor, cliente->buffer, sizeof(cliente->buffer));
+    inicializarGerador(&cliente->gerador, configuracao->semente ^ 0xC11E27EULL, (uint64_t)numero);
+    atomic_fetch_add(&configuracao->clientesAbertos, 1);
+    struct epoll_event evento = {EPOLLIN | EPOLLET, {.ptr = cliente}};
+    if (epoll_ctl(configuracao->epollClientes, EPOLL_CTL_ADD, descritor, &evento) != 0) {
+        atomic_fetch_sub(&configuracao->clientesAbertos, 1);
+        free(cliente);
+        return ERRO_ES;
+    }
+    return SUCESSO;
+}
+
+/**
+ * Inicia a partida de número dado em um objeto livre do pool e a coloca na fila de prontas
+ */
+static void iniciarPartidaCorrotina(EscalonadorCorrotinas* escalonador, long long numero) {
+    ConfiguracaoCorrotinas* configuracao = escalonador->configuracao;
+    const EstrategiaAtaque* ataque = configuracao->ataque;
+    int indice = adquirirPartidaPool(&escalonador->partidas);
+    PartidaCorrotina* partida = alocarNaPartidaPool(&escalonador->partidas, indice, sizeof(PartidaCorrotina),
+                                                    _Alignof(PartidaCorrotina));
+    memset(partida, 0, sizeof(*partida));
+    partida->cliente = -1;
+    partida->vencedor = -1;
+    inicializarGerador(&partida->gerador, configuracao->semente, (uint64_t)numero);
+    for (int j = 0; j < 2; j++) {
+        partida->estados[j] = alocarNaPartidaPool(&escalonador->partidas, indice, sizeof(EstadoJogo),
+                                                  _Alignof(EstadoJogo));
+        inicializarEstadoJogo(partida->estados[j]);
+        partida->contextos[j] = ataque->contexto;
+        if (ataque->tamanhoContextoPrivado > 0) {
+            partida->contextos[j] = alocarNaPartidaPool(&escalonador->partidas, indice, ataque->tamanhoContextoPrivado,
+                                                        TAMANHO_LINHA_CACHE);
+            memcpy(partida->contextos[j], ataque->contexto, ataque->tamanhoContextoPrivado);
+        }
+    }
+
+    int par[2];
+    if (configuracao->comClientes) {
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, par) != 0) {
+            escalonador->semCliente++;
+        } else if (entregarClienteAutomatico(configuracao, par[1], numero) != SUCESSO) {
+            close(par[0]);
+            close(par[1]);
+            escalonador->semCliente++;
+        } else {
+            char* buffer = alocarNaPartidaPool(&escalonador->partidas, indice, TAMANHO_ENTRADA_CORROTINA, 1);
+            struct epoll_event evento = {EPOLLIN | EPOLLET, {.u32 = (uint32_t)indice}};
+            epoll_ctl(escalonador->epoll, EPOLL_CTL_ADD, par[0], &evento);
+            partida->cliente = par[0];
+            iniciarLeitorComandos(&partida->leitor, par[0], buffer, TAMANHO_ENTRADA_CORROTINA);
+        }
+    }
+    enfileirarCorrotina(escalonador, indice);
+}
+
+static void encerrarPartidaCorrotina(EscalonadorCorrotinas* escalonador, int indice) {
+    PartidaCorrotina* partida = partidaCorrotina(escalonador, indice);
+    escalonador->concluidas++;
+    escalonador->vitoriasJogador0 += partida->vencedor == 0;
+    escalonador->empates += partida->vencedor == 2;
+    escalonador->abandonos += partida->erros > MAX_ERROS_CLIENTE_CORROTINA ||
+                              (partida->cliente >= 0 && partida->leitor.fimEntrada);
+    escalonador->turnos += partida->estados[0]->turno + partida->estados[1]->turno;
+    if (partida->cliente >= 0) {
+        close(partida->cliente);    // Também remove o descritor do epoll
+    }
+    liberarPartidaPool(&escalonador->partidas, indice);
+}
+
+/**
+ * Laço de uma thread do escalonador: mantém a janela de partidas vivas cheia e
+ * retoma as prontas em rodízio; o epoll é consultado sem espera a cada volta da
+ * fila e com espera apenas quando todas as partidas aguardam clientes
+ */
+static void* executarEscalonadorCorrotinas(void* argumento) {
+    EscalonadorCorrotinas* escalonador = argumento;
+    ConfiguracaoCorrotinas* configuracao = escalonador->configuracao;
+    struct epoll_event eventos[MAX_EVENTOS_EPOLL];
+    int passosDesdeEpoll = 0;
+
+    for (;;) {
+        while (!escalonador->semNovasPartidas && escalonador->partidas.livre >= 0) {
+            long long numero = atomic_fetch_add_explicit(&configuracao->proximaPartida, 1, memory_order_relaxed);
+            if (numero >= configuracao->totalPartidas) {
+                escalonador->semNovasPartidas = 1;
+                break;
+            }
+            iniciarPartidaCorrotina(escalonador, numero);
+        }
+        if (escalonador->quantidadeProntas == 0 && escalonador->estacionadas == 0) {
+            break;
+        }
+
+        if (escalonador->estacionadas > 0 &&
+            (escalonador->quantidadeProntas == 0 || passosDesdeEpoll >= escalonador->quantidadeProntas)) {
+            int quantidade = epoll_wait(escalonador->epoll, eventos, MAX_EVENTOS_EPOLL,
+                                        escalonador->quantidadeProntas == 0 ? -1 : 0);
+            for (int e = 0; e < quantidade; e++) {
+                PartidaCorrotina* partida = partidaCorrotina(escalonador, (int)eventos[e].data.u32);
+                if (partida->estacionada) {     // Senão a partida já está na fila e lerá os dados sozinha
+                    partida->estacionada = 0;
+                    escalonador->estacionadas--;
+                    enfileirarCorrotina(escalonador, (int)eventos[e].data.u32);
+                }
+            }
+            passosDesdeEpoll = 0;
+        }
+        if (escalonador->quantidadeProntas == 0) {
+            continue;
+        }
+
+        int indice = escalonador->prontas[escalonador->cabeca];
+        escalonador->cabeca = (escalonador->cabeca + 1) % escalonador->partidas.capacidade;
+        escalonador->quantidadeProntas--;
+        escalonador->retomadas++;
+        passosDesdeEpoll++;
+
+        PartidaCorrotina* partida = partidaCorrotina(escalonador, indice);
+        switch (passoPartidaCorrotina(configuracao, partida)) {
+            case CORROTINA_PRONTA:
+                enfileirarCorrotina(escalonador, indice);
+                break;
+            case CORROTINA_ESPERA_ENTRADA:
+                partida->estacionada = 1;
+                escalonador->estacionadas++;
+                escalonador->esperas++;
+                break;
+            default:
+                encerrarPartidaCorrotina(escalonador, indice);
+                break;
+        }
+    }
+    atomic_fetch_sub(&configuracao->escalonadoresAtivos, 1);
+    return NULL;
+}
+
+/**
+ * Responde às mensagens pendentes de um cliente automático (ataques aleatórios)
+ *
+ * @return 1 se o cliente continua, 0 ao fim da partida
+ */
+static int responderClienteAutomatico(ClienteAutomatico* cliente) {
+    char* linha;
+    size_t comprimento;
+    int leitura;
+    while ((leitura = lerLinhaComandos(&cliente->leitor, &linha, &comprimento)) == SUCESSO) {
+        char resposta[MAX_NAVIOS * (MAX_TEXTO_COORDENADA + 4)];
+        int tamanho = 0;
+        if (strcmp(linha, "FROTA") == 0) {
+            EstadoJogo frota;
+            inicializarEstadoJogo(&frota);
+            sortearFrota(&frota, TAMANHOS_NAVIOS, MAX_NAVIOS, &cliente->gerador);
+            for (int n = 0; n < frota.quantidadeNavios; n++) {
+                tamanho += formatarCoordenada(frota.navios[n].inicio, resposta + tamanho, sizeof(resposta) - (size_t)tamanho);
+                tamanho += snprintf(resposta + tamanho, sizeof(resposta) - (size_t)tamanho, " %c\n",
+                                    frota.navios[n].orientacao);
+            }
+        } else if (strcmp(linha, "VEZ") == 0) {
+            Coordenada centro = {(int)aleatorioLimitado(&cliente->gerador, TAMANHO_TABULEIRO),
+                                 (int)aleatorioLimitado(&cliente->gerador, TAMANHO_TABULEIRO)};
+            tamanho = snprintf(resposta, sizeof(resposta), "%s ",
+                               NOMES_HABILIDADES_PADRAO[aleatorioLimitado(&cliente->gerador, QUANTIDADE_HABILIDADES_PADRAO)]);
+            tamanho += formatarCoordenada(centro, resposta + tamanho, sizeof(resposta) - (size_t)tamanho);
+            resposta[tamanho++] = '\n';
+        } else if (strncmp(linha, "FIM", 3) == 0) {
+            return 0;
+        }
+        if (tamanho > 0 && write(cliente->descritor, resposta, (size_t)tamanho) != tamanho) {
+            return 0;
+        }
+    }
+    return leitura == ERRO_ENTRADA_PENDENTE;
+}
+
+/**
+ * Thread dos clientes automáticos: atende todos os socketpairs até o fim das partidas
+ */
+static void* executarClientesAutomaticos(void* argumento) {
+    ConfiguracaoCorrotinas* configuracao = argumento;
+    struct epoll_event eventos[MAX_EVENTOS_EPOLL];
+    while (atomic_load(&configuracao->escalonadoresAtivos) > 0 || atomic_load(&configuracao->clientesAbertos) > 0) {
+        int quantidade = epoll_wait(configuracao->epollClientes, eventos, MAX_EVENTOS_EPOLL, 10);
+        for (int e = 0; e < quantidade; e++) {
+            ClienteAutomatico* cliente = eventos[e].data.ptr;
+            if (!responderClienteAutomatico(cliente)) {
+                close(cliente->descritor);
+                free(cliente);
+                atomic_fetch_sub(&configuracao->clientesAbertos, 1);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Executa partidas de dois jogadores intercaladas em corrotinas (--corrotinas N)
+ * Sem clientes, as duas frotas são da IA e o resultado de cada partida depende
+ * só da semente e do seu número, não das threads nem da ordem de escalonamento
+ *
+ * @param quantidade Número de partidas
+ * @param quantidadeThreads Threads do escalonador (0 = núcleos disponíveis)
+ * @param ataqueDensidade 1 para a IA de densidade, 0 para ataques aleatórios
+ * @param comClientes 1 para o jogador 0 ser um cliente automático em um socketpair
+ * @param semente Semente das partidas
+ * @return 0 se todas as partidas foram concluídas
+ */
+int executarCorrotinas(long long quantidade, int quantidadeThreads, int ataqueDensidade, int comClientes,
+                       uint64_t semente) {
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    const int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    criarHabilidadesPadrao(habilidades);
+    if (quantidadeThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        quantidadeThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (quantidadeThreads > MAX_THREADS) {
+        quantidadeThreads = MAX_THREADS;
+    }
+    EstrategiaAtaque ataque = {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0};
+    ContextoAtaqueDensidade contextoDensidade;
+    if (ataqueDensidade) {
+        ataque = criarAtaqueDensidade(&contextoDensidade, habilidades, quantidadeHabilidades);
+    }
+    if (comClientes) {
+        elevarLimiteDescritores();
+        signal(SIGPIPE, SIG_IGN);
+    }
+
+    ConfiguracaoCorrotinas configuracao;
+    memset(&configuracao, 0, sizeof(configuracao));
+    configuracao.ataque = &ataque;
+    configuracao.habilidades = habilidades;
+    configuracao.semente = semente;
+    configuracao.totalPartidas = quantidade;
+    configuracao.comClientes = comClientes;
+    configuracao.epollClientes = comClientes ? epoll_create1(EPOLL_CLOEXEC) : -1;
+
+    // Arena de uma partida: a corrotina, dois estados, contextos privados da IA e o buffer do cliente
+    size_t bytesPartida = sizeof(PartidaCorrotina) + _Alignof(EstadoJogo) + 2 * sizeof(EstadoJogo) +
+                          2 * (ataque.tamanhoContextoPrivado + TAMANHO_LINHA_CACHE) + TAMANHO_ENTRADA_CORROTINA;
+    long long porThread = (quantidade + quantidadeThreads - 1) / quantidadeThreads;
+    int vivas = porThread < PARTIDAS_VIVAS_CORROTINAS ? (int)(porThread > 0 ? porThread : 1) : PARTIDAS_VIVAS_CORROTINAS;
+    EscalonadorCorrotinas* escalonadores =
+        alocarAlinhadoCache(sizeof(EscalonadorCorrotinas) * (size_t)quantidadeThreads);
+    if (escalonadores == NULL || (comClientes && configuracao.epollClientes < 0)) {
+        fprintf(stderr, "❌ Não foi possível preparar o escalonador.\n");
+        free(escalonadores);
+        return 1;
+    }
+    memset(escalonadores, 0, sizeof(EscalonadorCorrotinas) * (size_t)quantidadeThreads);
+    int preparados = 0;
+    for (; preparados < quantidadeThreads; preparados++) {
+        EscalonadorCorrotinas* escalonador = &escalonadores[preparados];
+        escalonador->configuracao = &configuracao;
+        escalonador->prontas = malloc(sizeof(int) * (size_t)vivas);
+        escalonador->epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (escalonador->prontas == NULL || escalonador->epoll < 0 ||
+            criarPoolPartidas(&escalonador->partidas, vivas, bytesPartida) != SUCESSO) {
+            break;
+        }
+    }
+
+    pthread_t threads[MAX_THREADS];
+    pthread_t threadClientes;
+    int iniciadas = 0;
+    int clientesIniciados = 0;
+    double inicio = tempoAtual();
+    if (preparados == quantidadeThreads) {
+        atomic_store(&configuracao.escalonadoresAtivos, quantidadeThreads);
+        clientesIniciados = comClientes && pthread_create(&threadClientes, NULL, executarClientesAutomaticos,
+                                                          &configuracao) == 0;
+        for (; iniciadas < quantidadeThreads && (clientesIniciados || !comClientes); iniciadas++) {
+            if (pthread_create(&threads[iniciadas], NULL, executarEscalonadorCorrotinas, &escalonadores[iniciadas]) != 0) {
+                break;
+            }
+        }
+        // Threads que não subiram não contam como ativas
+        atomic_fetch_sub(&configuracao.escalonadoresAtivos, quantidadeThreads - iniciadas);
+    }
+    for (int t = 0; t < iniciadas; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    if (clientesIniciados) {
+        pthread_join(threadClientes, NULL);
+    }
+    double segundos = tempoAtual() - inicio;
+
+    EscalonadorCorrotinas total;
+    memset(&total, 0, sizeof(total));
+    int picoVivas = 0;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        const EscalonadorCorrotinas* e = &escalonadores[t];
+        total.concluidas += e->concluidas;
+        total.vitoriasJogador0 += e->vitoriasJogador0;
+        total.empates += e->empates;
+        total.abandonos += e->abandonos;
+        total.turnos += e->turnos;
+        total.retomadas += e->retomadas;
+        total.esperas += e->esperas;
+        total.semCliente += e->semCliente;
+        picoVivas = e->partidas.stats.picoEmUso > picoVivas ? e->partidas.stats.picoEmUso : picoVivas;
+    }
+
+    printf("🧵 Corrotinas: %lld partidas em %d threads, até %d vivas por thread (IA '%s'%s)\n", quantidade,
+           quantidadeThreads, vivas, ataque.nome, comClientes ? ", jogador 0 em cliente por socketpair" : "");
+    printf("🎮 Concluídas: %lld | Vitórias do jogador 0: %lld (%.1f%%) | Empates: %lld | Abandonos: %lld\n",
+           total.concluidas, total.vitoriasJogador0,
+           total.concluidas > 0 ? 100.0 * (double)total.vitoriasJogador0 / (double)total.concluidas : 0.0,
+           total.empates, total.abandonos);
+    printf("🔁 Turnos por partida: %.2f | Retomadas: %lld (%.1f por partida) | Esperas por entrada: %lld\n",
+           total.concluidas > 0 ? (double)total.turnos / (double)total.concluidas : 0.0, total.retomadas,
+           total.concluidas > 0 ? (double)total.retomadas / (double)total.concluidas : 0.0, total.esperas);
+    printf("📈 Pico de partidas vivas por thread: %d | Tempo: %.3f s (%.0f partidas/s)\n", picoVivas, segundos,
+           segundos > 0 ? (double)total.concluidas / segundos : 0.0);
+    if (total.semCliente > 0) {
+        printf("⚠️  Partidas sem socketpair (jogadas IA contra IA): %lld\n", total.semCliente);
+    }
+
+    for (int t = 0; t < quantidadeThreads; t++) {
+        if (escalonadores[t].epoll > 0) {
+            close(escalonadores[t].epoll);
+        }
+        destruirPoolPartidas(&escalonadores[t].partidas);
+        free(escalonadores[t].prontas);
+    }
+    if (configuracao.epollClientes >= 0) {
+        close(configuracao.epollClientes);
+    }
+    free(escalonadores);
+    return total.concluidas == quantidade ? 0 : 1;
+}
+
+/*
+ * ============================================
+ * ENUMERAÇÃO EXATA DOS POSICIONAMENTOS DA FROTA
+ * ============================================
+ *
+ * Percorre todas as frotas legais de TAMANHOS_NAVIOS (posicionamentos da
+ * tabela de obterPosicionamentos, as mesmas regras de posicionarNavio, sem
+ * sobreposição) e conta, para cada posicionamento de cada navio, em quantas
+ * frotas ele aparece. Navios de mesmo tamanho são intercambiáveis: seus
+ * índices são crescentes, então cada frota distinta é contada uma vez
+ *
+ * A unidade de trabalho é um trio dos três primeiros navios; o último navio é
+ * uma varredura sobre a sua lista de máscaras, contando os livres. As contagens
+ * são inteiras, então a CPU e o OpenCL produzem exatamente os mesmos números
+ */
+
+_Static_assert(MAX_NAVIOS == 4, "a enumeração exata percorre trios dos três primeiros navios");
+
+/**
+ * Posicionamentos de cada navio em estrutura de arrays, concatenados na ordem da frota
+ */
+typedef struct {
+    int quantidade[MAX_NAVIOS];
+    int base[MAX_NAVIOS];               // Primeiro índice de cada navio nos vetores
+    int ordenado[MAX_NAVIOS];           // Mesmo tamanho do anterior: índice maior que o dele
+    int total;
+    uint64_t baixas[MAX_NAVIOS * MAX_POSICIONAMENTOS];  // Células 0-63
+    uint64_t altas[MAX_NAVIOS * MAX_POSICIONAMENTOS];   // Células 64-127
+} EnumeracaoFrotas;
+
+/**
+ * Contagens exatas: frotas em que cada posicionamento aparece
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) uint64_t contagens[MAX_NAVIOS * MAX_POSICIONAMENTOS];   // Um parcial por thread
+    uint64_t frotas;                    // Frotas distintas
+    uint64_t porCelula[TOTAL_CELULAS];  // Frotas que ocupam cada célula
+} ResultadoEnumeracao;
+
+typedef struct {
+    const EnumeracaoFrotas* enumeracao;
+    atomic_int proximoPar;              // Próximo par dos dois primeiros navios
+} TrabalhoEnumeracao;
+
+typedef struct {
+    TrabalhoEnumeracao* trabalho;
+    ResultadoEnumeracao* resultado;
+} TarefaEnumeracao;
+
+/**
+ * Monta as listas de posicionamentos da frota padrão
+ *
+ * @param enumeracao Estrutura a preencher
+ */
+static void prepararEnumeracaoFrotas(EnumeracaoFrotas* enumeracao) {
+    enumeracao->total = 0;
+    for (int n = 0; n < MAX_NAVIOS; n++) {
+        const PosicionamentosNavio* tabela = obterPosicionamentos(TAMANHOS_NAVIOS[n]);
+        enumeracao->quantidade[n] = tabela->quantidade;
+        enumeracao->base[n] = enumeracao->total;
+        enumeracao->ordenado[n] = n > 0 && TAMANHOS_NAVIOS[n] == TAMANHOS_NAVIOS[n - 1];
+        for (int p = 0; p < tabela->quantidade; p++) {
+            enumeracao->baixas[enumeracao->total + p] = tabela->mascaras[p].parte[0];
+            enumeracao->altas[enumeracao->total + p] = tabela->mascaras[p].parte[1];
+        }
+        enumeracao->total += tabela->quantidade;
+    }
+}
+
+/**
+ * Conta as frotas que completam um par dos dois primeiros navios
+ * Mesma decomposição do kernel OpenCL: para cada terceiro navio livre, o
+ * último navio é uma varredura sem desvios sobre as suas máscaras
+ *
+ * @param e Posicionamentos da frota
+ * @param a Posicionamento do primeiro navio
+ * @param b Posicionamento do segundo navio
+ * @param contagens Contagens por posicionamento (acumuladas)
+ */
+static void enumerarParFrotas(const EnumeracaoFrotas* e, int a, int b, uint64_t* contagens) {
+    const int pb = e->base[1] + b;
+    if ((e->ordenado[1] && b <= a) || (e->baixas[a] & e->baixas[pb]) || (e->altas[a] & e->altas[pb])) {
+        return;
+    }
+    const uint64_t baixasPar = e->baixas[a] | e->baixas[pb];
+    const uint64_t altasPar = e->altas[a] | e->altas[pb];
+    const uint64_t* restrict baixasUltimo = &e->baixas[e->base[3]];
+    const uint64_t* restrict altasUltimo = &e->altas[e->base[3]];
+    uint64_t* restrict contagensUltimo = &contagens[e->base[3]];
+    uint64_t frotasPar = 0;
+
+    for (int c = e->ordenado[2] ? b + 1 : 0; c < e->quantidade[2]; c++) {
+        const int pc = e->base[2] + c;
+        if ((baixasPar & e->baixas[pc]) || (altasPar & e->altas[pc])) {
+            continue;
+        }
+        const uint64_t baixasTrio = baixasPar | e->baixas[pc];
+        const uint64_t altasTrio = altasPar | e->altas[pc];
+        uint64_t frotasTrio = 0;
+        for (int d = e->ordenado[3] ? c + 1 : 0; d < e->quantidade[3]; d++) {
+            uint64_t livre = ((baixasTrio & baixasUltimo[d]) | (altasTrio & altasUltimo[d])) == 0;
+            contagensUltimo[d] += livre;
+            frotasTrio += livre;
+        }
+        contagens[pc] += frotasTrio;
+        frotasPar += frotasTrio;
+    }
+    contagens[a] += frotasPar;
+    contagens[pb] += frotasPar;
+}
+
+/**
+ * Corpo de uma thread da enumeração: pega o próximo par livre até acabarem
+ *
+ * @param argumento Ponteiro para TarefaEnumeracao
+ * @return NULL
+ */
+static void* executarTarefaEnumeracao(void* argumento) {
+    TarefaEnumeracao* tarefa = argumento;
+    const EnumeracaoFrotas* e = tarefa->trabalho->enumeracao;
+    const int pares = e->quantidade[0] * e->quantidade[1];
+
+    for (;;) {
+        int par = atomic_fetch_add_explicit(&tarefa->trabalho->proximoPar, 1, memory_order_relaxed);
+        if (par >= pares) {
+            break;
+        }
+        enumerarParFrotas(e, par / e->quantidade[1], par % e->quantidade[1], tarefa->resultado->contagens);
+    }
+    return NULL;
+}
+
+/**
+ * Enumera todas as frotas na CPU com várias threads
+ *
+ * @param e Posicionamentos da frota
+ * @param resultado Saída: contagens por posicionamento
+ * @param quantidadeThreads Número de threads (0 = todos os núcleos)
+ * @return Threads usadas, ou 0 sem memória
+ */
+static int enumerarFrotasCpu(const EnumeracaoFrotas* e, ResultadoEnumeracao* resultado, int quantidadeThreads) {
+    if (quantidadeThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        quantidadeThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (quantidadeThreads > MAX_THREADS) {
+        quantidadeThreads = MAX_THREADS;
+    }
+
+    // Contagens privadas por thread, somadas depois do join
+    ResultadoEnumeracao* parciais = alocarAlinhadoCache(sizeof(ResultadoEnumeracao) * (size_t)quantidadeThreads);
+    if (parciais == NULL) {
+        return 0;
+    }
+    memset(parciais, 0, sizeof(ResultadoEnumeracao) * (size_t)quantidadeThreads);
+
+    TrabalhoEnumeracao trabalho;
+    trabalho.enumeracao = e;
+    atomic_init(&trabalho.proximoPar, 0);
+    pthread_t threads[MAX_THREADS];
+    TarefaEnumeracao tarefas[MAX_THREADS];
+    int iniciadas = 0;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        tarefas[t].trabalho = &trabalho;
+        tarefas[t].resultado = &parciais[t];
+        if (pthread_create(&threads[t], NULL, executarTarefaEnumeracao, &tarefas[t]) != 0) {
+            break;
+        }
+        iniciadas++;
+    }
+    if (iniciadas == 0) {
+        // Sem threads disponíveis a thread principal faz todo o trabalho
+        tarefas[0].trabalho = &trabalho;
+        tarefas[0].resultado = &parciais[0];
+        executarTarefaEnumeracao(&tarefas[0]);
+        iniciadas = 1;
+    } else {
+        for (int t = 0; t < iniciadas; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    memset(resultado->contagens, 0, sizeof(resultado->contagens));
+    for (int t = 0; t < iniciadas; t++) {
+        for (int p = 0; p < e->total; p++) {
+            resultado->contagens[p] += parciais[t].contagens[p];
+        }
+    }
+    free(parciais);
+    return iniciadas;
+}
+
+#if BATALHA_OPENCL
+/*
+ * Backend OpenCL, carregado com dlopen: o binário não depende da biblioteca
+ * nem dos cabeçalhos do OpenCL, e sem plataforma a enumeração cai na CPU
+ * Cada item de trabalho é um trio; as contagens do grupo ficam em memória
+ * local de 32 bits e são somadas nas contagens globais de 64 bits no fim
+ */
+typedef int32_t cl_int;
+typedef uint32_t cl_uint;
+typedef uint64_t cl_bitfield;
+typedef void* cl_objeto;                // cl_platform_id, cl_device_id, cl_context, cl_mem...
+
+#define CL_SUCCESS 0
+#define CL_TRUE 1
+#define CL_DEVICE_TYPE_GPU (1 << 2)
+#define CL_DEVICE_TYPE_ALL 0xFFFFFFFFu
+#define CL_DEVICE_NAME 0x102B
+#define CL_MEM_READ_WRITE (1 << 0)
+#define CL_MEM_READ_ONLY (1 << 2)
+#define CL_MEM_COPY_HOST_PTR (1 << 5)
+#define CL_PROGRAM_BUILD_LOG 0x1183
+#define CL_BUILD_PROGRAM_FAILURE -11
+
+#define GRUPO_OPENCL_ENUMERACAO 256     // Itens por grupo de trabalho
+
+typedef struct {
+    cl_int (*clGetPlatformIDs)(cl_uint, cl_objeto*, cl_uint*);
+    cl_int (*clGetDeviceIDs)(cl_objeto, cl_bitfield, cl_uint, cl_objeto*, cl_uint*);
+    cl_int (*clGetDeviceInfo)(cl_objeto, cl_uint, size_t, void*, size_t*);
+    cl_objeto (*clCreateContext)(const intptr_t*, cl_uint, const cl_objeto*, void*, void*, cl_int*);
+    cl_objeto (*clCreateCommandQueue)(cl_objeto, cl_objeto, cl_bitfield, cl_int*);
+    cl_objeto (*clCreateProgramWithSource)(cl_objeto, cl_uint, const char**, const size_t*, cl_int*);
+    cl_int (*clBuildProgram)(cl_objeto, cl_uint, const cl_objeto*, const char*, void*, void*);
+    cl_int (*clGetProgramBuildInfo)(cl_objeto, cl_objeto, cl_uint, size_t, void*, size_t*);
+    cl_objeto (*clCreateKernel)(cl_objeto, const char*, cl_int*);
+    cl_objeto (*clCreateBuffer)(cl_objeto, cl_bitfield, size_t, void*, cl_int*);
+    cl_int (*clSetKernelArg)(cl_objeto, cl_uint, size_t, const void*);
+    cl_int (*clEnqueueNDRangeKernel)(cl_objeto, cl_objeto, cl_uint, const size_t*, const size_t*, const size_t*,
+                                     cl_uint, const void*, void*);
+    cl_int (*clEnqueueReadBuffer)(cl_objeto, cl_objeto, cl_uint, size_t, size_t, void*, cl_uint, const void*, void*);
+    cl_int (*clFinish)(cl_objeto);
+    cl_int (*clReleaseMemObject)(cl_objeto);
+    cl_int (*clReleaseKernel)(cl_objeto);
+    cl_int (*clReleaseProgram)(cl_objeto);
+    cl_int (*clReleaseCommandQueue)(cl_objeto);
+    cl_int (*clReleaseContext)(cl_objeto);
+} ApiOpenCL;
+
+// Mesma decomposição de enumerarParFrotas, com o terceiro navio no índice global
+static const char FONTE_KERNEL_ENUMERACAO[] =
+    "#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable\n"
+    "__kernel void enumerarTrios(__global const ulong* baixas, __global const ulong* altas,\n"
+    "                            __global ulong* contagens, int q0, int q1, int q2, int q3,\n"
+    "                            int ordenado1, int ordenado2, int ordenado3, __local uint* locais) {\n"
+    "    const int total = q0 + q1 + q2 + q3;\n"
+    "    for (int i = get_local_id(0); i < total; i += get_local_size(0)) locais[i] = 0;\n"
+    "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+    "    ulong g = get_global_id(0);\n"
+    "    if (g < (ulong)q0 * q1 * q2) {\n"
+    "        int c = (int)(g % q2), b = (int)(g / q2 % q1), a = (int)(g / ((ulong)q1 * q2));\n"
+    "        int pb = q0 + b, pc = q0 + q1 + c, pd = q0 + q1 + q2;\n"
+    "        ulong x = baixas[a] | baixas[pb], y = altas[a] | altas[pb];\n"
+    "        int livre = !(ordenado1 && b <= a) && !(ordenado2 && c <= b) &&\n"
+    "                    !((baixas[a] & baixas[pb]) | (altas[a] & altas[pb])) &&\n"
+    "                    !((x & baixas[pc]) | (y & altas[pc]));\n"
+    "        if (livre) {\n"
+    "            x |= baixas[pc];\n"
+    "            y |= altas[pc];\n"
+    "            uint frotas = 0;\n"
+    "            for (int d = ordenado3 ? c + 1 : 0; d < q3; d++) {\n"
+    "                if (((x & baixas[pd + d]) | (y & altas[pd + d])) == 0) {\n"
+    "                    frotas++;\n"
+    "                    atomic_inc(&locais[pd + d]);\n"
+    "                }\n"
+    "            }\n"
+    "            if (frotas) {\n"
+    "                atomic_add(&locais[a], frotas);\n"
+    "                atomic_add(&locais[pb], frotas);\n"
+    "                atomic_add(&locais[pc], frotas);\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "    barrier(CLK_LOCAL_MEM_FENCE);\n"
+    "    for (int i = get_local_id(0); i < total; i += get_local_size(0))\n"
+    "        if (locais[i]) atom_add(&contagens[i], (ulong)locais[i]);\n"
+    "}\n";
+
+/**
+ * Carrega as funções do OpenCL da biblioteca do sistema
+ *
+ * @return SUCESSO, ou ERRO_POSICAO_INVALIDA se a biblioteca ou alguma função faltar
+ */
+static int carregarApiOpenCL(ApiOpenCL* api) {
+    static const char* const nomes[] = {
+        "clGetPlatformIDs", "clGetDeviceIDs", "clGetDeviceInfo", "clCreateContext", "clCreateCommandQueue",
+        "clCreateProgramWithSource", "clBuildProgram", "clGetProgramBuildInfo", "clCreateKernel",
+        "clCreateBuffer", "clSetKernelArg", "clEnqueueNDRangeKernel", "clEnqueueReadBuffer", "clFinish",
+        "clReleaseMemObject", "clReleaseKernel", "clReleaseProgram", "clReleaseCommandQueue", "clReleaseContext"
+    };
+    _Static_assert(sizeof(nomes) / sizeof(nomes[0]) * sizeof(void*) == sizeof(ApiOpenCL),
+                   "um nome por ponteiro de ApiOpenCL, na mesma ordem");
+
+    void* biblioteca = dlopen("libOpenCL.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (biblioteca == NULL) {
+        biblioteca = dlopen("libOpenCL.so", RTLD_NOW | RTLD_LOCAL);
+    }
+    if (biblioteca == NULL) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+    void** funcoes = (void**)api;
+    for (size_t i = 0; i < sizeof(nomes) / sizeof(nomes[0]); i++) {
+        if ((funcoes[i] = dlsym(biblioteca, nomes[i])) == NULL) {
+            return ERRO_POSICAO_INVALIDA;
+        }
+    }
+    return SUCESSO;     // A biblioteca fica carregada até o fim do processo
+}
+
+/**
+ * Enumera todas as frotas no primeiro dispositivo OpenCL (GPU de preferência)
+ *
+ * @param e Posicionamentos da frota
+ * @param resultado Saída: contagens por posicionamento
+ * @param dispositivo Saída: nome do dispositivo usado
+ * @param tamanhoDispositivo Capacidade de dispositivo
+ * @return SUCESSO, ou ERRO_POSICAO_INVALIDA (com o motivo no stderr) para cair na CPU
+ */
+static int enumerarFrotasOpenCL(const EnumeracaoFrotas* e, ResultadoEnumeracao* resultado,
+                                char* dispositivo, size_t tamanhoDispositivo) {
+    ApiOpenCL api;
+    if (carregarApiOpenCL(&api) != SUCESSO) {
+        fprintf(stderr, "⚠️  Biblioteca OpenCL indisponível\n");
+        return ERRO_POSICAO_INVALIDA;
+    }
+    cl_objeto plataforma, aparelho;
+    cl_uint quantidade = 0;
+    if (api.clGetPlatformIDs(1, &plataforma, &quantidade) != CL_SUCCESS || quantidade == 0 ||
+        (api.clGetDeviceIDs(plataforma, CL_DEVICE_TYPE_GPU, 1, &aparelho, NULL) != CL_SUCCESS &&
+         api.clGetDeviceIDs(plataforma, CL_DEVICE_TYPE_ALL, 1, &aparelho, NULL) != CL_SUCCESS)) {
+        fprintf(stderr, "⚠️  Nenhuma plataforma ou dispositivo OpenCL\n");
+        return ERRO_POSICAO_INVALIDA;
+    }
+    if (api.clGetDeviceInfo(aparelho, CL_DEVICE_NAME, tamanhoDispositivo, dispositivo, NULL) != CL_SUCCESS) {
+        snprintf(dispositivo, tamanhoDispositivo, "OpenCL");
+    }
+
+    cl_int erro = CL_SUCCESS;
+    int resposta = ERRO_POSICAO_INVALIDA;
+    cl_objeto contexto = api.clCreateContext(NULL, 1, &aparelho, NULL, NULL, &erro);
+    cl_objeto fila = erro == CL_SUCCESS ? api.clCreateCommandQueue(contexto, aparelho, 0, &erro) : NULL;
+    const char* fonte = FONTE_KERNEL_ENUMERACAO;
+    cl_objeto programa = erro == CL_SUCCESS ? api.clCreateProgramWithSource(contexto, 1, &fonte, NULL, &erro) : NULL;
+    if (erro == CL_SUCCESS && api.clBuildProgram(programa, 1, &aparelho, "", NULL, NULL) != CL_SUCCESS) {
+        char log[4096] = "";
+        api.clGetProgramBuildInfo(programa, aparelho, CL_PROGRAM_BUILD_LOG, sizeof(log) - 1, log, NULL);
+        fprintf(stderr, "⚠️  Falha ao compilar o kernel OpenCL:\n%s\n", log);
+        erro = CL_BUILD_PROGRAM_FAILURE;
+    }
+    cl_objeto kernel = erro == CL_SUCCESS ? api.clCreateKernel(programa, "enumerarTrios", &erro) : NULL;
+
+    size_t bytes = sizeof(uint64_t) * (size_t)e->total;
+    memset(resultado->contagens, 0, sizeof(resultado->contagens));
+    cl_objeto baixas = NULL, altas = NULL, contagens = NULL;
+    if (erro == CL_SUCCESS) {
+        baixas = api.clCreateBuffer(contexto, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bytes, (void*)e->baixas, &erro);
+    }
+    if (erro == CL_SUCCESS) {
+        altas = api.clCreateBuffer(contexto, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, bytes, (void*)e->altas, &erro);
+    }
+    if (erro == CL_SUCCESS) {
+        contagens = api.clCreateBuffer(contexto, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, bytes,
+                                       resultado->contagens, &erro);
+    }
+
+    if (erro == CL_SUCCESS) {
+        cl_int argumentos[7] = {e->quantidade[0], e->quantidade[1], e->quantidade[2], e->quantidade[3],
+                                e->ordenado[1], e->ordenado[2], e->ordenado[3]};
+        api.clSetKernelArg(kernel, 0, sizeof(cl_objeto), &baixas);
+        api.clSetKernelArg(kernel, 1, sizeof(cl_objeto), &altas);
+        api.clSetKernelArg(kernel, 2, sizeof(cl_objeto), &contagens);
+        for (cl_uint i = 0; i < 7; i++) {
+            api.clSetKernelArg(kernel, 3 + i, sizeof(cl_int), &argumentos[i]);
+        }
+        api.clSetKernelArg(kernel, 10, sizeof(uint32_t) * (size_t)e->total, NULL);
+
+        size_t trios = (size_t)e->quantidade[0] * (size_t)e->quantidade[1] * (size_t)e->quantidade[2];
+        size_t local = GRUPO_OPENCL_ENUMERACAO;
+        size_t global = (trios + local - 1) / local * local;
+        if (api.clEnqueueNDRangeKernel(fila, kernel, 1, NULL, &global, &local, 0, NULL, NULL) == CL_SUCCESS &&
+            api.clEnqueueReadBuffer(fila, contagens, CL_TRUE, 0, bytes, resultado->contagens, 0, NULL, NULL) ==
+                CL_SUCCESS) {
+            resposta = SUCESSO;
+        } else {
+            fprintf(stderr, "⚠️  Falha ao executar o kernel OpenCL\n");
+        }
+    }
+
+    cl_objeto buffers[3] = {baixas, altas, contagens};
+    for (int i = 0; i < 3; i++) {
+        if (buffers[i] != NULL) {
+            api.clReleaseMemObject(buffers[i]);
+        }
+    }
+    if (kernel != NULL) {
+        api.clReleaseKernel(kernel);
+    }
+    if (programa != NULL) {
+        api.clReleaseProgram(programa);
+    }
+    if (fila != NULL) {
+        api.clReleaseCommandQueue(fila);
+    }
+    if (contexto != NULL) {
+        api.clReleaseContext(contexto);
+    }
+    return resposta;
+}
+#endif
+
+/**
+ * Completa o resultado a partir das contagens por posicionamento:
+ * total de frotas e frotas que ocupam cada célula
+ */
+static void completarResultadoEnumeracao(const EnumeracaoFrotas* e, ResultadoEnumeracao* resultado) {
+    resultado->frotas = 0;
+    for (int p = 0; p < e->quantidade[0]; p++) {
+        resultado->frotas += resultado->contagens[p];   // Cada frota tem exatamente um primeiro navio
+    }
+    memset(resultado->porCelula, 0, sizeof(resultado->porCelula));
+    for (int p = 0; p < e->total; p++) {
+        Bitboard mascara = {{e->baixas[p], e->altas[p]}};
+        while (!bitboardVazioTeste(mascara)) {
+            resultado->porCelula[bitboardExtrairPrimeiro(&mascara)] += resultado->contagens[p];
+        }
+    }
+}
+
+/**
+ * Assinatura FNV-1a das contagens, para comparar backends e execuções
+ */
+static uint64_t assinaturaEnumeracao(const EnumeracaoFrotas* e, const ResultadoEnumeracao* resultado) {
+    uint64_t assinatura = 14695981039346656037ull;
+    for (int p = 0; p < e->total; p++) {
+        for (int byte = 0; byte < 8; byte++) {
+            assinatura = (assinatura ^ ((resultado->contagens[p] >> (8 * byte)) & 0xFF)) * 1099511628211ull;
+        }
+    }
+    return assinatura;
+}
+
+/**
+ * Exibe a probabilidade exata de cada célula e, por habilidade, o centro com
+ * mais células de navio esperadas (linearidade da esperança sobre as células)
+ */
+static void exibirResultadoEnumeracao(const ResultadoEnumeracao* resultado) {
+    printf("\n🔥 Probabilidade de navio por célula (%%):\n     ");
+    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+        char coluna[4];
+        formatarColuna(j, coluna, sizeof(coluna));
+        printf("%6s", coluna);
+    }
+    printf("\n");
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        printf("%s", ROTULOS_LINHA[i]);
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            printf("%6.2f", (double)resultado->porCelula[indiceCelula(i, j)] / (double)resultado->frotas * 100);
+        }
+        printf("\n");
+    }
+
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    criarHabilidadesPadrao(habilidades);
+    printf("\n🎯 Melhores centros (células de navio atingidas em média):\n");
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        uint64_t melhor = 0;
+        int centro = 0;
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            // Com 10x10 os bits acima de TOTAL_CELULAS ficam zerados nas máscaras
+            uint64_t soma = 0;
+            Bitboard area = habilidades[h].mascaras[c];
+            while (!bitboardVazioTeste(area)) {
+                soma += resultado->porCelula[bitboardExtrairPrimeiro(&area)];
+            }
+            if (soma > melhor) {
+                melhor = soma;
+                centro = c;
+            }
+        }
+        char texto[16];
+        Coordenada coord = {centro / TAMANHO_TABULEIRO, centro % TAMANHO_TABULEIRO};
+        formatarCoordenada(coord, texto, sizeof(texto));
+        printf("   %-10s %-4s %.4f\n", NOMES_HABILIDADES_PADRAO[h], texto, (double)melhor / (double)resultado->frotas);
+    }
+}
+
+/**
+ * Enumera exatamente todas as frotas legais (--enumerar [--threads T] [--opencl] [--validar])
+ * Sem OpenCL disponível, ou compilado sem -DBATALHA_OPENCL=1, a CPU faz a enumeração
+ *
+ * @param quantidadeThreads Threads da CPU (0 = todos os núcleos)
+ * @param usarOpenCL 1 para tentar o backend OpenCL
+ * @param validar 1 para repetir a enumeração na CPU e comparar as contagens
+ * @return 0 se bem-sucedido (e, ao validar, se os backends concordam)
+ */
+int executarEnumeracaoFrotas(int quantidadeThreads, int usarOpenCL, int validar) {
+    EnumeracaoFrotas* e = malloc(sizeof(EnumeracaoFrotas));
+    ResultadoEnumeracao* resultado = alocarAlinhadoCache(sizeof(ResultadoEnumeracao));
+    ResultadoEnumeracao* referencia = validar ? alocarAlinhadoCache(sizeof(ResultadoEnumeracao)) : NULL;
+    if (e == NULL || resultado == NULL || (validar && referencia == NULL)) {
+        fprintf(stderr, "❌ Memória insuficiente para a enumeração.\n");
+        free(e);
+        free(resultado);
+        free(referencia);
+        return 1;
+    }
+    prepararEnumeracaoFrotas(e);
+    printf("🧮 Enumeração exata da frota {");
+    for (int n = 0; n < MAX_NAVIOS; n++) {
+        printf(n > 0 ? ",%d" : "%d", TAMANHOS_NAVIOS[n]);
+    }
+    printf("} em H/V/D: %d, %d, %d e %d posicionamentos por navio\n",
+           e->quantidade[0], e->quantidade[1], e->quantidade[2], e->quantidade[3]);
+
+    char backend[128] = "";
+    double inicio = tempoAtual();
+    int threadsUsadas = 0;
+#if BATALHA_OPENCL
+    if (!usarOpenCL || enumerarFrotasOpenCL(e, resultado, backend, sizeof(backend)) != SUCESSO) {
+        backend[0] = '\0';
+    }
+#else
+    if (usarOpenCL) {
+        fprintf(stderr, "⚠️  Compilado sem OpenCL (-DBATALHA_OPENCL=1); enumerando na CPU\n");
+    }
+#endif
+    if (backend[0] == '\0') {
+        if ((threadsUsadas = enumerarFrotasCpu(e, resultado, quantidadeThreads)) == 0) {
+            fprintf(stderr, "❌ Memória insuficiente para a enumeração.\n");
+            free(e);
+            free(resultado);
+            free(referencia);
+            return 1;
+        }
+        snprintf(backend, sizeof(backend), "CPU, %d threads", threadsUsadas);
+    }
+    double segundos = tempoAtual() - inicio;
+    completarResultadoEnumeracao(e, resultado);
+    printf("   %llu frotas distintas em %.2f s (%s)\n", (unsigned long long)resultado->frotas, segundos, backend);
+    printf("   Assinatura das contagens: %016llx\n", (unsigned long long)assinaturaEnumeracao(e, resultado));
+
+    int ok = 1;
+    if (validar) {
+        // Com a enumeração já feita na CPU, a validação muda o número de threads
+        int threadsReferencia = threadsUsadas == 0 ? quantidadeThreads : threadsUsadas == 1 ? 0 : 1;
+        inicio = tempoAtual();
+        ok = enumerarFrotasCpu(e, referencia, threadsReferencia) > 0 &&
+             memcmp(referencia->contagens, resultado->contagens, sizeof(uint64_t) * (size_t)e->total) == 0;
+        printf("%s Validação na CPU (%.2f s): contagens %s\n", ok ? "✅" : "❌", tempoAtual() - inicio,
+               ok ? "idênticas" : "divergentes");
+    }
+    exibirResultadoEnumeracao(resultado);
+    free(e);
+    free(resultado);
+    free(referencia);
+    return ok ? 0 : 1;
+}
+
+/*
+ * ============================================
+ * TORNEIO DISTRIBUÍDO ENTRE NÓS
+ * ============================================
+ */
+
+/*
+ * Um coordenador divide cada pareamento (estratégia de posicionamento contra
+ * estratégia de ataque) em lotes de partidas e os entrega a nós de trabalho
+ * por TCP. Cada nó roda o motor Monte Carlo localmente e devolve apenas os
+ * totais do lote (e, se pedido, o registro binário das partidas).
+ *
+ * Mensagens nos dois sentidos: [tipo u8][tamanho u32 LE][carga]
+ *   nó → coordenador: PEDIR (vazia), RESULTADO (lote u32, 7 × u64 das estatísticas, registro opcional)
+ *   coordenador → nó: LOTE (lote u32, posicionamento u8, ataque u8, partidas u32, semente u64, gravar u8), FIM
+ * Um RESULTADO vale também como pedido do próximo lote.
+ */
+
+typedef struct {
+    int descritor;
+    int lote;                       // Lote em andamento, -1 se nenhum
+    int esperando;                  // Pediu lote quando não havia nenhum livre
+    uint8_t* entrada;
+    size_t tamanhoEntrada;
+    size_t capacidadeEntrada;
+} NoTorneio;
+
+typedef struct {
+    int epoll;
+    int escuta;
+    NoTorneio nos[MAX_NOS_TORNEIO];
+    int nosConectados;
+    int nosAtendidos;
+    long long partidasPorPareamento;
+    int partidasPorLote;
+    int lotesPorPareamento;
+    int totalLotes;
+    int proximoLote;                // Próximo lote nunca entregue
+    int* devolvidos;                // Lotes de nós que caíram antes de responder
+    int quantidadeDevolvidos;
+    uint8_t* concluidos;
+    int lotesConcluidos;
+    EstatisticasSimulacao totais[PAREAMENTOS_TORNEIO];
+    const char* diretorio;          // Registros dos lotes, NULL para não gravar
+    int registrosGravados;
+    uint64_t semente;
+} CoordenadorTorneio;
+
+typedef struct {
+    const char* host;
+    const char* porta;
+    int indice;
+    long long lotes;
+    long long partidas;
+    int falhou;
+} TrabalhadorTorneio;
+
+static const EstrategiaPosicionamento posicionamentosTorneio[POSICIONAMENTOS_TORNEIO] = {
+    {"uniforme", posicionarFrotaUniforme, NULL},
+    {"espalhada", posicionarFrotaEspalhada, NULL},
+    {"bordas", posicionarFrotaBordas, NULL},
+};
+
+static const char* const ataquesTorneio[ATAQUES_TORNEIO] = {"aleatorio", "densidade"};
+
+/**
+ * Semente de um lote: depende só da semente do torneio, do pareamento e da
+ * posição do lote nele, nunca do nó ou da thread que o executa
+ */
+static uint64_t sementeLoteTorneio(uint64_t semente, int pareamento, int indiceLote) {
+    uint64_t estado = semente ^ ((uint64_t)pareamento << 32 | (uint64_t)indiceLote);
+    return splitmix64(&estado);
+}
+
+/**
+ * Envia uma mensagem do protocolo do torneio
+ *
+ * @return SUCESSO ou ERRO_ES se a escrita falhar
+ */
+static int enviarMensagemTorneio(int descritor, uint8_t tipo, const uint8_t* carga, size_t tamanho) {
+    uint8_t cabecalho[5];
+    cabecalho[0] = tipo;
+    escreverU32(cabecalho + 1, (uint32_t)tamanho);
+    if (escreverTudo(descritor, cabecalho, sizeof(cabecalho)) != SUCESSO) {
+        return ERRO_ES;
+    }
+    return tamanho == 0 ? SUCESSO : escreverTudo(descritor, carga, tamanho);
+}
+
+/**
+ * Lê exatamente tamanho bytes de um descritor bloqueante
+ *
+ * @return SUCESSO, ou ERRO_FIM_ENTRADA se a conexão fechar ou falhar antes
+ */
+static int lerExatoTorneio(int descritor, void* destino, size_t tamanho) {
+    uint8_t* bytes = destino;
+    size_t lidos = 0;
+    while (lidos < tamanho) {
+        ssize_t n = read(descritor, bytes + lidos, tamanho - lidos);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return ERRO_FIM_ENTRADA;
+        }
+        lidos += (size_t)n;
+    }
+    return SUCESSO;
+}
+
+/**
+ * Entrega um lote a um nó, preferindo os devolvidos por nós que caíram
+ *
+ * @return 1 se um lote foi entregue, 0 se não havia nenhum livre, -1 se o envio falhou
+ *         (o lote continua com o nó; fecharNoTorneio o devolve à fila)
+ */
+static int entregarLoteTorneio(CoordenadorTorneio* coordenador, int indice) {
+    NoTorneio* no = &coordenador->nos[indice];
+    int lote;
+    if (coordenador->quantidadeDevolvidos > 0) {
+        lote = coordenador->devolvidos[--coordenador->quantidadeDevolvidos];
+    } else if (coordenador->proximoLote < coordenador->totalLotes) {
+        lote = coordenador->proximoLote++;
+    } else {
+        return 0;
+    }
+
+    int pareamento = lote / coordenador->lotesPorPareamento;
+    int indiceLote = lote % coordenador->lotesPorPareamento;
+    long long restantes = coordenador->partidasPorPareamento - (long long)indiceLote * coordenador->partidasPorLote;
+    uint32_t partidas = (uint32_t)(restantes < coordenador->partidasPorLote ? restantes : coordenador->partidasPorLote);
+
+    uint8_t carga[TAMANHO_LOTE_TORNEIO];
+    escreverU32(carga, (uint32_t)lote);
+    carga[4] = (uint8_t)(pareamento / ATAQUES_TORNEIO);
+    carga[5] = (uint8_t)(pareamento % ATAQUES_TORNEIO);
+    escreverU32(carga + 6, partidas);
+    escreverU64(carga + 10, sementeLoteTorneio(coordenador->semente, pareamento, indiceLote));
+    carga[18] = coordenador->diretorio != NULL;
+
+    no->lote = lote;
+    no->esperando = 0;
+    return enviarMensagemTorneio(no->descritor, MSG_TORNEIO_LOTE, carga, sizeof(carga)) == SUCESSO ? 1 : -1;
+}
+
+/**
+ * Fecha a conexão de um nó, devolvendo à fila o lote que ele não concluiu
+ */
+static void fecharNoTorneio(CoordenadorTorneio* coordenador, int indice) {
+    NoTorneio* no = &coordenador->nos[indice];
+    if (no->lote >= 0 && !coordenador->concluidos[no->lote]) {
+        coordenador->devolvidos[coordenador->quantidadeDevolvidos++] = no->lote;
+    }
+    close(no->descritor);
+    free(no->entrada);
+    memset(no, 0, sizeof(*no));
+    no->descritor = -1;
+    no->lote = -1;
+    coordenador->nosConectados--;
+
+    // Um lote devolvido vai para quem estava esperando; quem não o recebe também é fechado
+    for (int i = 0; i < MAX_NOS_TORNEIO && coordenador->quantidadeDevolvidos > 0; i++) {
+        if (coordenador->nos[i].descritor >= 0 && coordenador->nos[i].esperando &&
+            entregarLoteTorneio(coordenador, i) < 0) {
+            fecharNoTorneio(coordenador, i);
+        }
+    }
+}
+
+/**
+ * Grava o registro recebido de um lote em DIRETORIO/lote-<pos>-<ataque>-<n>.bnr
+ */
+static void gravarRegistroLoteTorneio(CoordenadorTorneio* coordenador, int lote, const uint8_t* dados, size_t tamanho) {
+    int pareamento = lote / coordenador->lotesPorPareamento;
+    char caminho[1024];
+    snprintf(caminho, sizeof(caminho), "%s/lote-%s-%s-%d.bnr", coordenador->diretorio,
+             posicionamentosTorneio[pareamento / ATAQUES_TORNEIO].nome, ataquesTorneio[pareamento % ATAQUES_TORNEIO],
+             lote % coordenador->lotesPorPareamento);
+    int descritor = open(caminho, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (descritor < 0 || escreverTudo(descritor, dados, tamanho) != SUCESSO) {
+        fprintf(stderr, "⚠️  Não foi possível gravar %s: %s\n", caminho, strerror(errno));
+    } else {
+        coordenador->registrosGravados++;
+    }
+    if (descritor >= 0) {
+        close(descritor);
+    }
+}
+
+/**
+ * Trata uma mensagem completa de um nó
+ *
+ * @return 1 para manter a conexão, 0 para fechá-la
+ */
+static int tratarMensagemTorneio(CoordenadorTorneio* coordenador, int indice, uint8_t tipo,
+                                 const uint8_t* carga, size_t tamanho) {
+    NoTorneio* no = &coordenador->nos[indice];
+    if (tipo == MSG_TORNEIO_RESULTADO) {
+        if (tamanho < TAMANHO_RESULTADO_TORNEIO || no->lote < 0 || lerU32(carga) != (uint32_t)no->lote) {
+            return 0;
+        }
+        int lote = no->lote;
+        no->lote = -1;
+        if (!coordenador->concluidos[lote]) {
+            EstatisticasSimulacao* totais = &coordenador->totais[lote / coordenador->lotesPorPareamento];
+            const uint8_t* campo = carga + 4;
+            totais->partidas += (long long)lerU64(campo);
+            totais->partidasVencidas += (long long)lerU64(campo + 8);
+            totais->turnos += (long long)lerU64(campo + 16);
+            totais->totalTiros += (long long)lerU64(campo + 24);
+            totais->acertos += (long long)lerU64(campo + 32);
+            totais->erros += (long long)lerU64(campo + 40);
+            totais->naviosDestruidos += (long long)lerU64(campo + 48);
+            if (coordenador->diretorio != NULL && tamanho > TAMANHO_RESULTADO_TORNEIO) {
+                gravarRegistroLoteTorneio(coordenador, lote, carga + TAMANHO_RESULTADO_TORNEIO,
+                                          tamanho - TAMANHO_RESULTADO_TORNEIO);
+            }
+            coordenador->concluidos[lote] = 1;
+            coordenador->lotesConcluidos++;
+        }
+    } else if (tipo != MSG_TORNEIO_PEDIR || no->lote >= 0) {
+        return 0;
+    }
+
+    // Resultado ou pedido: o nó está livre para o próximo lote
+    int entregue = entregarLoteTorneio(coordenador, indice);
+    if (entregue == 0) {
+        no->esperando = 1;
+    }
+    return entregue >= 0;
+}
+
+/**
+ * Lê o que chegou de um nó e trata as mensagens completas
+ *
+ * @return 1 para manter a conexão, 0 para fechá-la
+ */
+static int lerNoTorneio(CoordenadorTorneio* coordenador, int indice) {
+    NoTorneio* no = &coordenador->nos[indice];
+    for (;;) {
+        // Cresce o buffer até caber a mensagem em andamento
+        size_t necessario = no->tamanhoEntrada + TAMANHO_LEITURA_TORNEIO;
+        if (no->tamanhoEntrada >= 5) {
+            size_t mensagem = 5 + (size_t)lerU32(no->entrada + 1);
+            necessario = mensagem > necessario ? mensagem : necessario;
+        }
+        if (necessario > no->capacidadeEntrada) {
+            uint8_t* maior = realloc(no->entrada, necessario);
+            if (maior == NULL) {
+                return 0;
+            }
+            no->entrada = maior;
+            no->capacidadeEntrada = necessario;
+        }
+
+        ssize_t n = read(no->descritor, no->entrada + no->tamanhoEntrada, no->capacidadeEntrada - no->tamanhoEntrada);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 1;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return 0;
+        }
+        no->tamanhoEntrada += (size_t)n;
+
+        size_t inicio = 0;
+        while (no->tamanhoEntrada - inicio >= 5) {
+            uint32_t tamanho = lerU32(no->entrada + inicio + 1);
+            if (tamanho > MAX_MENSAGEM_TORNEIO) {
+                return 0;
+            }
+            if (no->tamanhoEntrada - inicio < 5 + (size_t)tamanho) {
+                break;
+            }
+            if (!tratarMensagemTorneio(coordenador, indice, no->entrada[inicio], no->entrada + inicio + 5, tamanho)) {
+                return 0;
+            }
+            inicio += 5 + (size_t)tamanho;
+        }
+        memmove(no->entrada, no->entrada + inicio, no->tamanhoEntrada - inicio);
+        no->tamanhoEntrada -= inicio;
+    }
+}
+
+/**
+ * Aceita as conexões de nós pendentes na escuta
+ */
+static void aceitarNosTorneio(CoordenadorTorneio* coordenador) {
+    for (;;) {
+        int descritor = accept(coordenador->escuta, NULL, NULL);
+        if (descritor < 0) {
+            return;
+        }
+        fcntl(descritor, F_SETFL, fcntl(descritor, F_GETFL) | O_NONBLOCK);
+        fcntl(descritor, F_SETFD, FD_CLOEXEC);
+        int indice = 0;
+        while (indice < MAX_NOS_TORNEIO && coordenador->nos[indice].descritor >= 0) {
+            indice++;
+        }
+        if (indice == MAX_NOS_TORNEIO) {
+            close(descritor);
+            continue;
+        }
+        int ligado = 1;
+        setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &ligado, sizeof(ligado));
+        struct epoll_event evento = {.events = EPOLLIN, .data.u32 = (uint32_t)indice};
+        if (epoll_ctl(coordenador->epoll, EPOLL_CTL_ADD, descritor, &evento) != 0) {
+            close(descritor);
+            continue;
+        }
+        coordenador->nos[indice].descritor = descritor;
+        coordenador->nos[indice].lote = -1;
+        coordenador->nosConectados++;
+        coordenador->nosAtendidos++;
+    }
+}
+
+/**
+ * Exibe a classificação do torneio: por pareamento, por posicionamento e por ataque
+ */
+static void exibirClassificacaoTorneio(const CoordenadorTorneio* coordenador, double segundos) {
+    // "Destruídas" tem 10 colunas visíveis, mas mais bytes: vai sem largura
+    printf("\n%-12s %-12s %10s %s %9s %8s\n", "Frota", "Ataque", "Partidas", "Destruídas", "Turnos", "Acerto");
+    long long partidas = 0;
+    double turnosPosicionamento[POSICIONAMENTOS_TORNEIO] = {0};
+    double turnosAtaque[ATAQUES_TORNEIO] = {0};
+    for (int p = 0; p < PAREAMENTOS_TORNEIO; p++) {
+        const EstatisticasSimulacao* t = &coordenador->totais[p];
+        double turnos = t->partidas > 0 ? (double)t->turnos / (double)t->partidas : 0.0;
+        printf("%-12s %-12s %10lld %9.1f%% %9.2f %7.1f%%\n", posicionamentosTorneio[p / ATAQUES_TORNEIO].nome,
+               ataquesTorneio[p % ATAQUES_TORNEIO], t->partidas,
+               t->partidas > 0 ? 100.0 * (double)t->partidasVencidas / (double)t->partidas : 0.0, turnos,
+               t->totalTiros > 0 ? 100.0 * (double)t->acertos / (double)t->totalTiros : 0.0);
+        turnosPosicionamento[p / ATAQUES_TORNEIO] += turnos / ATAQUES_TORNEIO;
+        turnosAtaque[p % ATAQUES_TORNEIO] += turnos / POSICIONAMENTOS_TORNEIO;
+        partidas += t->partidas;
+    }
+
+    int melhorPosicionamento = 0, melhorAtaque = 0;
+    for (int p = 1; p < POSICIONAMENTOS_TORNEIO; p++) {
+        melhorPosicionamento = turnosPosicionamento[p] > turnosPosicionamento[melhorPosicionamento] ? p : melhorPosicionamento;
+    }
+    for (int a = 1; a < ATAQUES_TORNEIO; a++) {
+        melhorAtaque = turnosAtaque[a] < turnosAtaque[melhorAtaque] ? a : melhorAtaque;
+    }
+    printf("\n🛡️  Posicionamento mais resistente: %s (%.2f turnos em média)\n",
+           posicionamentosTorneio[melhorPosicionamento].nome, turnosPosicionamento[melhorPosicionamento]);
+    printf("🎯 Ataque mais eficiente: %s (%.2f turnos em média)\n", ataquesTorneio[melhorAtaque],
+           turnosAtaque[melhorAtaque]);
+    printf("⏱️  Tempo: %.3f s (%.0f partidas/s em %d nós)\n", segundos,
+           segundos > 0 ? (double)partidas / segundos : 0.0, coordenador->nosAtendidos);
+    if (coordenador->diretorio != NULL) {
+        printf("💾 Registros: %d lotes em %s\n", coordenador->registrosGravados, coordenador->diretorio);
+    }
+}
+
+/**
+ * Coordena um torneio entre as estratégias (--torneio PORTA N)
+ * Cada pareamento joga N partidas, divididas em lotes entregues aos nós que
+ * se conectarem; nós que caem têm o lote devolvido à fila. Os totais só
+ * dependem da semente e do tamanho do lote, não de quantos nós participaram
+ *
+ * @param porta Porta TCP de escuta dos nós
+ * @param partidasPorPareamento Partidas de cada pareamento
+ * @param partidasPorLote Partidas de cada lote (0 = PARTIDAS_LOTE_TORNEIO)
+ * @param diretorio Diretório dos registros dos lotes, NULL para não gravar
+ * @param semente Semente do torneio
+ * @return 0 se todos os lotes foram concluídos
+ */
+int executarCoordenadorTorneio(int porta, long long partidasPorPareamento, int partidasPorLote,
+                               const char* diretorio, uint64_t semente) {
+    if (partidasPorLote <= 0) {
+        partidasPorLote = PARTIDAS_LOTE_TORNEIO;
+    }
+    long long lotesPorPareamento = (partidasPorPareamento + partidasPorLote - 1) / partidasPorLote;
+    if (partidasPorPareamento <= 0 || lotesPorPareamento * PAREAMENTOS_TORNEIO > INT32_MAX) {
+        fprintf(stderr, "❌ Número de partidas inválido para o torneio.\n");
+        return 1;
+    }
+#if !BATALHA_EVENTOS
+    if (diretorio != NULL) {
+        fprintf(stderr, "❌ A gravação depende dos eventos; recompile sem -DBATALHA_EVENTOS=0 (%s).\n", diretorio);
+        return 1;
+    }
+#endif
+
+    CoordenadorTorneio* coordenador = calloc(1, sizeof(CoordenadorTorneio));
+    if (coordenador == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para o torneio.\n");
+        return 1;
+    }
+    coordenador->partidasPorPareamento = partidasPorPareamento;
+    coordenador->partidasPorLote = partidasPorLote;
+    coordenador->lotesPorPareamento = (int)lotesPorPareamento;
+    coordenador->totalLotes = (int)lotesPorPareamento * PAREAMENTOS_TORNEIO;
+    coordenador->diretorio = diretorio;
+    coordenador->semente = semente;
+    coordenador->devolvidos = malloc(sizeof(int) * (size_t)coordenador->totalLotes);
+    coordenador->concluidos = calloc((size_t)coordenador->totalLotes, 1);
+    for (int i = 0; i < MAX_NOS_TORNEIO; i++) {
+        coordenador->nos[i].descritor = -1;
+        coordenador->nos[i].lote = -1;
+    }
+    coordenador->escuta = abrirEscutaServidor(porta);
+    coordenador->epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event evento = {.events = EPOLLIN, .data.u32 = UINT32_MAX};
+    if (coordenador->devolvidos == NULL || coordenador->concluidos == NULL || coordenador->escuta < 0 ||
+        coordenador->epoll < 0 || epoll_ctl(coordenador->epoll, EPOLL_CTL_ADD, coordenador->escuta, &evento) != 0) {
+        fprintf(stderr, "❌ Não foi possível abrir a porta %d: %s\n", porta, strerror(errno));
+        if (coordenador->escuta >= 0) {
+            close(coordenador->escuta);
+        }
+        if (coordenador->epoll >= 0) {
+            close(coordenador->epoll);
+        }
+        free(coordenador->devolvidos);
+        free(coordenador->concluidos);
+        free(coordenador);
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, sinalEncerrarServidor);
+    signal(SIGTERM, sinalEncerrarServidor);
+    printf("🏟️  Torneio na porta %d: %d pareamentos × %lld partidas em %d lotes de até %d (semente %llu)\n",
+           porta, PAREAMENTOS_TORNEIO, partidasPorPareamento, coordenador->totalLotes, partidasPorLote,
+           (unsigned long long)semente);
+    fflush(stdout);
+
+    struct epoll_event eventos[MAX_EVENTOS_EPOLL];
+    double inicio = 0.0;
+    int ultimoProgresso = 0;
+    while (!servidorEncerrando && coordenador->lotesConcluidos < coordenador->totalLotes) {
+        int quantidade = epoll_wait(coordenador->epoll, eventos, MAX_EVENTOS_EPOLL, 1000);
+        for (int e = 0; e < quantidade; e++) {
+            uint32_t indice = eventos[e].data.u32;
+            if (indice == UINT32_MAX) {
+                if (coordenador->nosAtendidos == 0) {
+                    inicio = tempoAtual();
+                }
+                aceitarNosTorneio(coordenador);
+            } else if (coordenador->nos[indice].descritor >= 0 && !lerNoTorneio(coordenador, (int)indice)) {
+                fecharNoTorneio(coordenador, (int)indice);
+            }
+        }
+        int progresso = (int)(10LL * coordenador->lotesConcluidos / coordenador->totalLotes);
+        if (progresso > ultimoProgresso) {
+            ultimoProgresso = progresso;
+            printf("⏳ %d%% dos lotes concluídos (%d nós conectados)\n", 10 * progresso, coordenador->nosConectados);
+            fflush(stdout);
+        }
+    }
+    double segundos = coordenador->nosAtendidos > 0 ? tempoAtual() - inicio : 0.0;
+
+    // Dispensa os nós; os que ainda estiverem com lote só existem se o torneio foi interrompido
+    for (int i = 0; i < MAX_NOS_TORNEIO; i++) {
+        if (coordenador->nos[i].descritor >= 0) {
+            enviarMensagemTorneio(coordenador->nos[i].descritor, MSG_TORNEIO_FIM, NULL, 0);
+            close(coordenador->nos[i].descritor);
+            free(coordenador->nos[i].entrada);
+        }
+    }
+    int completo = coordenador->lotesConcluidos == coordenador->totalLotes;
+    if (!completo) {
+        printf("\n⚠️  Torneio interrompido: %d de %d lotes concluídos.\n", coordenador->lotesConcluidos,
+               coordenador->totalLotes);
+    }
+    exibirClassificacaoTorneio(coordenador, segundos);
+
+    close(coordenador->escuta);
+    close(coordenador->epoll);
+    free(coordenador->devolvidos);
+    free(coordenador->concluidos);
+    free(coordenador);
+    return completo ? 0 : 1;
+}
+
+/**
+ * Conecta um nó de trabalho ao coordenador (nome ou endereço IPv4/IPv6)
+ *
+ * @return Descritor conectado, ou -1
+ */
+static int conectarCoordenadorTorneio(const char* host, const char* porta) {
+    struct addrinfo dicas;
+    struct addrinfo* enderecos;
+    memset(&dicas, 0, sizeof(dicas));
+    dicas.ai_family = AF_UNSPEC;
+    dicas.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, porta, &dicas, &enderecos) != 0) {
+        return -1;
+    }
+    int descritor = -1;
+    for (struct addrinfo* e = enderecos; e != NULL && descritor < 0; e = e->ai_next) {
+        descritor = socket(e->ai_family, e->ai_socktype | SOCK_CLOEXEC, e->ai_protocol);
+        if (descritor >= 0 && connect(descritor, e->ai_addr, e->ai_addrlen) != 0) {
+            close(descritor);
+            descritor = -1;
+        }
+    }
+    freeaddrinfo(enderecos);
+    if (descritor >= 0) {
+        int ligado = 1;
+        setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &ligado, sizeof(ligado));
+    }
+    return descritor;
+}
+
+/**
+ * Joga um lote gravando as partidas e devolve o registro em memória
+ * O registro passa por um arquivo temporário porque o GravadorRegistro escreve
+ * em descritor; o fluxo aleatório é o mesmo do lote sem gravação
+ *
+ * @param registro Bytes do registro (alocados; o chamador libera)
+ * @return SUCESSO, ERRO_MEMORIA, ERRO_ES se o arquivo temporário falhar,
+ *         ou ERRO_POSICAO_INVALIDA se o binário foi compilado sem eventos
+ */
+static int jogarLoteGravadoTorneio(const EstrategiaPosicionamento* posicionamento, const EstrategiaAtaque* ataque,
+                                   const HabilidadeCompilada habilidades[], long long partidas, uint64_t semente,
+                                   EstatisticasSimulacao* totais, uint8_t** registro, size_t* tamanhoRegistro) {
+#if BATALHA_EVENTOS
+    char caminho[] = "/tmp/batalha-torneio-XXXXXX";
+    int temporario = mkstemp(caminho);
+    if (temporario < 0) {
+        return ERRO_ES;
+    }
+    close(temporario);
+    GravadorRegistro* gravador = malloc(sizeof(GravadorRegistro));
+    int aberto = gravador != NULL ? abrirGravadorRegistro(gravador, caminho) : ERRO_MEMORIA;
+    if (aberto != SUCESSO) {
+        free(gravador);
+        unlink(caminho);
+        return aberto;
+    }
+
+    EstadoJogo estado;
+    ContextoGravacao contexto = {gravador, &estado, habilidades, QUANTIDADE_HABILIDADES_PADRAO, 0, {0, 0}, 0};
+    ReceptorEventos receptor = {gravacaoInicioAtaque, NULL, gravacaoNavioDestruido, gravacaoFimAtaque, &contexto};
+    GeradorAleatorio gerador;
+    inicializarGerador(&gerador, semente, 1);
+    for (long long i = 0; i < partidas; i++) {
+        if (simularPartida(&estado, posicionamento, ataque, habilidades, &gerador, &receptor) >= 0) {
+            gravarFimPartida(gravador);
+            acumularPartida(totais, &estado);
+        }
+    }
+    int ok = fecharGravadorRegistro(gravador) == SUCESSO;
+    free(gravador);
+
+    int descritor = ok ? open(caminho, O_RDONLY | O_CLOEXEC) : -1;
+    unlink(caminho);
+    struct stat informacoes;
+    if (descritor < 0 || fstat(descritor, &informacoes) != 0) {
+        if (descritor >= 0) {
+            close(descritor);
+        }
+        return ERRO_ES;
+    }
+    if ((*registro = malloc((size_t)informacoes.st_size + 1)) == NULL) {
+        close(descritor);
+        return ERRO_MEMORIA;
+    }
+    *tamanhoRegistro = (size_t)informacoes.st_size;
+    ok = lerExatoTorneio(descritor, *registro, *tamanhoRegistro) == SUCESSO;
+    close(descritor);
+    if (!ok) {
+        free(*registro);
+        *registro = NULL;
+    }
+    return ok ? SUCESSO : ERRO_ES;
+#else
+    (void)posicionamento;
+    (void)ataque;
+    (void)habilidades;
+    (void)partidas;
+    (void)semente;
+    (void)totais;
+    (void)registro;
+    (void)tamanhoRegistro;
+    return ERRO_POSICAO_INVALIDA;
+#endif
+}
+
+/**
+ * Corpo de uma thread de um nó: uma conexão ao coordenador, um lote por vez
+ *
+ * @param argumento Ponteiro para TrabalhadorTorneio
+ * @return NULL
+ */
+static void* executarTrabalhadorTorneio(void* argumento) {
+    TrabalhadorTorneio* trabalhador = argumento;
+    int descritor = conectarCoordenadorTorneio(trabalhador->host, trabalhador->porta);
+    if (descritor < 0) {
+        trabalhador->falhou = 1;
+        return NULL;
+    }
+
+    HabilidadeCompilada habilidades[QUANTIDADE_HABILIDADES_PADRAO];
+    const int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    criarHabilidadesPadrao(habilidades);
+    ContextoAtaqueDensidade contextoDensidade;
+    EstrategiaAtaque ataques[ATAQUES_TORNEIO] = {
+        {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0},
+        criarAtaqueDensidade(&contextoDensidade, habilidades, quantidadeHabilidades),
+    };
+    ResultadoMonteCarlo* resultado = alocarAlinhadoCache(sizeof(ResultadoMonteCarlo));
+
+    uint8_t cabecalho[5];
+    uint8_t carga[TAMANHO_LOTE_TORNEIO];
+    int ok = resultado != NULL && enviarMensagemTorneio(descritor, MSG_TORNEIO_PEDIR, NULL, 0) == SUCESSO;
+    while (ok && lerExatoTorneio(descritor, cabecalho, sizeof(cabecalho)) == SUCESSO) {
+        if (cabecalho[0] == MSG_TORNEIO_FIM) {
+            break;
+        }
+        if (cabecalho[0] != MSG_TORNEIO_LOTE || lerU32(cabecalho + 1) != TAMANHO_LOTE_TORNEIO ||
+            lerExatoTorneio(descritor, carga, sizeof(carga)) != SUCESSO ||
+            carga[4] >= POSICIONAMENTOS_TORNEIO || carga[5] >= ATAQUES_TORNEIO) {
+            ok = 0;
+            break;
+        }
+        long long partidas = lerU32(carga + 6);
+        uint64_t semente = lerU64(carga + 10);
+        uint8_t* registro = NULL;
+        size_t tamanhoRegistro = 0;
+
+        memset(resultado, 0, sizeof(*resultado));
+        if (carga[18]) {
+            ok = jogarLoteGravadoTorneio(&posicionamentosTorneio[carga[4]], &ataques[carga[5]], habilidades, partidas,
+                                         semente, &resultado->totais, &registro, &tamanhoRegistro) == SUCESSO &&
+                 tamanhoRegistro <= MAX_MENSAGEM_TORNEIO - TAMANHO_RESULTADO_TORNEIO;
+        } else {
+            TarefaMonteCarlo tarefa = {habilidades, &posicionamentosTorneio[carga[4]], &ataques[carga[5]],
+                                       partidas, semente, 0, 0, resultado};
+            executarTarefaMonteCarlo(&tarefa);
+        }
+
+        uint8_t* mensagem = ok ? malloc(TAMANHO_RESULTADO_TORNEIO + tamanhoRegistro) : NULL;
+        if (mensagem != NULL) {
+            const EstatisticasSimulacao* t = &resultado->totais;
+            memcpy(mensagem, carga, 4);
+            escreverU64(mensagem + 4, (uint64_t)t->partidas);
+            escreverU64(mensagem + 12, (uint64_t)t->partidasVencidas);
+            escreverU64(mensagem + 20, (uint64_t)t->turnos);
+            escreverU64(mensagem + 28, (uint64_t)t->totalTiros);
+            escreverU64(mensagem + 36, (uint64_t)t->acertos);
+            escreverU64(mensagem + 44, (uint64_t)t->erros);
+            escreverU64(mensagem + 52, (uint64_t)t->naviosDestruidos);
+            if (tamanhoRegistro > 0) {
+                memcpy(mensagem + TAMANHO_RESULTADO_TORNEIO, registro, tamanhoRegistro);
+            }
+            ok = enviarMensagemTorneio(descritor, MSG_TORNEIO_RESULTADO, mensagem,
+                                       TAMANHO_RESULTADO_TORNEIO + tamanhoRegistro) == SUCESSO;
+            trabalhador->lotes++;
+            trabalhador->partidas += t->partidas;
+        }
+        ok = ok && mensagem != NULL;
+        free(mensagem);
+        free(registro);
+    }
+
+    trabalhador->falhou = !ok;
+    free(resultado);
+    close(descritor);
+    return NULL;
+}
+
+/**
+ * Executa um nó de trabalho do torneio (--no-torneio HOST:PORTA)
+ * Cada thread mantém sua própria conexão e pede lotes até o coordenador dispensá-la
+ *
+ * @param endereco "HOST:PORTA" do coordenador
+ * @param quantidadeThreads Conexões (e threads) do nó, 0 = núcleos disponíveis
+ * @return 0 se todas as threads terminaram dispensadas pelo coordenador
+ */
+int executarNoTorneio(const char* endereco, int quantidadeThreads) {
+    char host[256];
+    const char* separador = strrchr(endereco, ':');
+    if (separador == NULL || separador == endereco || (size_t)(separador - endereco) >= sizeof(host)) {
+        fprintf(stderr, "❌ Endereço do coordenador inválido (HOST:PORTA): %s\n", endereco);
+        return 1;
+    }
+    memcpy(host, endereco, (size_t)(separador - endereco));
+    host[separador - endereco] = '\0';
+    if (quantidadeThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        quantidadeThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if (quantidadeThreads > MAX_THREADS) {
+        quantidadeThreads = MAX_THREADS;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_t threads[MAX_THREADS];
+    TrabalhadorTorneio trabalhadores[MAX_THREADS];
+    memset(trabalhadores, 0, sizeof(trabalhadores));
+    double inicio = tempoAtual();
+    int iniciadas = 0;
+    for (; iniciadas < quantidadeThreads; iniciadas++) {
+        trabalhadores[iniciadas].host = host;
+        trabalhadores[iniciadas].porta = separador + 1;
+        trabalhadores[iniciadas].indice = iniciadas;
+        if (pthread_create(&threads[iniciadas], NULL, executarTrabalhadorTorneio, &trabalhadores[iniciadas]) != 0) {
+            break;
+        }
+    }
+
+    long long lotes = 0, partidas = 0;
+    int falhas = quantidadeThreads - iniciadas;
+    for (int t = 0; t < iniciadas; t++) {
+        pthread_join(threads[t], NULL);
+        lotes += trabalhadores[t].lotes;
+        partidas += trabalhadores[t].partidas;
+        falhas += trabalhadores[t].falhou;
+    }
+    double segundos = tempoAtual() - inicio;
+
+    printf("🛰️  Nó do torneio (%s): %lld lotes, %lld partidas em %d threads, %.3f s (%.0f partidas/s)\n",
+           endereco, lotes, partidas, quantidadeThreads, segundos, segundos > 0 ? (double)partidas / segundos : 0.0);
+    if (falhas > 0) {
+        fprintf(stderr, "❌ %d conexões com o coordenador falharam ou caíram.\n", falhas);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * ============================================
+ * TABULEIRO DINÂMICO (TAMANHO EM TEMPO DE EXECUÇÃO)
+ * ============================================
+ */
+
+/**
+ * Soma os tamanhos de uma frota: a capacidade de células de navio de um tabuleiro dinâmico
+ */
+static int celulasFrota(const int tamanhos[], int quantidade) {
+    int total = 0;
+    for (int i = 0; i < quantidade; i++) {
+        total += tamanhos[i];
+    }
+    return total;
+}
+
+/**
+ * Distribuição do bloco de um tabuleiro dinâmico: deslocamentos de cada região
+ */
+typedef struct {
+    size_t navios;
+    size_t mapa;
+    size_t celulas;
+    size_t total;
+    int bitsMapa;
+} LayoutTabuleiroDinamico;
+
+/**
+ * Calcula a distribuição do bloco de um tabuleiro dinâmico
+ *
+ * @return 1 se os parâmetros forem válidos, 0 caso contrário
+ */
+static int calcularLayoutDinamico(int linhas, int colunas, int capacidadeNavios, int capacidadeCelulas,
+                                  LayoutTabuleiroDinamico* layout) {
+    if (linhas < 1 || colunas < 1 || linhas > MAX_DIMENSAO_DINAMICA || colunas > MAX_DIMENSAO_DINAMICA ||
+        capacidadeNavios < 1 || capacidadeNavios > MAX_NAVIOS_DINAMICOS ||
+        capacidadeCelulas < 1 || (long long)capacidadeCelulas > (long long)linhas * colunas) {
+        return 0;
+    }
+    // Pelo menos o dobro das células de navio, para as sondagens continuarem curtas
+    layout->bitsMapa = 1;
+    while ((1LL << layout->bitsMapa) < 2LL * capacidadeCelulas) {
+        layout->bitsMapa++;
+    }
+    layout->navios = (sizeof(TabuleiroDinamico) + _Alignof(Navio) - 1) / _Alignof(Navio) * _Alignof(Navio);
+    layout->mapa = layout->navios + sizeof(Navio) * (size_t)capacidadeNavios;
+    layout->mapa = (layout->mapa + _Alignof(EntradaMapaNavios) - 1) / _Alignof(EntradaMapaNavios) *
+                   _Alignof(EntradaMapaNavios);
+    layout->celulas = layout->mapa + sizeof(EntradaMapaNavios) * ((size_t)1 << layout->bitsMapa);
+    layout->total = layout->celulas + ((size_t)linhas * (size_t)colunas + 3) / 4;
+    return 1;
+}
+
+/**
+ * Calcula o tamanho do bloco de um tabuleiro dinâmico (cabeçalho, navios, mapa e células)
+ *
+ * @param linhas Quantidade de linhas (1 a MAX_DIMENSAO_DINAMICA)
+ * @param colunas Quantidade de colunas (1 a MAX_DIMENSAO_DINAMICA)
+ * @param capacidadeNavios Máximo de navios (1 a MAX_NAVIOS_DINAMICOS)
+ * @param capacidadeCelulas Máximo de células somadas dos navios (1 a linhas * colunas)
+ * @return Bytes necessários, ou 0 se os parâmetros forem inválidos
+ */
+size_t tamanhoTabuleiroDinamico(int linhas, int colunas, int capacidadeNavios, int capacidadeCelulas) {
+    LayoutTabuleiroDinamico layout;
+    return calcularLayoutDinamico(linhas, colunas, capacidadeNavios, capacidadeCelulas, &layout) ? layout.total : 0;
+}
+
+/**
+ * Limpa células, navios e o mapa célula → navio mantendo as dimensões e a alocação
+ *
+ * @param tab Tabuleiro dinâmico
+ */
+void limparTabuleiroDinamico(TabuleiroDinamico* tab) {
+    memset(tab->celulas, POSICAO_VAZIA, ((size_t)tab->linhas * (size_t)tab->colunas + 3) / 4);
+    memset(tab->mapaNavios, 0, sizeof(EntradaMapaNavios) << tab->bitsMapa);
+    tab->quantidadeNavios = 0;
+    tab->naviosRestantes = 0;
+    tab->celulasNavios = 0;
+}
+
+/**
+ * Monta um tabuleiro dinâmico vazio sobre um bloco de tamanhoTabuleiroDinamico bytes
+ */
+static TabuleiroDinamico* montarTabuleiroDinamico(uint8_t* bloco, int linhas, int colunas, int capacidadeNavios,
+                                                  int capacidadeCelulas) {
+    LayoutTabuleiroDinamico layout;
+    calcularLayoutDinamico(linhas, colunas, capacidadeNavios, capacidadeCelulas, &layout);
+
+    TabuleiroDinamico* tab = (TabuleiroDinamico*)bloco;
+    tab->linhas = linhas;
+    tab->colunas = colunas;
+    tab->capacidadeNavios = capacidadeNavios;
+    tab->capacidadeCelulas = capacidadeCelulas;
+    tab->bitsMapa = layout.bitsMapa;
+    tab->navios = (Navio*)(bloco + layout.navios);
+    tab->mapaNavios = (EntradaMapaNavios*)(bloco + layout.mapa);
+    tab->celulas = bloco + layout.celulas;
+    limparTabuleiroDinamico(tab);
+    return tab;
+}
+
+/**
+ * Cria um tabuleiro dinâmico vazio em uma única alocação
+ *
+ * @param linhas Quantidade de linhas (1 a MAX_DIMENSAO_DINAMICA)
+ * @param colunas Quantidade de colunas (1 a MAX_DIMENSAO_DINAMICA)
+ * @param capacidadeNavios Máximo de navios (1 a MAX_NAVIOS_DINAMICOS)
+ * @param capacidadeCelulas Máximo de células somadas dos navios (1 a linhas * colunas)
+ * @return Tabuleiro criado, ou NULL se os parâmetros forem inválidos ou faltar memória
+ */
+TabuleiroDinamico* criarTabuleiroDinamico(int linhas, int colunas, int capacidadeNavios, int capacidadeCelulas) {
+    size_t bytes = tamanhoTabuleiroDinamico(linhas, colunas, capacidadeNavios, capacidadeCelulas);
+    uint8_t* bloco = bytes > 0 ? malloc(bytes) : NULL;
+    return bloco != NULL ? montarTabuleiroDinamico(bloco, linhas, colunas, capacidadeNavios, capacidadeCelulas)
+                         : NULL;
+}
+
+/**
+ * Cria um tabuleiro dinâmico vazio na arena de uma partida
+ * Não há liberação individual: o tabuleiro some quando a partida volta ao pool
+ *
+ * @return Tabuleiro criado, ou NULL se os parâmetros forem inválidos ou a arena estiver cheia
+ */
+TabuleiroDinamico* criarTabuleiroDinamicoNaArena(ArenaPartida* arena, int linhas, int colunas, int capacidadeNavios,
+                                                 int capacidadeCelulas) {
+    size_t bytes = tamanhoTabuleiroDinamico(linhas, colunas, capacidadeNavios, capacidadeCelulas);
+    uint8_t* bloco = bytes > 0 ? alocarArena(arena, bytes, _Alignof(TabuleiroDinamico)) : NULL;
+    return bloco != NULL ? montarTabuleiroDinamico(bloco, linhas, colunas, capacidadeNavios, capacidadeCelulas)
+                         : NULL;
+}
+
+/**
+ * Libera um tabuleiro dinâmico (uma única liberação para o bloco inteiro)
+ *
+ * @param tab Tabuleiro a ser liberado (pode ser NULL)
+ */
+void destruirTabuleiroDinamico(TabuleiroDinamico* tab) {
+    free(tab);
+}
+
+/**
+ * Primeira entrada sondada no mapa célula → navio (hash multiplicativo de Fibonacci)
+ */
+static inline uint32_t posicaoMapaNavios(const TabuleiroDinamico* tab, uint32_t chave) {
+    return (uint32_t)(((uint64_t)chave * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - tab->bitsMapa));
+}
+
+/**
+ * Associa uma célula de navio ao seu navio (a célula ainda não pode estar no mapa)
+ */
+static inline void inserirMapaNavios(TabuleiroDinamico* tab, size_t indice, int navio) {
+    uint32_t chave = (uint32_t)indice + 1;
+    uint32_t mascara = (1u << tab->bitsMapa) - 1;
+    uint32_t posicao = posicaoMapaNavios(tab, chave);
+    while (tab->mapaNavios[posicao].celula != 0) {
+        posicao = (posicao + 1) & mascara;
+    }
+    tab->mapaNavios[posicao].celula = chave;
+    tab->mapaNavios[posicao].navio = (uint32_t)navio;
+}
+
+/**
+ * Busca o navio dono de uma célula de navio: O(1) esperado com ocupação de até 50%
+ */
+static inline int buscarMapaNavios(const TabuleiroDinamico* tab, size_t indice) {
+    uint32_t chave = (uint32_t)indice + 1;
+    uint32_t mascara = (1u << tab->bitsMapa) - 1;
+    uint32_t posicao = posicaoMapaNavios(tab, chave);
+    while (tab->mapaNavios[posicao].celula != chave) {
+        posicao = (posicao + 1) & mascara;
+    }
+    return (int)tab->mapaNavios[posicao].navio;
+}
+
+static inline int coordenadaValidaDinamica(const TabuleiroDinamico* tab, int linha, int coluna) {
+    return linha >= 0 && linha < tab->linhas && coluna >= 0 && coluna < tab->colunas;
+}
+
+/**
+ * Lê o estado de uma célula (coordenada deve ser válida)
+ *
+ * @return Um dos valores POSICAO_*
+ */
+static inline int lerCelulaDinamica(const TabuleiroDinamico* tab, int linha, int coluna) {
+    size_t indice = (size_t)linha * (size_t)tab->colunas + (size_t)coluna;
+    return (tab->celulas[indice >> 2] >> ((indice & 3) * 2)) & 3;
+}
+
+/**
+ * Grava o estado de uma célula (coordenada deve ser válida)
+ *
+ * @param valor Um dos valores POSICAO_*
+ */
+static inline void definirCelulaDinamica(TabuleiroDinamico* tab, int linha, int coluna, int valor) {
+    size_t indice = (size_t)linha * (size_t)tab->colunas + (size_t)coluna;
+    int deslocamento = (int)(indice & 3) * 2;
+    tab->celulas[indice >> 2] = (uint8_t)((tab->celulas[indice >> 2] & ~(3 << deslocamento)) |
+                                          (valor << deslocamento));
+}
+
+/**
+ * Posiciona um navio no tabuleiro dinâmico
+ * Mesmas regras e mesma ordem de detecção de erros de posicionarNavio
+ *
+ * @param tab Tabuleiro dinâmico
+ * @param navio Navio a ser posicionado (id e partes são preenchidos aqui)
+ * @return SUCESSO ou código de erro
+ */
+int posicionarNavioDinamico(TabuleiroDinamico* tab, Navio navio) {
+    if (tab->quantidadeNavios >= tab->capacidadeNavios ||
+        navio.tamanho > tab->capacidadeCelulas - tab->celulasNavios) {
+        return ERRO_POSICAO_INVALIDA;
+    }
+
+    Coordenada coord = navio.inicio;
+    for (int i = 0; i < navio.tamanho; i++) {
+        if (!coordenadaValidaDinamica(tab, coord.linha, coord.coluna)) {
+            return ERRO_FORA_LIMITES;
+        }
+        if (lerCelulaDinamica(tab, coord.linha, coord.coluna) != POSICAO_VAZIA) {
+            return ERRO_POSICAO_OCUPADA;
+        }
+        proximaCoordenada(&coord, navio.orientacao);
+    }
+
+    coord = navio.inicio;
+    for (int i = 0; i < navio.tamanho; i++) {
+        definirCelulaDinamica(tab, coord.linha, coord.coluna, POSICAO_NAVIO);
+        inserirMapaNavios(tab, (size_t)coord.linha * (size_t)tab->colunas + (size_t)coord.coluna,
+                          tab->quantidadeNavios);
+        proximaCoordenada(&coord, navio.orientacao);
+    }
+    tab->celulasNavios += navio.tamanho;
+
+    navio.id = tab->quantidadeNavios + 1;
+    navio.foiDestruido = 0;
+    navio.partesRestantes = navio.tamanho;
+    tab->navios[tab->quantidadeNavios++] = navio;
+    tab->naviosRestantes++;
+    return SUCESSO;
+}
+
+/**
+ * Aplica uma habilidade 5x5 no tabuleiro dinâmico
+ * Caminho genérico com verificação de limites por célula; cada acerto
+ * desconta uma parte do navio dono da célula, achado no mapa sem revarrer a frota
+ *
+ * @param tab Tabuleiro dinâmico
+ * @param habilidade Matriz da habilidade
+ * @param centro Centro do ataque
+ * @param stats Estatísticas da partida
+ * @return Quantidade de novos acertos
+ */
+int aplicarHabilidadeDinamica(TabuleiroDinamico* tab,
+                              int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                              Coordenada centro, EstatisticasJogo* stats) {
+    const int deslocamento = TAMANHO_HABILIDADE / 2;
+    int tiros = 0;
+    int acertos = 0;
+
+    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
+        for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
+            int linha = centro.linha - deslocamento + i;
+            int coluna = centro.coluna - deslocamento + j;
+
+            if (habilidade[i][j] != AREA_AFETADA || !coordenadaValidaDinamica(tab, linha, coluna)) {
+                continue;
+            }
+
+            tiros++;
+            int estadoCelula = lerCelulaDinamica(tab, linha, coluna);
+            if (estadoCelula == POSICAO_NAVIO) {
+                definirCelulaDinamica(tab, linha, coluna, POSICAO_ATINGIDA);
+                acertos++;
+
+                Navio* navio = &tab->navios[buscarMapaNavios(tab, (size_t)linha * (size_t)tab->colunas +
+                                                                  (size_t)coluna)];
+                if (--navio->partesRestantes == 0) {
+                    navio->foiDestruido = 1;
+                    tab->naviosRestantes--;
+                    stats->naviosDestruidos++;
+                }
+            } else if (estadoCelula == POSICAO_VAZIA) {
+                definirCelulaDinamica(tab, linha, coluna, POSICAO_AGUA_ATINGIDA);
+            }
+        }
+    }
+
+    stats->totalTiros += tiros;
+    stats->acertos += acertos;
+    stats->erros += tiros - acertos;
+    return acertos;
+}
+
+/**
+ * Exibe o tabuleiro dinâmico com rótulos de coluna de várias letras
+ *
+ * @param tab Tabuleiro dinâmico
+ */
+void exibirTabuleiroDinamico(const TabuleiroDinamico* tab) {
+    char rotulo[MAX_LETRAS_COLUNA + 1];
+    int largura = formatarColuna(tab->colunas - 1, rotulo, sizeof(rotulo)) + 2;
+    int larguraLinha = snprintf(NULL, 0, "%d", tab->linhas - 1);
+
+    printf("%*s ", larguraLinha + 1, "");
+    for (int j = 0; j < tab->colunas; j++) {
+        formatarColuna(j, rotulo, sizeof(rotulo));
+        printf("%*s", largura, rotulo);
+    }
+    printf("\n");
+
+    for (int i = 0; i < tab->linhas; i++) {
+        printf(" %*d│", larguraLinha, i);
+        for (int j = 0; j < tab->colunas; j++) {
+            printf("%*d", largura, lerCelulaDinamica(tab, i, j));
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * Interpreta a composição da frota no formato "tamanho[:quantidade],..."
+ * Exemplo: "5:10,4:20,3,2:40"
+ *
+ * @param texto Especificação da frota
+ * @param frota Saída: frota interpretada
+ * @return 1 se válida, 0 caso contrário
+ */
+int interpretarFrota(const char* texto, ConfiguracaoFrota* frota) {
+    frota->quantidade = 0;
+
+    while (*texto != '\0') {
+        char* fim;
+        long tamanho = strtol(texto, &fim, 10);
+        long quantidade = 1;
+
+        if (fim == texto || tamanho < 1 || tamanho > MAX_DIMENSAO_DINAMICA) {
+            return 0;
+        }
+        if (*fim == ':') {
+            texto = fim + 1;
+            quantidade = strtol(texto, &fim, 10);
+            if (fim == texto || quantidade < 1) {
+                return 0;
+            }
+        }
+        if (frota->quantidade + quantidade > MAX_NAVIOS_DINAMICOS) {
+            return 0;
+        }
+        for (long i = 0; i < quantidade; i++) {
+            frota->tamanhos[frota->quantidade++] = (int)tamanho;
+        }
+
+        if (*fim == ',') {
+            fim++;
+        } else if (*fim != '\0') {
+            return 0;
+        }
+        texto = fim;
+    }
+
+    return frota->quantidade > 0;
+}
+
+/**
+ * Posiciona a frota em posições aleatórias do tabuleiro dinâmico
+ *
+ * @param tab Tabuleiro dinâmico (limpo)
+ * @param frota Composição da frota
+ * @param gerador Gerador de números aleatórios
+ * @return 1 se todos os navios couberam, 0 caso contrário
+ */
+int posicionarFrotaDinamica(TabuleiroDinamico* tab, const ConfiguracaoFrota* frota, GeradorAleatorio* gerador) {
+    static const char orientacoes[] = {'H', 'V', 'D'};
+    const int maxTentativas = 10000;
+
+    for (int i = 0; i < frota->quantidade; i++) {
+        int resultado = ERRO_POSICAO_INVALIDA;
+        for (int t = 0; t < maxTentativas && resultado != SUCESSO; t++) {
+            Navio navio = {{(int)aleatorioLimitado(gerador, (uint32_t)tab->linhas),
+                            (int)aleatorioLimitado(gerador, (uint32_t)tab->colunas)},
+                           frota->tamanhos[i], orientacoes[aleatorioLimitado(gerador, 3)], 0, 0, 0};
+            resultado = posicionarNavioDinamico(tab, navio);
+        }
+        if (resultado != SUCESSO) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Executa partidas simuladas em um tabuleiro e frota configurados
+ * As habilidades padrão giram em ordem, com centros aleatórios, até a frota
+ * afundar ou até um turno por célula do tabuleiro
+ *
+ * @param partidas Número de partidas
+ * @param linhas Linhas do tabuleiro
+ * @param colunas Colunas do tabuleiro
+ * @param frota Composição da frota
+ * @param semente Semente do gerador
+ * @return 0 se bem-sucedido
+ */
+int executarSimulacaoDinamica(long long partidas, int linhas, int colunas,
+                              const ConfiguracaoFrota* frota, uint64_t semente) {
+    int habilidades[QUANTIDADE_HABILIDADES_PADRAO][TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+    criarHabilidadeCone(habilidades[0]);
+    criarHabilidadeCruz(habilidades[1]);
+    criarHabilidadeOctaedro(habilidades[2]);
+
+    // Uma frota maior que o tabuleiro só falha no posicionamento, com a mensagem própria
+    long long celulas = celulasFrota(frota->tamanhos, frota->quantidade);
+    if (celulas > (long long)linhas * colunas) {
+        celulas = (long long)linhas * colunas;
+    }
+    TabuleiroDinamico* tab = criarTabuleiroDinamico(linhas, colunas, frota->quantidade, (int)celulas);
+    if (tab == NULL) {
+        fprintf(stderr, "❌ Tabuleiro %dx%d com %d navios não pôde ser criado.\n", linhas, colunas, frota->quantidade);
+        return 1;
+    }
+
+    GeradorAleatorio gerador;
+    inicializarGerador(&gerador, semente, 0);
+
+    EstatisticasSimulacao totais;
+    memset(&totais, 0, sizeof(totais));
+    long long limiteTurnos = (long long)linhas * colunas;
+
+    double inicio = tempoAtual();
+    for (long long p = 0; p < partidas; p++) {
+        EstatisticasJogo stats;
+        inicializarEstatisticas(&stats);
+        limparTabuleiroDinamico(tab);
+
+        if (!posicionarFrotaDinamica(tab, frota, &gerador)) {
+            fprintf(stderr, "❌ A frota não cabe no tabuleiro %dx%d.\n", linhas, colunas);
+            destruirTabuleiroDinamico(tab);
+            return 1;
+        }
+
+        long long turno = 0;
+        while (tab->naviosRestantes > 0 && turno < limiteTurnos) {
+            Coordenada centro = {(int)aleatorioLimitado(&gerador, (uint32_t)linhas),
+                                 (int)aleatorioLimitado(&gerador, (uint32_t)colunas)};
+            aplicarHabilidadeDinamica(tab, habilidades[turno % QUANTIDADE_HABILIDADES_PADRAO], centro, &stats);
+            turno++;
+        }
+
+        totais.partidas++;
+        totais.partidasVencidas += (tab->naviosRestantes == 0);
+        totais.turnos += turno;
+        totais.totalTiros += stats.totalTiros;
+        totais.acertos += stats.acertos;
+        totais.erros += stats.erros;
+        totais.naviosDestruidos += stats.naviosDestruidos;
+    }
+    double segundos = tempoAtual() - inicio;
+
+    printf("🎲 Simulação: tabuleiro %dx%d, %d navios, semente %llu\n",
+           linhas, colunas, frota->quantidade, (unsigned long long)semente);
+    if (linhas <= 26 && colunas <= 52) {
+        exibirTabuleiroDinamico(tab);
+    }
+    exibirResumoSimulacao(&totais, segundos);
+
+    destruirTabuleiroDinamico(tab);
+    return 0;
+}
+
+/**
+ * Interpreta as dimensões do tabuleiro no formato "LxC" ou "N"
+ *
+ * @param texto Dimensões
+ * @param linhas Saída: linhas
+ * @param colunas Saída: colunas
+ * @return 1 se válidas, 0 caso contrário
+ */
+static int interpretarDimensoes(const char* texto, int* linhas, int* colunas) {
+    char* fim;
+    long l = strtol(texto, &fim, 10);
+    long c = l;
+
+    if (fim == texto) {
+        return 0;
+    }
+    if (*fim == 'x' || *fim == 'X') {
+        const char* resto = fim + 1;
+        c = strtol(resto, &fim, 10);
+        if (fim == resto) {
+            return 0;
+        }
+    }
+    if (*fim != '\0' || l < 1 || c < 1 || l > MAX_DIMENSAO_DINAMICA || c > MAX_DIMENSAO_DINAMICA) {
+        return 0;
+    }
+
+    *linhas = (int)l;
+    *colunas = (int)c;
+    return 1;
+}
+
+/*
+ * ============================================
+ * REGRESSÃO ENTRE OS CAMINHOS DO MOTOR
+ * ============================================
+ *
+ * Partidas semeadas jogadas por todos os caminhos do motor e comparadas, bit a
+ * bit, com a referência (aplicarHabilidadeNoTabuleiro e verificarNaviosDestruidos
+ * sobre a matriz). A frota de cada partida vem da sua semente; o roteiro de
+ * ataques é sorteado por lote de partidas, para que os caminhos em lote (mesmo
+ * ataque em vários tabuleiros) joguem exatamente as mesmas partidas
+ */
+
+#define PARTIDAS_LOTE_REGRESSAO 64      // Partidas por lote (múltiplo de FAIXAS_LOTE_SOA)
+#define TURNOS_REGRESSAO 32             // Ataques do roteiro de cada lote
+#define CAMINHOS_REGRESSAO 8
+
+_Static_assert(PARTIDAS_LOTE_REGRESSAO % FAIXAS_LOTE_SOA == 0, "lotes SoA completos");
+_Static_assert(TURNOS_REGRESSAO <= MAX_TURNOS, "o roteiro cabe no diário de jogadas");
+
+enum {
+    CAMINHO_REFERENCIA,
+    CAMINHO_COMPILADO,
+    CAMINHO_ESPECIALIZADO,
+    CAMINHO_DINAMICO,
+    CAMINHO_HEADLESS,
+    CAMINHO_DIARIO,
+    CAMINHO_LOTE,
+    CAMINHO_SOA
+};
+
+static const char* const NOMES_CAMINHOS_REGRESSAO[CAMINHOS_REGRESSAO] = {
+    "Matriz (referência)", "Matriz compilada", "Kernels especializados", "Tabuleiro dinâmico",
+    "Núcleo headless", "Diário (desfaz e refaz)", "Lote de tabuleiros", "Lote SoA"
+};
+
+/**
+ * Estado final de uma partida em forma canônica, comum a todos os caminhos
+ */
+typedef struct {
+    int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];    // Valores POSICAO_*
+    EstatisticasJogo stats;
+    int afundados;                  // Bit n = navio n destruído
+} FinalRegressao;
+
+typedef struct {
+    double segundos[CAMINHOS_REGRESSAO];
+    long long divergencias[CAMINHOS_REGRESSAO];
+    long long primeiraDivergencia[CAMINHOS_REGRESSAO];  // Menor partida divergente, -1 se nenhuma
+    long long partidas;
+    uint64_t assinatura;            // Soma dos hashes dos finais da referência (independe da ordem)
+} ResultadoRegressao;
+
+typedef struct {
+    long long partidas;
+    uint64_t semente;
+    atomic_llong proximoLote;
+    int habilidades[QUANTIDADE_HABILIDADES_PADRAO][TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+} TrabalhoRegressao;
+
+/**
+ * Memória de trabalho de uma thread: um lote de partidas em cada representação
+ */
+typedef struct {
+    _Alignas(TAMANHO_LINHA_CACHE) TrabalhoRegressao* trabalho;    // Uma tarefa por thread
+    ResultadoRegressao resultado;
+    int quantidade;                 // Partidas do lote atual
+    EstadoJogo frotas[PARTIDAS_LOTE_REGRESSAO];
+    AtaqueLote roteiro[TURNOS_REGRESSAO];
+    FinalRegressao esperados[PARTIDAS_LOTE_REGRESSAO];
+    FinalRegressao obtidos[PARTIDAS_LOTE_REGRESSAO];
+    int tabuleiros[PARTIDAS_LOTE_REGRESSAO][TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    Navio navios[PARTIDAS_LOTE_REGRESSAO][MAX_NAVIOS];
+    EstatisticasJogo stats[PARTIDAS_LOTE_REGRESSAO];
+    EstadoJogo estados[PARTIDAS_LOTE_REGRESSAO];
+    EstadoJogo* ponteiros[PARTIDAS_LOTE_REGRESSAO];
+    TabuleiroDinamico* dinamicos[PARTIDAS_LOTE_REGRESSAO];
+    DiarioJogadas diario;
+    LoteTabuleirosSoA soa;
+} TarefaRegressao;
+
+/**
+ * Sorteia as frotas e o roteiro de um lote
+ * Frota: fluxo 2 * partida; roteiro: fluxo 2 * lote + 1 da mesma semente
+ */
+static void sortearLoteRegressao(TarefaRegressao* tarefa, long long lote) {
+    const TrabalhoRegressao* trabalho = tarefa->trabalho;
+    long long primeira = lote * PARTIDAS_LOTE_REGRESSAO;
+    tarefa->quantidade = (int)(trabalho->partidas - primeira < PARTIDAS_LOTE_REGRESSAO ?
+                               trabalho->partidas - primeira : PARTIDAS_LOTE_REGRESSAO);
+
+    GeradorAleatorio gerador;
+    for (int p = 0; p < tarefa->quantidade; p++) {
+        inicializarGerador(&gerador, trabalho->semente, 2 * (uint64_t)(primeira + p));
+        inicializarEstadoJogo(&tarefa->frotas[p]);
+        posicionarFrotaUniforme(NULL, &tarefa->frotas[p], &gerador);
+    }
+    inicializarGerador(&gerador, trabalho->semente, 2 * (uint64_t)lote + 1);
+    for (int t = 0; t < TURNOS_REGRESSAO; t++) {
+        tarefa->roteiro[t].habilidade = (uint8_t)aleatorioLimitado(&gerador, QUANTIDADE_HABILIDADES_PADRAO);
+        tarefa->roteiro[t].centro = (uint8_t)aleatorioLimitado(&gerador, TOTAL_CELULAS);
+    }
+}
+
+/**
+ * Prepara as partidas do lote na representação do caminho (fora da medição)
+ * Os caminhos sobre matriz posicionam a frota com o seu próprio posicionamento
+ */
+static void prepararCaminhoRegressao(TarefaRegressao* tarefa, int caminho) {
+    for (int p = 0; p < tarefa->quantidade; p++) {
+        const EstadoJogo* frota = &tarefa->frotas[p];
+        switch (caminho) {
+            case CAMINHO_REFERENCIA:
+            case CAMINHO_COMPILADO:
+            case CAMINHO_ESPECIALIZADO:
+                inicializarTabuleiro(tarefa->tabuleiros[p]);
+                inicializarEstatisticas(&tarefa->stats[p]);
+                for (int n = 0; n < frota->quantidadeNavios; n++) {
+                    tarefa->navios[p][n] = frota->navios[n];
+                    if (caminho == CAMINHO_ESPECIALIZADO) {
+                        posicionarNavioEspecializado(tarefa->tabuleiros[p], frota->navios[n]);
+                    } else {
+                        posicionarNavio(tarefa->tabuleiros[p], frota->navios[n]);
+                    }
+                }
+                break;
+            case CAMINHO_DINAMICO:
+                limparTabuleiroDinamico(tarefa->dinamicos[p]);
+                inicializarEstatisticas(&tarefa->stats[p]);
+                for (int n = 0; n < frota->quantidadeNavios; n++) {
+                    posicionarNavioDinamico(tarefa->dinamicos[p], frota->navios[n]);
+                }
+                break;
+            default:
+                tarefa->estados[p] = *frota;
+                tarefa->ponteiros[p] = &tarefa->estados[p];
+                break;
+        }
+    }
+    if (caminho == CAMINHO_SOA) {
+        limparLoteTabuleirosSoA(&tarefa->soa);
+        for (int p = 0; p < tarefa->quantidade; p++) {
+            carregarTabuleiroSoA(&tarefa->soa, &tarefa->estados[p]);
+        }
+    }
+}
+
+/**
+ * Joga o roteiro do lote pelo caminho (o trecho medido)
+ */
+static void jogarCaminhoRegressao(TarefaRegressao* tarefa, int caminho) {
+    TrabalhoRegressao* trabalho = tarefa->trabalho;
+    const int quantidade = tarefa->quantidade;
+
+    if (caminho == CAMINHO_LOTE || caminho == CAMINHO_SOA) {
+        for (int t = 0; t < TURNOS_REGRESSAO; t++) {
+            const HabilidadeCompilada* habilidade = &trabalho->compiladas[tarefa->roteiro[t].habilidade];
+            if (caminho == CAMINHO_LOTE) {
+                resolverAtaqueEmTabuleiros(tarefa->ponteiros, quantidade, habilidade, tarefa->roteiro[t].centro,
+                                           NULL, NULL);
+            } else {
+                resolverAtaqueSoA(&tarefa->soa, habilidade, tarefa->roteiro[t].centro);
+            }
+        }
+        return;
+    }
+
+    for (int p = 0; p < quantidade; p++) {
+        if (caminho == CAMINHO_DIARIO) {
+            inicializarDiario(&tarefa->diario);
+        }
+        for (int t = 0; t < TURNOS_REGRESSAO; t++) {
+            const AtaqueLote ataque = tarefa->roteiro[t];
+            const int linha = ataque.centro / TAMANHO_TABULEIRO, coluna = ataque.centro % TAMANHO_TABULEIRO;
+            switch (caminho) {
+                case CAMINHO_REFERENCIA:
+                    aplicarHabilidadeNoTabuleiro(tarefa->tabuleiros[p], trabalho->habilidades[ataque.habilidade],
+                                                 linha, coluna, NOMES_HABILIDADES_PADRAO[ataque.habilidade],
+                                                 tarefa->navios[p], MAX_NAVIOS, &tarefa->stats[p], NULL);
+                    break;
+                case CAMINHO_COMPILADO:
+                    aplicarHabilidadeCompiladaNoTabuleiro(tarefa->tabuleiros[p],
+                                                          &trabalho->compiladas[ataque.habilidade], linha, coluna,
+                                                          tarefa->navios[p], MAX_NAVIOS, &tarefa->stats[p], NULL);
+                    break;
+                case CAMINHO_ESPECIALIZADO:
+                    aplicarHabilidadeEspecializada(tarefa->tabuleiros[p], ataque.habilidade, linha, coluna,
+                                                   tarefa->navios[p], MAX_NAVIOS, &tarefa->stats[p], NULL);
+                    break;
+                case CAMINHO_DINAMICO: {
+                    Coordenada centro = {linha, coluna};
+                    aplicarHabilidadeDinamica(tarefa->dinamicos[p], trabalho->habilidades[ataque.habilidade],
+                                              centro, &tarefa->stats[p]);
+                    break;
+                }
+                case CAMINHO_HEADLESS: {
+                    Coordenada centro = {linha, coluna};
+                    resolverAtaque(&tarefa->estados[p], &trabalho->compiladas[ataque.habilidade], centro, NULL);
+                    break;
+                }
+                default:
+                    aplicarJogadaDiario(&tarefa->estados[p], &tarefa->diario, trabalho->compiladas, ataque);
+                    break;
+            }
+        }
+        if (caminho == CAMINHO_DIARIO) {
+            // Tudo desfeito e refeito: o diário tem de voltar exatamente ao mesmo estado
+            while (desfazerJogada(&tarefa->estados[p], &tarefa->diario) == SUCESSO) {
+            }
+            while (refazerJogada(&tarefa->estados[p], &tarefa->diario) == SUCESSO) {
+            }
+        }
+    }
+}
+
+/**
+ * Converte o resultado do caminho para a forma canônica
+ */
+static void extrairCaminhoRegressao(TarefaRegressao* tarefa, int caminho, FinalRegressao finais[]) {
+    for (int p = 0; p < tarefa->quantidade; p++) {
+        FinalRegressao* final = &finais[p];
+        const Navio* navios = tarefa->navios[p];
+        memset(final, 0, sizeof(*final));
+        final->stats = tarefa->stats[p];
+
+        switch (caminho) {
+            case CAMINHO_REFERENCIA:
+            case CAMINHO_COMPILADO:
+            case CAMINHO_ESPECIALIZADO:
+                memcpy(final->tabuleiro, tarefa->tabuleiros[p], sizeof(final->tabuleiro));
+                break;
+            case CAMINHO_DINAMICO:
+                for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+                    for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+                        final->tabuleiro[i][j] = lerCelulaDinamica(tarefa->dinamicos[p], i, j);
+                    }
+                }
+                navios = tarefa->dinamicos[p]->navios;
+                break;
+            default:
+                if (caminho == CAMINHO_SOA) {
+                    descarregarTabuleiroSoA(&tarefa->soa, p, &tarefa->estados[p]);
+                }
+                tabuleiroBitsParaMatriz(&tarefa->estados[p].tabuleiro, final->tabuleiro);
+                final->stats = tarefa->estados[p].stats;
+                navios = tarefa->estados[p].navios;
+                break;
+        }
+        for (int n = 0; n < tarefa->frotas[p].quantidadeNavios; n++) {
+            final->afundados |= (navios[n].foiDestruido != 0) << n;
+        }
+    }
+}
+
+/**
+ * Hash FNV-1a de um final canônico, misturado ao número da partida
+ */
+static uint64_t hashFinalRegressao(const FinalRegressao* final, long long partida) {
+    uint64_t hash = 14695981039346656037ull ^ (uint64_t)partida;
+    const uint8_t* bytes = (const uint8_t*)final;
+    for (size_t i = 0; i < sizeof(*final); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Corpo de uma thread da regressão: pega o próximo lote livre até acabarem
+ *
+ * @param argumento Ponteiro para TarefaRegressao
+ * @return NULL
+ */
+static void* executarTarefaRegressao(void* argumento) {
+    TarefaRegressao* tarefa = argumento;
+    TrabalhoRegressao* trabalho = tarefa->trabalho;
+    ResultadoRegressao* resultado = &tarefa->resultado;
+    const long long lotes = (trabalho->partidas + PARTIDAS_LOTE_REGRESSAO - 1) / PARTIDAS_LOTE_REGRESSAO;
+
+    for (;;) {
+        long long lote = atomic_fetch_add_explicit(&trabalho->proximoLote, 1, memory_order_relaxed);
+        if (lote >= lotes) {
+            break;
+        }
+        sortearLoteRegressao(tarefa, lote);
+
+        for (int caminho = 0; caminho < CAMINHOS_REGRESSAO; caminho++) {
+            prepararCaminhoRegressao(tarefa, caminho);
+            double inicio = tempoAtual();
+            jogarCaminhoRegressao(tarefa, caminho);
+            resultado->segundos[caminho] += tempoAtual() - inicio;
+            extrairCaminhoRegressao(tarefa, caminho, caminho == CAMINHO_REFERENCIA ? tarefa->esperados
+                                                                                   : tarefa->obtidos);
+            if (caminho == CAMINHO_REFERENCIA) {
+                continue;
+            }
+            for (int p = 0; p < tarefa->quantidade; p++) {
+                if (memcmp(&tarefa->esperados[p], &tarefa->obtidos[p], sizeof(FinalRegressao)) != 0) {
+                    long long partida = lote * PARTIDAS_LOTE_REGRESSAO + p;
+                    if (resultado->divergencias[caminho]++ == 0 || partida < resultado->primeiraDivergencia[caminho]) {
+                        resultado->primeiraDivergencia[caminho] = partida;
+                    }
+                }
+            }
+        }
+        for (int p = 0; p < tarefa->quantidade; p++) {
+            resultado->assinatura += hashFinalRegressao(&tarefa->esperados[p], lote * PARTIDAS_LOTE_REGRESSAO + p);
+        }
+        resultado->partidas += tarefa->quantidade;
+    }
+    return NULL;
+}
+
+static void liberarTarefaRegressao(TarefaRegressao* tarefa) {
+    for (int p = 0; p < PARTIDAS_LOTE_REGRESSAO; p++) {
+        destruirTabuleiroDinamico(tarefa->dinamicos[p]);
+    }
+    destruirLoteTabuleirosSoA(&tarefa->soa);
+}
+
+/**
+ * Joga partidas semeadas por todos os caminhos do motor e compara os finais
+ * com a referência bit a bit (--regressao N [--threads T] [--seed S])
+ * O tempo de cada caminho cobre só os ataques; a preparação e a comparação ficam de fora
+ *
+ * @param partidas Número de partidas
+ * @param quantidadeThreads Número de threads (0 = todos os núcleos)
+ * @param semente Semente das frotas e dos roteiros
+ * @return 0 se todos os caminhos reproduziram a referência em todas as partidas
+ */
+int executarRegressao(long long partidas, int quantidadeThreads, uint64_t semente) {
+    if (quantidadeThreads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        quantidadeThreads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    long long lotes = (partidas + PARTIDAS_LOTE_REGRESSAO - 1) / PARTIDAS_LOTE_REGRESSAO;
+    if (quantidadeThreads > lotes) {
+        quantidadeThreads = lotes > 0 ? (int)lotes : 1;
+    }
+    if (quantidadeThreads > MAX_THREADS) {
+        quantidadeThreads = MAX_THREADS;
+    }
+
+    TrabalhoRegressao trabalho;
+    trabalho.partidas = partidas;
+    trabalho.semente = semente;
+    atomic_init(&trabalho.proximoLote, 0);
+    criarHabilidadeCone(trabalho.habilidades[HABILIDADE_CONE]);
+    criarHabilidadeCruz(trabalho.habilidades[HABILIDADE_CRUZ]);
+    criarHabilidadeOctaedro(trabalho.habilidades[HABILIDADE_OCTAEDRO]);
+    criarHabilidadesPadrao(trabalho.compiladas);
+
+    TarefaRegressao* tarefas = alocarAlinhadoCache(sizeof(TarefaRegressao) * (size_t)quantidadeThreads);
+    if (tarefas == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para a regressão.\n");
+        return 1;
+    }
+    memset(tarefas, 0, sizeof(TarefaRegressao) * (size_t)quantidadeThreads);
+    int preparadas = 1;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        tarefas[t].trabalho = &trabalho;
+        for (int c = 0; c < CAMINHOS_REGRESSAO; c++) {
+            tarefas[t].resultado.primeiraDivergencia[c] = -1;
+        }
+        for (int p = 0; p < PARTIDAS_LOTE_REGRESSAO; p++) {
+            tarefas[t].dinamicos[p] = criarTabuleiroDinamico(TAMANHO_TABULEIRO, TAMANHO_TABULEIRO, MAX_NAVIOS,
+                                                             celulasFrota(TAMANHOS_NAVIOS, MAX_NAVIOS));
+            preparadas &= tarefas[t].dinamicos[p] != NULL;
+        }
+        preparadas &= criarLoteTabuleirosSoA(&tarefas[t].soa, PARTIDAS_LOTE_REGRESSAO) == SUCESSO;
+    }
+    if (!preparadas) {
+        fprintf(stderr, "❌ Memória insuficiente para a regressão.\n");
+        for (int t = 0; t < quantidadeThreads; t++) {
+            liberarTarefaRegressao(&tarefas[t]);
+        }
+        free(tarefas);
+        return 1;
+    }
+
+    pthread_t threads[MAX_THREADS];
+    double inicio = tempoAtual();
+    int iniciadas = 0;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        if (pthread_create(&threads[t], NULL, executarTarefaRegressao, &tarefas[t]) != 0) {
+            break;
+        }
+        iniciadas++;
+    }
+    if (iniciadas == 0) {
+        // Sem threads disponíveis a thread principal faz todo o trabalho
+        executarTarefaRegressao(&tarefas[0]);
+        iniciadas = 1;
+    } else {
+        for (int t = 0; t < iniciadas; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    double segundos = tempoAtual() - inicio;
+
+    ResultadoRegressao final;
+    memset(&final, 0, sizeof(final));
+    for (int c = 0; c < CAMINHOS_REGRESSAO; c++) {
+        final.primeiraDivergencia[c] = -1;
+    }
+    for (int t = 0; t < iniciadas; t++) {
+        const ResultadoRegressao* parcial = &tarefas[t].resultado;
+        for (int c = 0; c < CAMINHOS_REGRESSAO; c++) {
+            final.segundos[c] += parcial->segundos[c];
+            final.divergencias[c] += parcial->divergencias[c];
+            if (parcial->primeiraDivergencia[c] >= 0 &&
+                (final.primeiraDivergencia[c] < 0 || parcial->primeiraDivergencia[c] < final.primeiraDivergencia[c])) {
+                final.primeiraDivergencia[c] = parcial->primeiraDivergencia[c];
+            }
+        }
+        final.partidas += parcial->partidas;
+        final.assinatura += parcial->assinatura;
+    }
+
+    printf("🧪 Regressão: %lld partidas de %d ataques por %d caminhos em %d threads (%.2f s, semente %llu)\n",
+           final.partidas, TURNOS_REGRESSAO, CAMINHOS_REGRESSAO, iniciadas, segundos, (unsigned long long)semente);
+    printf("\n%12s %8s %13s  %s\n", "ns/ataque", "Ganho", "Divergências", "Caminho");
+    const double ataques = (double)final.partidas * TURNOS_REGRESSAO;
+    int ok = 1;
+    for (int c = 0; c < CAMINHOS_REGRESSAO; c++) {
+        printf("%12.1f %7.1fx %13lld  %s", final.segundos[c] * 1e9 / ataques,
+               final.segundos[c] > 0 ? final.segundos[CAMINHO_REFERENCIA] / final.segundos[c] : 0.0,
+               final.divergencias[c], NOMES_CAMINHOS_REGRESSAO[c]);
+        if (c == CAMINHO_SOA) {
+            printf("/%s", obterKernelLoteSoA());
+        }
+        if (final.divergencias[c] > 0) {
+            printf("  ❌ primeira: partida %lld", final.primeiraDivergencia[c]);
+            ok = 0;
+        }
+        printf("\n");
+    }
+    printf("\n🔏 Assinatura dos finais da referência: %016llx\n", (unsigned long long)final.assinatura);
+    printf("%s\n", ok ? "✅ Todos os caminhos reproduzem a referência bit a bit" :
+                        "❌ Caminhos divergentes da referência");
+
+    for (int t = 0; t < quantidadeThreads; t++) {
+        liberarTarefaRegressao(&tarefas[t]);
+    }
+    free(tarefas);
+    return ok ? 0 : 1;
+}
+
+/*
+ * ============================================
+ * BENCHMARK DOS KERNELS ESPECIALIZADOS
+ * ============================================
+ */
+
+#define TABULEIROS_BENCHMARK 64
+#define ATAQUES_LOTE_BENCHMARK 16      // Ataques por lote em medirKernelLote
+#define LINHAS_PARTIDA_BENCHMARK 100   // Tabuleiro dinâmico 100x100 dos benchmarks de alocação
+
+/**
+ * Conjunto de tabuleiros de referência usados pelos benchmarks
+ */
+typedef struct {
+    int tabuleiros[TABULEIROS_BENCHMARK][TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    Navio navios[TABULEIROS_BENCHMARK][MAX_NAVIOS];
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+    uint32_t padroes[QUANTIDADE_HABILIDADES_PADRAO];
+    int32_t mapas[TABULEIROS_BENCHMARK][TOTAL_CELULAS];     // Densidades no meio de partidas da IA
+    Bitboard disparadas[TABULEIROS_BENCHMARK];
+} CenariosBenchmark;
+
+// Impede que o compilador descarte os resultados medidos
+static volatile long long sumidouroBenchmark;
+
+/**
+ * Gera tabuleiros com frotas aleatórias para os benchmarks
  *
- * @param matriz Matriz onde será criado o padrão
+ * @param cenarios Destino dos tabuleiros
+ * @param semente Semente do gerador
  */
-void criarHabilidadeCruz(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
-    inicializarMatrizHabilidade(matriz);
+static void prepararCenariosBenchmark(CenariosBenchmark* cenarios, uint64_t semente) {
+    GeradorAleatorio gerador;
+    EstadoJogo estado;
+    inicializarGerador(&gerador, semente, 0);
 
-    const int centro = TAMANHO_HABILIDADE / 2;
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        inicializarEstadoJogo(&estado);
+        posicionarFrotaUniforme(NULL, &estado, &gerador);
+        tabuleiroBitsParaMatriz(&estado.tabuleiro, cenarios->tabuleiros[b]);
+        memcpy(cenarios->navios[b], estado.navios, sizeof(estado.navios));
+    }
 
-    // Linha vertical central
-    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
-        matriz[i][centro] = AREA_AFETADA;
+    // Mapas de densidade de partidas reais da IA, com 0 a 7 turnos jogados
+    criarHabilidadesPadrao(cenarios->compiladas);
+    ContextoAtaqueDensidade densidade;
+    EstrategiaAtaque ataque = criarAtaqueDensidade(&densidade, cenarios->compiladas, QUANTIDADE_HABILIDADES_PADRAO);
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        cenarios->padroes[h] = densidade.padroes[h];
+    }
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        inicializarEstadoJogo(&estado);
+        posicionarFrotaUniforme(NULL, &estado, &gerador);
+        for (int t = 0; t <= b % 8 && estado.naviosRestantes > 0; t++) {
+            int h;
+            Coordenada centro;
+            ataque.escolherAtaque(ataque.contexto, &estado, &gerador, &h, &centro);
+            if (t < b % 8) {
+                resolverAtaque(&estado, &cenarios->compiladas[h], centro, NULL);
+            }
+        }
+        memcpy(cenarios->mapas[b], densidade.mapa.mapa, sizeof(cenarios->mapas[b]));
+        cenarios->disparadas[b] = bitboardUniao(estado.tabuleiro.acertos, estado.tabuleiro.erros);
     }
+}
 
-    // Linha horizontal central
-    for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
-        matriz[centro][j] = AREA_AFETADA;
+/**
+ * Aplica uma habilidade em todos os 100 centros de um tabuleiro de referência
+ * pelo caminho genérico ou pelo especializado
+ *
+ * @return Acertos somados (usado para comparar os caminhos)
+ */
+static long long varrerCentros(const CenariosBenchmark* cenarios, int b, int tipo,
+                               int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                               int especializado,
+                               int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
+                               Navio navios[MAX_NAVIOS], EstatisticasJogo* stats) {
+    memcpy(tabuleiro, cenarios->tabuleiros[b], sizeof(cenarios->tabuleiros[b]));
+    memcpy(navios, cenarios->navios[b], sizeof(cenarios->navios[b]));
+    inicializarEstatisticas(stats);
+
+    for (int i = 0; i < TAMANHO_TABULEIRO; i++) {
+        for (int j = 0; j < TAMANHO_TABULEIRO; j++) {
+            if (especializado) {
+                aplicarHabilidadeEspecializada(tabuleiro, tipo, i, j, navios, MAX_NAVIOS, stats, NULL);
+            } else {
+                aplicarHabilidadeNoTabuleiro(tabuleiro, habilidade, i, j, NOMES_HABILIDADES_PADRAO[tipo],
+                                             navios, MAX_NAVIOS, stats, NULL);
+            }
+        }
     }
+    return stats->acertos;
 }
 
 /**
- * Cria o padrão de habilidade em octaedro (diamante)
- * Padrão otimizado para máximo impacto em área compacta
+ * Mede uma habilidade pelos dois caminhos e confere se os resultados são idênticos
  *
- * @param matriz Matriz onde será criado o padrão
+ * @param nsGenerico Saída: ns por aplicação no caminho genérico
+ * @param nsEspecializado Saída: ns por aplicação no caminho especializado
+ * @return 1 se os dois caminhos produziram o mesmo resultado
  */
-void criarHabilidadeOctaedro(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE]) {
-    inicializarMatrizHabilidade(matriz);
+static int medirKernelHabilidade(const CenariosBenchmark* cenarios, int tipo,
+                                 int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
+                                 long long iteracoes, double* nsGenerico, double* nsEspecializado) {
+    int tabA[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], tabB[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    Navio naviosA[MAX_NAVIOS], naviosB[MAX_NAVIOS];
+    EstatisticasJogo statsA, statsB;
+    int identicos = 1;
 
-    // Padrão diamante centrado
-    int padrao[][2] = {
-        {0, 2},                    // Topo
-        {1, 1}, {1, 2}, {1, 3},   // Meio expandido
-        {2, 2}                     // Base
-    };
+    // Conferência: mesmo tabuleiro final, navios e estatísticas em todos os cenários
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        varrerCentros(cenarios, b, tipo, habilidade, 0, tabA, naviosA, &statsA);
+        varrerCentros(cenarios, b, tipo, habilidade, 1, tabB, naviosB, &statsB);
+        identicos &= memcmp(tabA, tabB, sizeof(tabA)) == 0 &&
+                     memcmp(naviosA, naviosB, sizeof(naviosA)) == 0 &&
+                     memcmp(&statsA, &statsB, sizeof(statsA)) == 0;
+    }
 
-    int totalPosicoes = sizeof(padrao) / (sizeof(int) * 2);
-    for (int i = 0; i < totalPosicoes; i++) {
-        matriz[padrao[i][0]][padrao[i][1]] = AREA_AFETADA;
+    for (int especializado = 0; especializado <= 1; especializado++) {
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            soma += varrerCentros(cenarios, (int)(it % TABULEIROS_BENCHMARK), tipo, habilidade,
+                                  especializado, tabA, naviosA, &statsA);
+        }
+        double ns = (tempoAtual() - inicio) * 1e9 / ((double)iteracoes * TOTAL_CELULAS);
+        sumidouroBenchmark += soma;
+        if (especializado) {
+            *nsEspecializado = ns;
+        } else {
+            *nsGenerico = ns;
+        }
+    }
+
+    return identicos;
+}
+
+/**
+ * Escolhe o melhor ataque de um cenário por máscaras (0), convolução escalar (1) ou vetorial (2)
+ */
+static long long escolherAtaqueCenario(const CenariosBenchmark* cenarios, int b, int caminho,
+                                       int* habilidade, Coordenada* centro) {
+    if (caminho == 0) {
+        MapaProbabilidade mapa;
+        memcpy(mapa.mapa, cenarios->mapas[b], sizeof(mapa.mapa));
+        return escolherMelhorAtaque(&mapa, cenarios->compiladas, QUANTIDADE_HABILIDADES_PADRAO,
+                                    cenarios->disparadas[b], habilidade, centro);
     }
+    return escolherMelhorAtaqueConvolucao(cenarios->mapas[b], cenarios->disparadas[b], cenarios->padroes,
+                                          QUANTIDADE_HABILIDADES_PADRAO, caminho == 2, habilidade, centro);
 }
 
 /**
- * Exibe uma matriz de habilidade com formatação melhorada
+ * Mede a escolha do melhor ataque pelas máscaras e pela convolução (escalar e vetorial)
  *
- * @param matriz Matriz de habilidade a ser exibida
- * @param nomeHabilidade Nome da habilidade para exibição
+ * @return 1 se os três caminhos escolheram o mesmo ataque com a mesma pontuação
  */
-void exibirHabilidade(int matriz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE], const char* nomeHabilidade) {
-    printf("\n╔══════════════════════════════════════╗\n");
-    printf("║          HABILIDADE: %-15s ║\n", nomeHabilidade);
-    printf("╚══════════════════════════════════════╝\n");
+static int medirKernelConvolucao(const CenariosBenchmark* cenarios, long long iteracoes, double ns[3]) {
+    int identicos = 1;
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        int hRef, h;
+        Coordenada cRef, c;
+        long long ref = escolherAtaqueCenario(cenarios, b, 0, &hRef, &cRef);
+        for (int caminho = 1; caminho <= 2; caminho++) {
+            long long pontuacao = escolherAtaqueCenario(cenarios, b, caminho, &h, &c);
+            identicos &= pontuacao == ref && h == hRef && c.linha == cRef.linha && c.coluna == cRef.coluna;
+        }
+    }
 
-    printf("    ");
-    for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
-        printf("%2d ", j);
+    for (int caminho = 0; caminho <= 2; caminho++) {
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            int h;
+            Coordenada c;
+            soma += escolherAtaqueCenario(cenarios, (int)(it % TABULEIROS_BENCHMARK), caminho, &h, &c);
+        }
+        ns[caminho] = (tempoAtual() - inicio) * 1e9 / (double)iteracoes;
+        sumidouroBenchmark += soma;
     }
-    printf("\n");
+    return identicos;
+}
 
-    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
-        printf(" %d: ", i);
-        for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
-            if (matriz[i][j] == AREA_AFETADA) {
-                printf(" ● ");  // Posição afetada
+/**
+ * Mede ataques resolvidos um a um (resolverAtaque) contra os mesmos ataques em lote
+ * Também confere resolverAtaqueEmTabuleiros contra resolverAtaque tabuleiro a tabuleiro
+ *
+ * @param ns Saída: ns por ataque no caminho sequencial [0] e em lote [1]
+ * @return 1 se os estados finais forem idênticos byte a byte
+ */
+static int medirKernelLote(long long iteracoes, uint64_t semente, double ns[2]) {
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+    EstadoJogo* bases = malloc(sizeof(EstadoJogo) * 3 * TABULEIROS_BENCHMARK);
+    if (bases == NULL) {
+        return 0;
+    }
+    EstadoJogo* sequencial = bases + TABULEIROS_BENCHMARK;
+    EstadoJogo* lote = sequencial + TABULEIROS_BENCHMARK;
+    AtaqueLote ataques[TABULEIROS_BENCHMARK][ATAQUES_LOTE_BENCHMARK];
+    GeradorAleatorio gerador;
+    int identicos = 1;
+
+    criarHabilidadesPadrao(compiladas);
+    inicializarGerador(&gerador, semente, 3);
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        inicializarEstadoJogo(&bases[b]);
+        posicionarFrotaUniforme(NULL, &bases[b], &gerador);
+        for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+            ataques[b][a].habilidade = (uint8_t)aleatorioLimitado(&gerador, QUANTIDADE_HABILIDADES_PADRAO);
+            ataques[b][a].centro = (uint8_t)aleatorioLimitado(&gerador, TOTAL_CELULAS);
+        }
+    }
+
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        memcpy(&sequencial[b], &bases[b], sizeof(EstadoJogo));
+        memcpy(&lote[b], &bases[b], sizeof(EstadoJogo));
+        int acertos = 0;
+        for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+            Coordenada centro = {ataques[b][a].centro / TAMANHO_TABULEIRO, ataques[b][a].centro % TAMANHO_TABULEIRO};
+            acertos += resolverAtaque(&sequencial[b], &compiladas[ataques[b][a].habilidade], centro, NULL);
+        }
+        identicos &= resolverAtaquesEmLote(&lote[b], compiladas, ataques[b], ATAQUES_LOTE_BENCHMARK, NULL, NULL) == acertos;
+        identicos &= memcmp(&sequencial[b], &lote[b], sizeof(EstadoJogo)) == 0;
+    }
+
+    // Um ataque contra todos os tabuleiros de uma vez
+    EstadoJogo* alvos[TABULEIROS_BENCHMARK];
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        memcpy(&sequencial[b], &bases[b], sizeof(EstadoJogo));
+        memcpy(&lote[b], &bases[b], sizeof(EstadoJogo));
+        alvos[b] = &lote[b];
+    }
+    for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+        const AtaqueLote ataque = ataques[0][a];
+        Coordenada centro = {ataque.centro / TAMANHO_TABULEIRO, ataque.centro % TAMANHO_TABULEIRO};
+        int acertos = 0;
+        for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+            acertos += resolverAtaque(&sequencial[b], &compiladas[ataque.habilidade], centro, NULL);
+        }
+        identicos &= resolverAtaqueEmTabuleiros(alvos, TABULEIROS_BENCHMARK, &compiladas[ataque.habilidade],
+                                                ataque.centro, NULL, NULL) == acertos;
+    }
+    identicos &= memcmp(sequencial, lote, sizeof(EstadoJogo) * TABULEIROS_BENCHMARK) == 0;
+
+    for (int emLote = 0; emLote <= 1; emLote++) {
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            int b = (int)(it % TABULEIROS_BENCHMARK);
+            EstadoJogo* estado = &lote[b];
+            memcpy(estado, &bases[b], sizeof(EstadoJogo));
+            if (emLote) {
+                soma += resolverAtaquesEmLote(estado, compiladas, ataques[b], ATAQUES_LOTE_BENCHMARK, NULL, NULL);
             } else {
-                printf(" · ");  // Posição não afetada
+                for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+                    Coordenada centro = {ataques[b][a].centro / TAMANHO_TABULEIRO,
+                                         ataques[b][a].centro % TAMANHO_TABULEIRO};
+                    soma += resolverAtaque(estado, &compiladas[ataques[b][a].habilidade], centro, NULL);
+                }
             }
         }
-        printf("\n");
+        ns[emLote] = (tempoAtual() - inicio) * 1e9 / ((double)iteracoes * ATAQUES_LOTE_BENCHMARK);
+        sumidouroBenchmark += soma;
     }
-    printf("\n💡 Legenda: ● = Área atingida, · = Área não atingida\n");
+
+    free(bases);
+    return identicos;
 }
 
-/*
- * ============================================
- * FUNÇÕES DE ENTRADA DE DADOS DO USUÁRIO
- * ============================================
+/**
+ * Mede um ataque contra muitos tabuleiros: resolverAtaqueEmTabuleiros (um
+ * EstadoJogo por tabuleiro) contra o lote SoA com o kernel vetorial em uso
+ * Confere os kernels escalar e vetorial contra resolverAtaque tabuleiro a tabuleiro
+ *
+ * @param ns Saída: ns por tabuleiro e disparo em estados separados [0] e no lote SoA [1]
+ * @return 1 se os estados descarregados forem idênticos byte a byte
  */
+static int medirKernelSoA(long long iteracoes, uint64_t semente, double ns[2]) {
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+    EstadoJogo* bases = malloc(sizeof(EstadoJogo) * 3 * TABULEIROS_BENCHMARK);
+    LoteTabuleirosSoA lote;
+    if (bases == NULL || criarLoteTabuleirosSoA(&lote, TABULEIROS_BENCHMARK) != SUCESSO) {
+        free(bases);
+        return 0;
+    }
+    EstadoJogo* sequencial = bases + TABULEIROS_BENCHMARK;
+    EstadoJogo* descarregados = sequencial + TABULEIROS_BENCHMARK;
+    AtaqueLote ataques[ATAQUES_LOTE_BENCHMARK];
+    GeradorAleatorio gerador;
+    int identicos = 1;
+
+    criarHabilidadesPadrao(compiladas);
+    inicializarGerador(&gerador, semente, 9);
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        inicializarEstadoJogo(&bases[b]);
+        posicionarFrotaUniforme(NULL, &bases[b], &gerador);
+    }
+    for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+        ataques[a].habilidade = (uint8_t)aleatorioLimitado(&gerador, QUANTIDADE_HABILIDADES_PADRAO);
+        ataques[a].centro = (uint8_t)aleatorioLimitado(&gerador, TOTAL_CELULAS);
+    }
+
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        memcpy(&sequencial[b], &bases[b], sizeof(EstadoJogo));
+        for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+            Coordenada centro = {ataques[a].centro / TAMANHO_TABULEIRO, ataques[a].centro % TAMANHO_TABULEIRO};
+            resolverAtaque(&sequencial[b], &compiladas[ataques[a].habilidade], centro, NULL);
+        }
+    }
+    obterKernelLoteSoA();
+    for (int vetorial = 0; vetorial <= 1; vetorial++) {
+        limparLoteTabuleirosSoA(&lote);
+        for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+            carregarTabuleiroSoA(&lote, &bases[b]);
+        }
+        for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+            const HabilidadeCompilada* habilidade = &compiladas[ataques[a].habilidade];
+            if (vetorial) {
+                resolverAtaqueSoA(&lote, habilidade, ataques[a].centro);
+            } else {
+                for (int b = 0; b < lote.quantidade; b++) {
+                    lote.tiros[b] += bitboardContar(habilidade->mascaras[ataques[a].centro]);
+                    lote.turnos[b]++;
+                }
+                resolverFaixasEscalar(&lote, habilidade->mascaras[ataques[a].centro]);
+            }
+        }
+        for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+            memcpy(&descarregados[b], &bases[b], sizeof(EstadoJogo));
+            descarregarTabuleiroSoA(&lote, b, &descarregados[b]);
+        }
+        identicos &= memcmp(sequencial, descarregados, sizeof(EstadoJogo) * TABULEIROS_BENCHMARK) == 0;
+    }
+
+    EstadoJogo* alvos[TABULEIROS_BENCHMARK];
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        alvos[b] = &sequencial[b];
+    }
+    for (int soa = 0; soa <= 1; soa++) {
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            // Cada iteração recomeça das frotas iniciais: cópia dos estados ou recarga do lote
+            if (soa) {
+                limparLoteTabuleirosSoA(&lote);
+                for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+                    carregarTabuleiroSoA(&lote, &bases[b]);
+                }
+            } else {
+                memcpy(sequencial, bases, sizeof(EstadoJogo) * TABULEIROS_BENCHMARK);
+            }
+            for (int a = 0; a < ATAQUES_LOTE_BENCHMARK; a++) {
+                const HabilidadeCompilada* habilidade = &compiladas[ataques[a].habilidade];
+                soma += soa ? resolverAtaqueSoA(&lote, habilidade, ataques[a].centro)
+                            : resolverAtaqueEmTabuleiros(alvos, TABULEIROS_BENCHMARK, habilidade,
+                                                         ataques[a].centro, NULL, NULL);
+            }
+        }
+        ns[soa] = (tempoAtual() - inicio) * 1e9 /
+                  ((double)iteracoes * ATAQUES_LOTE_BENCHMARK * TABULEIROS_BENCHMARK);
+        sumidouroBenchmark += soma;
+    }
+
+    destruirLoteTabuleirosSoA(&lote);
+    free(bases);
+    return identicos;
+}
 
 /**
- * Solicita coordenadas do usuário no formato ColLetra (ex: A5, B3, J9)
+ * Mede o retrocesso de uma jogada: cópia do estado inteiro contra o diário de jogadas
+ * Confere que desfazer restaura o estado original e refazer reproduz o sequencial
  *
- * @param mensagem Mensagem a ser exibida para o usuário
- * @param coord Ponteiro para armazenar a coordenada lida
- * @return 1 se leitura bem-sucedida, 0 caso contrário
+ * @param ns Saída: ns por jogada com cópia [0] e com o diário [1]
+ * @return 1 se os estados forem idênticos byte a byte
  */
-int lerCoordenada(const char* mensagem, Coordenada* coord) {
-    char entrada[10];
-    printf("%s (formato: LetraLinha, ex: A5, B3, J9): ", mensagem);
-
-    if (scanf("%s", entrada) != 1) {
-        printf("❌ Erro na leitura. Tente novamente.\n");
+static int medirKernelDiario(long long iteracoes, uint64_t semente, double ns[2]) {
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+    EstadoJogo* estados = malloc(sizeof(EstadoJogo) * 3);
+    DiarioJogadas* diario = malloc(sizeof(DiarioJogadas));
+    if (estados == NULL || diario == NULL) {
+        free(estados);
+        free(diario);
         return 0;
     }
+    EstadoJogo *base = &estados[0], *sequencial = &estados[1], *estado = &estados[2];
+    AtaqueLote ataques[MAX_TURNOS];
+    GeradorAleatorio gerador;
+    int identicos = 1;
 
-    // Verifica se tem pelo menos 2 caracteres
-    if (strlen(entrada) < 2) {
-        printf("❌ Formato inválido. Use formato LetraLinha (ex: A5).\n");
-        return 0;
+    criarHabilidadesPadrao(compiladas);
+    inicializarGerador(&gerador, semente, 4);
+    inicializarEstadoJogo(base);
+    posicionarFrotaUniforme(NULL, base, &gerador);
+    for (int a = 0; a < MAX_TURNOS; a++) {
+        ataques[a].habilidade = (uint8_t)(a % QUANTIDADE_HABILIDADES_PADRAO);
+        ataques[a].centro = (uint8_t)aleatorioLimitado(&gerador, TOTAL_CELULAS);
     }
 
-    // Converte letra para coluna
-    int coluna = letraParaColuna(entrada[0]);
-    if (coluna == -1) {
-        printf("❌ Coluna inválida. Use letras de A a J.\n");
-        return 0;
+    // Partida inteira: aplica tudo, desfaz tudo, refaz tudo
+    memcpy(sequencial, base, sizeof(EstadoJogo));
+    memcpy(estado, base, sizeof(EstadoJogo));
+    inicializarDiario(diario);
+    for (int a = 0; a < MAX_TURNOS; a++) {
+        Coordenada centro = {ataques[a].centro / TAMANHO_TABULEIRO, ataques[a].centro % TAMANHO_TABULEIRO};
+        identicos &= resolverAtaque(sequencial, &compiladas[ataques[a].habilidade], centro, NULL) ==
+                     aplicarJogadaDiario(estado, diario, compiladas, ataques[a]);
     }
+    identicos &= memcmp(sequencial, estado, sizeof(EstadoJogo)) == 0;
+    while (desfazerJogada(estado, diario) == SUCESSO) {}
+    identicos &= memcmp(base, estado, sizeof(EstadoJogo)) == 0;
+    while (refazerJogada(estado, diario) == SUCESSO) {}
+    identicos &= memcmp(sequencial, estado, sizeof(EstadoJogo)) == 0;
 
-    // Converte número para linha
-    char* endptr;
-    int linha = strtol(&entrada[1], &endptr, 10);
+    // Experimenta cada jogada a partir da metade da partida e volta atrás
+    memcpy(estado, base, sizeof(EstadoJogo));
+    inicializarDiario(diario);
+    for (int a = 0; a < MAX_TURNOS / 2; a++) {
+        aplicarJogadaDiario(estado, diario, compiladas, ataques[a]);
+    }
+    memcpy(sequencial, estado, sizeof(EstadoJogo));
 
-    // Verifica se a conversão foi bem-sucedida e se a linha é válida
-    if (*endptr != '\0' || linha < 0 || linha >= TAMANHO_TABULEIRO) {
-        printf("❌ Linha inválida. Use números de 0 a %d.\n", TAMANHO_TABULEIRO - 1);
-        return 0;
+    for (int comDiario = 0; comDiario <= 1; comDiario++) {
+        EstadoJogo* copia = &estados[0];
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            AtaqueLote ataque = ataques[MAX_TURNOS / 2 + it % (MAX_TURNOS / 2)];
+            if (comDiario) {
+                soma += aplicarJogadaDiario(estado, diario, compiladas, ataque);
+                desfazerJogada(estado, diario);
+            } else {
+                memcpy(copia, estado, sizeof(EstadoJogo));
+                Coordenada centro = {ataque.centro / TAMANHO_TABULEIRO, ataque.centro % TAMANHO_TABULEIRO};
+                soma += resolverAtaque(estado, &compiladas[ataque.habilidade], centro, NULL);
+                memcpy(estado, copia, sizeof(EstadoJogo));
+            }
+        }
+        ns[comDiario] = (tempoAtual() - inicio) * 1e9 / (double)iteracoes;
+        sumidouroBenchmark += soma;
     }
+    identicos &= memcmp(sequencial, estado, sizeof(EstadoJogo)) == 0;
 
-    coord->linha = linha;
-    coord->coluna = coluna;
+    free(estados);
+    free(diario);
+    return identicos;
+}
 
-    printf("✅ Coordenada lida: %c%d (Linha %d, Coluna %d)\n",
-           colunaParaLetra(coluna), linha, linha, coluna);
+/**
+ * Mede a compilação das habilidades padrão: matrizes 5x5 célula a célula x arquivo de padrões
+ * Confere que o texto PADROES_HABILIDADES_PADRAO compila nas mesmas máscaras
+ *
+ * @param ns Saída: ns por conjunto de habilidades pelas matrizes [0] e pelo texto [1]
+ * @return 1 se as máscaras e os nomes forem idênticos
+ */
+static int medirKernelCatalogo(long long iteracoes, double ns[2]) {
+    HabilidadeCompilada padrao[QUANTIDADE_HABILIDADES_PADRAO];
+    CatalogoHabilidades catalogo;
+    int linhaErro;
 
-    return 1;
+    criarHabilidadesPadrao(padrao);
+    int identicos = interpretarPadroesHabilidades(PADROES_HABILIDADES_PADRAO, sizeof(PADROES_HABILIDADES_PADRAO) - 1,
+                                                  &catalogo, &linhaErro) == SUCESSO &&
+                    catalogo.quantidade == QUANTIDADE_HABILIDADES_PADRAO;
+    for (int h = 0; identicos && h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        identicos &= strcmp(padrao[h].nome, catalogo.habilidades[h].nome) == 0 &&
+                     memcmp(padrao[h].mascaras, catalogo.habilidades[h].mascaras, sizeof(padrao[h].mascaras)) == 0;
+    }
+    destruirCatalogoHabilidades(&catalogo);
+
+    for (int arquivo = 0; arquivo <= 1; arquivo++) {
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            if (arquivo) {
+                interpretarPadroesHabilidades(PADROES_HABILIDADES_PADRAO, sizeof(PADROES_HABILIDADES_PADRAO) - 1,
+                                              &catalogo, &linhaErro);
+                soma += (long long)catalogo.habilidades[it % QUANTIDADE_HABILIDADES_PADRAO].mascaras[it % TOTAL_CELULAS].parte[0];
+                destruirCatalogoHabilidades(&catalogo);
+            } else {
+                criarHabilidadesPadrao(padrao);
+                soma += (long long)padrao[it % QUANTIDADE_HABILIDADES_PADRAO].mascaras[it % TOTAL_CELULAS].parte[0];
+            }
+        }
+        ns[arquivo] = (tempoAtual() - inicio) * 1e9 / (double)iteracoes;
+        sumidouroBenchmark += soma;
+    }
+    return identicos;
 }
 
 /**
- * Solicita coordenadas de ataque ao usuário
+ * Mede o hash Zobrist de cada posição de uma partida: recalculado do zero x mantido pelo disparo
+ * Confere a cada ataque que o hash incremental é igual ao recalculado
  *
- * @param nomeHabilidade Nome da habilidade para exibição
- * @param coord Ponteiro para armazenar a coordenada do ataque
- * @return 1 se bem-sucedido, 0 caso contrário
+ * @param ns Saída: ns por posição recalculando [0] e incrementalmente [1]
+ * @return 1 se os hashes conferem em todas as posições
  */
-int lerCoordenadaAtaque(const char* nomeHabilidade, Coordenada* coord) {
-    printf("\n🎯 Escolha onde aplicar a habilidade %s:\n", nomeHabilidade);
-    return lerCoordenada("Coordenada do centro do ataque", coord);
+static int medirKernelZobrist(long long iteracoes, uint64_t semente, double ns[2]) {
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+    EstadoJogo estado;
+    EstadoJogo* posicoes = malloc(sizeof(EstadoJogo) * MAX_TURNOS);
+    ResultadoAtaqueLote disparos[MAX_TURNOS];
+    int afundados[MAX_TURNOS];
+    GeradorAleatorio gerador;
+    int identicos = 1;
+
+    if (posicoes == NULL) {
+        return 0;
+    }
+    criarHabilidadesPadrao(compiladas);
+    inicializarGerador(&gerador, semente, 5);
+    inicializarEstadoJogo(&estado);
+    posicionarFrotaUniforme(NULL, &estado, &gerador);
+    for (int a = 0; a < MAX_TURNOS; a++) {
+        Coordenada centro = {(int)aleatorioLimitado(&gerador, TAMANHO_TABULEIRO),
+                             (int)aleatorioLimitado(&gerador, TAMANHO_TABULEIRO)};
+        EstadoJogo* alvo = &estado;
+        resolverAtaqueEmTabuleiros(&alvo, 1, &compiladas[a % QUANTIDADE_HABILIDADES_PADRAO],
+                                   indiceCelula(centro.linha, centro.coluna), &disparos[a], &afundados[a]);
+        identicos &= estado.hash == calcularHashZobrist(&estado);
+        posicoes[a] = estado;
+    }
+
+    for (int incremental = 0; incremental <= 1; incremental++) {
+        uint64_t soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            int a = (int)(it % MAX_TURNOS);
+            if (incremental) {
+                soma ^= variacaoHashZobrist(disparos[a].acertos, disparos[a].erros, afundados[a]);
+            } else {
+                soma ^= calcularHashZobrist(&posicoes[a]);
+            }
+        }
+        ns[incremental] = (tempoAtual() - inicio) * 1e9 / (double)iteracoes;
+        sumidouroBenchmark += (long long)(soma & 0xFFFF);
+    }
+    free(posicoes);
+    return identicos;
 }
 
 /**
- * Solicita orientação do navio ao usuário
+ * Mede o posicionamento da frota padrão pelos dois caminhos
+ * Cada iteração tenta posicionar 4 navios aleatórios em um tabuleiro vazio
  *
- * @return Caractere da orientação ('H', 'V' ou 'D') ou 0 se inválida
+ * @return 1 se os dois caminhos produziram o mesmo resultado
  */
-char lerOrientacao() {
-    char orientacao;
-    printf("Orientação do navio:\n");
-    printf("  H - Horizontal (→)\n");
-    printf("  V - Vertical (↓)\n");
-    printf("  D - Diagonal (↘)\n");
-    printf("Escolha (H/V/D): ");
+static int medirKernelPosicionamento(long long iteracoes, uint64_t semente,
+                                     double* nsGenerico, double* nsEspecializado) {
+    enum { TENTATIVAS = 1024 };
+    static const char orientacoes[] = {'H', 'V', 'D'};
+    Navio tentativas[TENTATIVAS];
+    GeradorAleatorio gerador;
+    int tabA[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], tabB[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    int identicos = 1;
 
-    scanf(" %c", &orientacao);
+    inicializarGerador(&gerador, semente, 1);
+    for (int t = 0; t < TENTATIVAS; t++) {
+        Navio navio = {{(int)aleatorioLimitado(&gerador, TAMANHO_TABULEIRO),
+                        (int)aleatorioLimitado(&gerador, TAMANHO_TABULEIRO)},
+                       TAMANHOS_NAVIOS[t % MAX_NAVIOS], orientacoes[aleatorioLimitado(&gerador, 3)],
+                       t % MAX_NAVIOS + 1, 0, TAMANHOS_NAVIOS[t % MAX_NAVIOS]};
+        tentativas[t] = navio;
+    }
 
-    // Converte para maiúscula
-    if (orientacao >= 'a' && orientacao <= 'z') {
-        orientacao = orientacao - 'a' + 'A';
+    for (int t = 0; t < TENTATIVAS; t += MAX_NAVIOS) {
+        inicializarTabuleiro(tabA);
+        inicializarTabuleiro(tabB);
+        for (int n = 0; n < MAX_NAVIOS; n++) {
+            identicos &= posicionarNavio(tabA, tentativas[t + n]) == posicionarNavioEspecializado(tabB, tentativas[t + n]);
+        }
+        identicos &= memcmp(tabA, tabB, sizeof(tabA)) == 0;
     }
 
-    if (orientacao == 'H' || orientacao == 'V' || orientacao == 'D') {
-        printf("✅ Orientação selecionada: %c\n", orientacao);
-        return orientacao;
-    } else {
-        printf("❌ Orientação inválida. Use H, V ou D.\n");
-        return 0;
+    for (int especializado = 0; especializado <= 1; especializado++) {
+        long long soma = 0;
+        double inicio = tempoAtual();
+        for (long long it = 0; it < iteracoes; it++) {
+            int base = (int)(it % (TENTATIVAS / MAX_NAVIOS)) * MAX_NAVIOS;
+            inicializarTabuleiro(tabA);
+            for (int n = 0; n < MAX_NAVIOS; n++) {
+                soma += especializado ? posicionarNavioEspecializado(tabA, tentativas[base + n])
+                                      : posicionarNavio(tabA, tentativas[base + n]);
+            }
+        }
+        double ns = (tempoAtual() - inicio) * 1e9 / ((double)iteracoes * MAX_NAVIOS);
+        sumidouroBenchmark += soma;
+        if (especializado) {
+            *nsEspecializado = ns;
+        } else {
+            *nsGenerico = ns;
+        }
     }
+
+    return identicos;
 }
 
 /**
- * Solicita ao usuário o posicionamento manual de todos os navios
+ * Executa o benchmark comparando kernels especializados e caminho genérico
  *
- * @param tabuleiro Matriz do tabuleiro
- * @param navios Array de navios a serem posicionados
- * @param quantidadeNavios Quantidade de navios a posicionar
- * @return 1 se todos os navios foram posicionados, 0 caso contrário
+ * @param iteracoes Iterações por medição
+ * @param semente Semente dos cenários
+ * @return 0 se todos os caminhos produziram resultados idênticos
  */
-int posicionarNaviosManualmente(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
-                               Navio navios[], int quantidadeNavios) {
+int executarBenchmarkKernels(long long iteracoes, uint64_t semente) {
+    int habilidades[QUANTIDADE_HABILIDADES_PADRAO][TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+    criarHabilidadeCone(habilidades[HABILIDADE_CONE]);
+    criarHabilidadeCruz(habilidades[HABILIDADE_CRUZ]);
+    criarHabilidadeOctaedro(habilidades[HABILIDADE_OCTAEDRO]);
+
+    if (!conferirPadroesEspecializados()) {
+        fprintf(stderr, "❌ Os padrões PADRAO_* não conferem com criarHabilidade*.\n");
+        return 1;
+    }
 
-    // Definição dos tamanhos dos navios
-    int tamanhosNavios[] = {4, 3, 3, 2}; // Battleship, Cruiser, Cruiser, Destroyer
-    char* nomesNavios[] = {"Battleship", "Cruiser 1", "Cruiser 2", "Destroyer"};
+    CenariosBenchmark* cenarios = malloc(sizeof(CenariosBenchmark));
+    if (cenarios == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para o benchmark.\n");
+        return 1;
+    }
+    prepararCenariosBenchmark(cenarios, semente);
 
-    printf("\n╔════════════════════════════════════════════════╗\n");
-    printf("║          POSICIONAMENTO MANUAL DOS NAVIOS      ║\n");
-    printf("╚════════════════════════════════════════════════╝\n");
-    printf("🎯 Você precisa posicionar %d navios no tabuleiro.\n\n", quantidadeNavios);
+    printf("\n╔══════════════════════════════════════════════════════╗\n");
+    printf("║     KERNELS ESPECIALIZADOS x CAMINHO GENÉRICO        ║\n");
+    printf("╚══════════════════════════════════════════════════════╝\n");
+    printf("%-22s %12s %14s %9s %s\n", "Operação", "Genérico", "Especializado", "Ganho", "Resultado");
+
+    int todosIdenticos = 1;
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        double nsGenerico = 0, nsEspecializado = 0;
+        int identicos = medirKernelHabilidade(cenarios, h, habilidades[h], iteracoes, &nsGenerico, &nsEspecializado);
+        todosIdenticos &= identicos;
+        printf("habilidade %-11s %9.1f ns %11.1f ns %8.2fx %s\n", NOMES_HABILIDADES_PADRAO[h],
+               nsGenerico, nsEspecializado, nsGenerico / nsEspecializado, identicos ? "✅ idêntico" : "❌ divergente");
+    }
+
+    double nsGenerico = 0, nsEspecializado = 0;
+    int identicos = medirKernelPosicionamento(iteracoes * 25, semente, &nsGenerico, &nsEspecializado);
+    todosIdenticos &= identicos;
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", "posicionarNavio",
+           nsGenerico, nsEspecializado, nsGenerico / nsEspecializado, identicos ? "✅ idêntico" : "❌ divergente");
+
+    // Melhor ataque da IA: máscaras por centro x convolução escalar x convolução vetorial
+    double nsConvolucao[3];
+    identicos = medirKernelConvolucao(cenarios, iteracoes, nsConvolucao);
+    todosIdenticos &= identicos;
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", "melhorAtaque/escalar",
+           nsConvolucao[0], nsConvolucao[1], nsConvolucao[0] / nsConvolucao[1], identicos ? "✅ idêntico" : "❌ divergente");
+    char rotulo[32];
+    snprintf(rotulo, sizeof(rotulo), "melhorAtaque/%s", obterKernelConvolucao());
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", rotulo,
+           nsConvolucao[0], nsConvolucao[2], nsConvolucao[0] / nsConvolucao[2], identicos ? "✅ idêntico" : "❌ divergente");
+
+    double nsLote[2];
+    identicos = medirKernelLote(iteracoes * 4, semente, nsLote);
+    todosIdenticos &= identicos;
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", "ataques em lote",
+           nsLote[0], nsLote[1], nsLote[0] / nsLote[1], identicos ? "✅ idêntico" : "❌ divergente");
+
+    double nsSoA[2];
+    identicos = medirKernelSoA(iteracoes / 4 + 1, semente, nsSoA);
+    todosIdenticos &= identicos;
+    snprintf(rotulo, sizeof(rotulo), "tabuleiros SoA/%s", obterKernelLoteSoA());
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", rotulo,
+           nsSoA[0], nsSoA[1], nsSoA[0] / nsSoA[1], identicos ? "✅ idêntico" : "❌ divergente");
+
+    double nsDiario[2];
+    identicos = medirKernelDiario(iteracoes * 16, semente, nsDiario);
+    todosIdenticos &= identicos;
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", "jogada e retrocesso",
+           nsDiario[0], nsDiario[1], nsDiario[0] / nsDiario[1], identicos ? "✅ idêntico" : "❌ divergente");
+
+    double nsZobrist[2];
+    identicos = medirKernelZobrist(iteracoes * 16, semente, nsZobrist);
+    todosIdenticos &= identicos;
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", "hash Zobrist",
+           nsZobrist[0], nsZobrist[1], nsZobrist[0] / nsZobrist[1], identicos ? "✅ idêntico" : "❌ divergente");
+
+    double nsCatalogo[2];
+    identicos = medirKernelCatalogo(iteracoes / 10 + 1, nsCatalogo);
+    todosIdenticos &= identicos;
+    printf("%-22s %9.1f ns %11.1f ns %8.2fx %s\n", "compilar habilidades",
+           nsCatalogo[0], nsCatalogo[1], nsCatalogo[0] / nsCatalogo[1], identicos ? "✅ idêntico" : "❌ divergente");
+
+    free(cenarios);
+    return todosIdenticos ? 0 : 1;
+}
+
+/*
+ * ============================================
+ * SUÍTE DE MICRO-BENCHMARKS
+ * ============================================
+ */
+
+#define REPETICOES_BENCHMARK 7
+#define TEMPO_MINIMO_REPETICAO 0.02     // segundos por repetição depois da calibração
+
+/**
+ * Primitiva medida pela suíte
+ * executar roda "iteracoes" vezes e retorna quantas operações realizou
+ */
+typedef struct {
+    const char* nome;
+    long long (*executar)(void* contexto, long long iteracoes);
+    void* contexto;
+} PrimitivaBenchmark;
+
+/**
+ * Resultado de uma primitiva (mediana e mínimo entre as repetições)
+ */
+typedef struct {
+    const char* nome;
+    long long operacoes;
+    double nsMediana;
+    double nsMinimo;
+    double ciclosMediana;
+} ResultadoBenchmark;
 
-    // Exibe tabuleiro inicial vazio
-    exibirTabuleiro(tabuleiro);
+/**
+ * Contexto compartilhado pelas primitivas: cenários fixos gerados pela semente
+ */
+typedef struct {
+    CenariosBenchmark* cenarios;
+    int habilidades[QUANTIDADE_HABILIDADES_PADRAO][TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+    HabilidadeCompilada compiladas[QUANTIDADE_HABILIDADES_PADRAO];
+    Navio tentativas[1024];
+    int tabuleirosComAcertos[TABULEIROS_BENCHMARK][TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    GeradorAleatorio gerador;
+    PoolPartidas pool;
+    int tipo;
+} ContextoBenchmark;
 
-    for (int i = 0; i < quantidadeNavios; i++) {
-        printf("\n" "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
-        printf("🚢 POSICIONANDO NAVIO %d: %s (Tamanho: %d)\n", i + 1, nomesNavios[i], tamanhosNavios[i]);
-        printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+// Uma primitiva por habilidade precisa de um contexto próprio com o tipo
+typedef struct {
+    ContextoBenchmark* base;
+    int tipo;
+} ContextoHabilidadeBenchmark;
 
-        int navioPositionado = 0;
-        int tentativas = 0;
-        const int maxTentativas = 5;
+static long long benchInicializarTabuleiro(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    int (*tabuleiro)[TAMANHO_TABULEIRO] = ctx->tabuleirosComAcertos[0];
+    for (long long i = 0; i < iteracoes; i++) {
+        inicializarTabuleiro(tabuleiro);
+        tabuleiro[i % TAMANHO_TABULEIRO][0] = POSICAO_NAVIO;   // Evita que o memset seja eliminado
+    }
+    sumidouroBenchmark += tabuleiro[0][0];
+    return iteracoes;
+}
 
-        while (!navioPositionado && tentativas < maxTentativas) {
-            tentativas++;
+static long long executarPosicionamentos(ContextoBenchmark* ctx, long long iteracoes, int especializado) {
+    int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        int base = (int)(it % (1024 / MAX_NAVIOS)) * MAX_NAVIOS;
+        inicializarTabuleiro(tabuleiro);
+        for (int n = 0; n < MAX_NAVIOS; n++) {
+            soma += especializado ? posicionarNavioEspecializado(tabuleiro, ctx->tentativas[base + n])
+                                  : posicionarNavio(tabuleiro, ctx->tentativas[base + n]);
+        }
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes * MAX_NAVIOS;
+}
 
-            Coordenada inicio;
-            char orientacao;
+static long long benchPosicionarNavio(void* contexto, long long iteracoes) {
+    return executarPosicionamentos(contexto, iteracoes, 0);
+}
 
-            printf("\n🎯 Tentativa %d de %d:\n", tentativas, maxTentativas);
+static long long benchPosicionarNavioEspecializado(void* contexto, long long iteracoes) {
+    return executarPosicionamentos(contexto, iteracoes, 1);
+}
 
-            // Lê coordenada inicial
-            if (!lerCoordenada("Digite a posição inicial", &inicio)) {
-                printf("⚠️  Tente novamente.\n");
-                continue;
-            }
+static long long executarHabilidade(ContextoHabilidadeBenchmark* ctx, long long iteracoes, int especializado) {
+    int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
+    Navio navios[MAX_NAVIOS];
+    EstatisticasJogo stats;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        soma += varrerCentros(ctx->base->cenarios, (int)(it % TABULEIROS_BENCHMARK), ctx->tipo,
+                              ctx->base->habilidades[ctx->tipo], especializado, tabuleiro, navios, &stats);
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes * TOTAL_CELULAS;
+}
 
-            // Lê orientação
-            orientacao = lerOrientacao();
-            if (orientacao == 0) {
-                printf("⚠️  Tente novamente.\n");
-                continue;
-            }
+static long long benchAplicarHabilidade(void* contexto, long long iteracoes) {
+    return executarHabilidade(contexto, iteracoes, 0);
+}
 
-            // Configura o navio
-            navios[i].inicio = inicio;
-            navios[i].tamanho = tamanhosNavios[i];
-            navios[i].orientacao = orientacao;
-            navios[i].id = i + 1;
-            navios[i].foiDestruido = 0; // Inicializa o status do navio
+static long long benchAplicarHabilidadeEspecializada(void* contexto, long long iteracoes) {
+    return executarHabilidade(contexto, iteracoes, 1);
+}
 
-            // Tenta posicionar
-            int resultado = posicionarNavio(tabuleiro, navios[i]);
+static long long benchResolverAtaqueBits(void* contexto, long long iteracoes) {
+    ContextoHabilidadeBenchmark* ctx = contexto;
+    EstadoJogo estado;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        inicializarEstadoJogo(&estado);
+        posicionarFrotaUniforme(NULL, &estado, &ctx->base->gerador);
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            Coordenada centro = {c / TAMANHO_TABULEIRO, c % TAMANHO_TABULEIRO};
+            soma += resolverAtaque(&estado, &ctx->base->compiladas[ctx->tipo], centro, NULL);
+        }
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes * TOTAL_CELULAS;
+}
 
-            switch (resultado) {
-                case SUCESSO:
-                    printf("✅ %s posicionado com sucesso em %c%d!\n",
-                           nomesNavios[i], colunaParaLetra(inicio.coluna), inicio.linha);
-                    navioPositionado = 1;
+static long long benchVerificarNaviosDestruidos(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    Navio navios[MAX_NAVIOS];
+    EstatisticasJogo stats;
+    inicializarEstatisticas(&stats);
+    for (long long it = 0; it < iteracoes; it++) {
+        int b = (int)(it % TABULEIROS_BENCHMARK);
+        memcpy(navios, ctx->cenarios->navios[b], sizeof(navios));
+        verificarNaviosDestruidos(ctx->tabuleirosComAcertos[b], navios, MAX_NAVIOS, &stats, NULL);
+    }
+    sumidouroBenchmark += stats.naviosDestruidos;
+    return iteracoes;
+}
 
-                    // Exibe tabuleiro atualizado
-                    exibirTabuleiro(tabuleiro);
-                    break;
+static long long benchSortearFrota(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    EstadoJogo estado;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        inicializarEstadoJogo(&estado);
+        soma += posicionarFrotaUniforme(NULL, &estado, &ctx->gerador);
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes;
+}
 
-                case ERRO_FORA_LIMITES:
-                    printf("❌ Erro: O navio sai dos limites do tabuleiro nesta posição!\n");
-                    printf("💡 Dica: Considere a direção do navio e o tamanho (%d células).\n", tamanhosNavios[i]);
-                    break;
+static long long benchPartidaCompleta(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    const int quantidadeHabilidades = QUANTIDADE_HABILIDADES_PADRAO;
+    EstrategiaPosicionamento posicionamento = {"uniforme", posicionarFrotaUniforme, NULL};
+    EstrategiaAtaque ataque = {"aleatorio", escolherAtaqueAleatorio, (void*)&quantidadeHabilidades, 0};
+    EstadoJogo estado;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        soma += simularPartida(&estado, &posicionamento, &ataque, ctx->compiladas, &ctx->gerador, NULL);
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes;
+}
 
-                case ERRO_POSICAO_OCUPADA:
-                    printf("❌ Erro: Há outro navio bloqueando esta posição!\n");
-                    printf("💡 Dica: Escolha uma área livre no tabuleiro.\n");
-                    break;
+static long long benchPartidaDensidade(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    EstrategiaPosicionamento posicionamento = {"uniforme", posicionarFrotaUniforme, NULL};
+    ContextoAtaqueDensidade* contextoDensidade = malloc(sizeof(ContextoAtaqueDensidade));
+    if (contextoDensidade == NULL) {
+        return 0;
+    }
+    EstrategiaAtaque ataque = criarAtaqueDensidade(contextoDensidade, ctx->compiladas, QUANTIDADE_HABILIDADES_PADRAO);
+    EstadoJogo estado;
+    long long turnos = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        turnos += simularPartida(&estado, &posicionamento, &ataque, ctx->compiladas, &ctx->gerador, NULL);
+    }
+    free(contextoDensidade);
+    sumidouroBenchmark += turnos;
+    return turnos;  // Uma operação = uma decisão da IA mais a resolução do ataque
+}
 
-                default:
-                    printf("❌ Erro desconhecido ao posicionar o navio.\n");
-                    break;
-            }
-        }
+static long long benchRenderizarTabuleiro(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    BufferQuadro quadro;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        quadroLimpar(&quadro);
+        renderizarTabuleiro(&quadro, ctx->tabuleirosComAcertos[it % TABULEIROS_BENCHMARK]);
+        soma += (long long)quadro.tamanho;
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes;
+}
 
-        if (!navioPositionado) {
-            printf("❌ Não foi possível posicionar o %s após %d tentativas.\n", nomesNavios[i], maxTentativas);
-            printf("🔄 Reinicie o jogo e tente novamente.\n");
-            return 0;
-        }
+// Alterna entre o tabuleiro intacto e o atingido: cada quadro redesenha os acertos
+static long long benchRenderizarDiferenca(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    RenderizadorDiferencial renderizador;
+    BufferQuadro quadro;
+    long long soma = 0;
+    inicializarRenderizadorDiferencial(&renderizador);
+    for (long long it = 0; it < iteracoes; it++) {
+        int b = (int)((it / 2) % TABULEIROS_BENCHMARK);
+        quadroLimpar(&quadro);
+        soma += renderizarDiferenca(&renderizador, &quadro,
+                                    (it & 1) ? ctx->tabuleirosComAcertos[b] : ctx->cenarios->tabuleiros[b]);
     }
+    sumidouroBenchmark += soma;
+    return iteracoes;
+}
 
-    printf("\n🎉 Todos os navios foram posicionados com sucesso!\n");
-    return 1;
+// Ciclo de vida de uma partida de tabuleiro dinâmico: alocação geral contra pool + arena
+static long long benchPartidaMalloc(void* contexto, long long iteracoes) {
+    (void)contexto;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        TabuleiroDinamico* tab = criarTabuleiroDinamico(LINHAS_PARTIDA_BENCHMARK, LINHAS_PARTIDA_BENCHMARK, MAX_NAVIOS,
+                                                        celulasFrota(TAMANHOS_NAVIOS, MAX_NAVIOS));
+        EstatisticasJogo* stats = malloc(sizeof(EstatisticasJogo));
+        soma += tab != NULL && stats != NULL;
+        free(stats);
+        destruirTabuleiroDinamico(tab);
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes;
 }
 
-/*
- * ============================================
- * SISTEMA DE COMBATE E APLICAÇÃO DE HABILIDADES
- * ============================================
- */
+static long long benchPartidaPool(void* contexto, long long iteracoes) {
+    ContextoBenchmark* ctx = contexto;
+    long long soma = 0;
+    for (long long it = 0; it < iteracoes; it++) {
+        int indice = adquirirPartidaPool(&ctx->pool);
+        ArenaPartida* arena = arenaPartidaPool(&ctx->pool, indice);
+        TabuleiroDinamico* tab = criarTabuleiroDinamicoNaArena(arena, LINHAS_PARTIDA_BENCHMARK,
+                                                               LINHAS_PARTIDA_BENCHMARK, MAX_NAVIOS,
+                                                               celulasFrota(TAMANHOS_NAVIOS, MAX_NAVIOS));
+        EstatisticasJogo* stats = alocarArena(arena, sizeof(EstatisticasJogo), _Alignof(EstatisticasJogo));
+        soma += tab != NULL && stats != NULL;
+        liberarPartidaPool(&ctx->pool, indice);
+    }
+    sumidouroBenchmark += soma;
+    return iteracoes;
+}
 
+static int compararDouble(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
 
 /**
- * Verifica todos os navios para ver se algum foi destruído após um ataque.
- * Atualiza as estatísticas e o status do navio se for o caso.
+ * Mede uma primitiva: calibra as iterações e repete a medição
+ * A calibração dobra as iterações até uma repetição durar TEMPO_MINIMO_REPETICAO
  *
- * @param tabuleiro Matriz do tabuleiro do jogo.
- * @param navios Array com os navios do jogo.
- * @param quantidadeNavios Número total de navios.
- * @param stats Ponteiro para as estatísticas do jogo.
+ * @param primitiva Primitiva a ser medida
+ * @param resultado Saída: mediana, mínimo e ciclos por operação
  */
-void verificarNaviosDestruidos(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO], Navio navios[], int quantidadeNavios, EstatisticasJogo* stats) {
-    for (int i = 0; i < quantidadeNavios; i++) {
-        // Pula a verificação se o navio já foi marcado como destruído
-        if (navios[i].foiDestruido) {
-            continue;
+static void medirPrimitiva(const PrimitivaBenchmark* primitiva, ResultadoBenchmark* resultado) {
+    long long iteracoes = 1;
+    for (;;) {
+        double inicio = tempoAtual();
+        primitiva->executar(primitiva->contexto, iteracoes);
+        if (tempoAtual() - inicio >= TEMPO_MINIMO_REPETICAO || iteracoes >= (1LL << 40)) {
+            break;
         }
+        iteracoes *= 2;
+    }
 
-        int partesAtingidas = 0;
-        Coordenada coordAtual = navios[i].inicio;
+    double ns[REPETICOES_BENCHMARK], ciclos[REPETICOES_BENCHMARK];
+    long long operacoes = 0;
+    for (int r = 0; r < REPETICOES_BENCHMARK; r++) {
+        uint64_t ciclosInicio = lerCiclos();
+        double inicio = tempoAtual();
+        operacoes = primitiva->executar(primitiva->contexto, iteracoes);
+        double segundos = tempoAtual() - inicio;
+        uint64_t ciclosGastos = lerCiclos() - ciclosInicio;
 
-        // Itera por todas as coordenadas que o navio ocupa
-        for (int j = 0; j < navios[i].tamanho; j++) {
-            if (coordenadaValida(coordAtual.linha, coordAtual.coluna) &&
-                tabuleiro[coordAtual.linha][coordAtual.coluna] == POSICAO_ATINGIDA) {
-                partesAtingidas++;
-            }
-            // Calcula a próxima coordenada do navio
-            proximaCoordenada(&coordAtual, navios[i].orientacao);
-        }
+        ns[r] = segundos * 1e9 / (double)operacoes;
+        ciclos[r] = (double)ciclosGastos / (double)operacoes;
+    }
+    qsort(ns, REPETICOES_BENCHMARK, sizeof(double), compararDouble);
+    qsort(ciclos, REPETICOES_BENCHMARK, sizeof(double), compararDouble);
 
-        // Se o número de partes atingidas for igual ao tamanho do navio, ele foi destruído
-        if (partesAtingidas == navios[i].tamanho) {
-            printf("\n🎉 NAVIO DESTRUÍDO! O navio '%s' foi completamente afundado!\n", (navios[i].id == 1 ? "Battleship" : (navios[i].id <= 3 ? "Cruiser" : "Destroyer")));
-            navios[i].foiDestruido = 1; // Marca como destruído para não contar de novo
-            stats->naviosDestruidos++;  // Incrementa o contador de estatísticas
+    resultado->nome = primitiva->nome;
+    resultado->operacoes = operacoes;
+    resultado->nsMediana = ns[REPETICOES_BENCHMARK / 2];
+    resultado->nsMinimo = ns[0];
+    resultado->ciclosMediana = CONTADOR_CICLOS_DISPONIVEL ? ciclos[REPETICOES_BENCHMARK / 2] : -1;
+}
+
+/**
+ * Exibe os resultados como tabela legível
+ * A coluna dos nomes acompanha o nome mais longo (todos são ASCII)
+ */
+static void exibirResultadosBenchmark(const ResultadoBenchmark resultados[], int quantidade) {
+    int largura = (int)strlen("primitiva");
+    for (int i = 0; i < quantidade; i++) {
+        int comprimento = (int)strlen(resultados[i].nome);
+        largura = comprimento > largura ? comprimento : largura;
+    }
+
+    printf("\n╔══════════════════════════════════════════════════════════════════╗\n");
+    printf("║                 MICRO-BENCHMARKS DAS PRIMITIVAS                  ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════╝\n");
+    printf("%-*s %11s %11s %14s %10s\n", largura, "primitiva", "ns/op", "mín ns/op", "ops/s", "ciclos/op");
+    for (int i = 0; i < quantidade; i++) {
+        const ResultadoBenchmark* r = &resultados[i];
+        printf("%-*s %11.1f %11.1f %14.0f ", largura, r->nome, r->nsMediana, r->nsMinimo, 1e9 / r->nsMediana);
+        if (r->ciclosMediana >= 0) {
+            printf("%10.1f\n", r->ciclosMediana);
+        } else {
+            printf("%10s\n", "-");
         }
     }
 }
 
+/**
+ * Emite os resultados em JSON para acompanhamento de regressões entre versões
+ */
+static void emitirResultadosJson(const ResultadoBenchmark resultados[], int quantidade, uint64_t semente) {
+    printf("{\n");
+    printf("  \"versao\": \"%s\",\n", VERSAO_SISTEMA);
+    printf("  \"semente\": %llu,\n", (unsigned long long)semente);
+    printf("  \"repeticoes\": %d,\n", REPETICOES_BENCHMARK);
+    printf("  \"eventos_compilados\": %d,\n", BATALHA_EVENTOS);
+    printf("  \"resultados\": [\n");
+    for (int i = 0; i < quantidade; i++) {
+        const ResultadoBenchmark* r = &resultados[i];
+        printf("    {\"nome\": \"%s\", \"operacoes\": %lld, \"ns_por_op\": %.3f, \"ns_por_op_min\": %.3f, "
+               "\"ops_por_s\": %.1f, \"ciclos_por_op\": ",
+               r->nome, r->operacoes, r->nsMediana, r->nsMinimo, 1e9 / r->nsMediana);
+        if (r->ciclosMediana >= 0) {
+            printf("%.2f}", r->ciclosMediana);
+        } else {
+            printf("null}");
+        }
+        printf("%s\n", i + 1 < quantidade ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
 
 /**
- * Aplica uma habilidade no tabuleiro em uma coordenada específica
- * Versão otimizada com melhor feedback e controle de erros
+ * Executa a suíte de micro-benchmarks (--benchmark)
  *
- * @param tabuleiro Matriz do tabuleiro
- * @param habilidade Matriz da habilidade a ser aplicada
- * @param centroLinha Linha central onde a habilidade será aplicada
- * @param centroColuna Coluna central onde a habilidade será aplicada
- * @param nomeHabilidade Nome da habilidade para exibição
- * @param navios Array com todos os navios para verificação de destruição
- * @param quantidadeNavios Número total de navios no array
- * @param stats Ponteiro para estatísticas do jogo
+ * @param json 1 para emitir JSON, 0 para tabela
+ * @param semente Semente dos cenários (mesma semente, mesmos dados)
+ * @return 0 se bem-sucedido
  */
-void aplicarHabilidadeNoTabuleiro(int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO],
-                                  int habilidade[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE],
-                                  int centroLinha, int centroColuna,
-                                  const char* nomeHabilidade,
-                                  Navio navios[], int quantidadeNavios,
-                                  EstatisticasJogo* stats) {
+int executarSuiteBenchmarks(int json, uint64_t semente) {
+    static const char orientacoes[] = {'H', 'V', 'D'};
+    ContextoBenchmark* ctx = malloc(sizeof(ContextoBenchmark));
+    if (ctx == NULL || (ctx->cenarios = malloc(sizeof(CenariosBenchmark))) == NULL) {
+        fprintf(stderr, "❌ Memória insuficiente para o benchmark.\n");
+        free(ctx);
+        return 1;
+    }
 
-    const int deslocamento = TAMANHO_HABILIDADE / 2;
-    int acertosNesteTiro = 0;
-    int tirosNesteTurno = 0;
+    size_t bytesPartida = tamanhoTabuleiroDinamico(LINHAS_PARTIDA_BENCHMARK, LINHAS_PARTIDA_BENCHMARK, MAX_NAVIOS,
+                                                   celulasFrota(TAMANHOS_NAVIOS, MAX_NAVIOS)) +
+                          sizeof(EstatisticasJogo) + TAMANHO_LINHA_CACHE;
+    if (criarPoolPartidas(&ctx->pool, 1, bytesPartida) != SUCESSO) {
+        fprintf(stderr, "❌ Memória insuficiente para o benchmark.\n");
+        free(ctx->cenarios);
+        free(ctx);
+        return 1;
+    }
 
-    printf("\n╔══════════════════════════════════════╗\n");
-    printf("║    APLICANDO HABILIDADE: %-11s ║\n", nomeHabilidade);
-    printf("╚══════════════════════════════════════╝\n");
-    printf("🎯 Centro do ataque: %c%d\n", colunaParaLetra(centroColuna), centroLinha);
-    printf("📍 Posições atingidas:\n\n");
+    prepararCenariosBenchmark(ctx->cenarios, semente);
+    criarHabilidadeCone(ctx->habilidades[HABILIDADE_CONE]);
+    criarHabilidadeCruz(ctx->habilidades[HABILIDADE_CRUZ]);
+    criarHabilidadeOctaedro(ctx->habilidades[HABILIDADE_OCTAEDRO]);
+    criarHabilidadesPadrao(ctx->compiladas);
+    inicializarGerador(&ctx->gerador, semente, 1);
 
-    // Aplica a habilidade com loops otimizados
-    for (int i = 0; i < TAMANHO_HABILIDADE; i++) {
-        for (int j = 0; j < TAMANHO_HABILIDADE; j++) {
-            if (habilidade[i][j] == AREA_AFETADA) {
-                int linhaTab = centroLinha - deslocamento + i;
-                int colunaTab = centroColuna - deslocamento + j;
-
-                if (coordenadaValida(linhaTab, colunaTab)) {
-                    tirosNesteTurno++;
-                    printf("   [%c%d] → ", colunaParaLetra(colunaTab), linhaTab);
-
-                    if (tabuleiro[linhaTab][colunaTab] == POSICAO_NAVIO) {
-                        printf("💥 ACERTO! Navio atingido!\n");
-                        tabuleiro[linhaTab][colunaTab] = POSICAO_ATINGIDA;
-                        acertosNesteTiro++;
-                    } else if (tabuleiro[linhaTab][colunaTab] == POSICAO_VAZIA) {
-                        printf("🌊 Água - Tiro na água\n");
-                        tabuleiro[linhaTab][colunaTab] = POSICAO_AGUA_ATINGIDA;
-                    } else if (tabuleiro[linhaTab][colunaTab] == POSICAO_ATINGIDA) {
-                        printf("🔄 Já atingido anteriormente\n");
-                    } else {
-                        printf("🌊 Água já atingida\n");
-                    }
-                }
+    for (int t = 0; t < 1024; t++) {
+        Navio navio = {{(int)aleatorioLimitado(&ctx->gerador, TAMANHO_TABULEIRO),
+                        (int)aleatorioLimitado(&ctx->gerador, TAMANHO_TABULEIRO)},
+                       TAMANHOS_NAVIOS[t % MAX_NAVIOS], orientacoes[aleatorioLimitado(&ctx->gerador, 3)],
+                       t % MAX_NAVIOS + 1, 0, TAMANHOS_NAVIOS[t % MAX_NAVIOS]};
+        ctx->tentativas[t] = navio;
+    }
+
+    // Tabuleiros com metade das células de navio atingidas para verificarNaviosDestruidos
+    for (int b = 0; b < TABULEIROS_BENCHMARK; b++) {
+        memcpy(ctx->tabuleirosComAcertos[b], ctx->cenarios->tabuleiros[b], sizeof(ctx->tabuleirosComAcertos[b]));
+        for (int c = 0; c < TOTAL_CELULAS; c++) {
+            int* celula = &ctx->tabuleirosComAcertos[b][c / TAMANHO_TABULEIRO][c % TAMANHO_TABULEIRO];
+            if (*celula == POSICAO_NAVIO && (aleatorioLimitado(&ctx->gerador, 2) == 0)) {
+                *celula = POSICAO_ATINGIDA;
             }
         }
     }
 
-    // Verifica se algum navio foi destruído após a rodada de ataques
-    if (acertosNesteTiro > 0) {
-        verificarNaviosDestruidos(tabuleiro, navios, quantidadeNavios, stats);
+    ContextoHabilidadeBenchmark porHabilidade[QUANTIDADE_HABILIDADES_PADRAO];
+    for (int h = 0; h < QUANTIDADE_HABILIDADES_PADRAO; h++) {
+        porHabilidade[h].base = ctx;
+        porHabilidade[h].tipo = h;
     }
 
-    // Atualiza estatísticas se fornecidas
-    if (stats != NULL) {
-        stats->totalTiros += tirosNesteTurno;
-        stats->acertos += acertosNesteTiro;
-        stats->erros += (tirosNesteTurno - acertosNesteTiro);
+    PrimitivaBenchmark primitivas[] = {
+        {"inicializarTabuleiro", benchInicializarTabuleiro, ctx},
+        {"posicionarNavio", benchPosicionarNavio, ctx},
+        {"posicionarNavio/especializado", benchPosicionarNavioEspecializado, ctx},
+        {"aplicarHabilidadeNoTabuleiro/CONE", benchAplicarHabilidade, &porHabilidade[HABILIDADE_CONE]},
+        {"aplicarHabilidadeNoTabuleiro/CRUZ", benchAplicarHabilidade, &porHabilidade[HABILIDADE_CRUZ]},
+        {"aplicarHabilidadeNoTabuleiro/OCTAEDRO", benchAplicarHabilidade, &porHabilidade[HABILIDADE_OCTAEDRO]},
+        {"aplicarHabilidade/especializada/CONE", benchAplicarHabilidadeEspecializada, &porHabilidade[HABILIDADE_CONE]},
+        {"aplicarHabilidade/especializada/CRUZ", benchAplicarHabilidadeEspecializada, &porHabilidade[HABILIDADE_CRUZ]},
+        {"aplicarHabilidade/especializada/OCTAEDRO", benchAplicarHabilidadeEspecializada, &porHabilidade[HABILIDADE_OCTAEDRO]},
+        {"resolverAtaque/bits/CONE", benchResolverAtaqueBits, &porHabilidade[HABILIDADE_CONE]},
+        {"resolverAtaque/bits/CRUZ", benchResolverAtaqueBits, &porHabilidade[HABILIDADE_CRUZ]},
+        {"resolverAtaque/bits/OCTAEDRO", benchResolverAtaqueBits, &porHabilidade[HABILIDADE_OCTAEDRO]},
+        {"verificarNaviosDestruidos", benchVerificarNaviosDestruidos, ctx},
+        {"sortearFrota", benchSortearFrota, ctx},
+        {"simularPartida", benchPartidaCompleta, ctx},
+        {"turno/densidade", benchPartidaDensidade, ctx},
+        {"renderizarTabuleiro", benchRenderizarTabuleiro, ctx},
+        {"renderizarDiferenca", benchRenderizarDiferenca, ctx},
+        {"partida/malloc", benchPartidaMalloc, ctx},
+        {"partida/pool", benchPartidaPool, ctx},
+    };
+    const int quantidade = (int)(sizeof(primitivas) / sizeof(primitivas[0]));
+    ResultadoBenchmark resultados[sizeof(primitivas) / sizeof(primitivas[0])];
+
+    for (int i = 0; i < quantidade; i++) {
+        // Cada primitiva recomeça do mesmo fluxo aleatório para medições repetíveis
+        inicializarGerador(&ctx->gerador, semente, 2);
+        medirPrimitiva(&primitivas[i], &resultados[i]);
     }
 
-    printf("\n📊 Resultado deste ataque:\n");
-    printf("   • Tiros disparados: %d\n", tirosNesteTurno);
-    printf("   • Acertos: %d\n", acertosNesteTiro);
-    printf("   • Erros: %d\n", tirosNesteTurno - acertosNesteTiro);
-    if (acertosNesteTiro > 0 && tirosNesteTurno > 0) {
-        printf("   🎉 Taxa de acerto: %.1f%%\n", (float)acertosNesteTiro / tirosNesteTurno * 100);
+    if (json) {
+        emitirResultadosJson(resultados, quantidade, semente);
+    } else {
+        exibirResultadosBenchmark(resultados, quantidade);
     }
+
+    destruirPoolPartidas(&ctx->pool);
+    free(ctx->cenarios);
+    free(ctx);
+    return 0;
 }
 
 /**
- * Exibe estatísticas finais do jogo
+ * Lê um argumento numérico inteiro positivo da linha de comando
  *
- * @param stats Estrutura com as estatísticas
+ * @param texto Texto do argumento
+ * @param valor Ponteiro para armazenar o valor
+ * @return 1 se válido, 0 caso contrário
  */
-void exibirEstatisticasFinais(EstatisticasJogo* stats) {
-    printf("\n╔══════════════════════════════════════╗\n");
-    printf("║        ESTATÍSTICAS FINAIS           ║\n");
-    printf("╚══════════════════════════════════════╝\n");
-    printf("📊 Total de tiros disparados: %d\n", stats->totalTiros);
-    printf("🎯 Total de acertos: %d\n", stats->acertos);
-    printf("❌ Total de erros: %d\n", stats->erros);
-    if (stats->totalTiros > 0) {
-        printf("📈 Taxa de acerto geral: %.1f%%\n", (float)stats->acertos / stats->totalTiros * 100);
+static int lerArgumentoNumerico(const char* texto, long long* valor) {
+    char* endptr;
+    long long convertido = strtoll(texto, &endptr, 10);
+    if (texto[0] == '\0' || *endptr != '\0' || convertido < 0) {
+        return 0;
     }
-    printf("🚢 Navios destruídos: %d de %d\n", stats->naviosDestruidos, MAX_NAVIOS);
+    *valor = convertido;
+    return 1;
 }
 
 /*
@@ -780,18 +12547,345 @@ void exibirEstatisticasFinais(EstatisticasJogo* stats) {
  * ============================================
  */
 
+/**
+ * Mostra todos os modos de linha de comando (os mesmos listados em main)
+ *
+ * @param programa Nome do executável (argv[0])
+ */
+static void exibirUso(const char* programa) {
+    static const char* const modos[] = {
+        "(sem argumentos: jogo interativo)",
+        "--simulate N [--ia] [--seed S]",
+        "--montecarlo N [--threads T] [--ia] [--seed S]",
+        "--simulate N --tabuleiro LxC [--frota 5:10,4:20,3,2] [--seed S]",
+        "--benchmark-kernels [--iteracoes N] [--seed S]",
+        "--benchmark [--json] [--seed S]",
+        "--assistir [--ia] [--seed S]",
+        "--simulate N --planejador [--threads T] [--orcamento MS] [--seed S]",
+        "--assistir --planejador [--threads T] [--orcamento MS] [--seed S]",
+        "--simulate N --gravar ARQUIVO [--ia] [--seed S]",
+        "--inspecionar ARQUIVO",
+        "--habilidades PADROES [--simulate N [--ia | --planejador]]",
+        "--replay ARQUIVO... [--threads T]",
+        "--roteiro ARQUIVO",
+        "--servidor PORTA [--max-partidas N] [--metricas PORTA] [--instantaneo ARQUIVO] [--seed S]",
+        "--carga PORTA N [--seed S]",
+        "--corrotinas N [--threads T] [--ia] [--clientes] [--seed S]",
+        "--torneio PORTA N [--lote L] [--gravar DIRETORIO] [--seed S]",
+        "--no-torneio HOST:PORTA [--threads T]",
+        "--enumerar [--threads T] [--opencl] [--validar]",
+        "--regressao N [--threads T] [--seed S]",
+    };
+    for (size_t i = 0; i < sizeof(modos) / sizeof(modos[0]); i++) {
+        fprintf(stderr, "%s %s %s\n", i == 0 ? "Uso:" : "    ", programa, modos[i]);
+    }
+}
+
 /**
  * Função principal do sistema
  * Controla todo o fluxo do jogo de batalha naval
  *
+ * Uso: batalhaNaval                          (jogo interativo)
+ *      batalhaNaval --simulate N [--ia] [--seed S]  (N partidas em memória)
+ *      batalhaNaval --montecarlo N [--threads T] [--ia] [--seed S]
+ *      batalhaNaval --simulate N --tabuleiro LxC [--frota 5:10,4:20,3,2] [--seed S]
+ *      batalhaNaval --benchmark-kernels [--iteracoes N] [--seed S]
+ *      batalhaNaval --benchmark [--json] [--seed S]
+ *      batalhaNaval --assistir [--ia] [--seed S]   (uma partida redesenhada por diferenças)
+ *      batalhaNaval --simulate N --planejador [--threads T] [--orcamento MS] [--seed S]
+ *      batalhaNaval --assistir --planejador [--threads T] [--orcamento MS] [--seed S]
+ *      batalhaNaval --simulate N --gravar ARQUIVO [--ia] [--seed S]
+ *      batalhaNaval --inspecionar ARQUIVO
+ *      batalhaNaval --habilidades PADROES [--simulate N [--ia | --planejador]]
+ *      batalhaNaval --replay ARQUIVO... [--threads T]
+ *      batalhaNaval --roteiro ARQUIVO                (comandos "A5 H", "CONE B3", "FIM"; "-" = stdin)
+ *      batalhaNaval --servidor PORTA [--max-partidas N] [--metricas PORTA] [--seed S]
+ *      batalhaNaval --servidor PORTA --instantaneo ARQUIVO   (restaura e grava as partidas em andamento)
+ *      batalhaNaval --carga PORTA N [--seed S]     (N partidas contra o servidor local)
+ *      batalhaNaval --corrotinas N [--threads T] [--ia] [--clientes] [--seed S]
+ *      batalhaNaval --torneio PORTA N [--lote L] [--gravar DIRETORIO] [--seed S]  (N partidas por pareamento)
+ *      batalhaNaval --no-torneio HOST:PORTA [--threads T]
+ *      batalhaNaval --enumerar [--threads T] [--opencl] [--validar]  (todas as frotas legais, contagens exatas)
+ *      batalhaNaval --regressao N [--threads T] [--seed S]  (N partidas por todos os caminhos do motor)
+ *
  * @return 0 se execução bem-sucedida
  */
-int main() {
+int main(int argc, char* argv[]) {
+#if BATALHA_INSTRUMENTACAO
+    atexit(exibirInstrumentacao);
+#endif
+
+    // Modos não interativos selecionados pela linha de comando
+    if (argc > 1) {
+        long long partidas = -1;
+        long long partidasMonteCarlo = -1;
+        long long threads = 0;
+        long long semente = 42;
+        int linhas = 0, colunas = 0;
+        ConfiguracaoFrota frota = {MAX_NAVIOS, {4, 3, 3, 2}};   // Frota padrão até --frota
+        int frotaInformada = 0;
+        int benchmarkKernels = 0;
+        int benchmark = 0;
+        int json = 0;
+        int assistir = 0;
+        int ataqueDensidade = 0;
+        int planejador = 0;
+        long long orcamentoMs = ORCAMENTO_PLANEJADOR_MS;
+        const char* arquivoGravacao = NULL;
+        const char* arquivoInspecao = NULL;
+        const char* arquivoHabilidades = NULL;
+        const char* arquivoRoteiro = NULL;
+        const char* arquivoInstantaneo = NULL;
+        const char* const* arquivosReplay = NULL;
+        int quantidadeReplay = 0;
+        long long portaServidor = -1;
+        long long portaMetricas = -1;
+        long long portaCarga = -1;
+        long long partidasCarga = 0;
+        long long partidasCorrotinas = -1;
+        int clientesCorrotinas = 0;
+        long long portaTorneio = -1;
+        long long partidasTorneio = 0;
+        long long partidasLote = 0;
+        const char* coordenadorTorneio = NULL;
+        long long maxPartidas = PARTIDAS_SERVIDOR_PADRAO;
+        long long iteracoes = 20000;
+        int enumerar = 0;
+        long long partidasRegressao = -1;
+        int enumerarOpenCL = 0;
+        int validarEnumeracao = 0;
+
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--simulate") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &partidas)) {
+                    fprintf(stderr, "❌ Número de partidas inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--montecarlo") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &partidasMonteCarlo)) {
+                    fprintf(stderr, "❌ Número de partidas inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &threads)) {
+                    fprintf(stderr, "❌ Número de threads inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--tabuleiro") == 0 && i + 1 < argc) {
+                if (!interpretarDimensoes(argv[++i], &linhas, &colunas)) {
+                    fprintf(stderr, "❌ Dimensões inválidas: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--frota") == 0 && i + 1 < argc) {
+                if (!interpretarFrota(argv[++i], &frota)) {
+                    fprintf(stderr, "❌ Frota inválida: %s\n", argv[i]);
+                    return 1;
+                }
+                frotaInformada = 1;
+            } else if (strcmp(argv[i], "--benchmark") == 0) {
+                benchmark = 1;
+            } else if (strcmp(argv[i], "--json") == 0) {
+                json = 1;
+            } else if (strcmp(argv[i], "--assistir") == 0) {
+                assistir = 1;
+            } else if (strcmp(argv[i], "--ia") == 0) {
+                ataqueDensidade = 1;
+            } else if (strcmp(argv[i], "--planejador") == 0) {
+                planejador = 1;
+            } else if (strcmp(argv[i], "--orcamento") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &orcamentoMs) || orcamentoMs == 0 || orcamentoMs > 60000) {
+                    fprintf(stderr, "❌ Orçamento inválido (ms): %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--gravar") == 0 && i + 1 < argc) {
+                arquivoGravacao = argv[++i];
+            } else if (strcmp(argv[i], "--inspecionar") == 0 && i + 1 < argc) {
+                arquivoInspecao = argv[++i];
+            } else if (strcmp(argv[i], "--habilidades") == 0 && i + 1 < argc) {
+                arquivoHabilidades = argv[++i];
+            } else if (strcmp(argv[i], "--roteiro") == 0 && i + 1 < argc) {
+                arquivoRoteiro = argv[++i];
+            } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+                // Todos os argumentos seguintes que não são opções são registros
+                arquivosReplay = (const char* const*)&argv[i + 1];
+                while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                    quantidadeReplay++;
+                    i++;
+                }
+            } else if (strcmp(argv[i], "--servidor") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &portaServidor) || portaServidor > 65535) {
+                    fprintf(stderr, "❌ Porta inválida: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &portaMetricas) || portaMetricas > 65535) {
+                    fprintf(stderr, "❌ Porta inválida: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--instantaneo") == 0 && i + 1 < argc) {
+                arquivoInstantaneo = argv[++i];
+            } else if (strcmp(argv[i], "--max-partidas") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &maxPartidas) || maxPartidas == 0 || maxPartidas > 1000000) {
+                    fprintf(stderr, "❌ Número de partidas inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--carga") == 0 && i + 2 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &portaCarga) || portaCarga > 65535 ||
+                    !lerArgumentoNumerico(argv[++i], &partidasCarga) || partidasCarga == 0) {
+                    fprintf(stderr, "❌ Uso: --carga PORTA PARTIDAS\n");
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--corrotinas") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &partidasCorrotinas)) {
+                    fprintf(stderr, "❌ Número de partidas inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--clientes") == 0) {
+                clientesCorrotinas = 1;
+            } else if (strcmp(argv[i], "--torneio") == 0 && i + 2 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &portaTorneio) || portaTorneio > 65535 ||
+                    !lerArgumentoNumerico(argv[++i], &partidasTorneio) || partidasTorneio == 0) {
+                    fprintf(stderr, "❌ Uso: --torneio PORTA PARTIDAS\n");
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &partidasLote) || partidasLote == 0 || partidasLote > 1000000) {
+                    fprintf(stderr, "❌ Tamanho de lote inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--no-torneio") == 0 && i + 1 < argc) {
+                coordenadorTorneio = argv[++i];
+            } else if (strcmp(argv[i], "--regressao") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &partidasRegressao) || partidasRegressao == 0) {
+                    fprintf(stderr, "❌ Número de partidas inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--enumerar") == 0) {
+                enumerar = 1;
+            } else if (strcmp(argv[i], "--opencl") == 0) {
+                enumerarOpenCL = 1;
+            } else if (strcmp(argv[i], "--validar") == 0) {
+                validarEnumeracao = 1;
+            } else if (strcmp(argv[i], "--benchmark-kernels") == 0) {
+                benchmarkKernels = 1;
+            } else if (strcmp(argv[i], "--iteracoes") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &iteracoes) || iteracoes == 0) {
+                    fprintf(stderr, "❌ Número de iterações inválido: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                if (!lerArgumentoNumerico(argv[++i], &semente)) {
+                    fprintf(stderr, "❌ Semente inválida: %s\n", argv[i]);
+                    return 1;
+                }
+            } else {
+                exibirUso(argv[0]);
+                return 1;
+            }
+        }
+        // Tabuleiro e frota configuráveis só existem na simulação dinâmica
+        if ((linhas > 0 || frotaInformada) && partidas < 0) {
+            exibirUso(argv[0]);
+            return 1;
+        }
+
+        if (benchmark) {
+            return executarSuiteBenchmarks(json, (uint64_t)semente);
+        }
+        if (portaServidor >= 0) {
+            return executarServidor((int)portaServidor, (int)portaMetricas, (int)maxPartidas, (uint64_t)semente,
+                                    arquivoInstantaneo);
+        }
+        if (portaCarga >= 0) {
+            return executarGeradorCarga((int)portaCarga, (int)partidasCarga, (uint64_t)semente);
+        }
+        if (portaTorneio >= 0) {
+            return executarCoordenadorTorneio((int)portaTorneio, partidasTorneio, (int)partidasLote, arquivoGravacao,
+                                              (uint64_t)semente);
+        }
+        if (coordenadorTorneio != NULL) {
+            return executarNoTorneio(coordenadorTorneio, (int)threads);
+        }
+        if (partidasCorrotinas >= 0) {
+            return executarCorrotinas(partidasCorrotinas, (int)threads, ataqueDensidade, clientesCorrotinas,
+                                      (uint64_t)semente);
+        }
+        if (quantidadeReplay > 0) {
+            return executarReplay(arquivosReplay, quantidadeReplay, (int)threads);
+        }
+        if (arquivoInspecao != NULL) {
+            return executarInspecaoRegistro(arquivoInspecao);
+        }
+        if (arquivoRoteiro != NULL) {
+            return executarRoteiro(arquivoRoteiro);
+        }
+        ConfiguracaoPlanejador configuracaoPlanejador = {(int)(threads > MAX_THREADS ? MAX_THREADS : threads),
+                                                         (int)orcamentoMs};
+        const ConfiguracaoPlanejador* usarPlanejador = planejador ? &configuracaoPlanejador : NULL;
+        if (planejador && (partidasMonteCarlo >= 0 || arquivoGravacao != NULL)) {
+            fprintf(stderr, "❌ O planejador usa o próprio pool de threads: combine-o com --simulate ou --assistir.\n");
+            return 1;
+        }
+        if (arquivoHabilidades != NULL) {
+            if (partidas < 0) {
+                return executarCatalogoHabilidades(arquivoHabilidades);
+            }
+            if (assistir || benchmarkKernels || partidasMonteCarlo >= 0 || linhas > 0 || frotaInformada ||
+                arquivoGravacao != NULL) {
+                fprintf(stderr, "❌ Habilidades de arquivo se combinam apenas com --simulate N [--ia | --planejador].\n");
+                return 1;
+            }
+            CatalogoHabilidades catalogo;
+            int linhaErro;
+            int carregado = carregarArquivoHabilidades(arquivoHabilidades, &catalogo, &linhaErro);
+            if (carregado != SUCESSO) {
+                if (carregado == ERRO_MEMORIA) {
+                    fprintf(stderr, "❌ Memória insuficiente para carregar %s\n", arquivoHabilidades);
+                } else {
+                    fprintf(stderr, "❌ Arquivo de habilidades inválido: %s (linha %d)\n", arquivoHabilidades, linhaErro);
+                }
+                destruirCatalogoHabilidades(&catalogo);
+                return 1;
+            }
+            int resultado = executarSimulacao(partidas, (uint64_t)semente, ataqueDensidade, usarPlanejador, &catalogo);
+            destruirCatalogoHabilidades(&catalogo);
+            return resultado;
+        }
+        if (assistir) {
+            return executarModoEspectador((uint64_t)semente, ataqueDensidade, usarPlanejador);
+        }
+        if (benchmarkKernels) {
+            return executarBenchmarkKernels(iteracoes, (uint64_t)semente);
+        }
+        if (partidasRegressao > 0) {
+            return executarRegressao(partidasRegressao, (int)threads, (uint64_t)semente);
+        }
+        if (enumerar) {
+            return executarEnumeracaoFrotas((int)threads, enumerarOpenCL, validarEnumeracao);
+        }
+        if (partidasMonteCarlo >= 0) {
+            return executarModoMonteCarlo(partidasMonteCarlo, (int)threads, (uint64_t)semente, ataqueDensidade);
+        }
+        if (partidas >= 0 && (linhas > 0 || frotaInformada)) {
+            return executarSimulacaoDinamica(partidas,
+                                             linhas > 0 ? linhas : TAMANHO_TABULEIRO,
+                                             colunas > 0 ? colunas : TAMANHO_TABULEIRO,
+                                             &frota, (uint64_t)semente);
+        }
+        if (partidas >= 0 && arquivoGravacao != NULL) {
+            return executarSimulacaoGravada(partidas, (uint64_t)semente, ataqueDensidade, arquivoGravacao);
+        }
+        if (partidas >= 0) {
+            return executarSimulacao(partidas, (uint64_t)semente, ataqueDensidade, usarPlanejador, NULL);
+        }
+    }
+
     // Declaração das estruturas principais
     int tabuleiro[TAMANHO_TABULEIRO][TAMANHO_TABULEIRO];
     int habilidadeCone[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
     int habilidadeCruz[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
     int habilidadeOctaedro[TAMANHO_HABILIDADE][TAMANHO_HABILIDADE];
+    HabilidadeCompilada cone, cruz, octaedro;
     EstatisticasJogo stats;
 
     // Banner inicial do sistema
@@ -842,6 +12936,11 @@ int main() {
     criarHabilidadeOctaedro(habilidadeOctaedro);
     exibirHabilidade(habilidadeOctaedro, "OCTAEDRO");
 
+    // Compila as habilidades uma única vez em máscaras por centro
+    compilarHabilidade(habilidadeCone, "CONE", &cone);
+    compilarHabilidade(habilidadeCruz, "CRUZ", &cruz);
+    compilarHabilidade(habilidadeOctaedro, "OCTAEDRO", &octaedro);
+
     // Simulação de combate
     printf("\n╔════════════════════════════════════════════════╗\n");
     printf("║               INÍCIO DO COMBATE                ║\n");
@@ -858,17 +12957,17 @@ int main() {
 
     // Ataque com CONE
     if (lerCoordenadaAtaque("CONE", &ataques[0])) {
-        aplicarHabilidadeNoTabuleiro(tabuleiro, habilidadeCone, ataques[0].linha, ataques[0].coluna, "CONE", navios, MAX_NAVIOS, &stats);
+        aplicarHabilidadeCompiladaNoTabuleiro(tabuleiro, &cone, ataques[0].linha, ataques[0].coluna, navios, MAX_NAVIOS, &stats, &receptorConsole);
     }
 
     // Ataque com CRUZ
     if (lerCoordenadaAtaque("CRUZ", &ataques[1])) {
-        aplicarHabilidadeNoTabuleiro(tabuleiro, habilidadeCruz, ataques[1].linha, ataques[1].coluna, "CRUZ", navios, MAX_NAVIOS, &stats);
+        aplicarHabilidadeCompiladaNoTabuleiro(tabuleiro, &cruz, ataques[1].linha, ataques[1].coluna, navios, MAX_NAVIOS, &stats, &receptorConsole);
     }
 
     // Ataque com OCTAEDRO
     if (lerCoordenadaAtaque("OCTAEDRO", &ataques[2])) {
-        aplicarHabilidadeNoTabuleiro(tabuleiro, habilidadeOctaedro, ataques[2].linha, ataques[2].coluna, "OCTAEDRO", navios, MAX_NAVIOS, &stats);
+        aplicarHabilidadeCompiladaNoTabuleiro(tabuleiro, &octaedro, ataques[2].linha, ataques[2].coluna, navios, MAX_NAVIOS, &stats, &receptorConsole);
     }
 
     // Exibição do tabuleiro final